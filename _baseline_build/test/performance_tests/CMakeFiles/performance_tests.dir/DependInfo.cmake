@@ -0,0 +1,45 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/blob_detection.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/blob_detection.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/blob_detection.cpp.o.d"
+  "/root/repo/src/edge_detection.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/edge_detection.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/edge_detection.cpp.o.d"
+  "/root/repo/src/filtering.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/filtering.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/filtering.cpp.o.d"
+  "/root/repo/src/function_pool.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/function_pool.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/function_pool.cpp.o.d"
+  "/root/repo/src/function_pool_batch.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/function_pool_batch.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/function_pool_batch.cpp.o.d"
+  "/root/repo/src/function_pool_task.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/function_pool_task.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/function_pool_task.cpp.o.d"
+  "/root/repo/src/image_function.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/image_function.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/image_function.cpp.o.d"
+  "/root/repo/src/image_function_helper.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/image_function_helper.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/image_function_helper.cpp.o.d"
+  "/root/repo/src/image_function_simd.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/image_function_simd.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/image_function_simd.cpp.o.d"
+  "/root/repo/src/image_function_simd_avx.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_avx.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_avx.cpp.o.d"
+  "/root/repo/src/image_function_simd_avx512.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_avx512.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_avx512.cpp.o.d"
+  "/root/repo/src/image_function_simd_neon.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_neon.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_neon.cpp.o.d"
+  "/root/repo/src/image_function_simd_sse.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_sse.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_sse.cpp.o.d"
+  "/root/repo/src/math/math_base.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/math/math_base.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/math/math_base.cpp.o.d"
+  "/root/repo/src/penguinv/penguinv.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/penguinv/penguinv.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/penguinv/penguinv.cpp.o.d"
+  "/root/repo/src/thread_pool.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/thread_pool.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/__/src/thread_pool.cpp.o.d"
+  "/root/repo/test/test_helper.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/__/test_helper.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/__/test_helper.cpp.o.d"
+  "/root/repo/test/performance_tests/performance_test_blob_detection.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_blob_detection.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_blob_detection.cpp.o.d"
+  "/root/repo/test/performance_tests/performance_test_edge_detection.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_edge_detection.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_edge_detection.cpp.o.d"
+  "/root/repo/test/performance_tests/performance_test_filtering.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_filtering.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_filtering.cpp.o.d"
+  "/root/repo/test/performance_tests/performance_test_framework.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_framework.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_framework.cpp.o.d"
+  "/root/repo/test/performance_tests/performance_test_helper.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_helper.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_helper.cpp.o.d"
+  "/root/repo/test/performance_tests/performance_test_image_function.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_image_function.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_image_function.cpp.o.d"
+  "/root/repo/test/performance_tests/performance_test_memory.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_memory.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_memory.cpp.o.d"
+  "/root/repo/test/performance_tests/performance_test_penguinv.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_penguinv.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_penguinv.cpp.o.d"
+  "/root/repo/test/performance_tests/performance_test_thread_pool.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_thread_pool.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_test_thread_pool.cpp.o.d"
+  "/root/repo/test/performance_tests/performance_tests.cpp" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_tests.cpp.o" "gcc" "test/performance_tests/CMakeFiles/performance_tests.dir/performance_tests.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
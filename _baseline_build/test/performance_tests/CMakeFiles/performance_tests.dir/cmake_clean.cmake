@@ -0,0 +1,63 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/performance_tests.dir/__/__/src/blob_detection.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/blob_detection.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/__/src/edge_detection.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/edge_detection.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/__/src/filtering.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/filtering.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/__/src/function_pool.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/function_pool.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/__/src/function_pool_batch.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/function_pool_batch.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/__/src/function_pool_task.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/function_pool_task.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/__/src/image_function.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/image_function.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/__/src/image_function_helper.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/image_function_helper.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/__/src/image_function_simd.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/image_function_simd.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_avx.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_avx.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_avx512.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_avx512.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_neon.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_neon.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_sse.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/image_function_simd_sse.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/__/src/math/math_base.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/math/math_base.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/__/src/penguinv/penguinv.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/penguinv/penguinv.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/__/src/thread_pool.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/__/src/thread_pool.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/__/test_helper.cpp.o"
+  "CMakeFiles/performance_tests.dir/__/test_helper.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/performance_test_blob_detection.cpp.o"
+  "CMakeFiles/performance_tests.dir/performance_test_blob_detection.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/performance_test_edge_detection.cpp.o"
+  "CMakeFiles/performance_tests.dir/performance_test_edge_detection.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/performance_test_filtering.cpp.o"
+  "CMakeFiles/performance_tests.dir/performance_test_filtering.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/performance_test_framework.cpp.o"
+  "CMakeFiles/performance_tests.dir/performance_test_framework.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/performance_test_helper.cpp.o"
+  "CMakeFiles/performance_tests.dir/performance_test_helper.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/performance_test_image_function.cpp.o"
+  "CMakeFiles/performance_tests.dir/performance_test_image_function.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/performance_test_memory.cpp.o"
+  "CMakeFiles/performance_tests.dir/performance_test_memory.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/performance_test_penguinv.cpp.o"
+  "CMakeFiles/performance_tests.dir/performance_test_penguinv.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/performance_test_thread_pool.cpp.o"
+  "CMakeFiles/performance_tests.dir/performance_test_thread_pool.cpp.o.d"
+  "CMakeFiles/performance_tests.dir/performance_tests.cpp.o"
+  "CMakeFiles/performance_tests.dir/performance_tests.cpp.o.d"
+  "performance_tests"
+  "performance_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/performance_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
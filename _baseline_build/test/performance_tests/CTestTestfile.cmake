@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/performance_tests
+# Build directory: /root/repo/_baseline_build/test/performance_tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(perf_test "/root/repo/_baseline_build/test/performance_tests/performance_tests")
+set_tests_properties(perf_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/performance_tests/CMakeLists.txt;74;add_test;/root/repo/test/performance_tests/CMakeLists.txt;0;")
@@ -0,0 +1,57 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/thirdparty/kissfft/kiss_fft.c" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/thirdparty/kissfft/kiss_fft.c.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/thirdparty/kissfft/kiss_fft.c.o.d"
+  "/root/repo/src/thirdparty/kissfft/kiss_fftnd.c" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/thirdparty/kissfft/kiss_fftnd.c.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/thirdparty/kissfft/kiss_fftnd.c.o.d"
+  "/root/repo/src/blob_detection.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/blob_detection.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/blob_detection.cpp.o.d"
+  "/root/repo/src/edge_detection.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/edge_detection.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/edge_detection.cpp.o.d"
+  "/root/repo/src/fft.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/fft.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/fft.cpp.o.d"
+  "/root/repo/src/file/bmp_image.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/file/bmp_image.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/file/bmp_image.cpp.o.d"
+  "/root/repo/src/file/jpeg_image.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/file/jpeg_image.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/file/jpeg_image.cpp.o.d"
+  "/root/repo/src/file/png_image.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/file/png_image.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/file/png_image.cpp.o.d"
+  "/root/repo/src/filtering.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/filtering.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/filtering.cpp.o.d"
+  "/root/repo/src/function_pool.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/function_pool.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/function_pool.cpp.o.d"
+  "/root/repo/src/function_pool_async.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/function_pool_async.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/function_pool_async.cpp.o.d"
+  "/root/repo/src/function_pool_batch.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/function_pool_batch.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/function_pool_batch.cpp.o.d"
+  "/root/repo/src/function_pool_graph.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/function_pool_graph.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/function_pool_graph.cpp.o.d"
+  "/root/repo/src/function_pool_task.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/function_pool_task.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/function_pool_task.cpp.o.d"
+  "/root/repo/src/image_function.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/image_function.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/image_function.cpp.o.d"
+  "/root/repo/src/image_function_helper.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/image_function_helper.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/image_function_helper.cpp.o.d"
+  "/root/repo/src/image_function_simd.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/image_function_simd.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/image_function_simd.cpp.o.d"
+  "/root/repo/src/image_function_simd_avx.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/image_function_simd_avx.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/image_function_simd_avx.cpp.o.d"
+  "/root/repo/src/image_function_simd_avx512.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/image_function_simd_avx512.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/image_function_simd_avx512.cpp.o.d"
+  "/root/repo/src/image_function_simd_neon.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/image_function_simd_neon.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/image_function_simd_neon.cpp.o.d"
+  "/root/repo/src/image_function_simd_sse.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/image_function_simd_sse.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/image_function_simd_sse.cpp.o.d"
+  "/root/repo/src/math/fft_base.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/math/fft_base.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/math/fft_base.cpp.o.d"
+  "/root/repo/src/math/haar_transform.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/math/haar_transform.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/math/haar_transform.cpp.o.d"
+  "/root/repo/src/math/hough_transform.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/math/hough_transform.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/math/hough_transform.cpp.o.d"
+  "/root/repo/src/math/math_base.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/math/math_base.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/math/math_base.cpp.o.d"
+  "/root/repo/src/penguinv/penguinv.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/penguinv/penguinv.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/penguinv/penguinv.cpp.o.d"
+  "/root/repo/src/thread_pool.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/thread_pool.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/__/src/thread_pool.cpp.o.d"
+  "/root/repo/test/test_helper.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/__/test_helper.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/__/test_helper.cpp.o.d"
+  "/root/repo/test/unit_tests/unit_test_blob_detection.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_blob_detection.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_blob_detection.cpp.o.d"
+  "/root/repo/test/unit_tests/unit_test_edge_detection.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_edge_detection.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_edge_detection.cpp.o.d"
+  "/root/repo/test/unit_tests/unit_test_fft.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_fft.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_fft.cpp.o.d"
+  "/root/repo/test/unit_tests/unit_test_file.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_file.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_file.cpp.o.d"
+  "/root/repo/test/unit_tests/unit_test_framework.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_framework.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_framework.cpp.o.d"
+  "/root/repo/test/unit_tests/unit_test_helper.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_helper.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_helper.cpp.o.d"
+  "/root/repo/test/unit_tests/unit_test_image_buffer.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_image_buffer.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_image_buffer.cpp.o.d"
+  "/root/repo/test/unit_tests/unit_test_image_function.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_image_function.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_image_function.cpp.o.d"
+  "/root/repo/test/unit_tests/unit_test_math.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_math.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_math.cpp.o.d"
+  "/root/repo/test/unit_tests/unit_test_memory.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_memory.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_test_memory.cpp.o.d"
+  "/root/repo/test/unit_tests/unit_tests.cpp" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_tests.cpp.o" "gcc" "test/unit_tests/CMakeFiles/unit_tests.dir/unit_tests.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/unit_tests
+# Build directory: /root/repo/_baseline_build/test/unit_tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(unit_test "/root/repo/_baseline_build/test/unit_tests/unit_tests")
+set_tests_properties(unit_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/unit_tests/CMakeLists.txt;111;add_test;/root/repo/test/unit_tests/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+# Source files with code of SIMD instruction sets are compiled with own compiler flags while the rest of files use baseline flags.
+# The best instruction set supported by a processor is selected during runtime. Visual Studio does not need such flags for intrinsics.
+# LIB_DIR variable must point to the source directory of the library
+if(NOT MSVC AND CMAKE_SYSTEM_PROCESSOR MATCHES "(x86_64)|(X86_64)|(AMD64)|(amd64)|(i[3-6]86)")
+    set_source_files_properties(${LIB_DIR}/image_function_simd_sse.cpp
+                                PROPERTIES COMPILE_FLAGS "-msse2 -mssse3")
+    set_source_files_properties(${LIB_DIR}/image_function_simd_avx.cpp
+                                PROPERTIES COMPILE_FLAGS "-mavx2")
+    set_source_files_properties(${LIB_DIR}/image_function_simd_avx512.cpp
+                                PROPERTIES COMPILE_FLAGS "-mavx512f -mavx512cd -mavx512bw -mavx512dq -mavx512vl")
+endif()
@@ -23,13 +23,17 @@
 #include "../../src/image_function.h"
 #include "../../src/penguinv_exception.h"
 #include "../../src/thread_pool.h"
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 
 void basic( const std::vector<penguinV::Image> & frame );
 void multithreaded( const std::vector<penguinV::Image> & frame );
+void configured( const std::vector<penguinV::Image> & frame );
+std::vector<double> processFrames( const std::vector<penguinV::Image> & frame );
 
 double getElapsedTime( std::chrono::time_point<std::chrono::system_clock> start );
+void printLatency( std::vector<double> latency );
 
 template <class T_>
 T_ randomValue( uint32_t maximum )
@@ -90,6 +94,13 @@ int main()
         multithreaded( frame );
 
         std::cout << "Total time is " << getElapsedTime( startTime ) << " seconds" << std::endl;
+
+        std::cout << "----------" << std::endl << "Functions with configured thread pool. Evaluating time..." << std::endl << "----------" << std::endl;
+        startTime = std::chrono::system_clock::now();
+
+        configured( frame );
+
+        std::cout << "Total time is " << getElapsedTime( startTime ) << " seconds" << std::endl;
     }
     catch ( const std::exception & ex ) { // uh-oh, something went wrong!
         std::cout << ex.what() << ". Press any button to continue." << std::endl;
@@ -114,6 +125,15 @@ double getElapsedTime( std::chrono::time_point<std::chrono::system_clock> start
     return time.count();
 }
 
+void printLatency( std::vector<double> latency )
+{
+    // a frame must be processed before the next one comes so the worst frames matter more than average time
+    std::sort( latency.begin(), latency.end() );
+
+    std::cout << "Frame latency: median is " << latency[latency.size() / 2] * 1000 << " ms, 99th percentile is "
+              << latency[( latency.size() * 99 ) / 100] * 1000 << " ms" << std::endl;
+}
+
 void basic( const std::vector<penguinV::Image> & frame )
 {
     // Prepare image map
@@ -145,14 +165,46 @@ void multithreaded( const std::vector<penguinV::Image> & frame )
     // okay we setup 4 thread in global thread pool
     ThreadPoolMonoid::instance().resize( 4 );
 
+    printLatency( processFrames( frame ) );
+
+    // We stop all threads in thread pool
+    ThreadPoolMonoid::instance().stop();
+}
+
+void configured( const std::vector<penguinV::Image> & frame )
+{
+    // Worker threads of global thread pool could be moved by the system between cores and even between CPU sockets
+    // in the middle of a frame and they compete for cores with other threads of the application. Some frames take much longer then.
+    // Here we create another thread pool for this latency critical processing: its threads have higher priority
+    // (it requires privileges on Linux, otherwise it is ignored), every thread is pinned to its own core
+    // and threads are grouped by NUMA nodes so they access memory of their node and steal tasks from neighbours first
+    ThreadPoolConfiguration configuration;
+    configuration.pinThreads = true;
+    configuration.groupByNode = true;
+    configuration.priority = high_priority;
+
+    ThreadPool pool( 4, configuration );
+
+    // All Function_Pool functions called in this thread use selected thread pool while selection object exists
+    ThreadPoolSelection selection( pool );
+
+    printLatency( processFrames( frame ) );
+}
+
+std::vector<double> processFrames( const std::vector<penguinV::Image> & frame )
+{
     // Prepare image map
     penguinV::Image map( frame.front().width(), frame.front().height() );
     map.fill( 0 );
 
     penguinV::Image result( map.width(), map.height() );
 
+    std::vector<double> latency;
+
     // As you see the only difference in this loop is namespace name
     for ( size_t i = 0; i + 1 < frame.size(); ++i ) {
+        const std::chrono::time_point<std::chrono::system_clock> frameTime = std::chrono::system_clock::now();
+
         // subtract one image from another
         Function_Pool::Subtract( frame[i + 1], frame[i], result );
 
@@ -165,10 +217,11 @@ void multithreaded( const std::vector<penguinV::Image> & frame )
             // add result to the map
             Function_Pool::BitwiseOr( map, result, map );
         }
+
+        latency.push_back( getElapsedTime( frameTime ) );
     }
 
     // here we have to save the image map but don't do this in the example
 
-    // We stop all threads in thread pool
-    ThreadPoolMonoid::instance().stop();
+    return latency;
 }
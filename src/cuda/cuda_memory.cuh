@@ -21,7 +21,6 @@
 #pragma once
 
 #include <cuda_runtime.h>
-#include <map>
 #include "../memory/memory_allocator.h"
 
 namespace multiCuda
@@ -53,14 +52,16 @@ namespace multiCuda
             if ( _data != nullptr && size < _size ) {
                 const uint8_t level = _getAllocationLevel( size );
 
-                if ( _split( level ) ) {
-                    _DataType* address = reinterpret_cast<_DataType*>(static_cast<uint8_t*>(_data) + *_freeChunk[level].begin());
-                    _allocatedChunk.insert( std::pair<size_t, uint8_t >( *_freeChunk[level].begin(), level ) );
-                    _freeChunk[level].erase( _freeChunk[level].begin() );
-                    return address;
+                size_t offset = 0;
+
+                if ( _allocateChunk( level, offset ) ) {
+                    _registerChunkAllocation( size, level );
+                    return reinterpret_cast<_DataType*>(static_cast<uint8_t*>(_data) + offset);
                 }
             }
 
+            _registerHeapAllocation();
+
             // if no space in preallocated memory just allocate as usual memory
             _DataType* address = nullptr;
             cudaError_t error = cudaMalloc( &address, size );
@@ -76,14 +77,11 @@ namespace multiCuda
         // otherwise CUDA specific function will be called
         void free( void * address )
         {
-            if ( _data != nullptr && address >= _data ) {
-                std::map <size_t, uint8_t>::iterator pos =
-                    _allocatedChunk.find( static_cast<uint8_t*>(address) - static_cast<uint8_t*>(_data) );
-
-                if ( pos != _allocatedChunk.end() ) {
-                    _freeChunk[pos->second].insert( pos->first );
-                    _merge( pos->first, pos->second );
-                    _allocatedChunk.erase( pos );
+            if ( _data != nullptr && address >= _data && static_cast<uint8_t*>(address) < static_cast<uint8_t*>(_data) + _size ) {
+                const size_t offset = static_cast<size_t>( static_cast<uint8_t*>(address) - static_cast<uint8_t*>(_data) );
+
+                if ( _isChunkAllocated( offset ) ) {
+                    _releaseChunk( offset );
                     return;
                 }
             }
@@ -102,10 +100,6 @@ namespace multiCuda
         void * _data; // a pointer to memory allocated chunk
         const size_t _availableSize; // maximum available memory size
 
-        // a map which holds an information about allocated memory in preallocated memory chunk
-        // first parameter is an offset from preallocated memory, second parameter is a power of 2 (level)
-        std::map <size_t, uint8_t> _allocatedChunk;
-
         // true memory allocation on devices with CUDA support
         virtual void _allocate( size_t size )
         {
@@ -113,7 +107,7 @@ namespace multiCuda
                 throw std::logic_error( "Memory size to be allocated is bigger than available size on device" );
 
             if ( _size != size && size > 0 ) {
-                if ( !_allocatedChunk.empty() )
+                if ( _hasAllocatedChunks() )
                     throw std::logic_error( "Cannot free a memory on device with CUDA support. Not all objects were previously deallocated from allocator." );
 
                 _free();
@@ -135,8 +129,6 @@ namespace multiCuda
                     throw std::logic_error( "Cannot deallocate memory for CUDA device" );
                 _data = nullptr;
             }
-
-            _allocatedChunk.clear();
         }
 
         MemoryAllocator( const MemoryAllocator & )
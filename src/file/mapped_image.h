@@ -0,0 +1,202 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include "../image_buffer.h"
+#include <map>
+#include <mutex>
+#include <string>
+
+#if !defined( _WIN32 )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace penguinV
+{
+    enum MappingMode
+    {
+        read_only_mapping, // pixel data is shared with the file, the image must not be modified
+        copy_on_write_mapping // modified pages become private copies of the process, the file is never changed
+    };
+
+    // Image which pixel data is a memory mapped file. Mapping takes constant time: the system loads pages on first access and could evict them
+    // at any moment so an image could be bigger than RAM and repeated jobs on the same file are served from page cache.
+    // Images created without a file, including copies of mapped images, use anonymous memory mapping. Mapping is supported only on POSIX systems
+    template <typename TColorDepth>
+    class ImageTemplateMapped : public ImageTemplate<TColorDepth>
+    {
+    public:
+        explicit ImageTemplateMapped( uint32_t width_ = 0u, uint32_t height_ = 0u, uint8_t colorCount_ = 1u, uint8_t alignment_ = 1u )
+        {
+            ImageTemplate<TColorDepth>::_setType( 4, _allocateMemory, _deallocateMemory );
+            ImageTemplate<TColorDepth>::setColorCount( colorCount_ );
+            ImageTemplate<TColorDepth>::setAlignment( alignment_ );
+            ImageTemplate<TColorDepth>::resize( width_, height_ );
+        }
+
+        ImageTemplateMapped( const std::string & path, uint32_t width_, uint32_t height_, uint8_t colorCount_ = 1u, uint8_t alignment_ = 1u,
+                             MappingMode mode = copy_on_write_mapping, size_t offset = 0u )
+        {
+            ImageTemplate<TColorDepth>::_setType( 4, _allocateMemory, _deallocateMemory );
+            map( path, width_, height_, colorCount_, alignment_, mode, offset );
+        }
+
+        ImageTemplateMapped( const ImageTemplateMapped & image )
+            : ImageTemplate<TColorDepth>()
+        {
+            ImageTemplate<TColorDepth>::_setType( 4, _allocateMemory, _deallocateMemory );
+            ImageTemplate<TColorDepth>::operator=( image );
+        }
+
+        ImageTemplateMapped( ImageTemplateMapped && image )
+        {
+            ImageTemplate<TColorDepth>::_setType( 4, _allocateMemory, _deallocateMemory );
+            ImageTemplate<TColorDepth>::swap( image );
+        }
+
+        ImageTemplateMapped & operator=( const ImageTemplateMapped & image )
+        {
+            ImageTemplate<TColorDepth>::operator=( image );
+
+            return ( *this );
+        }
+
+        ImageTemplateMapped & operator=( ImageTemplateMapped && image )
+        {
+            ImageTemplate<TColorDepth>::swap( image );
+
+            return ( *this );
+        }
+
+        // Maps pixel data of a file starting from an offset in bytes, for example after a header of a container file.
+        // Rows must be stored one after another from top to bottom, row size includes alignment
+        void map( const std::string & path, uint32_t width_, uint32_t height_, uint8_t colorCount_ = 1u, uint8_t alignment_ = 1u,
+                  MappingMode mode = copy_on_write_mapping, size_t offset = 0u )
+        {
+            if ( path.empty() || width_ == 0 || height_ == 0 || colorCount_ == 0 || alignment_ == 0 || offset % sizeof( TColorDepth ) != 0 )
+                throw penguinVException( "Incorrect parameters for memory mapped image" );
+
+            size_t rowSize = static_cast<size_t>( width_ ) * colorCount_;
+            if ( rowSize % alignment_ != 0 )
+                rowSize = ( rowSize / alignment_ + 1 ) * alignment_;
+
+            const size_t size = sizeof( TColorDepth ) * rowSize * height_;
+
+#if !defined( _WIN32 )
+            const int file = open( path.c_str(), O_RDONLY );
+            if ( file < 0 )
+                throw penguinVException( "Cannot open file for memory mapping" );
+
+            struct stat info;
+            if ( fstat( file, &info ) != 0 || static_cast<size_t>( info.st_size ) < offset + size ) {
+                close( file );
+                throw penguinVException( "File is too small for memory mapped image" );
+            }
+
+            // mapping must start at page boundary
+            const size_t pageOffset = offset % static_cast<size_t>( sysconf( _SC_PAGESIZE ) );
+            const int protection = ( mode == read_only_mapping ) ? PROT_READ : ( PROT_READ | PROT_WRITE );
+            const int flags = ( mode == read_only_mapping ) ? MAP_SHARED : MAP_PRIVATE;
+
+            void * block = mmap( nullptr, size + pageOffset, protection, flags, file, static_cast<off_t>( offset - pageOffset ) );
+            close( file ); // the mapping keeps its own reference to the file
+
+            if ( block == MAP_FAILED )
+                throw penguinVException( "Cannot map file into memory" );
+
+            TColorDepth * data = reinterpret_cast<TColorDepth *>( reinterpret_cast<uint8_t *>( block ) + pageOffset );
+            _registerMapping( data, block, size + pageOffset );
+
+            ImageTemplate<TColorDepth>::assign( data, width_, height_, colorCount_, alignment_ );
+#else
+            (void)mode;
+            throw penguinVException( "Memory mapped images are not supported on this system" );
+#endif
+        }
+
+    private:
+        struct Mapping
+        {
+            void * address;
+            size_t size;
+        };
+
+        static std::map<const TColorDepth *, Mapping> & _mapping()
+        {
+            static std::map<const TColorDepth *, Mapping> mapping;
+            return mapping;
+        }
+
+        static std::mutex & _mappingLock()
+        {
+            static std::mutex lock;
+            return lock;
+        }
+
+        static void _registerMapping( const TColorDepth * data, void * address, size_t size )
+        {
+            Mapping mapping;
+            mapping.address = address;
+            mapping.size = size;
+
+            std::lock_guard<std::mutex> lock( _mappingLock() );
+            _mapping()[data] = mapping;
+        }
+
+        static TColorDepth * _allocateMemory( size_t size )
+        {
+#if !defined( _WIN32 )
+            // no swap is reserved so untouched pages of huge sparse images don't count against memory limits
+            void * data = mmap( nullptr, sizeof( TColorDepth ) * size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+            if ( data == MAP_FAILED )
+                throw penguinVException( "Cannot allocate memory mapped image" );
+
+            _registerMapping( reinterpret_cast<TColorDepth *>( data ), data, sizeof( TColorDepth ) * size );
+
+            return reinterpret_cast<TColorDepth *>( data );
+#else
+            (void)size;
+            throw penguinVException( "Memory mapped images are not supported on this system" );
+#endif
+        }
+
+        static void _deallocateMemory( TColorDepth * data )
+        {
+#if !defined( _WIN32 )
+            std::lock_guard<std::mutex> lock( _mappingLock() );
+
+            typename std::map<const TColorDepth *, Mapping>::iterator mapping = _mapping().find( data );
+            if ( mapping != _mapping().end() ) {
+                munmap( mapping->second.address, mapping->second.size );
+                _mapping().erase( mapping );
+            }
+#else
+            (void)data;
+#endif
+        }
+    };
+
+    typedef penguinV::ImageTemplateMapped<uint8_t> ImageMapped;
+    typedef penguinV::ImageTemplateMapped<uint16_t> ImageMapped16Bit;
+}
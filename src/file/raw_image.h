@@ -21,6 +21,7 @@
 #pragma once
 #include "../image_buffer.h"
 #include "../parameter_validation.h"
+#include "mapped_image.h"
 #include <fstream>
 
 namespace Raw_Operation
@@ -67,6 +68,32 @@ namespace Raw_Operation
         return image;
     }
 
+    // Maps a file as pixel data of an image without reading it. Returns an empty image if the file cannot be opened or has a different size
+    template <typename _Type>
+    penguinV::ImageTemplateMapped<_Type> Map( const std::string & path, uint32_t width, uint32_t height, uint8_t colorCount,
+                                               penguinV::MappingMode mode = penguinV::copy_on_write_mapping )
+    {
+        if ( path.empty() || width == 0 || height == 0 || colorCount == 0 )
+            throw penguinVException( "Incorrect parameters for raw image mapping" );
+
+        std::fstream file;
+        file.open( path, std::fstream::in | std::fstream::binary );
+
+        if ( !file )
+            return penguinV::ImageTemplateMapped<_Type>();
+
+        file.seekg( 0, file.end );
+        const std::streamoff length = file.tellg();
+        file.close();
+
+        const std::streamoff overallImageSize = static_cast<std::streamoff>( width ) * height * colorCount * static_cast<std::streamoff>( sizeof( _Type ) );
+
+        if ( length != overallImageSize )
+            return penguinV::ImageTemplateMapped<_Type>();
+
+        return penguinV::ImageTemplateMapped<_Type>( path, width, height, colorCount, 1u, mode );
+    }
+
     template <typename _Type>
     void Save( const std::string & path, const penguinV::ImageTemplate<_Type> & image )
     {
@@ -19,10 +19,76 @@
  ***************************************************************************/
 
 #include "function_pool.h"
+#include "filtering.h"
 #include "function_pool_task.h"
+#include "image_function.h"
 #include "image_function_helper.h"
 #include "parameter_validation.h"
 #include "penguinv/penguinv.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace
+{
+    // Number of pixels which a task of the cheapest function must process to cover costs of running it in thread pool
+    const uint32_t minimumTaskArea = 65536u;
+
+    const char * const roiError = "An error occured during processing of ROIs";
+
+    // A part of image rows processed by one task of functions taking a list of ROIs
+    struct RoiBand
+    {
+        std::vector<penguinV::Roi> roi; // ROIs clipped by the band
+        std::vector<size_t> id; // IDs of original ROIs
+    };
+
+    // Rows crossed by ROIs are split into bands with similar number of ROI pixels, every band is big enough to cover costs of a task.
+    // ROIs must be validated by a caller
+    std::vector<RoiBand> SplitRoiIntoBands( const penguinV::Image & image, const std::vector<penguinV::Roi> & roi )
+    {
+        std::vector<int64_t> rowAreaChange( image.height() + 1u, 0 ); // change of number of ROI pixels in a row compared to previous row
+        uint64_t totalArea = 0u;
+
+        for ( std::vector<penguinV::Roi>::const_iterator area = roi.cbegin(); area != roi.cend(); ++area ) {
+            rowAreaChange[area->y] += area->width;
+            rowAreaChange[area->y + area->height] -= area->width;
+            totalArea += static_cast<uint64_t>( area->width ) * area->height;
+        }
+
+        const uint64_t bandCount = std::max<uint64_t>( std::min<uint64_t>( ThreadPoolMonoid::instance().threadCount(), totalArea / minimumTaskArea ), 1u );
+
+        std::vector<uint32_t> border( 1u, 0u ); // first row of every band
+        int64_t rowArea = 0;
+        uint64_t area = 0u;
+
+        for ( uint32_t y = 0; y < image.height() && border.size() < bandCount; ++y ) {
+            rowArea += rowAreaChange[y];
+            area += static_cast<uint64_t>( rowArea );
+
+            if ( area * bandCount >= totalArea * border.size() )
+                border.push_back( y + 1u );
+        }
+
+        border.push_back( image.height() );
+
+        std::vector<RoiBand> band( border.size() - 1u );
+
+        for ( size_t bandId = 0; bandId < band.size(); ++bandId ) {
+            for ( size_t id = 0; id < roi.size(); ++id ) {
+                const uint32_t startY = std::max( roi[id].y, border[bandId] );
+                const uint32_t endY = std::min( roi[id].y + roi[id].height, border[bandId + 1u] );
+
+                if ( startY < endY ) {
+                    band[bandId].roi.push_back( penguinV::Roi( roi[id].x, startY, roi[id].width, endY - startY ) );
+                    band[bandId].id.push_back( id );
+                }
+            }
+        }
+
+        return band;
+    }
+}
 
 namespace Function_Pool
 {
@@ -38,6 +104,15 @@ namespace Function_Pool
             , extractChannelId( 255 )
             , horizontalFlip( false )
             , verticalFlip( false )
+            , kernelSize( 0 )
+            , dilationX( 0 )
+            , dilationY( 0 )
+            , shiftX( 0 )
+            , shiftY( 0 )
+            , areaX( 0 )
+            , areaY( 0 )
+            , areaWidth( 0 )
+            , areaHeight( 0 )
         {}
 
         uint8_t minThreshold; // for Threshold() function same as threshold
@@ -49,6 +124,15 @@ namespace Function_Pool
         std::vector<uint8_t> lookupTable; // for LookupTable() function
         bool horizontalFlip;
         bool verticalFlip;
+        uint32_t kernelSize; // for Median() function
+        uint32_t dilationX; // for BinaryDilate() and BinaryErode() functions
+        uint32_t dilationY; // for BinaryDilate() and BinaryErode() functions
+        double shiftX; // for Shift() function
+        double shiftY; // for Shift() function
+        uint32_t areaX; // for Median() function, the whole input area
+        uint32_t areaY;
+        uint32_t areaWidth;
+        uint32_t areaHeight;
     };
     // This structure holds output data for some specific functions
     struct OutputInfo
@@ -71,32 +155,27 @@ namespace Function_Pool
             _getArray( histogram, histogram_ );
         }
 
-        void getProjection( std::vector<uint32_t> & projection_ )
+        // offset is a position of every task's projection in the whole projection, projections of tasks at the same position are summed
+        void getProjection( std::vector<uint32_t> & projection_, const std::vector<uint32_t> & offset )
         {
             if ( projection.empty() )
                 throw penguinVException( "Projection array is empty" );
 
-            if ( projection_.size() == projection.front().size() ) {
-                _getArray( projection, projection_ );
-            }
-            else {
-                size_t totalSize = 0u;
-                for ( size_t i = 0; i < projection.size(); ++i )
-                    totalSize += projection[i].size();
+            std::fill( projection_.begin(), projection_.end(), 0u );
 
-                if ( projection_.size() != totalSize )
+            for ( size_t i = 0; i < projection.size(); ++i ) {
+                if ( offset[i] + projection[i].size() > projection_.size() )
                     throw penguinVException( "Projection array is invalid" );
 
-                uint32_t * out = projection_.data();
-                for ( size_t i = 0; i < projection.size(); ++i ) {
-                    std::vector<uint32_t>::const_iterator in = projection[i].begin();
-                    std::vector<uint32_t>::const_iterator end = projection[i].end();
+                uint32_t * out = projection_.data() + offset[i];
+                std::vector<uint32_t>::const_iterator in = projection[i].begin();
+                std::vector<uint32_t>::const_iterator end = projection[i].end();
 
-                    for ( ; in != end; ++in, ++out )
-                        *out = *in;
-                }
-                projection.clear(); // to guarantee that no one can use it second time
+                for ( ; in != end; ++in, ++out )
+                    *out += *in;
             }
+
+            projection.clear(); // to guarantee that no one can use it second time
         }
 
         uint32_t getSum()
@@ -170,13 +249,28 @@ namespace Function_Pool
         void AbsoluteDifference( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out,
                                  uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
         {
+            _setTaskCost( _AbsoluteDifference );
             _setup( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
             _process( _AbsoluteDifference );
         }
 
+        // dilation is done along one axis per call: rows are independent along X axis and columns are independent along Y axis
+        void BinaryDilate( Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t dilationX, uint32_t dilationY )
+        {
+            _setupDilation( _BinaryDilate, image, x, y, width, height, dilationX, dilationY );
+            _process( _BinaryDilate );
+        }
+
+        void BinaryErode( Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t erosionX, uint32_t erosionY )
+        {
+            _setupDilation( _BinaryErode, image, x, y, width, height, erosionX, erosionY );
+            _process( _BinaryErode );
+        }
+
         void BitwiseAnd( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                          uint32_t startYOut, uint32_t width, uint32_t height )
         {
+            _setTaskCost( _BitwiseAnd );
             _setup( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
             _process( _BitwiseAnd );
         }
@@ -184,6 +278,7 @@ namespace Function_Pool
         void BitwiseOr( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                         uint32_t startYOut, uint32_t width, uint32_t height )
         {
+            _setTaskCost( _BitwiseOr );
             _setup( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
             _process( _BitwiseOr );
         }
@@ -191,6 +286,7 @@ namespace Function_Pool
         void BitwiseXor( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                          uint32_t startYOut, uint32_t width, uint32_t height )
         {
+            _setTaskCost( _BitwiseXor );
             _setup( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
             _process( _BitwiseXor );
         }
@@ -198,12 +294,14 @@ namespace Function_Pool
         void ConvertToGrayScale( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width,
                                  uint32_t height )
         {
+            _setTaskCost( _ConvertToGrayScale );
             _setup( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
             _process( _ConvertToGrayScale );
         }
 
         void ConvertToRgb( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
         {
+            _setTaskCost( _ConvertToRgb );
             _setup( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
             _process( _ConvertToRgb );
         }
@@ -211,6 +309,7 @@ namespace Function_Pool
         void ExtractChannel( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                              uint8_t channelId )
         {
+            _setTaskCost( _ExtractChannel );
             _setup( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
 
             _dataIn.extractChannelId = channelId;
@@ -221,24 +320,18 @@ namespace Function_Pool
         void Flip( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                    bool horizontal, bool vertical )
         {
+            _setTaskCost( _Flip );
             _setup( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
 
             _dataIn.horizontalFlip = horizontal;
             _dataIn.verticalFlip = vertical;
 
-            if ( _infoOut1->_size() > 1 ) {
-                if ( _infoOut1->startY[0] == _infoOut1->startY[1] ) {
-                    if ( horizontal ) {
-                        for ( size_t i = 0u; i < _infoOut1->_size(); ++i )
-                            _infoOut1->startX[i] = 2 * startXOut + width - ( _infoOut1->startX[i] + _infoOut1->width[i] );
-                    }
-                }
-                else {
-                    if ( vertical ) {
-                        for ( size_t i = 0u; i < _infoOut1->_size(); ++i )
-                            _infoOut1->startY[i] = 2 * startYOut + height - ( _infoOut1->startY[i] + _infoOut1->height[i] );
-                    }
-                }
+            // every task writes its flipped area into mirrored position of output image
+            for ( size_t i = 0u; i < _infoOut1->_size(); ++i ) {
+                if ( horizontal )
+                    _infoOut1->startX[i] = 2 * startXOut + width - ( _infoOut1->startX[i] + _infoOut1->width[i] );
+                if ( vertical )
+                    _infoOut1->startY[i] = 2 * startYOut + height - ( _infoOut1->startY[i] + _infoOut1->height[i] );
             }
 
             _process( _Flip );
@@ -247,6 +340,7 @@ namespace Function_Pool
         void GammaCorrection( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width,
                               uint32_t height, double a, double gamma )
         {
+            _setTaskCost( _GammaCorrection );
             _setup( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
 
             if ( a < 0 || gamma < 0 )
@@ -260,6 +354,7 @@ namespace Function_Pool
 
         void Histogram( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint32_t> & histogram )
         {
+            _setTaskCost( _Histogram );
             _setup( image, x, y, width, height );
             _dataOut.resize( _infoIn1->_size() );
             _process( _Histogram );
@@ -268,12 +363,14 @@ namespace Function_Pool
 
         void Invert( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
         {
+            _setTaskCost( _Invert );
             _setup( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
             _process( _Invert );
         }
 
         bool IsEqual( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height )
         {
+            _setTaskCost( _IsEqual );
             _setup( in1, startX1, startY1, in2, startX2, startY2, width, height );
             _dataOut.resize( _infoIn1->_size() );
             _process( _IsEqual );
@@ -283,6 +380,7 @@ namespace Function_Pool
         void LookupTable( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                           const std::vector<uint8_t> & table )
         {
+            _setTaskCost( _LookupTable );
             _setup( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
 
             _dataIn.lookupTable = table;
@@ -290,9 +388,31 @@ namespace Function_Pool
             _process( _LookupTable );
         }
 
+        void Median( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
+                     uint32_t kernelSize )
+        {
+            _setTaskCost( _Median );
+            // every task has at least a kernel size of pixels along both axes
+            _minimumTaskWidth = kernelSize;
+            _minimumTaskHeight = kernelSize;
+            _setup( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
+            Image_Function::VerifyGrayScaleImage( in, out );
+
+            if ( kernelSize < 3 || kernelSize % 2 == 0 || kernelSize >= width || kernelSize >= height )
+                throw penguinVException( "Kernel size for filter is not correct" );
+
+            _dataIn.kernelSize = kernelSize;
+            _dataIn.areaX = startXIn;
+            _dataIn.areaY = startYIn;
+            _dataIn.areaWidth = width;
+            _dataIn.areaHeight = height;
+            _process( _Median );
+        }
+
         void Merge( const Image & in1, uint32_t startXIn1, uint32_t startYIn1, const Image & in2, uint32_t startXIn2, uint32_t startYIn2, const Image & in3,
                     uint32_t startXIn3, uint32_t startYIn3, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
         {
+            _setTaskCost( _Merge );
             _setup( in1, startXIn1, startYIn1, in2, startXIn2, startYIn2, in3, startXIn3, startYIn3, out, startXOut, startYOut, width, height );
 
             _process( _Merge );
@@ -301,6 +421,7 @@ namespace Function_Pool
         void Maximum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                       uint32_t startYOut, uint32_t width, uint32_t height )
         {
+            _setTaskCost( _Maximum );
             _setup( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
             _process( _Maximum );
         }
@@ -308,37 +429,85 @@ namespace Function_Pool
         void Minimum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                       uint32_t startYOut, uint32_t width, uint32_t height )
         {
+            _setTaskCost( _Minimum );
             _setup( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
             _process( _Minimum );
         }
 
+        void Prewitt( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
+        {
+            _setupGradient( _Prewitt, in, startXIn, startYIn, out, startXOut, startYOut, width, height );
+            _process( _Prewitt );
+        }
+
         void ProjectionProfile( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal, std::vector<uint32_t> & projection )
         {
+            _setTaskCost( _ProjectionProfile );
             _setup( image, x, y, width, height );
             _dataOut.resize( _infoIn1->_size() );
             _dataIn.horizontalProjection = horizontal;
             _process( _ProjectionProfile );
 
+            std::vector<uint32_t> offset( _infoIn1->_size() );
+            for ( size_t i = 0u; i < offset.size(); ++i )
+                offset[i] = horizontal ? _infoIn1->startX[i] - x : _infoIn1->startY[i] - y;
+
             projection.resize( horizontal ? width : height );
-            _dataOut.getProjection( projection );
+            _dataOut.getProjection( projection, offset );
         }
 
         void Resize( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t widthIn, uint32_t heightIn, Image & out, uint32_t startXOut, uint32_t startYOut,
                      uint32_t widthOut, uint32_t heightOut )
         {
+            _setTaskCost( _Resize );
             _setup( in, startXIn, startYIn, widthIn, heightIn, out, startXOut, startYOut, widthOut, heightOut );
             _process( _Resize );
         }
 
         void RgbToBgr( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
         {
+            _setTaskCost( _RgbToBgr );
             _setup( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
             _process( _RgbToBgr );
         }
 
+        void Shift( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
+                    double shiftX, double shiftY )
+        {
+            if ( ( fabs( shiftX ) > width - 1 ) || ( fabs( shiftY ) > height - 1 ) )
+                throw penguinVException( "Shift value by value bigger than ROI" );
+
+            _setTaskCost( _Shift );
+            // a task must be bigger than the shift otherwise it reads pixels which are not within the image
+            _minimumTaskWidth = static_cast<uint32_t>( fabs( shiftX ) ) + 2u;
+            _minimumTaskHeight = static_cast<uint32_t>( fabs( shiftY ) ) + 2u;
+
+            // Image_Function::Shift moves whole rows of ROI when the left part of ROI is out of the image so such rows cannot be split
+            int32_t shiftXIntegral = -static_cast<int32_t>( shiftX );
+            if ( shiftX + shiftXIntegral > 0.0 )
+                --shiftXIntegral;
+
+            if ( shiftXIntegral < 0 && startXIn < static_cast<uint32_t>( -shiftXIntegral ) )
+                _minimumTaskWidth = width;
+
+            _setup( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
+            Image_Function::VerifyGrayScaleImage( in, out );
+
+            _dataIn.shiftX = shiftX;
+            _dataIn.shiftY = shiftY;
+            _process( _Shift );
+        }
+
+        void Sobel( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
+        {
+            _setupGradient( _Sobel, in, startXIn, startYIn, out, startXOut, startYOut, width, height );
+            _process( _Sobel );
+        }
+
         void Subtract( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                        uint32_t startYOut, uint32_t width, uint32_t height )
         {
+            _setTaskCost( _Subtract );
             _setup( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
             _process( _Subtract );
         }
@@ -346,12 +515,14 @@ namespace Function_Pool
         void Split( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out1, uint32_t startXOut1, uint32_t startYOut1, Image & out2, uint32_t startXOut2,
                     uint32_t startYOut2, Image & out3, uint32_t startXOut3, uint32_t startYOut3, uint32_t width, uint32_t height )
         {
+            _setTaskCost( _Split );
             _setup( in, startXIn, startYIn, out1, startXOut1, startYOut1, out2, startXOut2, startYOut2, out3, startXOut3, startYOut3, width, height );
             _process( _Split );
         }
 
         uint32_t Sum( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height )
         {
+            _setTaskCost( _Sum );
             _setup( image, x, y, width, height );
             _dataOut.resize( _infoIn1->_size() );
             _process( _Sum );
@@ -361,6 +532,7 @@ namespace Function_Pool
         void Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                         uint8_t threshold )
         {
+            _setTaskCost( _Threshold );
             _setup( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
             _dataIn.minThreshold = threshold;
             _process( _Threshold );
@@ -369,6 +541,7 @@ namespace Function_Pool
         void Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                         uint8_t minThreshold, uint8_t maxThreshold )
         {
+            _setTaskCost( _ThresholdDouble );
             _setup( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
 
             if ( minThreshold > maxThreshold )
@@ -381,6 +554,7 @@ namespace Function_Pool
 
         void Transpose( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
         {
+            _setTaskCost( _Transpose );
             _setup( in, startXIn, startYIn, width, height, out, startXOut, startYOut, height, width, true );
             _process( _Transpose );
         }
@@ -390,6 +564,8 @@ namespace Function_Pool
         {
             _none,
             _AbsoluteDifference,
+            _BinaryDilate,
+            _BinaryErode,
             _BitwiseAnd,
             _BitwiseOr,
             _BitwiseXor,
@@ -403,11 +579,15 @@ namespace Function_Pool
             _IsEqual,
             _LookupTable,
             _Maximum,
+            _Median,
             _Merge,
             _Minimum,
+            _Prewitt,
             _ProjectionProfile,
             _Resize,
             _RgbToBgr,
+            _Shift,
+            _Sobel,
             _Subtract,
             _Split,
             _Sum,
@@ -422,112 +602,135 @@ namespace Function_Pool
             case _none:
                 throw penguinVException( "Image function task is not setup" );
             case _AbsoluteDifference:
-                penguinV::AbsoluteDifference( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId],
+                _function.AbsoluteDifference( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId],
                                               _infoIn2->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId], _infoOut1->startY[taskId], _infoIn1->width[taskId],
                                               _infoIn1->height[taskId] );
                 break;
+            case _BinaryDilate:
+                Image_Function::BinaryDilate( _infoOut1->image, _infoOut1->startX[taskId], _infoOut1->startY[taskId], _infoOut1->width[taskId],
+                                              _infoOut1->height[taskId], _dataIn.dilationX, _dataIn.dilationY );
+                break;
+            case _BinaryErode:
+                Image_Function::BinaryErode( _infoOut1->image, _infoOut1->startX[taskId], _infoOut1->startY[taskId], _infoOut1->width[taskId],
+                                             _infoOut1->height[taskId], _dataIn.dilationX, _dataIn.dilationY );
+                break;
             case _BitwiseAnd:
-                penguinV::BitwiseAnd( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId],
+                _function.BitwiseAnd( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId],
                                       _infoIn2->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId], _infoOut1->startY[taskId], _infoIn1->width[taskId],
                                       _infoIn1->height[taskId] );
                 break;
             case _BitwiseOr:
-                penguinV::BitwiseOr( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId],
+                _function.BitwiseOr( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId],
                                      _infoIn2->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId], _infoOut1->startY[taskId], _infoIn1->width[taskId],
                                      _infoIn1->height[taskId] );
                 break;
             case _BitwiseXor:
-                penguinV::BitwiseXor( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId],
+                _function.BitwiseXor( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId],
                                       _infoIn2->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId], _infoOut1->startY[taskId], _infoIn1->width[taskId],
                                       _infoIn1->height[taskId] );
                 break;
             case _ConvertToGrayScale:
-                penguinV::ConvertToGrayScale( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
+                _function.ConvertToGrayScale( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
                                               _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId] );
                 break;
             case _ConvertToRgb:
-                penguinV::ConvertToRgb( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
+                _function.ConvertToRgb( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
                                         _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId] );
                 break;
             case _ExtractChannel:
-                penguinV::ExtractChannel( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
+                _function.ExtractChannel( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
                                           _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId], _dataIn.extractChannelId );
                 break;
             case _Flip:
-                penguinV::Flip( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
+                _function.Flip( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
                                 _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId], _dataIn.horizontalFlip, _dataIn.verticalFlip );
                 break;
             case _GammaCorrection:
-                penguinV::GammaCorrection( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
+                _function.GammaCorrection( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
                                            _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId], _dataIn.coefficientA, _dataIn.coefficientGamma );
                 break;
             case _Histogram:
-                penguinV::Histogram( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId],
+                _function.Histogram( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId],
                                      _dataOut.histogram[taskId] );
                 break;
             case _Invert:
-                penguinV::Invert( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
+                _function.Invert( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
                                   _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId] );
                 break;
             case _IsEqual:
-                _dataOut.equality[taskId] = penguinV::IsEqual( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image,
+                _dataOut.equality[taskId] = _function.IsEqual( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image,
                                                                _infoIn2->startX[taskId], _infoIn2->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId] );
                 break;
             case _LookupTable:
-                penguinV::LookupTable( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
+                _function.LookupTable( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
                                        _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId], _dataIn.lookupTable );
                 break;
             case _Maximum:
-                penguinV::Maximum( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId],
+                _function.Maximum( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId],
                                    _infoIn2->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId], _infoOut1->startY[taskId], _infoIn1->width[taskId],
                                    _infoIn1->height[taskId] );
                 break;
+            case _Median:
+                _median( taskId );
+                break;
             case _Merge:
-                penguinV::Merge( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId], _infoIn2->startY[taskId],
+                _function.Merge( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId], _infoIn2->startY[taskId],
                                  _infoIn3->image, _infoIn3->startX[taskId], _infoIn3->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
                                  _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId] );
                 break;
             case _Minimum:
-                penguinV::Minimum( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId],
+                _function.Minimum( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId],
                                    _infoIn2->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId], _infoOut1->startY[taskId], _infoIn1->width[taskId],
                                    _infoIn1->height[taskId] );
                 break;
+            case _Prewitt:
+                Image_Function::Prewitt( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
+                                         _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId] );
+                break;
             case _ProjectionProfile:
-                penguinV::ProjectionProfile( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId],
+                _function.ProjectionProfile( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId],
                                              _dataIn.horizontalProjection, _dataOut.projection[taskId] );
                 break;
             case _Resize:
-                penguinV::Resize( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId],
+                _function.Resize( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId],
                                   _infoOut1->image, _infoOut1->startX[taskId], _infoOut1->startY[taskId], _infoOut1->width[taskId], _infoOut1->height[taskId] );
                 break;
             case _RgbToBgr:
-                penguinV::RgbToBgr( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
+                _function.RgbToBgr( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
                                     _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId] );
                 break;
+            case _Shift:
+                Image_Function::Shift( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
+                                       _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId], _dataIn.shiftX, _dataIn.shiftY );
+                break;
+            case _Sobel:
+                Image_Function::Sobel( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
+                                       _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId] );
+                break;
             case _Subtract:
-                penguinV::Subtract( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId],
+                _function.Subtract( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn2->image, _infoIn2->startX[taskId],
                                     _infoIn2->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId], _infoOut1->startY[taskId], _infoIn1->width[taskId],
                                     _infoIn1->height[taskId] );
                 break;
             case _Split:
-                penguinV::Split( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
+                _function.Split( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
                                  _infoOut1->startY[taskId], _infoOut2->image, _infoOut2->startX[taskId], _infoOut2->startY[taskId], _infoOut3->image,
                                  _infoOut3->startX[taskId], _infoOut3->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId] );
                 break;
             case _Sum:
                 _dataOut.sum[taskId]
-                    = penguinV::Sum( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId] );
+                    = _function.Sum( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId] );
                 break;
             case _Threshold:
-                penguinV::Threshold( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
+                _function.Threshold( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
                                      _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId], _dataIn.minThreshold );
                 break;
             case _ThresholdDouble:
-                penguinV::Threshold( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
-                                     _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId], _dataIn.minThreshold, _dataIn.maxThreshold );
+                _function.Threshold2( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
+                                      _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId], _dataIn.minThreshold, _dataIn.maxThreshold );
                 break;
             case _Transpose:
-                penguinV::Transpose( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
+                _function.Transpose( _infoIn1->image, _infoIn1->startX[taskId], _infoIn1->startY[taskId], _infoOut1->image, _infoOut1->startX[taskId],
                                      _infoOut1->startY[taskId], _infoIn1->width[taskId], _infoIn1->height[taskId] );
                 break;
             default:
@@ -537,16 +740,156 @@ namespace Function_Pool
 
     private:
         TaskName functionId;
+        Image_Function_Helper::FunctionTableHolder _function; // functions called by tasks, resolved once per call
 
         InputInfo _dataIn; // structure which holds some unique input parameters
         OutputInfo _dataOut; // structure which holds some unique output values
 
+        // a task of more expensive function could process fewer pixels
+        void _setTaskCost( TaskName id )
+        {
+            uint32_t cost = 1u; // relative processing time of a pixel
+
+            switch ( id ) {
+            case _ConvertToGrayScale:
+            case _ConvertToRgb:
+            case _ExtractChannel:
+            case _Flip:
+            case _Histogram:
+            case _LookupTable:
+            case _Merge:
+            case _ProjectionProfile:
+            case _RgbToBgr:
+            case _Split:
+            case _Transpose:
+                cost = 2u;
+                break;
+            case _BinaryDilate:
+            case _BinaryErode:
+            case _Resize:
+                cost = 4u;
+                break;
+            case _Prewitt:
+            case _Shift:
+            case _Sobel:
+                cost = 16u;
+                break;
+            case _Median:
+                cost = 256u;
+                break;
+            default:
+                break;
+            }
+
+            _minimumTaskArea = minimumTaskArea / cost;
+        }
+
+        void _setupDilation( TaskName id, Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t dilationX, uint32_t dilationY )
+        {
+            if ( dilationX > 0u && dilationY > 0u )
+                throw penguinVException( "Dilation must be done along one axis at a time" );
+
+            _setTaskCost( id );
+            // a task contains whole rows for dilation along X axis or whole columns for dilation along Y axis
+            if ( dilationX > 0u )
+                _minimumTaskWidth = width;
+            else
+                _minimumTaskHeight = height;
+            _setup( image, x, y, width, height );
+            Image_Function::VerifyGrayScaleImage( image );
+
+            _dataIn.dilationX = dilationX;
+            _dataIn.dilationY = dilationY;
+        }
+
+        // gradient filters read 1 pixel around their area so tasks do not need any special handling of task borders
+        void _setupGradient( TaskName id, const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width,
+                             uint32_t height )
+        {
+            _setTaskCost( id );
+            // a task smaller than 3 pixels does not fit filter kernel
+            _minimumTaskWidth = 3u;
+            _minimumTaskHeight = 3u;
+            _setup( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
+            Image_Function::VerifyGrayScaleImage( in, out );
+
+            if ( width < 3 || height < 3 )
+                throw penguinVException( "Input image is very small for Sobel filter to be applied" );
+        }
+
+        // A task filters its area extended by a half of kernel (a halo) but not beyond the whole input area into a temporary image
+        // and copies only own area into output image. Pixels near borders of the whole area are copied from input like in single thread
+        void _median( size_t taskId )
+        {
+            const uint32_t halo = _dataIn.kernelSize / 2;
+
+            const uint32_t startX = _infoIn1->startX[taskId];
+            const uint32_t startY = _infoIn1->startY[taskId];
+            const uint32_t width = _infoIn1->width[taskId];
+            const uint32_t height = _infoIn1->height[taskId];
+
+            const uint32_t haloStartX = std::max( startX, _dataIn.areaX + halo ) - halo;
+            const uint32_t haloStartY = std::max( startY, _dataIn.areaY + halo ) - halo;
+            const uint32_t haloEndX = std::min( startX + width + halo, _dataIn.areaX + _dataIn.areaWidth );
+            const uint32_t haloEndY = std::min( startY + height + halo, _dataIn.areaY + _dataIn.areaHeight );
+
+            Image filtered( haloEndX - haloStartX, haloEndY - haloStartY );
+
+            Image_Function::Median( _infoIn1->image, haloStartX, haloStartY, filtered, 0, 0, filtered.width(), filtered.height(), _dataIn.kernelSize );
+            Image_Function::Copy( filtered, startX - haloStartX, startY - haloStartY, _infoOut1->image, _infoOut1->startX[taskId], _infoOut1->startY[taskId], width,
+                                  height );
+        }
+
         void _process( TaskName id )
         {
             functionId = id;
 
+            _setFunctionTable();
             _processTask();
         }
+
+        // Tasks call backend functions directly to avoid looking up and validating a function for every task.
+        // Functions which are not present in the backend or require intertype conversion are called through penguinV dispatching
+        void _setFunctionTable()
+        {
+            const uint8_t type = _infoIn1->image.type();
+
+            if ( _isImageType( _infoIn2.get(), type ) && _isImageType( _infoIn3.get(), type ) && _isImageType( _infoOut1.get(), type )
+                 && _isImageType( _infoOut2.get(), type ) && _isImageType( _infoOut3.get(), type ) )
+                _function = ImageTypeManager::instance().functionTable( type );
+
+            Image_Function_Helper::SetDefaultFunction( _function.AbsoluteDifference, penguinV::AbsoluteDifference );
+            Image_Function_Helper::SetDefaultFunction( _function.BitwiseAnd, penguinV::BitwiseAnd );
+            Image_Function_Helper::SetDefaultFunction( _function.BitwiseOr, penguinV::BitwiseOr );
+            Image_Function_Helper::SetDefaultFunction( _function.BitwiseXor, penguinV::BitwiseXor );
+            Image_Function_Helper::SetDefaultFunction( _function.ConvertToGrayScale, penguinV::ConvertToGrayScale );
+            Image_Function_Helper::SetDefaultFunction( _function.ConvertToRgb, penguinV::ConvertToRgb );
+            Image_Function_Helper::SetDefaultFunction( _function.ExtractChannel, penguinV::ExtractChannel );
+            Image_Function_Helper::SetDefaultFunction( _function.Flip, penguinV::Flip );
+            Image_Function_Helper::SetDefaultFunction( _function.GammaCorrection, penguinV::GammaCorrection );
+            Image_Function_Helper::SetDefaultFunction( _function.Histogram, penguinV::Histogram );
+            Image_Function_Helper::SetDefaultFunction( _function.Invert, penguinV::Invert );
+            Image_Function_Helper::SetDefaultFunction( _function.IsEqual, penguinV::IsEqual );
+            Image_Function_Helper::SetDefaultFunction( _function.LookupTable, penguinV::LookupTable );
+            Image_Function_Helper::SetDefaultFunction( _function.Maximum, penguinV::Maximum );
+            Image_Function_Helper::SetDefaultFunction( _function.Merge, penguinV::Merge );
+            Image_Function_Helper::SetDefaultFunction( _function.Minimum, penguinV::Minimum );
+            Image_Function_Helper::SetDefaultFunction( _function.ProjectionProfile, penguinV::ProjectionProfile );
+            Image_Function_Helper::SetDefaultFunction( _function.Resize, penguinV::Resize );
+            Image_Function_Helper::SetDefaultFunction( _function.RgbToBgr, penguinV::RgbToBgr );
+            Image_Function_Helper::SetDefaultFunction( _function.Split, penguinV::Split );
+            Image_Function_Helper::SetDefaultFunction( _function.Subtract, penguinV::Subtract );
+            Image_Function_Helper::SetDefaultFunction( _function.Sum, penguinV::Sum );
+            Image_Function_Helper::SetDefaultFunction( _function.Threshold, penguinV::Threshold );
+            Image_Function_Helper::SetDefaultFunction( _function.Threshold2, penguinV::Threshold );
+            Image_Function_Helper::SetDefaultFunction( _function.Transpose, penguinV::Transpose );
+        }
+
+        template <typename _Info>
+        static bool _isImageType( const _Info * info, uint8_t type )
+        {
+            return ( info == nullptr ) || ( info->image.type() == type );
+        }
     };
 
     // The list of global functions
@@ -572,6 +915,52 @@ namespace Function_Pool
         FunctionTask().AbsoluteDifference( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
     }
 
+    Image AbsoluteDifference( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::AbsoluteDifference( AbsoluteDifference, in1, in2 );
+    }
+
+    void AbsoluteDifference( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::AbsoluteDifference( AbsoluteDifference, in1, in2, out );
+    }
+
+    void BinaryDilate( Image & image, uint32_t dilationX, uint32_t dilationY )
+    {
+        Image_Function::ValidateImageParameters( image );
+
+        BinaryDilate( image, 0, 0, image.width(), image.height(), dilationX, dilationY );
+    }
+
+    void BinaryDilate( Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t dilationX, uint32_t dilationY )
+    {
+        Image_Function::ValidateImageParameters( image, x, y, width, height );
+        Image_Function::VerifyGrayScaleImage( image );
+
+        if ( dilationX > 0u )
+            FunctionTask().BinaryDilate( image, x, y, width, height, dilationX, 0u );
+        if ( dilationY > 0u )
+            FunctionTask().BinaryDilate( image, x, y, width, height, 0u, dilationY );
+    }
+
+    void BinaryErode( Image & image, uint32_t erosionX, uint32_t erosionY )
+    {
+        Image_Function::ValidateImageParameters( image );
+
+        BinaryErode( image, 0, 0, image.width(), image.height(), erosionX, erosionY );
+    }
+
+    void BinaryErode( Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t erosionX, uint32_t erosionY )
+    {
+        Image_Function::ValidateImageParameters( image, x, y, width, height );
+        Image_Function::VerifyGrayScaleImage( image );
+
+        if ( erosionX > 0u )
+            FunctionTask().BinaryErode( image, x, y, width, height, erosionX, 0u );
+        if ( erosionY > 0u )
+            FunctionTask().BinaryErode( image, x, y, width, height, 0u, erosionY );
+    }
+
     Image BitwiseAnd( const Image & in1, const Image & in2 )
     {
         return Image_Function_Helper::BitwiseAnd( BitwiseAnd, in1, in2 );
@@ -593,6 +982,16 @@ namespace Function_Pool
         FunctionTask().BitwiseAnd( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
     }
 
+    Image BitwiseAnd( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::BitwiseAnd( BitwiseAnd, in1, in2 );
+    }
+
+    void BitwiseAnd( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::BitwiseAnd( BitwiseAnd, in1, in2, out );
+    }
+
     Image BitwiseOr( const Image & in1, const Image & in2 )
     {
         return Image_Function_Helper::BitwiseOr( BitwiseOr, in1, in2 );
@@ -614,6 +1013,16 @@ namespace Function_Pool
         FunctionTask().BitwiseOr( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
     }
 
+    Image BitwiseOr( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::BitwiseOr( BitwiseOr, in1, in2 );
+    }
+
+    void BitwiseOr( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::BitwiseOr( BitwiseOr, in1, in2, out );
+    }
+
     Image BitwiseXor( const Image & in1, const Image & in2 )
     {
         return Image_Function_Helper::BitwiseXor( BitwiseXor, in1, in2 );
@@ -635,6 +1044,16 @@ namespace Function_Pool
         FunctionTask().BitwiseXor( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
     }
 
+    Image BitwiseXor( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::BitwiseXor( BitwiseXor, in1, in2 );
+    }
+
+    void BitwiseXor( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::BitwiseXor( BitwiseXor, in1, in2, out );
+    }
+
     Image ConvertToGrayScale( const Image & in )
     {
         return Image_Function_Helper::ConvertToGrayScale( ConvertToGrayScale, in );
@@ -770,6 +1189,52 @@ namespace Function_Pool
         FunctionTask().Histogram( image, x, y, width, height, histogram );
     }
 
+    std::vector<std::vector<uint32_t>> Histogram( const Image & image, const std::vector<Roi> & roi )
+    {
+        std::vector<std::vector<uint32_t>> histogram;
+        Histogram( image, roi, histogram );
+        return histogram;
+    }
+
+    void Histogram( const Image & image, const std::vector<Roi> & roi, std::vector<std::vector<uint32_t>> & histogram )
+    {
+        Image_Function::ValidateImageParameters( image, roi );
+
+        const std::vector<RoiBand> band = SplitRoiIntoBands( image, roi );
+        if ( band.size() < 2u ) {
+            Image_Function_Helper::RoiList::Histogram( image, roi, histogram );
+            return;
+        }
+
+        std::vector<std::vector<std::vector<uint32_t>>> bandHistogram( band.size() );
+        IndexedTask( [&]( size_t bandId ) { Image_Function_Helper::RoiList::Histogram( image, band[bandId].roi, bandHistogram[bandId] ); }, roiError )
+            .process( band.size() );
+
+        histogram.resize( roi.size() );
+        for ( std::vector<std::vector<uint32_t>>::iterator data = histogram.begin(); data != histogram.end(); ++data )
+            data->assign( 256u * image.colorCount(), 0u );
+
+        for ( size_t bandId = 0; bandId < band.size(); ++bandId ) {
+            for ( size_t i = 0; i < band[bandId].id.size(); ++i ) {
+                std::vector<uint32_t> & data = histogram[band[bandId].id[i]];
+                const std::vector<uint32_t> & bandData = bandHistogram[bandId][i];
+
+                for ( size_t value = 0; value < data.size(); ++value )
+                    data[value] += bandData[value];
+            }
+        }
+    }
+
+    std::vector<uint32_t> Histogram( const ConstImageView & image )
+    {
+        return Image_Function_Helper::Histogram( Histogram, image );
+    }
+
+    void Histogram( const ConstImageView & image, std::vector<uint32_t> & histogram )
+    {
+        Image_Function_Helper::Histogram( Histogram, image, histogram );
+    }
+
     Image Invert( const Image & in )
     {
         return Image_Function_Helper::Invert( Invert, in );
@@ -790,6 +1255,16 @@ namespace Function_Pool
         FunctionTask().Invert( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
     }
 
+    Image Invert( const ConstImageView & in )
+    {
+        return Image_Function_Helper::Invert( Invert, in );
+    }
+
+    void Invert( const ConstImageView & in, const ImageView & out )
+    {
+        Image_Function_Helper::Invert( Invert, in, out );
+    }
+
     bool IsEqual( const Image & in1, const Image & in2 )
     {
         Image_Function::ValidateImageParameters( in1, in2 );
@@ -844,6 +1319,51 @@ namespace Function_Pool
         FunctionTask().Maximum( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
     }
 
+    Image Maximum( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::Maximum( Maximum, in1, in2 );
+    }
+
+    void Maximum( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::Maximum( Maximum, in1, in2, out );
+    }
+
+    Image Median( const Image & in, uint32_t kernelSize )
+    {
+        Image_Function::ValidateImageParameters( in );
+
+        Image out( in.width(), in.height() );
+
+        Median( in, 0, 0, out, 0, 0, out.width(), out.height(), kernelSize );
+
+        return out;
+    }
+
+    void Median( const Image & in, Image & out, uint32_t kernelSize )
+    {
+        Image_Function::ValidateImageParameters( in, out );
+
+        Median( in, 0, 0, out, 0, 0, out.width(), out.height(), kernelSize );
+    }
+
+    Image Median( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height, uint32_t kernelSize )
+    {
+        Image_Function::ValidateImageParameters( in, startXIn, startYIn, width, height );
+
+        Image out( width, height );
+
+        Median( in, startXIn, startYIn, out, 0, 0, width, height, kernelSize );
+
+        return out;
+    }
+
+    void Median( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
+                 uint32_t kernelSize )
+    {
+        FunctionTask().Median( in, startXIn, startYIn, out, startXOut, startYOut, width, height, kernelSize );
+    }
+
     Image Merge( const Image & in1, const Image & in2, const Image & in3 )
     {
         return Image_Function_Helper::Merge( Merge, in1, in2, in3 );
@@ -887,6 +1407,16 @@ namespace Function_Pool
         FunctionTask().Minimum( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
     }
 
+    Image Minimum( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::Minimum( Minimum, in1, in2 );
+    }
+
+    void Minimum( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::Minimum( Minimum, in1, in2, out );
+    }
+
     Image Normalize( const Image & in )
     {
         return Image_Function_Helper::Normalize( Normalize, in );
@@ -936,6 +1466,40 @@ namespace Function_Pool
         }
     }
 
+    Image Prewitt( const Image & in )
+    {
+        Image_Function::ValidateImageParameters( in );
+
+        Image out( in.width(), in.height() );
+
+        Prewitt( in, 0, 0, out, 0, 0, out.width(), out.height() );
+
+        return out;
+    }
+
+    void Prewitt( const Image & in, Image & out )
+    {
+        Image_Function::ValidateImageParameters( in, out );
+
+        Prewitt( in, 0, 0, out, 0, 0, out.width(), out.height() );
+    }
+
+    Image Prewitt( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height )
+    {
+        Image_Function::ValidateImageParameters( in, startXIn, startYIn, width, height );
+
+        Image out( width, height );
+
+        Prewitt( in, startXIn, startYIn, out, 0, 0, width, height );
+
+        return out;
+    }
+
+    void Prewitt( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
+    {
+        FunctionTask().Prewitt( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
+    }
+
     std::vector<uint32_t> ProjectionProfile( const Image & image, bool horizontal )
     {
         return Image_Function_Helper::ProjectionProfile( ProjectionProfile, image, horizontal );
@@ -956,6 +1520,54 @@ namespace Function_Pool
         FunctionTask().ProjectionProfile( image, x, y, width, height, horizontal, projection );
     }
 
+    std::vector<std::vector<uint32_t>> ProjectionProfile( const Image & image, const std::vector<Roi> & roi, bool horizontal )
+    {
+        std::vector<std::vector<uint32_t>> projection;
+        ProjectionProfile( image, roi, horizontal, projection );
+        return projection;
+    }
+
+    void ProjectionProfile( const Image & image, const std::vector<Roi> & roi, bool horizontal, std::vector<std::vector<uint32_t>> & projection )
+    {
+        Image_Function::ValidateImageParameters( image, roi );
+
+        const std::vector<RoiBand> band = SplitRoiIntoBands( image, roi );
+        if ( band.size() < 2u ) {
+            Image_Function_Helper::RoiList::ProjectionProfile( image, roi, horizontal, projection, simd::actualSimdType() );
+            return;
+        }
+
+        const simd::SIMDType simdType = simd::actualSimdType();
+
+        std::vector<std::vector<std::vector<uint32_t>>> bandProjection( band.size() );
+        IndexedTask(
+            [&]( size_t bandId ) {
+                Image_Function_Helper::RoiList::ProjectionProfile( image, band[bandId].roi, horizontal, bandProjection[bandId], simdType );
+            },
+            roiError )
+            .process( band.size() );
+
+        projection.resize( roi.size() );
+        for ( size_t id = 0; id < roi.size(); ++id )
+            projection[id].assign( horizontal ? roi[id].width * image.colorCount() : roi[id].height, 0u );
+
+        for ( size_t bandId = 0; bandId < band.size(); ++bandId ) {
+            for ( size_t i = 0; i < band[bandId].id.size(); ++i ) {
+                const size_t id = band[bandId].id[i];
+                const std::vector<uint32_t> & bandData = bandProjection[bandId][i];
+
+                if ( horizontal ) {
+                    for ( size_t x = 0; x < bandData.size(); ++x )
+                        projection[id][x] += bandData[x];
+                }
+                else {
+                    // rows of a band are a continuous part of ROI rows
+                    std::copy( bandData.begin(), bandData.end(), projection[id].begin() + ( band[bandId].roi[i].y - roi[id].y ) );
+                }
+            }
+        }
+    }
+
     Image Resize( const Image & in, uint32_t widthOut, uint32_t heightOut )
     {
         return Image_Function_Helper::Resize( Resize, in, widthOut, heightOut );
@@ -1000,6 +1612,61 @@ namespace Function_Pool
         FunctionTask().RgbToBgr( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
     }
 
+    Image Shift( const Image & in, double shiftX, double shiftY )
+    {
+        return Image_Function_Helper::Shift( Shift, in, shiftX, shiftY );
+    }
+
+    void Shift( const Image & in, Image & out, double shiftX, double shiftY )
+    {
+        Image_Function_Helper::Shift( Shift, in, out, shiftX, shiftY );
+    }
+
+    Image Shift( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height, double shiftX, double shiftY )
+    {
+        return Image_Function_Helper::Shift( Shift, in, startXIn, startYIn, width, height, shiftX, shiftY );
+    }
+
+    void Shift( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
+                double shiftX, double shiftY )
+    {
+        FunctionTask().Shift( in, startXIn, startYIn, out, startXOut, startYOut, width, height, shiftX, shiftY );
+    }
+
+    Image Sobel( const Image & in )
+    {
+        Image_Function::ValidateImageParameters( in );
+
+        Image out( in.width(), in.height() );
+
+        Sobel( in, 0, 0, out, 0, 0, out.width(), out.height() );
+
+        return out;
+    }
+
+    void Sobel( const Image & in, Image & out )
+    {
+        Image_Function::ValidateImageParameters( in, out );
+
+        Sobel( in, 0, 0, out, 0, 0, out.width(), out.height() );
+    }
+
+    Image Sobel( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height )
+    {
+        Image_Function::ValidateImageParameters( in, startXIn, startYIn, width, height );
+
+        Image out( width, height );
+
+        Sobel( in, startXIn, startYIn, out, 0, 0, width, height );
+
+        return out;
+    }
+
+    void Sobel( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
+    {
+        FunctionTask().Sobel( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
+    }
+
     Image Subtract( const Image & in1, const Image & in2 )
     {
         return Image_Function_Helper::Subtract( Subtract, in1, in2 );
@@ -1042,6 +1709,16 @@ namespace Function_Pool
         FunctionTask().Subtract( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
     }
 
+    Image Subtract( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::Subtract( Subtract, in1, in2 );
+    }
+
+    void Subtract( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::Subtract( Subtract, in1, in2, out );
+    }
+
     uint32_t Sum( const Image & image )
     {
         return Function_Pool::Sum( image, 0, 0, image.width(), image.height() );
@@ -1052,6 +1729,37 @@ namespace Function_Pool
         return FunctionTask().Sum( image, x, y, width, height );
     }
 
+    uint32_t Sum( const ConstImageView & image )
+    {
+        return Image_Function_Helper::Sum( Sum, image );
+    }
+
+    std::vector<uint32_t> Sum( const Image & image, const std::vector<Roi> & roi )
+    {
+        Image_Function::ValidateImageParameters( image, roi );
+        if ( !roi.empty() )
+            Image_Function::VerifyGrayScaleImage( image );
+
+        const std::vector<RoiBand> band = SplitRoiIntoBands( image, roi );
+        if ( band.size() < 2u )
+            return Image_Function_Helper::RoiList::Sum( image, roi, simd::actualSimdType() );
+
+        const simd::SIMDType simdType = simd::actualSimdType();
+
+        std::vector<std::vector<uint32_t>> bandSum( band.size() );
+        IndexedTask( [&]( size_t bandId ) { bandSum[bandId] = Image_Function_Helper::RoiList::Sum( image, band[bandId].roi, simdType ); }, roiError )
+            .process( band.size() );
+
+        std::vector<uint32_t> sum( roi.size(), 0u );
+
+        for ( size_t bandId = 0; bandId < band.size(); ++bandId ) {
+            for ( size_t i = 0; i < band[bandId].id.size(); ++i )
+                sum[band[bandId].id[i]] += bandSum[bandId][i];
+        }
+
+        return sum;
+    }
+
     Image Threshold( const Image & in, uint8_t threshold )
     {
         return Image_Function_Helper::Threshold( Threshold, in, threshold );
@@ -1073,6 +1781,16 @@ namespace Function_Pool
         FunctionTask().Threshold( in, startXIn, startYIn, out, startXOut, startYOut, width, height, threshold );
     }
 
+    Image Threshold( const ConstImageView & in, uint8_t threshold )
+    {
+        return Image_Function_Helper::Threshold( Threshold, in, threshold );
+    }
+
+    void Threshold( const ConstImageView & in, const ImageView & out, uint8_t threshold )
+    {
+        Image_Function_Helper::Threshold( Threshold, in, out, threshold );
+    }
+
     Image Threshold( const Image & in, uint8_t minThreshold, uint8_t maxThreshold )
     {
         return Image_Function_Helper::Threshold( Threshold, in, minThreshold, maxThreshold );
@@ -1094,6 +1812,16 @@ namespace Function_Pool
         FunctionTask().Threshold( in, startXIn, startYIn, out, startXOut, startYOut, width, height, minThreshold, maxThreshold );
     }
 
+    Image Threshold( const ConstImageView & in, uint8_t minThreshold, uint8_t maxThreshold )
+    {
+        return Image_Function_Helper::Threshold( Threshold, in, minThreshold, maxThreshold );
+    }
+
+    void Threshold( const ConstImageView & in, const ImageView & out, uint8_t minThreshold, uint8_t maxThreshold )
+    {
+        Image_Function_Helper::Threshold( Threshold, in, out, minThreshold, maxThreshold );
+    }
+
     Image Transpose( const Image & in )
     {
         return Image_Function_Helper::Transpose( Transpose, in );
@@ -1118,3 +1846,32 @@ namespace Function_Pool
         FunctionTask().Transpose( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
     }
 }
+
+namespace
+{
+    // Function_Pool is a backend for automatic selection in penguinV namespace
+    struct BackendRegistrator
+    {
+        BackendRegistrator()
+        {
+            Image_Function_Helper::FunctionTableHolder table;
+
+            table.AbsoluteDifference = &Function_Pool::AbsoluteDifference;
+            table.BitwiseAnd = &Function_Pool::BitwiseAnd;
+            table.BitwiseOr = &Function_Pool::BitwiseOr;
+            table.BitwiseXor = &Function_Pool::BitwiseXor;
+            table.Histogram = &Function_Pool::Histogram;
+            table.Invert = &Function_Pool::Invert;
+            table.Maximum = &Function_Pool::Maximum;
+            table.Minimum = &Function_Pool::Minimum;
+            table.Subtract = &Function_Pool::Subtract;
+            table.Sum = &Function_Pool::Sum;
+            table.Threshold = &Function_Pool::Threshold;
+            table.Threshold2 = &Function_Pool::Threshold;
+
+            BackendSelector::instance().registerBackend( "function_pool", penguinV::Image().type(), table );
+        }
+    };
+
+    const BackendRegistrator backendRegistrator;
+}
@@ -36,24 +36,39 @@ namespace Function_Pool
                               uint32_t height );
     void AbsoluteDifference( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out,
                              uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height );
+    Image AbsoluteDifference( const ConstImageView & in1, const ConstImageView & in2 );
+    void AbsoluteDifference( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
+
+    // Binary dilation and erosion are done along X axis for all rows and after that along Y axis for all columns
+    void BinaryDilate( Image & image, uint32_t dilationX, uint32_t dilationY );
+    void BinaryDilate( Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t dilationX, uint32_t dilationY );
+
+    void BinaryErode( Image & image, uint32_t erosionX, uint32_t erosionY );
+    void BinaryErode( Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t erosionX, uint32_t erosionY );
 
     Image BitwiseAnd( const Image & in1, const Image & in2 );
     void BitwiseAnd( const Image & in1, const Image & in2, Image & out );
     Image BitwiseAnd( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void BitwiseAnd( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                      uint32_t startYOut, uint32_t width, uint32_t height );
+    Image BitwiseAnd( const ConstImageView & in1, const ConstImageView & in2 );
+    void BitwiseAnd( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image BitwiseOr( const Image & in1, const Image & in2 );
     void BitwiseOr( const Image & in1, const Image & in2, Image & out );
     Image BitwiseOr( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void BitwiseOr( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                     uint32_t startYOut, uint32_t width, uint32_t height );
+    Image BitwiseOr( const ConstImageView & in1, const ConstImageView & in2 );
+    void BitwiseOr( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image BitwiseXor( const Image & in1, const Image & in2 );
     void BitwiseXor( const Image & in1, const Image & in2, Image & out );
     Image BitwiseXor( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void BitwiseXor( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                      uint32_t startYOut, uint32_t width, uint32_t height );
+    Image BitwiseXor( const ConstImageView & in1, const ConstImageView & in2 );
+    void BitwiseXor( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image ConvertToGrayScale( const Image & in );
     void ConvertToGrayScale( const Image & in, Image & out );
@@ -94,12 +109,21 @@ namespace Function_Pool
     void Histogram( const Image & image, std::vector<uint32_t> & histogram );
     std::vector<uint32_t> Histogram( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
     void Histogram( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint32_t> & histogram );
+    std::vector<uint32_t> Histogram( const ConstImageView & image );
+    void Histogram( const ConstImageView & image, std::vector<uint32_t> & histogram );
+
+    // Functions taking a list of ROIs of one image return results per ROI in the same order as ROIs. Rows crossed by ROIs are split
+    // into bands with similar number of ROI pixels and every band is read once by one task while all ROIs crossing it are updated
+    std::vector<std::vector<uint32_t>> Histogram( const Image & image, const std::vector<Roi> & roi );
+    void Histogram( const Image & image, const std::vector<Roi> & roi, std::vector<std::vector<uint32_t>> & histogram );
 
     // Invert function is Bitwise NOT operation. But to make function name more user-friendly we named it like this
     Image Invert( const Image & in );
     void Invert( const Image & in, Image & out );
     Image Invert( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height );
     void Invert( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Invert( const ConstImageView & in );
+    void Invert( const ConstImageView & in, const ImageView & out );
 
     bool IsEqual( const Image & in1, const Image & in2 );
     bool IsEqual( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
@@ -115,6 +139,15 @@ namespace Function_Pool
     Image Maximum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void Maximum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                   uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Maximum( const ConstImageView & in1, const ConstImageView & in2 );
+    void Maximum( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
+
+    // Every task filters its area extended by a half of kernel size so the result is the same as in single thread version
+    Image Median( const Image & in, uint32_t kernelSize );
+    void Median( const Image & in, Image & out, uint32_t kernelSize );
+    Image Median( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height, uint32_t kernelSize );
+    void Median( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
+                 uint32_t kernelSize );
 
     Image Merge( const Image & in1, const Image & in2, const Image & in3 );
     void Merge( const Image & in1, const Image & in2, const Image & in3, Image & out );
@@ -128,16 +161,26 @@ namespace Function_Pool
     Image Minimum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void Minimum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                   uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Minimum( const ConstImageView & in1, const ConstImageView & in2 );
+    void Minimum( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image Normalize( const Image & in );
     void Normalize( const Image & in, Image & out );
     Image Normalize( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height );
     void Normalize( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height );
 
+    // This filter returns image based on gradient magnitude in both X and Y directions
+    Image Prewitt( const Image & in );
+    void Prewitt( const Image & in, Image & out );
+    Image Prewitt( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height );
+    void Prewitt( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height );
+
     std::vector<uint32_t> ProjectionProfile( const Image & image, bool horizontal );
     void ProjectionProfile( const Image & image, bool horizontal, std::vector<uint32_t> & projection );
     std::vector<uint32_t> ProjectionProfile( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal );
     void ProjectionProfile( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal, std::vector<uint32_t> & projection );
+    std::vector<std::vector<uint32_t>> ProjectionProfile( const Image & image, const std::vector<Roi> & roi, bool horizontal );
+    void ProjectionProfile( const Image & image, const std::vector<Roi> & roi, bool horizontal, std::vector<std::vector<uint32_t>> & projection );
 
     // Image resizing (scaling) is based on nearest-neighbour interpolation method
     Image Resize( const Image & in, uint32_t widthOut, uint32_t heightOut );
@@ -151,6 +194,18 @@ namespace Function_Pool
     Image RgbToBgr( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height );
     void RgbToBgr( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height );
 
+    Image Shift( const Image & in, double shiftX, double shiftY );
+    void Shift( const Image & in, Image & out, double shiftX, double shiftY );
+    Image Shift( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height, double shiftX, double shiftY );
+    void Shift( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
+                double shiftX, double shiftY );
+
+    // This filter returns image based on gradient magnitude in both X and Y directions
+    Image Sobel( const Image & in );
+    void Sobel( const Image & in, Image & out );
+    Image Sobel( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height );
+    void Sobel( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height );
+
     void Split( const Image & in, Image & out1, Image & out2, Image & out3 );
     void Split( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out1, uint32_t startXOut1, uint32_t startYOut1, Image & out2, uint32_t startXOut2,
                 uint32_t startYOut2, Image & out3, uint32_t startXOut3, uint32_t startYOut3, uint32_t width, uint32_t height );
@@ -160,11 +215,15 @@ namespace Function_Pool
     Image Subtract( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void Subtract( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                    uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Subtract( const ConstImageView & in1, const ConstImageView & in2 );
+    void Subtract( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     // Make sure that your image is not so big to do not have overloaded uint32_t value
     // For example not bigger than [4096 * 4096] for 32-bit application
     uint32_t Sum( const Image & image );
     uint32_t Sum( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
+    uint32_t Sum( const ConstImageView & image );
+    std::vector<uint32_t> Sum( const Image & image, const std::vector<Roi> & roi );
 
     // Thresholding works in such way:
     // if pixel intensity on input image is          less (  < ) than threshold then set pixel intensity on output image as 0
@@ -174,6 +233,8 @@ namespace Function_Pool
     Image Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height, uint8_t threshold );
     void Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                     uint8_t threshold );
+    Image Threshold( const ConstImageView & in, uint8_t threshold );
+    void Threshold( const ConstImageView & in, const ImageView & out, uint8_t threshold );
 
     // Thresholding works in such way:
     // if pixel intensity on input image is less ( < ) than minimum threshold or more ( > ) than maximum threshold
@@ -184,6 +245,8 @@ namespace Function_Pool
     Image Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height, uint8_t minThreshold, uint8_t maxThreshold );
     void Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                     uint8_t minThreshold, uint8_t maxThreshold );
+    Image Threshold( const ConstImageView & in, uint8_t minThreshold, uint8_t maxThreshold );
+    void Threshold( const ConstImageView & in, const ImageView & out, uint8_t minThreshold, uint8_t maxThreshold );
 
     // Swap columns and rows in input image. It is equivalent to 90 degree rotation
     // Output image (area) must be [height, width] compare to original [width, height]
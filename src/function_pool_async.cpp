@@ -0,0 +1,401 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "function_pool_async.h"
+#include "function_pool.h"
+#include "penguinv_exception.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <exception>
+
+namespace
+{
+    using namespace Function_Pool::Async;
+
+    // One task running a function in thread pool. The task owns itself and it is destroyed when it is completed
+    class AsyncTask : public TaskProviderSingleton
+    {
+    public:
+        AsyncTask( ThreadPool & pool, const std::shared_ptr<FutureState> & result, const std::function<void()> & function )
+            : _pool( pool )
+            , _result( result )
+            , _function( function )
+            , _executed( false )
+        {
+            _notifyCompletion = true;
+        }
+
+        virtual ~AsyncTask() {}
+
+        void start()
+        {
+            ThreadPoolSelection selection( _pool );
+            _run( 1u );
+        }
+
+    protected:
+        virtual void _task( size_t )
+        {
+            _executed = true;
+
+            // functions called by the task must run in the same thread pool
+            ThreadPoolSelection selection( _pool );
+
+            try {
+                _function();
+            }
+            catch ( const std::exception & error ) {
+                _result->setFailed( error.what() );
+                return;
+            }
+            catch ( ... ) {
+                _result->setFailed( "An unknown exception is raised during asynchronous task execution" );
+                return;
+            }
+
+            _result->setReady();
+        }
+
+        virtual void _onCompletion( bool )
+        {
+            if ( !_executed )
+                _result->setFailed( "Asynchronous task is removed from thread pool" );
+
+            delete this;
+        }
+
+    private:
+        ThreadPool & _pool;
+        std::shared_ptr<FutureState> _result;
+        std::function<void()> _function;
+        bool _executed;
+    };
+
+    void start( ThreadPool & pool, const std::shared_ptr<FutureState> & result, const std::function<void()> & function )
+    {
+        AsyncTask * task = new AsyncTask( pool, result, function );
+
+        try {
+            task->start();
+        }
+        catch ( const std::exception & error ) {
+            delete task;
+            result->setFailed( error.what() );
+        }
+    }
+
+    template <typename _Result, typename _Function>
+    Future<_Result> run( const Future<Image> & in1, const Future<Image> & in2, _Function function )
+    {
+        std::shared_ptr<FutureValue<_Result>> result( new FutureValue<_Result> );
+
+        std::shared_ptr<FutureValue<Image>> image1 = std::static_pointer_cast<FutureValue<Image>>( in1.state() );
+        std::shared_ptr<FutureValue<Image>> image2 = std::static_pointer_cast<FutureValue<Image>>( in2.state() );
+
+        FutureValue<_Result> * output = result.get();
+        Run( { in1.state(), in2.state() }, result, [image1, image2, output, function]() { output->value = function( image1->value, image2->value ); } );
+
+        return Future<_Result>( result );
+    }
+}
+
+namespace Function_Pool
+{
+    namespace Async
+    {
+        FutureState::FutureState()
+            : _ready( false )
+            , _failed( false )
+        {}
+
+        FutureState::~FutureState() {}
+
+        bool FutureState::ready() const
+        {
+            std::lock_guard<std::mutex> lock( _lock );
+            return _ready;
+        }
+
+        bool FutureState::failed() const
+        {
+            std::lock_guard<std::mutex> lock( _lock );
+            return _failed;
+        }
+
+        std::string FutureState::error() const
+        {
+            std::lock_guard<std::mutex> lock( _lock );
+            return _error;
+        }
+
+        void FutureState::wait() const
+        {
+            std::unique_lock<std::mutex> lock( _lock );
+            _completion.wait( lock, [&] { return _ready; } );
+
+            if ( _failed )
+                throw penguinVException( _error );
+        }
+
+        void FutureState::setReady()
+        {
+            _complete();
+        }
+
+        void FutureState::setFailed( const std::string & error )
+        {
+            _lock.lock();
+            _failed = true;
+            _error = error;
+            _lock.unlock();
+
+            _complete();
+        }
+
+        void FutureState::onCompletion( const std::function<void()> & continuation )
+        {
+            {
+                std::lock_guard<std::mutex> lock( _lock );
+                if ( !_ready ) {
+                    _continuation.push_back( continuation );
+                    return;
+                }
+            }
+
+            continuation();
+        }
+
+        void FutureState::_complete()
+        {
+            std::vector<std::function<void()>> continuation;
+
+            {
+                std::lock_guard<std::mutex> lock( _lock );
+                if ( _ready )
+                    return;
+
+                _ready = true;
+                std::swap( continuation, _continuation );
+                _completion.notify_all();
+            }
+
+            // continuations are called without the lock as they could access this state
+            for ( std::vector<std::function<void()>>::iterator function = continuation.begin(); function != continuation.end(); ++function )
+                ( *function )();
+        }
+
+        void Run( const std::vector<std::shared_ptr<FutureState>> & dependency, const std::shared_ptr<FutureState> & result, const std::function<void()> & function )
+        {
+            for ( std::vector<std::shared_ptr<FutureState>>::const_iterator state = dependency.begin(); state != dependency.end(); ++state ) {
+                if ( !( *state ) )
+                    throw penguinVException( "Future is not valid" );
+            }
+
+            ThreadPool * pool = &ThreadPoolMonoid::instance();
+
+            // the last completed dependency starts the function. One extra count is held until all continuations are registered
+            std::shared_ptr<std::atomic<size_t>> remaining( new std::atomic<size_t>( dependency.size() + 1u ) );
+
+            const std::function<void()> continuation = [pool, dependency, result, function, remaining]() {
+                if ( --( *remaining ) > 0u )
+                    return;
+
+                for ( std::vector<std::shared_ptr<FutureState>>::const_iterator state = dependency.begin(); state != dependency.end(); ++state ) {
+                    if ( ( *state )->failed() ) {
+                        result->setFailed( ( *state )->error() );
+                        return;
+                    }
+                }
+
+                start( *pool, result, function );
+            };
+
+            for ( std::vector<std::shared_ptr<FutureState>>::const_iterator state = dependency.begin(); state != dependency.end(); ++state )
+                ( *state )->onCompletion( continuation );
+
+            continuation();
+        }
+
+        FutureBase::FutureBase( const std::shared_ptr<FutureState> & state )
+            : _state( state )
+        {}
+
+        bool FutureBase::valid() const
+        {
+            return _state != nullptr;
+        }
+
+        bool FutureBase::ready() const
+        {
+            return valid() && _state->ready();
+        }
+
+        void FutureBase::wait() const
+        {
+            if ( !valid() )
+                throw penguinVException( "Future is not valid" );
+
+            _state->wait();
+        }
+
+        const std::shared_ptr<FutureState> & FutureBase::state() const
+        {
+            return _state;
+        }
+
+        Future<void> WhenAll( const std::vector<FutureBase> & futures )
+        {
+            std::vector<std::shared_ptr<FutureState>> dependency;
+            for ( std::vector<FutureBase>::const_iterator future = futures.begin(); future != futures.end(); ++future )
+                dependency.push_back( future->state() );
+
+            std::shared_ptr<FutureValue<void>> result( new FutureValue<void> );
+            Run( dependency, result, []() {} );
+
+            return Future<void>( result );
+        }
+
+        void WaitAll( const std::vector<FutureBase> & futures )
+        {
+            for ( std::vector<FutureBase>::const_iterator future = futures.begin(); future != futures.end(); ++future )
+                future->wait();
+        }
+
+        Future<Image> AbsoluteDifference( const Future<Image> & in1, const Future<Image> & in2 )
+        {
+            return run<Image>( in1, in2, []( const Image & image1, const Image & image2 ) { return Function_Pool::AbsoluteDifference( image1, image2 ); } );
+        }
+
+        Future<Image> BitwiseAnd( const Future<Image> & in1, const Future<Image> & in2 )
+        {
+            return run<Image>( in1, in2, []( const Image & image1, const Image & image2 ) { return Function_Pool::BitwiseAnd( image1, image2 ); } );
+        }
+
+        Future<Image> BitwiseOr( const Future<Image> & in1, const Future<Image> & in2 )
+        {
+            return run<Image>( in1, in2, []( const Image & image1, const Image & image2 ) { return Function_Pool::BitwiseOr( image1, image2 ); } );
+        }
+
+        Future<Image> BitwiseXor( const Future<Image> & in1, const Future<Image> & in2 )
+        {
+            return run<Image>( in1, in2, []( const Image & image1, const Image & image2 ) { return Function_Pool::BitwiseXor( image1, image2 ); } );
+        }
+
+        Future<Image> ConvertToGrayScale( const Future<Image> & in )
+        {
+            return in.then( []( const Image & image ) { return Function_Pool::ConvertToGrayScale( image ); } );
+        }
+
+        Future<Image> ConvertToRgb( const Future<Image> & in )
+        {
+            return in.then( []( const Image & image ) { return Function_Pool::ConvertToRgb( image ); } );
+        }
+
+        Future<Image> Flip( const Future<Image> & in, bool horizontal, bool vertical )
+        {
+            return in.then( [horizontal, vertical]( const Image & image ) { return Function_Pool::Flip( image, horizontal, vertical ); } );
+        }
+
+        Future<Image> GammaCorrection( const Future<Image> & in, double a, double gamma )
+        {
+            return in.then( [a, gamma]( const Image & image ) { return Function_Pool::GammaCorrection( image, a, gamma ); } );
+        }
+
+        Future<std::vector<uint32_t>> Histogram( const Future<Image> & image )
+        {
+            return image.then( []( const Image & in ) { return Function_Pool::Histogram( in ); } );
+        }
+
+        Future<Image> Invert( const Future<Image> & in )
+        {
+            return in.then( []( const Image & image ) { return Function_Pool::Invert( image ); } );
+        }
+
+        Future<bool> IsEqual( const Future<Image> & in1, const Future<Image> & in2 )
+        {
+            return run<bool>( in1, in2, []( const Image & image1, const Image & image2 ) { return Function_Pool::IsEqual( image1, image2 ); } );
+        }
+
+        Future<Image> LookupTable( const Future<Image> & in, const std::vector<uint8_t> & table )
+        {
+            return in.then( [table]( const Image & image ) { return Function_Pool::LookupTable( image, table ); } );
+        }
+
+        Future<Image> Maximum( const Future<Image> & in1, const Future<Image> & in2 )
+        {
+            return run<Image>( in1, in2, []( const Image & image1, const Image & image2 ) { return Function_Pool::Maximum( image1, image2 ); } );
+        }
+
+        Future<Image> Median( const Future<Image> & in, uint32_t kernelSize )
+        {
+            return in.then( [kernelSize]( const Image & image ) { return Function_Pool::Median( image, kernelSize ); } );
+        }
+
+        Future<Image> Minimum( const Future<Image> & in1, const Future<Image> & in2 )
+        {
+            return run<Image>( in1, in2, []( const Image & image1, const Image & image2 ) { return Function_Pool::Minimum( image1, image2 ); } );
+        }
+
+        Future<Image> Normalize( const Future<Image> & in )
+        {
+            return in.then( []( const Image & image ) { return Function_Pool::Normalize( image ); } );
+        }
+
+        Future<std::vector<uint32_t>> ProjectionProfile( const Future<Image> & image, bool horizontal )
+        {
+            return image.then( [horizontal]( const Image & in ) { return Function_Pool::ProjectionProfile( in, horizontal ); } );
+        }
+
+        Future<Image> Resize( const Future<Image> & in, uint32_t widthOut, uint32_t heightOut )
+        {
+            return in.then( [widthOut, heightOut]( const Image & image ) { return Function_Pool::Resize( image, widthOut, heightOut ); } );
+        }
+
+        Future<Image> Sobel( const Future<Image> & in )
+        {
+            return in.then( []( const Image & image ) { return Function_Pool::Sobel( image ); } );
+        }
+
+        Future<Image> Subtract( const Future<Image> & in1, const Future<Image> & in2 )
+        {
+            return run<Image>( in1, in2, []( const Image & image1, const Image & image2 ) { return Function_Pool::Subtract( image1, image2 ); } );
+        }
+
+        Future<uint32_t> Sum( const Future<Image> & image )
+        {
+            return image.then( []( const Image & in ) { return Function_Pool::Sum( in ); } );
+        }
+
+        Future<Image> Threshold( const Future<Image> & in, uint8_t threshold )
+        {
+            return in.then( [threshold]( const Image & image ) { return Function_Pool::Threshold( image, threshold ); } );
+        }
+
+        Future<Image> Threshold( const Future<Image> & in, uint8_t minThreshold, uint8_t maxThreshold )
+        {
+            return in.then( [minThreshold, maxThreshold]( const Image & image ) { return Function_Pool::Threshold( image, minThreshold, maxThreshold ); } );
+        }
+
+        Future<Image> Transpose( const Future<Image> & in )
+        {
+            return in.then( []( const Image & image ) { return Function_Pool::Transpose( image ); } );
+        }
+    }
+}
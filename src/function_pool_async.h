@@ -0,0 +1,261 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include "image_buffer.h"
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Function_Pool
+{
+    // Asynchronous versions of Function_Pool functions. A function returns immediately a future which becomes ready when the result is computed.
+    // Every operation runs as a task of thread pool selected by ThreadPoolMonoid class in calling thread, no extra threads are created.
+    // Input images are passed as futures so operations are chained without waiting: an operation starts once all its inputs are ready.
+    // Futures share ownership of images and values so inputs and outputs stay alive until all operations using them are completed
+    namespace Async
+    {
+        using namespace penguinV;
+
+        // Shared state of an asynchronous operation
+        class FutureState
+        {
+        public:
+            FutureState();
+            virtual ~FutureState();
+
+            FutureState & operator=( const FutureState & ) = delete;
+            FutureState( const FutureState & ) = delete;
+
+            bool ready() const; // returns true when an operation is completed successfully or not
+            bool failed() const;
+            std::string error() const;
+
+            void wait() const; // waits for completion, throws an exception if the operation failed
+
+            void setReady();
+            void setFailed( const std::string & error );
+
+            // continuation is called once the operation is completed: immediately in calling thread if it is already completed
+            // or in a thread which completes the operation. Continuation must not block the thread
+            void onCompletion( const std::function<void()> & continuation );
+
+        private:
+            mutable std::mutex _lock;
+            mutable std::condition_variable _completion;
+            bool _ready;
+            bool _failed;
+            std::string _error;
+            std::vector<std::function<void()>> _continuation;
+
+            void _complete();
+        };
+
+        template <typename _Type>
+        class FutureValue : public FutureState
+        {
+        public:
+            _Type value;
+        };
+
+        template <>
+        class FutureValue<void> : public FutureState
+        {};
+
+        // Runs a function in thread pool when all dependencies are completed and marks the result as ready. If any dependency failed
+        // the result fails with the same error without running the function. If the function raises an exception the result fails too
+        void Run( const std::vector<std::shared_ptr<FutureState>> & dependency, const std::shared_ptr<FutureState> & result, const std::function<void()> & function );
+
+        // Stores a result of a function call into a future value
+        template <typename _Result>
+        struct Call
+        {
+            template <typename _Function, typename... _Argument>
+            static void run( FutureValue<_Result> & result, _Function & function, const _Argument &... argument )
+            {
+                result.value = function( argument... );
+            }
+        };
+
+        template <>
+        struct Call<void>
+        {
+            template <typename _Function, typename... _Argument>
+            static void run( FutureValue<void> &, _Function & function, const _Argument &... argument )
+            {
+                function( argument... );
+            }
+        };
+
+        class FutureBase
+        {
+        public:
+            explicit FutureBase( const std::shared_ptr<FutureState> & state = std::shared_ptr<FutureState>() );
+
+            bool valid() const; // returns false for default constructed futures
+            bool ready() const;
+
+            void wait() const; // waits for completion, throws an exception if the operation failed
+
+            const std::shared_ptr<FutureState> & state() const;
+
+        protected:
+            std::shared_ptr<FutureState> _state;
+        };
+
+        template <typename _Type>
+        class Future : public FutureBase
+        {
+        public:
+            Future() {}
+
+            explicit Future( const std::shared_ptr<FutureValue<_Type>> & state )
+                : FutureBase( state )
+            {}
+
+            // waits for completion and returns the result, throws an exception if the operation failed
+            const _Type & get() const
+            {
+                wait();
+                return static_cast<const FutureValue<_Type> *>( _state.get() )->value;
+            }
+
+            // function is called in thread pool with the result of this future when it is ready. It could call any Function_Pool function
+            template <typename _Function>
+            Future<decltype( std::declval<_Function>()( std::declval<const _Type &>() ) )> then( _Function function ) const
+            {
+                typedef decltype( std::declval<_Function>()( std::declval<const _Type &>() ) ) _Result;
+
+                std::shared_ptr<FutureValue<_Result>> result( new FutureValue<_Result> );
+                std::shared_ptr<FutureValue<_Type>> input = std::static_pointer_cast<FutureValue<_Type>>( _state );
+
+                FutureValue<_Result> * output = result.get();
+                Run( { _state }, result, [input, output, function]() mutable { Call<_Result>::run( *output, function, input->value ); } );
+
+                return Future<_Result>( result );
+            }
+        };
+
+        template <>
+        class Future<void> : public FutureBase
+        {
+        public:
+            Future() {}
+
+            explicit Future( const std::shared_ptr<FutureValue<void>> & state )
+                : FutureBase( state )
+            {}
+
+            void get() const
+            {
+                wait();
+            }
+
+            template <typename _Function>
+            Future<decltype( std::declval<_Function>()() )> then( _Function function ) const
+            {
+                typedef decltype( std::declval<_Function>()() ) _Result;
+
+                std::shared_ptr<FutureValue<_Result>> result( new FutureValue<_Result> );
+
+                FutureValue<_Result> * output = result.get();
+                Run( { _state }, result, [output, function]() mutable { Call<_Result>::run( *output, function ); } );
+
+                return Future<_Result>( result );
+            }
+        };
+
+        // Returns a ready future owning the value. Move an image into it to avoid copying
+        template <typename _Type>
+        Future<_Type> MakeReady( _Type value )
+        {
+            std::shared_ptr<FutureValue<_Type>> result( new FutureValue<_Type> );
+            result->value = std::move( value );
+            result->setReady();
+
+            return Future<_Type>( result );
+        }
+
+        // Returns a future which is ready when all futures are completed, it fails if any of futures failed
+        Future<void> WhenAll( const std::vector<FutureBase> & futures );
+
+        // Waits for completion of all futures, throws an exception if any of them failed
+        void WaitAll( const std::vector<FutureBase> & futures );
+
+        template <typename... _Future>
+        void WaitAll( const _Future &... futures )
+        {
+            WaitAll( std::vector<FutureBase>{ futures... } );
+        }
+
+        Future<Image> AbsoluteDifference( const Future<Image> & in1, const Future<Image> & in2 );
+
+        Future<Image> BitwiseAnd( const Future<Image> & in1, const Future<Image> & in2 );
+
+        Future<Image> BitwiseOr( const Future<Image> & in1, const Future<Image> & in2 );
+
+        Future<Image> BitwiseXor( const Future<Image> & in1, const Future<Image> & in2 );
+
+        Future<Image> ConvertToGrayScale( const Future<Image> & in );
+
+        Future<Image> ConvertToRgb( const Future<Image> & in );
+
+        Future<Image> Flip( const Future<Image> & in, bool horizontal, bool vertical );
+
+        Future<Image> GammaCorrection( const Future<Image> & in, double a, double gamma );
+
+        Future<std::vector<uint32_t>> Histogram( const Future<Image> & image );
+
+        Future<Image> Invert( const Future<Image> & in );
+
+        Future<bool> IsEqual( const Future<Image> & in1, const Future<Image> & in2 );
+
+        Future<Image> LookupTable( const Future<Image> & in, const std::vector<uint8_t> & table );
+
+        Future<Image> Maximum( const Future<Image> & in1, const Future<Image> & in2 );
+
+        Future<Image> Median( const Future<Image> & in, uint32_t kernelSize );
+
+        Future<Image> Minimum( const Future<Image> & in1, const Future<Image> & in2 );
+
+        Future<Image> Normalize( const Future<Image> & in );
+
+        Future<std::vector<uint32_t>> ProjectionProfile( const Future<Image> & image, bool horizontal );
+
+        Future<Image> Resize( const Future<Image> & in, uint32_t widthOut, uint32_t heightOut );
+
+        Future<Image> Sobel( const Future<Image> & in );
+
+        Future<Image> Subtract( const Future<Image> & in1, const Future<Image> & in2 );
+
+        Future<uint32_t> Sum( const Future<Image> & image );
+
+        Future<Image> Threshold( const Future<Image> & in, uint8_t threshold );
+
+        Future<Image> Threshold( const Future<Image> & in, uint8_t minThreshold, uint8_t maxThreshold );
+
+        Future<Image> Transpose( const Future<Image> & in );
+    }
+}
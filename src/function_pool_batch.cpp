@@ -0,0 +1,175 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "function_pool_batch.h"
+#include "function_pool_task.h"
+#include "image_function_helper.h"
+#include "penguinv/penguinv.h"
+#include "penguinv_exception.h"
+
+namespace
+{
+    const char * const batchError = "An error occured during batch processing";
+
+    // Functions are resolved once per batch when all images have the same type, otherwise they are called through penguinV dispatching
+    Image_Function_Helper::FunctionTableHolder functionTable( const std::vector<penguinV::Image> & in, const std::vector<penguinV::Image> & out )
+    {
+        Image_Function_Helper::FunctionTableHolder table;
+
+        if ( !in.empty() ) {
+            const uint8_t type = in.front().type();
+            bool sameType = true;
+
+            for ( std::vector<penguinV::Image>::const_iterator image = in.cbegin(); image != in.cend() && sameType; ++image )
+                sameType = ( image->type() == type );
+            for ( std::vector<penguinV::Image>::const_iterator image = out.cbegin(); image != out.cend() && sameType; ++image )
+                sameType = ( image->type() == type );
+
+            if ( sameType )
+                table = ImageTypeManager::instance().functionTable( type );
+        }
+
+        Image_Function_Helper::SetDefaultFunction( table.Histogram, penguinV::Histogram );
+        Image_Function_Helper::SetDefaultFunction( table.Resize, penguinV::Resize );
+        Image_Function_Helper::SetDefaultFunction( table.Sum, penguinV::Sum );
+        Image_Function_Helper::SetDefaultFunction( table.Threshold, penguinV::Threshold );
+        Image_Function_Helper::SetDefaultFunction( table.Threshold2, penguinV::Threshold );
+
+        return table;
+    }
+
+    void verifyBatchSize( const std::vector<penguinV::Image> & in, const std::vector<penguinV::Image> & out )
+    {
+        if ( in.size() != out.size() )
+            throw penguinVException( "Number of input and output images in batch is different" );
+    }
+}
+
+namespace Function_Pool
+{
+    // Every task processes one image. Thread pool claims tasks in chunks so a batch of thousands of images costs few synchronizations
+    namespace Batch
+    {
+        std::vector<Blob_Detection::BlobDetection> BlobDetection( const std::vector<Image> & image, const Blob_Detection::BlobParameters & parameter,
+                                                                  uint8_t threshold )
+        {
+            std::vector<Blob_Detection::BlobDetection> detection;
+            BlobDetection( image, detection, parameter, threshold );
+            return detection;
+        }
+
+        void BlobDetection( const std::vector<Image> & image, std::vector<Blob_Detection::BlobDetection> & detection, const Blob_Detection::BlobParameters & parameter,
+                            uint8_t threshold )
+        {
+            detection.resize( image.size() );
+
+            IndexedTask( [&]( size_t id ) { detection[id].find( image[id], parameter, threshold ); }, batchError ).process( image.size() );
+        }
+
+        std::vector<std::vector<uint32_t>> Histogram( const std::vector<Image> & image )
+        {
+            std::vector<std::vector<uint32_t>> histogram;
+            Histogram( image, histogram );
+            return histogram;
+        }
+
+        void Histogram( const std::vector<Image> & image, std::vector<std::vector<uint32_t>> & histogram )
+        {
+            const Image_Function_Helper::FunctionTableHolder table = functionTable( image, std::vector<Image>() );
+
+            histogram.resize( image.size() );
+
+            IndexedTask( [&]( size_t id ) { Image_Function_Helper::Histogram( table.Histogram, image[id], histogram[id] ); }, batchError ).process( image.size() );
+        }
+
+        std::vector<Image> Resize( const std::vector<Image> & in, uint32_t widthOut, uint32_t heightOut )
+        {
+            const Image_Function_Helper::FunctionTableHolder table = functionTable( in, std::vector<Image>() );
+
+            std::vector<Image> out( in.size() );
+
+            IndexedTask( [&]( size_t id ) { out[id] = Image_Function_Helper::Resize( table.Resize, in[id], widthOut, heightOut ); }, batchError ).process( in.size() );
+
+            return out;
+        }
+
+        void Resize( const std::vector<Image> & in, std::vector<Image> & out )
+        {
+            verifyBatchSize( in, out );
+
+            const Image_Function_Helper::FunctionTableHolder table = functionTable( in, out );
+
+            IndexedTask( [&]( size_t id ) { Image_Function_Helper::Resize( table.Resize, in[id], out[id] ); }, batchError ).process( in.size() );
+        }
+
+        std::vector<uint32_t> Sum( const std::vector<Image> & image )
+        {
+            const Image_Function_Helper::FunctionTableHolder table = functionTable( image, std::vector<Image>() );
+
+            std::vector<uint32_t> sum( image.size() );
+
+            IndexedTask( [&]( size_t id ) { sum[id] = table.Sum( image[id], 0, 0, image[id].width(), image[id].height() ); }, batchError ).process( image.size() );
+
+            return sum;
+        }
+
+        std::vector<Image> Threshold( const std::vector<Image> & in, uint8_t threshold )
+        {
+            const Image_Function_Helper::FunctionTableHolder table = functionTable( in, std::vector<Image>() );
+
+            std::vector<Image> out( in.size() );
+
+            IndexedTask( [&]( size_t id ) { out[id] = Image_Function_Helper::Threshold( table.Threshold, in[id], threshold ); }, batchError ).process( in.size() );
+
+            return out;
+        }
+
+        void Threshold( const std::vector<Image> & in, std::vector<Image> & out, uint8_t threshold )
+        {
+            verifyBatchSize( in, out );
+
+            const Image_Function_Helper::FunctionTableHolder table = functionTable( in, out );
+
+            IndexedTask( [&]( size_t id ) { Image_Function_Helper::Threshold( table.Threshold, in[id], out[id], threshold ); }, batchError ).process( in.size() );
+        }
+
+        std::vector<Image> Threshold( const std::vector<Image> & in, uint8_t minThreshold, uint8_t maxThreshold )
+        {
+            const Image_Function_Helper::FunctionTableHolder table = functionTable( in, std::vector<Image>() );
+
+            std::vector<Image> out( in.size() );
+
+            IndexedTask( [&]( size_t id ) { out[id] = Image_Function_Helper::Threshold( table.Threshold2, in[id], minThreshold, maxThreshold ); }, batchError )
+                .process( in.size() );
+
+            return out;
+        }
+
+        void Threshold( const std::vector<Image> & in, std::vector<Image> & out, uint8_t minThreshold, uint8_t maxThreshold )
+        {
+            verifyBatchSize( in, out );
+
+            const Image_Function_Helper::FunctionTableHolder table = functionTable( in, out );
+
+            IndexedTask( [&]( size_t id ) { Image_Function_Helper::Threshold( table.Threshold2, in[id], out[id], minThreshold, maxThreshold ); }, batchError )
+                .process( in.size() );
+        }
+    }
+}
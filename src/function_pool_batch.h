@@ -0,0 +1,56 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include "blob_detection.h"
+#include "image_buffer.h"
+#include <vector>
+
+namespace Function_Pool
+{
+    // Functions processing batches of small images, for example thousands of 64 x 64 patches, for which splitting of every image
+    // between threads costs more than processing itself. Every image is processed by one thread and the whole batch is given
+    // to thread pool selected by ThreadPoolMonoid class at once. Output vectors must contain the same number of images as input vectors
+    namespace Batch
+    {
+        using namespace penguinV;
+
+        std::vector<Blob_Detection::BlobDetection> BlobDetection( const std::vector<Image> & image,
+                                                                  const Blob_Detection::BlobParameters & parameter = Blob_Detection::BlobParameters(),
+                                                                  uint8_t threshold = 1 );
+        void BlobDetection( const std::vector<Image> & image, std::vector<Blob_Detection::BlobDetection> & detection,
+                            const Blob_Detection::BlobParameters & parameter = Blob_Detection::BlobParameters(), uint8_t threshold = 1 );
+
+        std::vector<std::vector<uint32_t>> Histogram( const std::vector<Image> & image );
+        void Histogram( const std::vector<Image> & image, std::vector<std::vector<uint32_t>> & histogram );
+
+        std::vector<Image> Resize( const std::vector<Image> & in, uint32_t widthOut, uint32_t heightOut );
+        void Resize( const std::vector<Image> & in, std::vector<Image> & out );
+
+        std::vector<uint32_t> Sum( const std::vector<Image> & image );
+
+        std::vector<Image> Threshold( const std::vector<Image> & in, uint8_t threshold );
+        void Threshold( const std::vector<Image> & in, std::vector<Image> & out, uint8_t threshold );
+
+        std::vector<Image> Threshold( const std::vector<Image> & in, uint8_t minThreshold, uint8_t maxThreshold );
+        void Threshold( const std::vector<Image> & in, std::vector<Image> & out, uint8_t minThreshold, uint8_t maxThreshold );
+    }
+}
@@ -0,0 +1,728 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "function_pool_graph.h"
+#include "function_pool_async.h"
+#include "function_pool_task.h"
+#include "penguinv/penguinv.h"
+#include "penguinv_exception.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    const size_t noGroup = std::numeric_limits<size_t>::max();
+
+    // Number of pixels which a task must process to cover costs of running it in thread pool
+    const uint32_t minimumTaskArea = 65536u;
+
+    // Size of band-sized images of a task, they must stay in CPU cache between functions of a group
+    const uint32_t bandSize = 128u * 1024u;
+}
+
+namespace Function_Pool
+{
+    Graph::NodeInfo::NodeInfo( Operation operation_ )
+        : operation( operation_ )
+        , group( noGroup )
+        , output( false )
+        , value1( 0 )
+        , value2( 0 )
+        , coefficientA( 1 )
+        , coefficientGamma( 1 )
+        , width( 0 )
+        , height( 0 )
+        , colorCount( 1 )
+        , image( nullptr )
+        , buffer( nullptr )
+        , scratch( 0 )
+        , sum( 0 )
+    {}
+
+    Graph::GroupInfo::GroupInfo()
+        : taskCount( 0 )
+        , bandHeight( 0 )
+    {}
+
+    Graph::Graph() {}
+
+    Graph::Node Graph::input()
+    {
+        return _add( _input, std::vector<Node>() );
+    }
+
+    Graph::Node Graph::absoluteDifference( Node in1, Node in2 )
+    {
+        return _add( _absoluteDifference, { in1, in2 } );
+    }
+
+    Graph::Node Graph::bitwiseAnd( Node in1, Node in2 )
+    {
+        return _add( _bitwiseAnd, { in1, in2 } );
+    }
+
+    Graph::Node Graph::bitwiseOr( Node in1, Node in2 )
+    {
+        return _add( _bitwiseOr, { in1, in2 } );
+    }
+
+    Graph::Node Graph::bitwiseXor( Node in1, Node in2 )
+    {
+        return _add( _bitwiseXor, { in1, in2 } );
+    }
+
+    Graph::Node Graph::convertToGrayScale( Node in )
+    {
+        return _add( _convertToGrayScale, { in } );
+    }
+
+    Graph::Node Graph::convertToRgb( Node in )
+    {
+        return _add( _convertToRgb, { in } );
+    }
+
+    Graph::Node Graph::extractChannel( Node in, uint8_t channelId )
+    {
+        const Node node = _add( _extractChannel, { in } );
+        _node[node].value1 = channelId;
+        return node;
+    }
+
+    Graph::Node Graph::gammaCorrection( Node in, double a, double gamma )
+    {
+        const Node node = _add( _gammaCorrection, { in } );
+        _node[node].coefficientA = a;
+        _node[node].coefficientGamma = gamma;
+        return node;
+    }
+
+    Graph::Node Graph::invert( Node in )
+    {
+        return _add( _invert, { in } );
+    }
+
+    Graph::Node Graph::lookupTable( Node in, const std::vector<uint8_t> & table )
+    {
+        const Node node = _add( _lookupTable, { in } );
+        _node[node].table = table;
+        return node;
+    }
+
+    Graph::Node Graph::maximum( Node in1, Node in2 )
+    {
+        return _add( _maximum, { in1, in2 } );
+    }
+
+    Graph::Node Graph::minimum( Node in1, Node in2 )
+    {
+        return _add( _minimum, { in1, in2 } );
+    }
+
+    Graph::Node Graph::subtract( Node in1, Node in2 )
+    {
+        return _add( _subtract, { in1, in2 } );
+    }
+
+    Graph::Node Graph::threshold( Node in, uint8_t threshold )
+    {
+        const Node node = _add( _threshold, { in } );
+        _node[node].value1 = threshold;
+        return node;
+    }
+
+    Graph::Node Graph::threshold( Node in, uint8_t minThreshold, uint8_t maxThreshold )
+    {
+        if ( minThreshold > maxThreshold )
+            throw penguinVException( "Minimum threshold value is bigger than maximum threshold value" );
+
+        const Node node = _add( _thresholdDouble, { in } );
+        _node[node].value1 = minThreshold;
+        _node[node].value2 = maxThreshold;
+        return node;
+    }
+
+    Graph::Node Graph::histogram( Node image )
+    {
+        return _add( _histogram, { image } );
+    }
+
+    Graph::Node Graph::sum( Node image )
+    {
+        return _add( _sum, { image } );
+    }
+
+    Graph::Node Graph::transform( Node in, const std::function<void( const Image &, Image & )> & function )
+    {
+        if ( !function )
+            throw penguinVException( "Function is not set" );
+
+        const Node node = _add( _transform, { in } );
+        _node[node].transform = function;
+        return node;
+    }
+
+    Graph::Node Graph::process( Node image, const std::function<void( const Image & )> & function )
+    {
+        if ( !function )
+            throw penguinVException( "Function is not set" );
+
+        const Node node = _add( _process, { image } );
+        _node[node].process = function;
+        return node;
+    }
+
+    void Graph::output( Node node )
+    {
+        if ( node >= _node.size() )
+            throw penguinVException( "Graph node does not exist" );
+
+        const Operation operation = _node[node].operation;
+        if ( operation == _input || operation == _histogram || operation == _sum || operation == _process )
+            throw penguinVException( "Only image functions could be outputs of graph" );
+
+        _node[node].output = true;
+    }
+
+    void Graph::run( const Image & in )
+    {
+        run( std::vector<const Image *>( 1u, &in ) );
+    }
+
+    void Graph::run( const std::vector<const Image *> & in )
+    {
+        _prepare( in );
+
+        const std::vector<size_t> order = _groupOrder();
+
+        std::vector<std::shared_ptr<Async::FutureState>> state( _group.size() );
+
+        for ( std::vector<size_t>::const_iterator groupId = order.begin(); groupId != order.end(); ++groupId ) {
+            std::vector<std::shared_ptr<Async::FutureState>> dependency;
+            for ( std::vector<size_t>::const_iterator id = _group[*groupId].dependency.begin(); id != _group[*groupId].dependency.end(); ++id )
+                dependency.push_back( state[*id] );
+
+            state[*groupId].reset( new Async::FutureValue<void> );
+
+            const size_t id = *groupId;
+            Async::Run( dependency, state[id], [this, id]() { _runGroup( id ); } );
+        }
+
+        // all groups must be completed before leaving as they use the graph
+        std::string error;
+        for ( std::vector<std::shared_ptr<Async::FutureState>>::const_iterator groupState = state.begin(); groupState != state.end(); ++groupState ) {
+            try {
+                ( *groupState )->wait();
+            }
+            catch ( const penguinVException & exception ) {
+                if ( error.empty() )
+                    error = exception.what();
+            }
+        }
+
+        if ( !error.empty() )
+            throw penguinVException( error );
+    }
+
+    const Image & Graph::getImage( Node node ) const
+    {
+        const NodeInfo & info = _get( node );
+        if ( !info.output )
+            throw penguinVException( "Graph node is not an output" );
+
+        return info.result;
+    }
+
+    const std::vector<uint32_t> & Graph::getHistogram( Node node ) const
+    {
+        const NodeInfo & info = _get( node );
+        if ( info.operation != _histogram )
+            throw penguinVException( "Graph node is not a histogram" );
+
+        return info.histogram;
+    }
+
+    uint32_t Graph::getSum( Node node ) const
+    {
+        const NodeInfo & info = _get( node );
+        if ( info.operation != _sum )
+            throw penguinVException( "Graph node is not a sum" );
+
+        return info.sum;
+    }
+
+    size_t Graph::bufferCount() const
+    {
+        return _buffer.size();
+    }
+
+    Graph::Node Graph::_add( Operation operation, const std::vector<Node> & input )
+    {
+        for ( std::vector<Node>::const_iterator in = input.begin(); in != input.end(); ++in ) {
+            if ( *in >= _node.size() )
+                throw penguinVException( "Graph node does not exist" );
+
+            const Operation inputOperation = _node[*in].operation;
+            if ( inputOperation == _histogram || inputOperation == _sum || inputOperation == _process )
+                throw penguinVException( "Graph node does not produce an image" );
+        }
+
+        const Node node = _node.size();
+
+        NodeInfo info( operation );
+        info.input = input;
+
+        // a node joins a group of its input if the group does not have to wait for another input which depends on the group
+        if ( _isFusable( operation ) ) {
+            for ( std::vector<Node>::const_iterator in = input.begin(); ( in != input.end() ) && ( info.group == noGroup ); ++in ) {
+                if ( !_isFusable( _node[*in].operation ) )
+                    continue;
+
+                const size_t groupId = _node[*in].group;
+
+                bool noCycle = true;
+                for ( std::vector<Node>::const_iterator other = input.begin(); other != input.end(); ++other ) {
+                    const size_t otherGroupId = _node[*other].group;
+                    if ( otherGroupId != noGroup && otherGroupId != groupId && _dependsOn( otherGroupId, groupId ) )
+                        noCycle = false;
+                }
+
+                if ( noCycle )
+                    info.group = groupId;
+            }
+        }
+
+        if ( operation != _input && info.group == noGroup ) {
+            info.group = _group.size();
+            _group.push_back( GroupInfo() );
+        }
+
+        if ( info.group != noGroup ) {
+            GroupInfo & group = _group[info.group];
+            group.node.push_back( node );
+
+            for ( std::vector<Node>::const_iterator in = input.begin(); in != input.end(); ++in ) {
+                const size_t groupId = _node[*in].group;
+                if ( groupId != noGroup && groupId != info.group && std::find( group.dependency.begin(), group.dependency.end(), groupId ) == group.dependency.end() )
+                    group.dependency.push_back( groupId );
+            }
+        }
+
+        for ( std::vector<Node>::const_iterator in = input.begin(); in != input.end(); ++in )
+            _node[*in].consumer.push_back( node );
+
+        _node.push_back( info );
+
+        return node;
+    }
+
+    bool Graph::_isFusable( Operation operation ) const
+    {
+        return operation != _input && operation != _transform && operation != _process;
+    }
+
+    bool Graph::_dependsOn( size_t group, size_t dependency ) const
+    {
+        const std::vector<size_t> & direct = _group[group].dependency;
+
+        for ( std::vector<size_t>::const_iterator id = direct.begin(); id != direct.end(); ++id ) {
+            if ( *id == dependency || _dependsOn( *id, dependency ) )
+                return true;
+        }
+
+        return false;
+    }
+
+    void Graph::_prepare( const std::vector<const Image *> & in )
+    {
+        size_t inputCount = 0u;
+        for ( std::vector<NodeInfo>::const_iterator info = _node.begin(); info != _node.end(); ++info ) {
+            if ( info->operation == _input )
+                ++inputCount;
+        }
+
+        if ( inputCount == 0u )
+            throw penguinVException( "Graph has no inputs" );
+
+        if ( in.size() != inputCount || std::find( in.begin(), in.end(), nullptr ) != in.end() )
+            throw penguinVException( "Number of images does not match number of graph inputs" );
+
+        // image sizes
+        std::vector<const Image *>::const_iterator image = in.begin();
+
+        for ( std::vector<NodeInfo>::iterator info = _node.begin(); info != _node.end(); ++info ) {
+            info->image = nullptr;
+            info->buffer = nullptr;
+
+            if ( info->operation == _input ) {
+                if ( ( *image )->empty() || ( *image )->type() != in.front()->type() )
+                    throw penguinVException( "Graph input image is empty or has different type" );
+
+                info->width = ( *image )->width();
+                info->height = ( *image )->height();
+                info->colorCount = ( *image )->colorCount();
+                info->image = *image;
+                ++image;
+                continue;
+            }
+
+            const NodeInfo & first = _node[info->input.front()];
+
+            for ( std::vector<Node>::const_iterator id = info->input.begin(); id != info->input.end(); ++id ) {
+                if ( _node[*id].width != first.width || _node[*id].height != first.height || _node[*id].colorCount != first.colorCount )
+                    throw penguinVException( "Input images of graph node have different sizes" );
+            }
+
+            info->width = first.width;
+            info->height = first.height;
+
+            if ( info->operation == _convertToGrayScale || info->operation == _extractChannel )
+                info->colorCount = 1u;
+            else if ( info->operation == _convertToRgb )
+                info->colorCount = 3u;
+            else
+                info->colorCount = first.colorCount;
+        }
+
+        // full-sized images are needed for outputs, for whole image functions and for images used by other groups
+        std::vector<bool> fullSize( _node.size(), false );
+
+        for ( size_t id = 0; id < _node.size(); ++id ) {
+            const NodeInfo & info = _node[id];
+            if ( info.operation == _input || info.operation == _histogram || info.operation == _sum || info.operation == _process )
+                continue;
+
+            fullSize[id] = info.output || info.operation == _transform;
+
+            for ( std::vector<Node>::const_iterator consumer = info.consumer.begin(); consumer != info.consumer.end(); ++consumer ) {
+                if ( _node[*consumer].group != info.group || !_isFusable( _node[*consumer].operation ) )
+                    fullSize[id] = true;
+            }
+        }
+
+        // a buffer could be reused by a group if a group which wrote the buffer and all groups which read it are completed before the group starts
+        const std::vector<size_t> order = _groupOrder();
+
+        std::vector<std::vector<bool>> ancestor( _group.size(), std::vector<bool>( _group.size(), false ) );
+        for ( std::vector<size_t>::const_iterator groupId = order.begin(); groupId != order.end(); ++groupId ) {
+            const std::vector<size_t> & dependency = _group[*groupId].dependency;
+
+            for ( std::vector<size_t>::const_iterator id = dependency.begin(); id != dependency.end(); ++id ) {
+                ancestor[*groupId][*id] = true;
+                for ( size_t i = 0; i < _group.size(); ++i ) {
+                    if ( ancestor[*id][i] )
+                        ancestor[*groupId][i] = true;
+                }
+            }
+        }
+
+        std::vector<Node> bufferOwner( _buffer.size(), std::numeric_limits<Node>::max() );
+        const Image & reference = *in.front();
+
+        for ( std::vector<size_t>::const_iterator groupId = order.begin(); groupId != order.end(); ++groupId ) {
+            const std::vector<Node> & groupNode = _group[*groupId].node;
+
+            for ( std::vector<Node>::const_iterator id = groupNode.begin(); id != groupNode.end(); ++id ) {
+                NodeInfo & info = _node[*id];
+                if ( !fullSize[*id] )
+                    continue;
+
+                if ( info.output ) {
+                    if ( info.result.width() != info.width || info.result.height() != info.height || info.result.colorCount() != info.colorCount
+                         || info.result.type() != reference.type() )
+                        info.result = reference.generate( info.width, info.height, info.colorCount );
+
+                    info.buffer = &info.result;
+                    info.image = &info.result;
+                    continue;
+                }
+
+                size_t bufferId = _buffer.size();
+
+                for ( size_t i = 0; i < _buffer.size() && bufferId == _buffer.size(); ++i ) {
+                    const Image & buffer = *_buffer[i];
+                    const bool sameSize = buffer.width() == info.width && buffer.height() == info.height && buffer.colorCount() == info.colorCount
+                                          && buffer.type() == reference.type();
+
+                    if ( bufferOwner[i] == std::numeric_limits<Node>::max() ) {
+                        if ( sameSize )
+                            bufferId = i;
+                        continue;
+                    }
+
+                    const NodeInfo & owner = _node[bufferOwner[i]];
+                    bool released = sameSize && ancestor[*groupId][owner.group];
+
+                    for ( std::vector<Node>::const_iterator consumer = owner.consumer.begin(); consumer != owner.consumer.end() && released; ++consumer )
+                        released = ancestor[*groupId][_node[*consumer].group];
+
+                    if ( released )
+                        bufferId = i;
+                }
+
+                // a buffer of another size which is not used in this run is resized instead of allocating a new one
+                for ( size_t i = 0; i < _buffer.size() && bufferId == _buffer.size(); ++i ) {
+                    if ( bufferOwner[i] == std::numeric_limits<Node>::max() ) {
+                        *_buffer[i] = reference.generate( info.width, info.height, info.colorCount );
+                        bufferId = i;
+                    }
+                }
+
+                if ( bufferId == _buffer.size() ) {
+                    _buffer.push_back( std::unique_ptr<Image>( new Image( reference.generate( info.width, info.height, info.colorCount ) ) ) );
+                    bufferOwner.push_back( std::numeric_limits<Node>::max() );
+                }
+
+                bufferOwner[bufferId] = *id;
+                info.buffer = _buffer[bufferId].get();
+                info.image = info.buffer;
+            }
+        }
+
+        // band-sized images are reused inside a group when all functions reading them are done
+        for ( std::vector<GroupInfo>::iterator group = _group.begin(); group != _group.end(); ++group ) {
+            group->scratch.clear();
+            std::vector<Node> lastUse;
+
+            for ( std::vector<Node>::const_iterator id = group->node.begin(); id != group->node.end(); ++id ) {
+                NodeInfo & info = _node[*id];
+                if ( fullSize[*id] || info.operation == _histogram || info.operation == _sum || info.operation == _process )
+                    continue;
+
+                size_t scratchId = group->scratch.size();
+                for ( size_t i = 0; i < group->scratch.size() && scratchId == group->scratch.size(); ++i ) {
+                    if ( group->scratch[i] == info.colorCount && lastUse[i] < *id )
+                        scratchId = i;
+                }
+
+                if ( scratchId == group->scratch.size() ) {
+                    group->scratch.push_back( info.colorCount );
+                    lastUse.push_back( 0u );
+                }
+
+                info.scratch = scratchId;
+                lastUse[scratchId] = info.consumer.empty() ? *id : *std::max_element( info.consumer.begin(), info.consumer.end() );
+            }
+
+            const NodeInfo & first = _node[group->node.front()];
+            if ( !_isFusable( first.operation ) ) {
+                group->taskCount = 0u;
+                group->taskScratch.clear();
+                continue;
+            }
+
+            // rows are split between tasks and every task processes its rows by bands fitting into CPU cache
+            const size_t maximumTaskCount = std::max<size_t>( ThreadPoolMonoid::instance().threadCount() * 4u, 1u );
+            const size_t areaTaskCount = std::max<size_t>( ( static_cast<size_t>( first.width ) * first.height ) / minimumTaskArea, 1u );
+            group->taskCount = static_cast<uint32_t>( std::min<size_t>( std::min( maximumTaskCount, areaTaskCount ), first.height ) );
+
+            uint32_t scratchRowSize = 0u;
+            for ( std::vector<uint8_t>::const_iterator colorCount = group->scratch.begin(); colorCount != group->scratch.end(); ++colorCount )
+                scratchRowSize += first.width * ( *colorCount );
+
+            group->bandHeight = std::max( bandSize / std::max( scratchRowSize, 1u ), 1u );
+
+            // band-sized images are generated again only when their size or type is changed
+            const uint32_t scratchHeight = std::min( group->bandHeight, ( first.height + group->taskCount - 1u ) / group->taskCount );
+
+            group->taskScratch.resize( group->taskCount );
+            for ( std::vector<std::vector<Image>>::iterator scratch = group->taskScratch.begin(); scratch != group->taskScratch.end(); ++scratch ) {
+                scratch->resize( group->scratch.size() );
+
+                for ( size_t i = 0; i < group->scratch.size(); ++i ) {
+                    Image & image = ( *scratch )[i];
+                    if ( image.width() != first.width || image.height() != scratchHeight || image.colorCount() != group->scratch[i] || image.type() != reference.type() )
+                        image = reference.generate( first.width, scratchHeight, group->scratch[i] );
+                }
+            }
+        }
+    }
+
+    std::vector<size_t> Graph::_groupOrder() const
+    {
+        std::vector<size_t> order;
+        std::vector<bool> added( _group.size(), false );
+
+        while ( order.size() < _group.size() ) {
+            for ( size_t id = 0; id < _group.size(); ++id ) {
+                if ( added[id] )
+                    continue;
+
+                const std::vector<size_t> & dependency = _group[id].dependency;
+                bool ready = true;
+                for ( std::vector<size_t>::const_iterator dependencyId = dependency.begin(); dependencyId != dependency.end(); ++dependencyId )
+                    ready = ready && added[*dependencyId];
+
+                if ( ready ) {
+                    order.push_back( id );
+                    added[id] = true;
+                }
+            }
+        }
+
+        return order;
+    }
+
+    void Graph::_runGroup( size_t groupId )
+    {
+        GroupInfo & group = _group[groupId];
+        NodeInfo & first = _node[group.node.front()];
+
+        if ( first.operation == _transform ) {
+            first.transform( *_node[first.input.front()].image, *first.buffer );
+            return;
+        }
+
+        if ( first.operation == _process ) {
+            first.process( *_node[first.input.front()].image );
+            return;
+        }
+
+        const uint32_t height = first.height;
+        const uint32_t taskCount = group.taskCount;
+        const uint32_t bandHeight = group.bandHeight;
+
+        std::vector<std::vector<std::vector<uint32_t>>> histogram( taskCount, std::vector<std::vector<uint32_t>>( group.node.size() ) );
+        std::vector<std::vector<uint32_t>> sum( taskCount, std::vector<uint32_t>( group.node.size(), 0u ) );
+
+        IndexedTask( [&]( size_t taskId ) {
+            const uint32_t startY = static_cast<uint32_t>( height * taskId / taskCount );
+            const uint32_t endY = static_cast<uint32_t>( height * ( taskId + 1u ) / taskCount );
+
+            for ( uint32_t y = startY; y < endY; y += bandHeight )
+                _runBand( group, group.taskScratch[taskId], y, std::min( bandHeight, endY - y ), histogram[taskId], sum[taskId] );
+        }, "An error occured during task execution in graph" ).process( taskCount );
+
+        for ( size_t i = 0; i < group.node.size(); ++i ) {
+            NodeInfo & info = _node[group.node[i]];
+
+            if ( info.operation == _histogram ) {
+                info.histogram = histogram.front()[i];
+                for ( uint32_t taskId = 1u; taskId < taskCount; ++taskId ) {
+                    for ( size_t value = 0; value < info.histogram.size(); ++value )
+                        info.histogram[value] += histogram[taskId][i][value];
+                }
+            }
+            else if ( info.operation == _sum ) {
+                info.sum = 0u;
+                for ( uint32_t taskId = 0u; taskId < taskCount; ++taskId )
+                    info.sum += sum[taskId][i];
+            }
+        }
+    }
+
+    void Graph::_runBand( const GroupInfo & group, std::vector<Image> & scratch, uint32_t y, uint32_t height, std::vector<std::vector<uint32_t>> & histogram,
+                          std::vector<uint32_t> & sum ) const
+    {
+        for ( size_t i = 0; i < group.node.size(); ++i ) {
+            const NodeInfo & info = _node[group.node[i]];
+            const uint32_t width = info.width;
+
+            // full-sized images are accessed at band position while band-sized images start from the top
+            const NodeInfo & input1 = _node[info.input.front()];
+            const Image & in1 = ( input1.image != nullptr ) ? *input1.image : scratch[input1.scratch];
+            const uint32_t y1 = ( input1.image != nullptr ) ? y : 0u;
+
+            const NodeInfo & input2 = _node[info.input.back()];
+            const Image & in2 = ( input2.image != nullptr ) ? *input2.image : scratch[input2.scratch];
+            const uint32_t y2 = ( input2.image != nullptr ) ? y : 0u;
+
+            if ( info.operation == _histogram ) {
+                std::vector<uint32_t> bandHistogram;
+                penguinV::Histogram( in1, 0, y1, width, height, bandHistogram );
+
+                if ( histogram[i].empty() ) {
+                    histogram[i] = bandHistogram;
+                }
+                else {
+                    for ( size_t value = 0; value < bandHistogram.size(); ++value )
+                        histogram[i][value] += bandHistogram[value];
+                }
+                continue;
+            }
+
+            if ( info.operation == _sum ) {
+                sum[i] += penguinV::Sum( in1, 0, y1, width, height );
+                continue;
+            }
+
+            Image & out = ( info.buffer != nullptr ) ? *info.buffer : scratch[info.scratch];
+            const uint32_t yOut = ( info.buffer != nullptr ) ? y : 0u;
+
+            switch ( info.operation ) {
+            case _absoluteDifference:
+                penguinV::AbsoluteDifference( in1, 0, y1, in2, 0, y2, out, 0, yOut, width, height );
+                break;
+            case _bitwiseAnd:
+                penguinV::BitwiseAnd( in1, 0, y1, in2, 0, y2, out, 0, yOut, width, height );
+                break;
+            case _bitwiseOr:
+                penguinV::BitwiseOr( in1, 0, y1, in2, 0, y2, out, 0, yOut, width, height );
+                break;
+            case _bitwiseXor:
+                penguinV::BitwiseXor( in1, 0, y1, in2, 0, y2, out, 0, yOut, width, height );
+                break;
+            case _convertToGrayScale:
+                penguinV::ConvertToGrayScale( in1, 0, y1, out, 0, yOut, width, height );
+                break;
+            case _convertToRgb:
+                penguinV::ConvertToRgb( in1, 0, y1, out, 0, yOut, width, height );
+                break;
+            case _extractChannel:
+                penguinV::ExtractChannel( in1, 0, y1, out, 0, yOut, width, height, info.value1 );
+                break;
+            case _gammaCorrection:
+                penguinV::GammaCorrection( in1, 0, y1, out, 0, yOut, width, height, info.coefficientA, info.coefficientGamma );
+                break;
+            case _invert:
+                penguinV::Invert( in1, 0, y1, out, 0, yOut, width, height );
+                break;
+            case _lookupTable:
+                penguinV::LookupTable( in1, 0, y1, out, 0, yOut, width, height, info.table );
+                break;
+            case _maximum:
+                penguinV::Maximum( in1, 0, y1, in2, 0, y2, out, 0, yOut, width, height );
+                break;
+            case _minimum:
+                penguinV::Minimum( in1, 0, y1, in2, 0, y2, out, 0, yOut, width, height );
+                break;
+            case _subtract:
+                penguinV::Subtract( in1, 0, y1, in2, 0, y2, out, 0, yOut, width, height );
+                break;
+            case _threshold:
+                penguinV::Threshold( in1, 0, y1, out, 0, yOut, width, height, info.value1 );
+                break;
+            case _thresholdDouble:
+                penguinV::Threshold( in1, 0, y1, out, 0, yOut, width, height, info.value1, info.value2 );
+                break;
+            default:
+                throw penguinVException( "Wrong graph node type" );
+            }
+        }
+    }
+
+    const Graph::NodeInfo & Graph::_get( Node node ) const
+    {
+        if ( node >= _node.size() )
+            throw penguinVException( "Graph node does not exist" );
+
+        return _node[node];
+    }
+}
@@ -0,0 +1,175 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include "image_buffer.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Function_Pool
+{
+    using namespace penguinV;
+
+    // Dataflow graph of image functions: nodes are functions and edges are images. The graph is described once and run for every frame.
+    // Chains of point-wise functions and reductions are fused into groups, every group is processed in one pass over bands of rows
+    // so intermediate images of a group exist only as small band-sized images staying in CPU cache. Groups which do not depend
+    // on each other run concurrently in thread pool. Full-sized intermediate images are reused between groups according to their
+    // lifetime and between runs. Functions are called through penguinV dispatching so any registered function table is used
+    class Graph
+    {
+    public:
+        typedef size_t Node; // ID of a node
+
+        Graph();
+
+        // image passed to run() function, inputs are numbered in order of creation
+        Node input();
+
+        // point-wise functions, they are fused with functions producing their inputs
+        Node absoluteDifference( Node in1, Node in2 );
+        Node bitwiseAnd( Node in1, Node in2 );
+        Node bitwiseOr( Node in1, Node in2 );
+        Node bitwiseXor( Node in1, Node in2 );
+        Node convertToGrayScale( Node in );
+        Node convertToRgb( Node in );
+        Node extractChannel( Node in, uint8_t channelId );
+        Node gammaCorrection( Node in, double a, double gamma );
+        Node invert( Node in );
+        Node lookupTable( Node in, const std::vector<uint8_t> & table );
+        Node maximum( Node in1, Node in2 );
+        Node minimum( Node in1, Node in2 );
+        Node subtract( Node in1, Node in2 );
+        Node threshold( Node in, uint8_t threshold );
+        Node threshold( Node in, uint8_t minThreshold, uint8_t maxThreshold );
+
+        // reductions are computed in the same pass as functions producing their input
+        Node histogram( Node image );
+        Node sum( Node image );
+
+        // function processing the whole image into an image of the same size, for example Function_Pool::Median()
+        Node transform( Node in, const std::function<void( const Image &, Image & )> & function );
+
+        // function processing the whole image without producing an image, for example blob detection
+        Node process( Node image, const std::function<void( const Image & )> & function );
+
+        // image of the node is kept after run() function and could be taken by getImage() function
+        void output( Node node );
+
+        // runs the graph in thread pool selected by ThreadPoolMonoid class. All images must have the same type
+        void run( const Image & in );
+        void run( const std::vector<const Image *> & in );
+
+        // results of the last run
+        const Image & getImage( Node node ) const;
+        const std::vector<uint32_t> & getHistogram( Node node ) const;
+        uint32_t getSum( Node node ) const;
+
+        size_t bufferCount() const; // number of full-sized intermediate images allocated by the graph
+    private:
+        enum Operation
+        {
+            _input,
+            _absoluteDifference,
+            _bitwiseAnd,
+            _bitwiseOr,
+            _bitwiseXor,
+            _convertToGrayScale,
+            _convertToRgb,
+            _extractChannel,
+            _gammaCorrection,
+            _invert,
+            _lookupTable,
+            _maximum,
+            _minimum,
+            _subtract,
+            _threshold,
+            _thresholdDouble,
+            _histogram,
+            _sum,
+            _transform,
+            _process
+        };
+
+        struct NodeInfo
+        {
+            explicit NodeInfo( Operation operation_ );
+
+            Operation operation;
+            std::vector<Node> input;
+            std::vector<Node> consumer;
+            size_t group; // group of fused nodes, graph inputs do not belong to any group
+            bool output;
+
+            // function parameters
+            uint8_t value1;
+            uint8_t value2;
+            double coefficientA;
+            double coefficientGamma;
+            std::vector<uint8_t> table;
+            std::function<void( const Image &, Image & )> transform;
+            std::function<void( const Image & )> process;
+
+            // parameters calculated for every run
+            uint32_t width;
+            uint32_t height;
+            uint8_t colorCount;
+            const Image * image; // full-sized image of the node, nullptr if the node exists only in bands of its group
+            Image * buffer; // full-sized image written by the node
+            size_t scratch; // ID of band-sized image for nodes existing only in bands
+
+            // results
+            Image result;
+            std::vector<uint32_t> histogram;
+            uint32_t sum;
+        };
+
+        struct GroupInfo
+        {
+            GroupInfo();
+
+            std::vector<Node> node; // nodes of the group in order of execution
+            std::vector<size_t> dependency; // groups which must be completed before this group
+            std::vector<uint8_t> scratch; // color count of band-sized images
+
+            // parameters calculated for every run
+            uint32_t taskCount; // number of tasks sharing rows of the group
+            uint32_t bandHeight; // number of rows processed by a task at once
+            std::vector<std::vector<Image>> taskScratch; // band-sized images of every task, they are kept between runs
+        };
+
+        std::vector<NodeInfo> _node;
+        std::vector<GroupInfo> _group;
+        std::vector<std::unique_ptr<Image>> _buffer; // full-sized intermediate images
+
+        Node _add( Operation operation, const std::vector<Node> & input );
+        bool _isFusable( Operation operation ) const;
+        bool _dependsOn( size_t group, size_t dependency ) const;
+
+        void _prepare( const std::vector<const Image *> & in ); // calculates image sizes, places images into buffers and bands, splits rows between tasks
+        std::vector<size_t> _groupOrder() const; // groups in order of their dependencies
+        void _runGroup( size_t groupId );
+        void _runBand( const GroupInfo & group, std::vector<Image> & scratch, uint32_t y, uint32_t height, std::vector<std::vector<uint32_t>> & histogram,
+                       std::vector<uint32_t> & sum ) const;
+
+        const NodeInfo & _get( Node node ) const;
+    };
+}
@@ -20,26 +20,43 @@
 
 #include "function_pool_task.h"
 #include "parameter_validation.h"
+#include <algorithm>
 
 namespace
 {
-    uint32_t threadCount()
+    // Maximum number of tasks for an image ROI. Big images are split into more tasks than threads so threads which complete their tasks earlier
+    // take remaining tasks instead of waiting for the slowest thread
+    uint32_t taskCount()
     {
         const uint32_t count = static_cast<uint32_t>( ThreadPoolMonoid::instance().threadCount() );
         if ( count == 0 )
             throw penguinVException( "Thread Pool is not initialized." );
-        return count;
+        return ( count > 1u ) ? count * 4u : 1u;
     }
 
-    const uint32_t cacheSize = 16; // Remember: every CPU has it's own caching technique so processing time of subsequent memory cells is much faster!
-                                   // Change this value if you need to adjust to specific CPU. 16 bytes are set for proper SSE/NEON support
+    const uint32_t minimumTaskWidth = 64; // tasks narrower than a cache line in bytes would share cache lines with neighbour tasks
+
+    // start and size of a part of an axis which is split into equal parts
+    uint32_t partStart( uint32_t start, uint32_t size, uint32_t count, uint32_t id )
+    {
+        return start + id * ( size / count ) + std::min( id, size % count );
+    }
+
+    uint32_t partSize( uint32_t size, uint32_t count, uint32_t id )
+    {
+        return size / count + ( ( id < size % count ) ? 1u : 0u );
+    }
 }
 
 namespace Function_Pool
 {
-    AreaInfo::AreaInfo( uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count )
+    AreaInfo::AreaInfo( uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count, uint32_t minimumArea, uint32_t minimumWidth,
+                        uint32_t minimumHeight )
+        : columnCount( 0 )
+        , rowCount( 0 )
+        , columnOrder( false )
     {
-        _calculate( x, y, width_, height_, count );
+        _calculate( x, y, width_, height_, count, minimumArea, minimumWidth, minimumHeight );
     }
 
     size_t AreaInfo::_size() const
@@ -49,90 +66,76 @@ namespace Function_Pool
 
     void AreaInfo::_copy( const AreaInfo & info, uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, bool oppositeAxis )
     {
+        // tasks of transposed area are ordered column by column so task IDs of both areas point to the same (transposed) tiles
         if ( info._size() > 0 ) {
-            bool yAxis = true;
-
-            for ( size_t i = 0; i < info._size() - 1; ++i ) {
-                if ( info.startX[i] != info.startX[i + 1] || info.width[i] != info.width[i + 1] ) {
-                    yAxis = false;
-                    break;
-                }
-            }
-
-            _fill( x, y, width_, height_, static_cast<uint32_t>( info._size() ), oppositeAxis ? !yAxis : yAxis );
+            if ( oppositeAxis )
+                _fill( x, y, width_, height_, info.rowCount, info.columnCount, !info.columnOrder );
+            else
+                _fill( x, y, width_, height_, info.columnCount, info.rowCount, info.columnOrder );
         }
     }
 
-    void AreaInfo::_calculate( uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count )
+    void AreaInfo::_calculate( uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count, uint32_t minimumArea, uint32_t minimumWidth,
+                               uint32_t minimumHeight )
     {
-        uint32_t maximumXTaskCount = width_ / cacheSize;
-        if ( maximumXTaskCount == 0 )
-            maximumXTaskCount = 1;
-        if ( maximumXTaskCount > count )
-            maximumXTaskCount = count;
+        // small tasks cost more to run in thread pool than they save
+        const uint64_t maximumTaskCount = ( static_cast<uint64_t>( width_ ) * height_ ) / std::max( minimumArea, 1u );
+        const uint32_t taskCount = static_cast<uint32_t>( std::max<uint64_t>( std::min<uint64_t>( maximumTaskCount, count ), 1u ) );
 
-        const uint32_t maximumYTaskCount = ( height_ > count ) ? count : height_;
+        // split by rows is preferred as every task processes continuous memory
+        const uint32_t rowCount_ = std::min( taskCount, std::max( height_ / std::max( minimumHeight, 1u ), 1u ) );
+        uint32_t columnCount_ = 1u;
 
-        count = ( maximumYTaskCount >= maximumXTaskCount ) ? maximumYTaskCount : maximumXTaskCount;
+        if ( rowCount_ < taskCount ) {
+            const uint32_t maximumColumnCount = std::max( width_ / std::max( minimumTaskWidth, minimumWidth ), 1u );
+            columnCount_ = std::min( ( taskCount + rowCount_ - 1u ) / rowCount_, maximumColumnCount );
+        }
 
-        _fill( x, y, width_, height_, count, maximumYTaskCount >= maximumXTaskCount );
+        _fill( x, y, width_, height_, columnCount_, rowCount_, false );
     }
 
-    void AreaInfo::_fill( uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count, bool yAxis )
+    void AreaInfo::_fill( uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t columnCount_, uint32_t rowCount_, bool columnOrder_ )
     {
+        columnCount = columnCount_;
+        rowCount = rowCount_;
+        columnOrder = columnOrder_;
+
+        const size_t count = static_cast<size_t>( columnCount ) * rowCount;
+
         startX.resize( count );
         startY.resize( count );
         width.resize( count );
         height.resize( count );
 
-        if ( yAxis ) { // process by rows
-            std::fill( startX.begin(), startX.end(), x );
-            std::fill( width.begin(), width.end(), width_ );
-
-            uint32_t remainValue = height_ % count;
-            uint32_t previousValue = y;
-
-            for ( size_t i = 0; i < count; ++i ) {
-                height[i] = height_ / count;
-                if ( remainValue > 0 ) {
-                    --remainValue;
-                    ++height[i];
-                }
-                startY[i] = previousValue;
-                previousValue = startY[i] + height[i];
-            }
-        }
-        else { // process by columns
-            std::fill( startY.begin(), startY.end(), y );
-            std::fill( height.begin(), height.end(), height_ );
-
-            uint32_t remainValue = width_ % count;
-            uint32_t previousValue = x;
-
-            for ( size_t i = 0; i < count; ++i ) {
-                width[i] = width_ / count;
-                if ( remainValue > 0 ) {
-                    --remainValue;
-                    ++width[i];
-                }
-                startX[i] = previousValue;
-                previousValue = startX[i] + width[i];
+        for ( uint32_t row = 0; row < rowCount; ++row ) {
+            for ( uint32_t column = 0; column < columnCount; ++column ) {
+                const size_t id = columnOrder ? static_cast<size_t>( column ) * rowCount + row : static_cast<size_t>( row ) * columnCount + column;
+
+                startX[id] = partStart( x, width_, columnCount, column );
+                startY[id] = partStart( y, height_, rowCount, row );
+                width[id] = partSize( width_, columnCount, column );
+                height[id] = partSize( height_, rowCount, row );
             }
         }
     }
 
-    InputImageInfo::InputImageInfo( const Image & in, uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count )
-        : AreaInfo( x, y, width_, height_, count )
+    InputImageInfo::InputImageInfo( const Image & in, uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count, uint32_t minimumArea,
+                                    uint32_t minimumWidth, uint32_t minimumHeight )
+        : AreaInfo( x, y, width_, height_, count, minimumArea, minimumWidth, minimumHeight )
         , image( in )
     {}
 
-    OutputImageInfo::OutputImageInfo( Image & in, uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count )
-        : AreaInfo( x, y, width_, height_, count )
+    OutputImageInfo::OutputImageInfo( Image & in, uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count, uint32_t minimumArea,
+                                      uint32_t minimumWidth, uint32_t minimumHeight )
+        : AreaInfo( x, y, width_, height_, count, minimumArea, minimumWidth, minimumHeight )
         , image( in )
     {}
 
-    FunctionPoolTask::FunctionPoolTask() {}
-
+    FunctionPoolTask::FunctionPoolTask()
+        : _minimumTaskArea( 1u )
+        , _minimumTaskWidth( 1u )
+        , _minimumTaskHeight( 1u )
+    {}
     FunctionPoolTask::~FunctionPoolTask() {}
 
     void FunctionPoolTask::_setup( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height )
@@ -141,7 +144,17 @@ namespace Function_Pool
 
         Image_Function::ValidateImageParameters( image, x, y, width, height );
 
-        _infoIn1 = std::unique_ptr<InputImageInfo>( new InputImageInfo( image, x, y, width, height, threadCount() ) );
+        _infoIn1 = _inputInfo( image, x, y, width, height );
+    }
+
+    void FunctionPoolTask::_setup( Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height )
+    {
+        _validateTask();
+
+        Image_Function::ValidateImageParameters( image, x, y, width, height );
+
+        _infoIn1 = _inputInfo( image, x, y, width, height );
+        _infoOut1 = _outputInfo( image, x, y, width, height );
     }
 
     void FunctionPoolTask::_setup( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width,
@@ -151,8 +164,8 @@ namespace Function_Pool
 
         Image_Function::ValidateImageParameters( in1, startX1, startY1, in2, startX2, startY2, width, height );
 
-        _infoIn1 = std::unique_ptr<InputImageInfo>( new InputImageInfo( in1, startX1, startY1, width, height, threadCount() ) );
-        _infoIn2 = std::unique_ptr<InputImageInfo>( new InputImageInfo( in2, startX2, startY2, width, height, threadCount() ) );
+        _infoIn1 = _inputInfo( in1, startX1, startY1, width, height );
+        _infoIn2 = _inputInfo( in2, startX2, startY2, width, height );
     }
 
     void FunctionPoolTask::_setup( const Image & in, uint32_t inX, uint32_t inY, Image & out, uint32_t outX, uint32_t outY, uint32_t width, uint32_t height )
@@ -161,8 +174,8 @@ namespace Function_Pool
 
         Image_Function::ValidateImageParameters( in, inX, inY, out, outX, outY, width, height );
 
-        _infoIn1 = std::unique_ptr<InputImageInfo>( new InputImageInfo( in, inX, inY, width, height, threadCount() ) );
-        _infoOut1 = std::unique_ptr<OutputImageInfo>( new OutputImageInfo( out, outX, outY, width, height, threadCount() ) );
+        _infoIn1 = _inputInfo( in, inX, inY, width, height );
+        _infoOut1 = _outputInfo( out, outX, outY, width, height );
     }
 
     void FunctionPoolTask::_setup( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t widthIn, uint32_t heightIn, Image & out, uint32_t startXOut,
@@ -173,9 +186,8 @@ namespace Function_Pool
         Image_Function::ValidateImageParameters( in, startXIn, startYIn, widthIn, heightIn );
         Image_Function::ValidateImageParameters( out, startXOut, startYOut, widthOut, heightOut );
 
-        _infoIn1 = std::unique_ptr<InputImageInfo>(
-            new InputImageInfo( in, startXIn, startYIn, std::min( widthIn, widthOut ), std::min( heightIn, heightOut ), threadCount() ) );
-        _infoOut1 = std::unique_ptr<OutputImageInfo>( new OutputImageInfo( out, startXOut, startYOut, widthOut, heightOut, threadCount() ) );
+        _infoIn1 = _inputInfo( in, startXIn, startYIn, std::min( widthIn, widthOut ), std::min( heightIn, heightOut ) );
+        _infoOut1 = _outputInfo( out, startXOut, startYOut, widthOut, heightOut );
 
         _infoOut1->_copy( *_infoIn1, startXOut, startYOut, widthOut, heightOut, oppositeAxis );
         _infoIn1->_copy( *_infoOut1, startXIn, startYIn, widthIn, heightIn, oppositeAxis );
@@ -188,9 +200,9 @@ namespace Function_Pool
 
         Image_Function::ValidateImageParameters( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
 
-        _infoIn1 = std::unique_ptr<InputImageInfo>( new InputImageInfo( in1, startX1, startY1, width, height, threadCount() ) );
-        _infoIn2 = std::unique_ptr<InputImageInfo>( new InputImageInfo( in2, startX2, startY2, width, height, threadCount() ) );
-        _infoOut1 = std::unique_ptr<OutputImageInfo>( new OutputImageInfo( out, startXOut, startYOut, width, height, threadCount() ) );
+        _infoIn1 = _inputInfo( in1, startX1, startY1, width, height );
+        _infoIn2 = _inputInfo( in2, startX2, startY2, width, height );
+        _infoOut1 = _outputInfo( out, startXOut, startYOut, width, height );
     }
 
     void FunctionPoolTask::_setup( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out1, uint32_t startXOut1, uint32_t startYOut1, Image & out2,
@@ -201,10 +213,10 @@ namespace Function_Pool
         Image_Function::ValidateImageParameters( in, startXIn, startYIn, out1, startXOut1, startYOut1, out2, startXOut2, startYOut2, width, height );
         Image_Function::ValidateImageParameters( in, startXIn, startYIn, out3, startXOut3, startYOut3, width, height );
 
-        _infoIn1 = std::unique_ptr<InputImageInfo>( new InputImageInfo( in, startXIn, startYIn, width, height, threadCount() ) );
-        _infoOut1 = std::unique_ptr<OutputImageInfo>( new OutputImageInfo( out1, startXOut1, startYOut1, width, height, threadCount() ) );
-        _infoOut2 = std::unique_ptr<OutputImageInfo>( new OutputImageInfo( out2, startXOut2, startYOut2, width, height, threadCount() ) );
-        _infoOut3 = std::unique_ptr<OutputImageInfo>( new OutputImageInfo( out3, startXOut3, startYOut3, width, height, threadCount() ) );
+        _infoIn1 = _inputInfo( in, startXIn, startYIn, width, height );
+        _infoOut1 = _outputInfo( out1, startXOut1, startYOut1, width, height );
+        _infoOut2 = _outputInfo( out2, startXOut2, startYOut2, width, height );
+        _infoOut3 = _outputInfo( out3, startXOut3, startYOut3, width, height );
     }
 
     void FunctionPoolTask::_setup( const Image & in1, uint32_t startXIn1, uint32_t startYIn1, const Image & in2, uint32_t startXIn2, uint32_t startYIn2,
@@ -216,15 +228,37 @@ namespace Function_Pool
         Image_Function::ValidateImageParameters( in1, startXIn1, startYIn1, in2, startXIn2, startYIn2, in3, startXIn3, startYIn3, width, height );
         Image_Function::ValidateImageParameters( in1, startXIn1, startYIn1, out, startXOut, startYOut, width, height );
 
-        _infoIn1 = std::unique_ptr<InputImageInfo>( new InputImageInfo( in1, startXIn1, startYIn1, width, height, threadCount() ) );
-        _infoIn2 = std::unique_ptr<InputImageInfo>( new InputImageInfo( in2, startXIn2, startYIn2, width, height, threadCount() ) );
-        _infoIn3 = std::unique_ptr<InputImageInfo>( new InputImageInfo( in3, startXIn3, startYIn3, width, height, threadCount() ) );
-        _infoOut1 = std::unique_ptr<OutputImageInfo>( new OutputImageInfo( out, startXOut, startYOut, width, height, threadCount() ) );
+        _infoIn1 = _inputInfo( in1, startXIn1, startYIn1, width, height );
+        _infoIn2 = _inputInfo( in2, startXIn2, startYIn2, width, height );
+        _infoIn3 = _inputInfo( in3, startXIn3, startYIn3, width, height );
+        _infoOut1 = _outputInfo( out, startXOut, startYOut, width, height );
+    }
+
+    std::unique_ptr<InputImageInfo> FunctionPoolTask::_inputInfo( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height ) const
+    {
+        return std::unique_ptr<InputImageInfo>(
+            new InputImageInfo( image, x, y, width, height, taskCount(), _minimumTaskArea, _minimumTaskWidth, _minimumTaskHeight ) );
+    }
+
+    std::unique_ptr<OutputImageInfo> FunctionPoolTask::_outputInfo( Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height ) const
+    {
+        return std::unique_ptr<OutputImageInfo>(
+            new OutputImageInfo( image, x, y, width, height, taskCount(), _minimumTaskArea, _minimumTaskWidth, _minimumTaskHeight ) );
     }
 
     void FunctionPoolTask::_processTask()
     {
-        _run( _infoIn1->_size() );
+        const size_t taskCount = _infoIn1->_size();
+
+        if ( taskCount == 0u )
+            return;
+
+        if ( taskCount == 1u ) {
+            _task( 0u );
+            return;
+        }
+
+        _run( taskCount );
 
         if ( !_wait() )
             throw penguinVException( "An error occured during task execution in function pool" );
@@ -235,4 +269,32 @@ namespace Function_Pool
         if ( !_ready() )
             throw penguinVException( "FunctionPoolTask object was called multiple times!" );
     }
+
+    IndexedTask::IndexedTask( const std::function<void( size_t )> & function, const char * errorMessage )
+        : _function( function )
+        , _errorMessage( errorMessage )
+    {}
+
+    IndexedTask::~IndexedTask() {}
+
+    void IndexedTask::process( size_t taskCount )
+    {
+        if ( taskCount == 0u )
+            return;
+
+        if ( taskCount == 1u ) {
+            _function( 0u );
+            return;
+        }
+
+        _run( taskCount );
+
+        if ( !_wait() )
+            throw penguinVException( _errorMessage );
+    }
+
+    void IndexedTask::_task( size_t taskId )
+    {
+        _function( taskId );
+    }
 }
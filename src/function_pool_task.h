@@ -22,21 +22,30 @@
 
 #include "image_buffer.h"
 #include "thread_pool.h"
+#include <functional>
 #include <vector>
 
 namespace Function_Pool
 {
     using namespace penguinV;
 
+    // Image ROI split into tasks. The ROI is split by rows and when there are not enough rows for all tasks into 2D tiles
     struct AreaInfo
     {
-        AreaInfo( uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count );
+        // count is the maximum number of tasks, every task processes at least minimumArea pixels (the whole ROI in one task if it is smaller)
+        // and is not smaller than minimumWidth x minimumHeight pixels which is needed for functions using neighbour pixels
+        AreaInfo( uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count, uint32_t minimumArea = 1u, uint32_t minimumWidth = 1u,
+                  uint32_t minimumHeight = 1u );
 
         std::vector<uint32_t> startX; // start X position of image ROI
         std::vector<uint32_t> startY; // start Y position of image ROI
         std::vector<uint32_t> width; // width of image ROI
         std::vector<uint32_t> height; // height of image ROI
 
+        uint32_t columnCount; // number of tasks along X axis
+        uint32_t rowCount; // number of tasks along Y axis
+        bool columnOrder; // tasks are ordered column by column instead of row by row
+
         size_t _size() const;
 
         // makes a similar input data sorting like it is done in info parameter
@@ -44,22 +53,25 @@ namespace Function_Pool
 
     private:
         // sorts out all input data into arrays for multithreading execution
-        void _calculate( uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count );
+        void _calculate( uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count, uint32_t minimumArea, uint32_t minimumWidth,
+                         uint32_t minimumHeight );
 
         // fills all arrays by necessary values
-        void _fill( uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count, bool yAxis );
+        void _fill( uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t columnCount_, uint32_t rowCount_, bool columnOrder_ );
     };
 
     struct InputImageInfo : public AreaInfo
     {
-        InputImageInfo( const Image & in, uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count );
+        InputImageInfo( const Image & in, uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count, uint32_t minimumArea = 1u,
+                        uint32_t minimumWidth = 1u, uint32_t minimumHeight = 1u );
 
         const Image & image;
     };
 
     struct OutputImageInfo : public AreaInfo
     {
-        OutputImageInfo( Image & in, uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count );
+        OutputImageInfo( Image & in, uint32_t x, uint32_t y, uint32_t width_, uint32_t height_, uint32_t count, uint32_t minimumArea = 1u,
+                         uint32_t minimumWidth = 1u, uint32_t minimumHeight = 1u );
 
         Image & image;
     };
@@ -80,9 +92,16 @@ namespace Function_Pool
         std::unique_ptr<OutputImageInfo> _infoOut2;
         std::unique_ptr<OutputImageInfo> _infoOut3;
 
+        uint32_t _minimumTaskArea; // minimum number of pixels processed by one task, it must be set before calling of _setup() functions
+        uint32_t _minimumTaskWidth; // minimum size of a task area for functions using neighbour pixels, it must be set before calling of _setup() functions
+        uint32_t _minimumTaskHeight;
+
         // functions for setting up all parameters needed for multithreading and to validate input parameters
         void _setup( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
 
+        // for functions modifying an image in place, the image is set as input and output
+        void _setup( Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
+
         void _setup( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
 
         void _setup( const Image & in, uint32_t inX, uint32_t inY, Image & out, uint32_t outX, uint32_t outY, uint32_t width, uint32_t height );
@@ -101,8 +120,30 @@ namespace Function_Pool
 
         virtual void _task( size_t taskId ) = 0;
 
+        // image areas split into tasks according to thread count and minimum task sizes
+        std::unique_ptr<InputImageInfo> _inputInfo( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height ) const;
+        std::unique_ptr<OutputImageInfo> _outputInfo( Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height ) const;
+
         void _processTask(); // function which calls global thread pool and waits results from it
 
         void _validateTask();
     };
+
+    // Task calling a function for every task ID, for example to process images of a batch or bands of an image in parallel
+    class IndexedTask : public TaskProviderSingleton
+    {
+    public:
+        // error message is given to an exception raised when any call of the function fails
+        IndexedTask( const std::function<void( size_t )> & function, const char * errorMessage );
+        virtual ~IndexedTask();
+
+        void process( size_t taskCount ); // a single task is done in calling thread without thread pool
+
+    protected:
+        virtual void _task( size_t taskId );
+
+    private:
+        std::function<void( size_t )> _function;
+        const char * _errorMessage;
+    };
 }
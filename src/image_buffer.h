@@ -25,10 +25,18 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <limits>
+#include <utility>
 #include <vector>
 
 namespace penguinV
 {
+    // Alignment in bytes of base address and rows of SIMD aligned images (cache line and AVX-512 register size)
+    const static uint8_t SIMD_ALIGNMENT = 64u;
+
+    template <typename TColorDepth>
+    class ImagePoolTemplate;
+
     template <typename TColorDepth>
     class ImageTemplate
     {
@@ -99,21 +107,21 @@ namespace penguinV
             if ( width_ > 0 && height_ > 0 && ( width_ != _width || height_ != _height ) ) {
                 clear();
 
+                const uint32_t rowSize_ = _calculateRowSize( width_, colorCount(), alignment() );
+                const size_t size = _calculateSize( rowSize_, height_ );
+
                 _width = width_;
                 _height = height_;
+                _rowSize = rowSize_;
 
-                _rowSize = width() * colorCount();
-                if ( _rowSize % alignment() != 0 )
-                    _rowSize = ( _rowSize / alignment() + 1 ) * alignment();
-
-                _data = _allocate( static_cast<size_t>( _height ) * static_cast<size_t>( _rowSize ) );
+                _data = _allocateBuffer( size );
             }
         }
 
         void clear()
         {
             if ( _data != nullptr ) {
-                _deallocate( _data );
+                _deallocateBuffer( _data, static_cast<size_t>( _height ) * static_cast<size_t>( _rowSize ) );
                 _data = nullptr;
             }
 
@@ -137,6 +145,9 @@ namespace penguinV
             if ( data_ == nullptr || width_ == 0 || height_ == 0 || colorCount_ == 0 || alignment_ == 0 )
                 throw penguinVException( "Invalid image assignment parameters" );
 
+            const uint32_t rowSize_ = _calculateRowSize( width_, colorCount_, alignment_ );
+            _calculateSize( rowSize_, height_ );
+
             clear();
 
             _width = width_;
@@ -147,9 +158,7 @@ namespace penguinV
 
             _data = data_;
 
-            _rowSize = width() * colorCount();
-            if ( _rowSize % alignment() != 0 )
-                _rowSize = ( _rowSize / alignment() + 1 ) * alignment();
+            _rowSize = rowSize_;
         }
 
         bool empty() const
@@ -198,12 +207,25 @@ namespace penguinV
             }
         }
 
+        // Returns an alignment which makes every row to start at SIMD_ALIGNMENT bytes boundary. Memory allocator aligns base address of such images
+        // in the same way. Image functions could overwrite padding bytes at the end of rows of these images to avoid processing of row tails
+        static uint8_t simdAlignment()
+        {
+            return sizeof( TColorDepth ) < SIMD_ALIGNMENT ? static_cast<uint8_t>( SIMD_ALIGNMENT / sizeof( TColorDepth ) ) : 1u;
+        }
+
+        bool isSimdAligned() const
+        {
+            return _data != nullptr && ( reinterpret_cast<std::uintptr_t>( _data ) % SIMD_ALIGNMENT ) == 0u
+                   && ( static_cast<size_t>( _rowSize ) * sizeof( TColorDepth ) ) % SIMD_ALIGNMENT == 0u;
+        }
+
         void fill( TColorDepth value )
         {
             if ( empty() )
                 return;
 
-            _set( data(), value, sizeof( TColorDepth ) * height() * rowSize() );
+            _set( data(), value, sizeof( TColorDepth ) * static_cast<size_t>( height() ) * rowSize() );
         }
 
         void swap( ImageTemplate & image )
@@ -234,27 +256,25 @@ namespace penguinV
             _alignment = image._alignment;
 
             if ( image._data != nullptr ) {
-                _data = _allocate( static_cast<size_t>( _height ) * static_cast<size_t>( _rowSize ) );
+                _data = _allocateBuffer( static_cast<size_t>( _height ) * static_cast<size_t>( _rowSize ) );
 
-                _copy( _data, image._data, sizeof( TColorDepth ) * _height * _rowSize );
+                _copy( _data, image._data, sizeof( TColorDepth ) * static_cast<size_t>( _height ) * _rowSize );
             }
         }
 
         bool mutate( uint32_t width_, uint32_t height_, uint8_t colorCount_, uint8_t alignment_ )
         {
             if ( colorCount_ > 0 && alignment_ > 0 ) {
-                uint32_t rowSize_ = width_ * colorCount_;
-                if ( rowSize_ % alignment_ != 0 )
-                    rowSize_ = ( rowSize_ / alignment_ + 1 ) * alignment_;
+                const uint64_t rowSize_ = ( ( static_cast<uint64_t>( width_ ) * colorCount_ + alignment_ - 1u ) / alignment_ ) * alignment_;
 
-                if ( rowSize_ * height_ != _rowSize * _height )
+                if ( rowSize_ > std::numeric_limits<uint32_t>::max() || rowSize_ * height_ != static_cast<uint64_t>( _rowSize ) * _height )
                     return false;
 
                 _width = width_;
                 _height = height_;
                 _colorCount = colorCount_;
                 _alignment = alignment_;
-                _rowSize = rowSize_;
+                _rowSize = static_cast<uint32_t>( rowSize_ );
 
                 return true;
             }
@@ -293,6 +313,65 @@ namespace penguinV
         }
 
     private:
+        friend class ImagePoolTemplate<TColorDepth>;
+
+        // row size (in elements) including alignment, all calculations are done in 64-bit to detect overflow
+        static uint32_t _calculateRowSize( uint32_t width_, uint8_t colorCount_, uint8_t alignment_ )
+        {
+            const uint64_t rowSize_ = ( ( static_cast<uint64_t>( width_ ) * colorCount_ + alignment_ - 1u ) / alignment_ ) * alignment_;
+            if ( rowSize_ > std::numeric_limits<uint32_t>::max() )
+                throw penguinVException( "Image row size is too big" );
+
+            return static_cast<uint32_t>( rowSize_ );
+        }
+
+        // overall size (in elements) of image data, a difference between any pointers inside the data must fit into ptrdiff_t
+        static size_t _calculateSize( uint32_t rowSize_, uint32_t height_ )
+        {
+            const uint64_t size = static_cast<uint64_t>( rowSize_ ) * height_;
+            if ( size * sizeof( TColorDepth ) > std::numeric_limits<size_t>::max() / 2u )
+                throw penguinVException( "Image size is too big for this platform" );
+
+            return static_cast<size_t>( size );
+        }
+
+        // memory functions of image pool which are used for images of one type while the pool exists. Allocation function receives
+        // image geometry (width, height, color count and alignment) as the pool recycles buffers per geometry
+        typedef TColorDepth * ( *PoolAllocateFunction )( uint32_t width, uint32_t height, uint8_t colorCount, uint8_t alignment, size_t size );
+        typedef void ( *PoolDeallocateFunction )( TColorDepth * data, size_t size );
+
+        struct PoolFunctions
+        {
+            uint8_t type;
+            PoolAllocateFunction allocate;
+            PoolDeallocateFunction deallocate;
+        };
+
+        static PoolFunctions & _poolFunctions()
+        {
+            static PoolFunctions functions = { 0u, nullptr, nullptr };
+            return functions;
+        }
+
+        // buffer of current image geometry, it is taken from image pool if the pool exists for the image type
+        TColorDepth * _allocateBuffer( size_t size ) const
+        {
+            const PoolFunctions & pool = _poolFunctions();
+            if ( pool.allocate != nullptr && pool.type == _type )
+                return pool.allocate( _width, _height, _colorCount, _alignment, size );
+
+            return _allocate( size );
+        }
+
+        void _deallocateBuffer( TColorDepth * data, size_t size ) const
+        {
+            const PoolFunctions & pool = _poolFunctions();
+            if ( pool.deallocate != nullptr && pool.type == _type )
+                pool.deallocate( data, size );
+            else
+                _deallocate( data );
+        }
+
         TColorDepth * _allocate( size_t size ) const
         {
             return FunctionFacade::instance().allocate( _type )( size );
@@ -315,12 +394,12 @@ namespace penguinV
 
         static TColorDepth * _allocateMemory( size_t size )
         {
-            return cpu_Memory::MemoryAllocator::instance().allocate<TColorDepth>( size );
+            return cpu_Memory::NodeMemoryAllocator::instance().allocate<TColorDepth>( size );
         }
 
         static void _deallocateMemory( TColorDepth * data )
         {
-            cpu_Memory::MemoryAllocator::instance().free( data );
+            cpu_Memory::NodeMemoryAllocator::instance().free( data );
         }
 
         static void _copyMemory( TColorDepth * out, TColorDepth * in, size_t size )
@@ -417,6 +496,129 @@ namespace penguinV
     typedef ImageTemplate<uint8_t> Image;
     typedef ImageTemplate<uint16_t> Image16Bit;
 
+    // Non-owning rectangular area (region of interest) of an image. A view does not allocate or copy any pixel data
+    // so it can be created in constant time. The view stores a pointer to the image therefore it must not outlive the image
+    // Use constant image type as a template parameter for read-only views
+    template <typename TImage>
+    class ImageViewTemplate
+    {
+    public:
+        explicit ImageViewTemplate( TImage & image_ )
+            : _image( &image_ )
+            , _x( 0 )
+            , _y( 0 )
+            , _width( image_.width() )
+            , _height( image_.height() )
+        {}
+
+        ImageViewTemplate( TImage & image_, uint32_t x_, uint32_t y_, uint32_t width_, uint32_t height_ )
+            : _image( &image_ )
+            , _x( x_ )
+            , _y( y_ )
+            , _width( width_ )
+            , _height( height_ )
+        {
+            if ( image_.empty() || width_ == 0 || height_ == 0 || x_ + width_ > image_.width() || y_ + height_ > image_.height() || x_ + width_ < width_
+                 || y_ + height_ < height_ )
+                throw penguinVException( "Invalid image view parameters" );
+        }
+
+        // Any view can be used as a read-only view
+        template <typename TOtherImage>
+        ImageViewTemplate( const ImageViewTemplate<TOtherImage> & view_ )
+            : _image( &view_.image() )
+            , _x( view_.x() )
+            , _y( view_.y() )
+            , _width( view_.width() )
+            , _height( view_.height() )
+        {}
+
+        // Returns a view of an area within this view. Coordinates are relative to this view
+        ImageViewTemplate view( uint32_t x_, uint32_t y_, uint32_t width_, uint32_t height_ ) const
+        {
+            if ( width_ == 0 || height_ == 0 || x_ + width_ > _width || y_ + height_ > _height || x_ + width_ < width_ || y_ + height_ < height_ )
+                throw penguinVException( "Invalid image view parameters" );
+
+            return ImageViewTemplate( *_image, _x + x_, _y + y_, width_, height_ );
+        }
+
+        TImage & image() const
+        {
+            return *_image;
+        }
+
+        // Pointer to the first pixel of the view
+        auto data() const -> decltype( std::declval<TImage &>().data() )
+        {
+            return _image->data() + static_cast<size_t>( _y ) * _image->rowSize() + static_cast<size_t>( _x ) * _image->colorCount();
+        }
+
+        bool empty() const
+        {
+            return _image->empty();
+        }
+
+        uint32_t x() const
+        {
+            return _x;
+        }
+
+        uint32_t y() const
+        {
+            return _y;
+        }
+
+        uint32_t width() const
+        {
+            return _width;
+        }
+
+        uint32_t height() const
+        {
+            return _height;
+        }
+
+        uint32_t rowSize() const
+        {
+            return _image->rowSize();
+        }
+
+        uint8_t colorCount() const
+        {
+            return _image->colorCount();
+        }
+
+    private:
+        TImage * _image;
+
+        uint32_t _x;
+        uint32_t _y;
+        uint32_t _width;
+        uint32_t _height;
+    };
+
+    typedef ImageViewTemplate<Image> ImageView;
+    typedef ImageViewTemplate<const Image> ConstImageView;
+    typedef ImageViewTemplate<Image16Bit> ImageView16Bit;
+    typedef ImageViewTemplate<const Image16Bit> ConstImageView16Bit;
+
+    // Rectangular area (region of interest) given by position and size. Unlike a view it does not refer to any image
+    // so the same list of areas could be applied to every frame, for example by functions processing many ROIs in one call
+    struct Roi
+    {
+        Roi( uint32_t x_ = 0, uint32_t y_ = 0, uint32_t width_ = 0, uint32_t height_ = 0 )
+            : x( x_ )
+            , y( y_ )
+            , width( width_ )
+            , height( height_ )
+        {}
+
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+        uint32_t height;
+    };
+
     const static uint8_t GRAY_SCALE = 1u;
     const static uint8_t RGB = 3u;
     const static uint8_t RGBA = 4u;
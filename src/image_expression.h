@@ -0,0 +1,1066 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include "image_buffer.h"
+#include "image_function_helper.h"
+#include "penguinv/cpu_identification.h"
+#include <limits>
+#include <type_traits>
+
+#ifdef PENGUINV_AVX_SET
+#include <immintrin.h>
+#endif
+
+#ifdef PENGUINV_SSE_SET
+#include <emmintrin.h>
+#endif
+
+#ifdef PENGUINV_NEON_SET
+#include <arm_neon.h>
+#endif
+
+// Lazy point-wise image arithmetic. Functions of this namespace do not compute anything, they build a compile-time expression tree
+// and the whole tree is evaluated when it is assigned to an image:
+//     Image out = Image_Expression::Threshold( Image_Expression::AbsoluteDifference( in1, in2 ), 64 );
+// Every pixel is loaded once into a SIMD register, all functions are applied to the register and the result is stored once
+// so no intermediate images are allocated and the memory is read and written in a single pass. Operands could be images,
+// image views or other expressions of the same color depth (8-bit or 16-bit). Functions work with every color channel independently
+namespace Image_Expression
+{
+    using namespace penguinV;
+
+    // SIMD registers of every technology with saturated unsigned integer operations, register width is the same as in Image_Function_Simd
+    namespace Register
+    {
+        template <typename TColorDepth>
+        struct Cpu
+        {
+            typedef TColorDepth ColorDepth;
+            typedef TColorDepth type;
+            static const uint32_t size = 1u;
+
+            static type load( const TColorDepth * data )
+            {
+                return *data;
+            }
+
+            static void store( TColorDepth * data, type value )
+            {
+                *data = value;
+            }
+
+            static type set( TColorDepth value )
+            {
+                return value;
+            }
+
+            static type bitwiseAnd( type in1, type in2 )
+            {
+                return static_cast<type>( in1 & in2 );
+            }
+
+            static type bitwiseOr( type in1, type in2 )
+            {
+                return static_cast<type>( in1 | in2 );
+            }
+
+            static type bitwiseXor( type in1, type in2 )
+            {
+                return static_cast<type>( in1 ^ in2 );
+            }
+
+            static type maximum( type in1, type in2 )
+            {
+                return in1 > in2 ? in1 : in2;
+            }
+
+            static type minimum( type in1, type in2 )
+            {
+                return in1 < in2 ? in1 : in2;
+            }
+
+            static type subtract( type in1, type in2 )
+            {
+                return static_cast<type>( in1 > in2 ? in1 - in2 : 0 );
+            }
+
+            // returns a register with all bits set for zero values and zero otherwise
+            static type isZero( type in )
+            {
+                return in == 0 ? std::numeric_limits<type>::max() : 0;
+            }
+        };
+
+#ifdef PENGUINV_AVX512_SKL_SET
+        struct Avx512Base
+        {
+            typedef __m512i type;
+
+            static type bitwiseAnd( type in1, type in2 )
+            {
+                return _mm512_and_si512( in1, in2 );
+            }
+
+            static type bitwiseOr( type in1, type in2 )
+            {
+                return _mm512_or_si512( in1, in2 );
+            }
+
+            static type bitwiseXor( type in1, type in2 )
+            {
+                return _mm512_xor_si512( in1, in2 );
+            }
+        };
+
+        template <typename TColorDepth>
+        struct Avx512;
+
+        template <>
+        struct Avx512<uint8_t> : public Avx512Base
+        {
+            typedef uint8_t ColorDepth;
+            static const uint32_t size = 64u;
+
+            static type load( const uint8_t * data )
+            {
+                return _mm512_loadu_si512( data );
+            }
+
+            static void store( uint8_t * data, type value )
+            {
+                _mm512_storeu_si512( data, value );
+            }
+
+            static type set( uint8_t value )
+            {
+                return _mm512_set1_epi8( static_cast<char>( value ) );
+            }
+
+            static type maximum( type in1, type in2 )
+            {
+                return _mm512_max_epu8( in1, in2 );
+            }
+
+            static type minimum( type in1, type in2 )
+            {
+                return _mm512_min_epu8( in1, in2 );
+            }
+
+            static type subtract( type in1, type in2 )
+            {
+                return _mm512_subs_epu8( in1, in2 );
+            }
+
+            static type isZero( type in )
+            {
+                return _mm512_movm_epi8( _mm512_cmpeq_epi8_mask( in, _mm512_setzero_si512() ) );
+            }
+        };
+
+        template <>
+        struct Avx512<uint16_t> : public Avx512Base
+        {
+            typedef uint16_t ColorDepth;
+            static const uint32_t size = 32u;
+
+            static type load( const uint16_t * data )
+            {
+                return _mm512_loadu_si512( data );
+            }
+
+            static void store( uint16_t * data, type value )
+            {
+                _mm512_storeu_si512( data, value );
+            }
+
+            static type set( uint16_t value )
+            {
+                return _mm512_set1_epi16( static_cast<short>( value ) );
+            }
+
+            static type maximum( type in1, type in2 )
+            {
+                return _mm512_max_epu16( in1, in2 );
+            }
+
+            static type minimum( type in1, type in2 )
+            {
+                return _mm512_min_epu16( in1, in2 );
+            }
+
+            static type subtract( type in1, type in2 )
+            {
+                return _mm512_subs_epu16( in1, in2 );
+            }
+
+            static type isZero( type in )
+            {
+                return _mm512_movm_epi16( _mm512_cmpeq_epi16_mask( in, _mm512_setzero_si512() ) );
+            }
+        };
+#endif
+
+#ifdef PENGUINV_AVX_SET
+        struct AvxBase
+        {
+            typedef __m256i type;
+
+            static type bitwiseAnd( type in1, type in2 )
+            {
+                return _mm256_and_si256( in1, in2 );
+            }
+
+            static type bitwiseOr( type in1, type in2 )
+            {
+                return _mm256_or_si256( in1, in2 );
+            }
+
+            static type bitwiseXor( type in1, type in2 )
+            {
+                return _mm256_xor_si256( in1, in2 );
+            }
+        };
+
+        template <typename TColorDepth>
+        struct Avx;
+
+        template <>
+        struct Avx<uint8_t> : public AvxBase
+        {
+            typedef uint8_t ColorDepth;
+            static const uint32_t size = 32u;
+
+            static type load( const uint8_t * data )
+            {
+                return _mm256_loadu_si256( reinterpret_cast<const type *>( data ) );
+            }
+
+            static void store( uint8_t * data, type value )
+            {
+                _mm256_storeu_si256( reinterpret_cast<type *>( data ), value );
+            }
+
+            static type set( uint8_t value )
+            {
+                return _mm256_set1_epi8( static_cast<char>( value ) );
+            }
+
+            static type maximum( type in1, type in2 )
+            {
+                return _mm256_max_epu8( in1, in2 );
+            }
+
+            static type minimum( type in1, type in2 )
+            {
+                return _mm256_min_epu8( in1, in2 );
+            }
+
+            static type subtract( type in1, type in2 )
+            {
+                return _mm256_subs_epu8( in1, in2 );
+            }
+
+            static type isZero( type in )
+            {
+                return _mm256_cmpeq_epi8( in, _mm256_setzero_si256() );
+            }
+        };
+
+        template <>
+        struct Avx<uint16_t> : public AvxBase
+        {
+            typedef uint16_t ColorDepth;
+            static const uint32_t size = 16u;
+
+            static type load( const uint16_t * data )
+            {
+                return _mm256_loadu_si256( reinterpret_cast<const type *>( data ) );
+            }
+
+            static void store( uint16_t * data, type value )
+            {
+                _mm256_storeu_si256( reinterpret_cast<type *>( data ), value );
+            }
+
+            static type set( uint16_t value )
+            {
+                return _mm256_set1_epi16( static_cast<short>( value ) );
+            }
+
+            static type maximum( type in1, type in2 )
+            {
+                return _mm256_max_epu16( in1, in2 );
+            }
+
+            static type minimum( type in1, type in2 )
+            {
+                return _mm256_min_epu16( in1, in2 );
+            }
+
+            static type subtract( type in1, type in2 )
+            {
+                return _mm256_subs_epu16( in1, in2 );
+            }
+
+            static type isZero( type in )
+            {
+                return _mm256_cmpeq_epi16( in, _mm256_setzero_si256() );
+            }
+        };
+#endif
+
+#ifdef PENGUINV_SSE_SET
+        struct SseBase
+        {
+            typedef __m128i type;
+
+            static type bitwiseAnd( type in1, type in2 )
+            {
+                return _mm_and_si128( in1, in2 );
+            }
+
+            static type bitwiseOr( type in1, type in2 )
+            {
+                return _mm_or_si128( in1, in2 );
+            }
+
+            static type bitwiseXor( type in1, type in2 )
+            {
+                return _mm_xor_si128( in1, in2 );
+            }
+        };
+
+        template <typename TColorDepth>
+        struct Sse;
+
+        template <>
+        struct Sse<uint8_t> : public SseBase
+        {
+            typedef uint8_t ColorDepth;
+            static const uint32_t size = 16u;
+
+            static type load( const uint8_t * data )
+            {
+                return _mm_loadu_si128( reinterpret_cast<const type *>( data ) );
+            }
+
+            static void store( uint8_t * data, type value )
+            {
+                _mm_storeu_si128( reinterpret_cast<type *>( data ), value );
+            }
+
+            static type set( uint8_t value )
+            {
+                return _mm_set1_epi8( static_cast<char>( value ) );
+            }
+
+            static type maximum( type in1, type in2 )
+            {
+                return _mm_max_epu8( in1, in2 );
+            }
+
+            static type minimum( type in1, type in2 )
+            {
+                return _mm_min_epu8( in1, in2 );
+            }
+
+            static type subtract( type in1, type in2 )
+            {
+                return _mm_subs_epu8( in1, in2 );
+            }
+
+            static type isZero( type in )
+            {
+                return _mm_cmpeq_epi8( in, _mm_setzero_si128() );
+            }
+        };
+
+        template <>
+        struct Sse<uint16_t> : public SseBase
+        {
+            typedef uint16_t ColorDepth;
+            static const uint32_t size = 8u;
+
+            static type load( const uint16_t * data )
+            {
+                return _mm_loadu_si128( reinterpret_cast<const type *>( data ) );
+            }
+
+            static void store( uint16_t * data, type value )
+            {
+                _mm_storeu_si128( reinterpret_cast<type *>( data ), value );
+            }
+
+            static type set( uint16_t value )
+            {
+                return _mm_set1_epi16( static_cast<short>( value ) );
+            }
+
+            // SSE2 has no unsigned 16-bit maximum and minimum so they are made from saturated subtraction
+            static type maximum( type in1, type in2 )
+            {
+                return _mm_add_epi16( _mm_subs_epu16( in1, in2 ), in2 );
+            }
+
+            static type minimum( type in1, type in2 )
+            {
+                return _mm_sub_epi16( in1, _mm_subs_epu16( in1, in2 ) );
+            }
+
+            static type subtract( type in1, type in2 )
+            {
+                return _mm_subs_epu16( in1, in2 );
+            }
+
+            static type isZero( type in )
+            {
+                return _mm_cmpeq_epi16( in, _mm_setzero_si128() );
+            }
+        };
+#endif
+
+#ifdef PENGUINV_NEON_SET
+        template <typename TColorDepth>
+        struct Neon;
+
+        template <>
+        struct Neon<uint8_t>
+        {
+            typedef uint8_t ColorDepth;
+            typedef uint8x16_t type;
+            static const uint32_t size = 16u;
+
+            static type load( const uint8_t * data )
+            {
+                return vld1q_u8( data );
+            }
+
+            static void store( uint8_t * data, type value )
+            {
+                vst1q_u8( data, value );
+            }
+
+            static type set( uint8_t value )
+            {
+                return vdupq_n_u8( value );
+            }
+
+            static type bitwiseAnd( type in1, type in2 )
+            {
+                return vandq_u8( in1, in2 );
+            }
+
+            static type bitwiseOr( type in1, type in2 )
+            {
+                return vorrq_u8( in1, in2 );
+            }
+
+            static type bitwiseXor( type in1, type in2 )
+            {
+                return veorq_u8( in1, in2 );
+            }
+
+            static type maximum( type in1, type in2 )
+            {
+                return vmaxq_u8( in1, in2 );
+            }
+
+            static type minimum( type in1, type in2 )
+            {
+                return vminq_u8( in1, in2 );
+            }
+
+            static type subtract( type in1, type in2 )
+            {
+                return vqsubq_u8( in1, in2 );
+            }
+
+            static type isZero( type in )
+            {
+                return vceqq_u8( in, vdupq_n_u8( 0 ) );
+            }
+        };
+
+        template <>
+        struct Neon<uint16_t>
+        {
+            typedef uint16_t ColorDepth;
+            typedef uint16x8_t type;
+            static const uint32_t size = 8u;
+
+            static type load( const uint16_t * data )
+            {
+                return vld1q_u16( data );
+            }
+
+            static void store( uint16_t * data, type value )
+            {
+                vst1q_u16( data, value );
+            }
+
+            static type set( uint16_t value )
+            {
+                return vdupq_n_u16( value );
+            }
+
+            static type bitwiseAnd( type in1, type in2 )
+            {
+                return vandq_u16( in1, in2 );
+            }
+
+            static type bitwiseOr( type in1, type in2 )
+            {
+                return vorrq_u16( in1, in2 );
+            }
+
+            static type bitwiseXor( type in1, type in2 )
+            {
+                return veorq_u16( in1, in2 );
+            }
+
+            static type maximum( type in1, type in2 )
+            {
+                return vmaxq_u16( in1, in2 );
+            }
+
+            static type minimum( type in1, type in2 )
+            {
+                return vminq_u16( in1, in2 );
+            }
+
+            static type subtract( type in1, type in2 )
+            {
+                return vqsubq_u16( in1, in2 );
+            }
+
+            static type isZero( type in )
+            {
+                return vceqq_u16( in, vdupq_n_u16( 0 ) );
+            }
+        };
+#endif
+    }
+
+    // Functions applied to registers, results are the same as for Image_Function functions
+    namespace Operation
+    {
+        struct AbsoluteDifference
+        {
+            template <typename TRegister>
+            typename TRegister::type apply( typename TRegister::type in1, typename TRegister::type in2 ) const
+            {
+                return TRegister::bitwiseOr( TRegister::subtract( in1, in2 ), TRegister::subtract( in2, in1 ) );
+            }
+        };
+
+        struct BitwiseAnd
+        {
+            template <typename TRegister>
+            typename TRegister::type apply( typename TRegister::type in1, typename TRegister::type in2 ) const
+            {
+                return TRegister::bitwiseAnd( in1, in2 );
+            }
+        };
+
+        struct BitwiseOr
+        {
+            template <typename TRegister>
+            typename TRegister::type apply( typename TRegister::type in1, typename TRegister::type in2 ) const
+            {
+                return TRegister::bitwiseOr( in1, in2 );
+            }
+        };
+
+        struct BitwiseXor
+        {
+            template <typename TRegister>
+            typename TRegister::type apply( typename TRegister::type in1, typename TRegister::type in2 ) const
+            {
+                return TRegister::bitwiseXor( in1, in2 );
+            }
+        };
+
+        struct Invert
+        {
+            template <typename TRegister>
+            typename TRegister::type apply( typename TRegister::type in ) const
+            {
+                return TRegister::bitwiseXor( in, TRegister::set( std::numeric_limits<typename TRegister::ColorDepth>::max() ) );
+            }
+        };
+
+        struct Maximum
+        {
+            template <typename TRegister>
+            typename TRegister::type apply( typename TRegister::type in1, typename TRegister::type in2 ) const
+            {
+                return TRegister::maximum( in1, in2 );
+            }
+        };
+
+        struct Minimum
+        {
+            template <typename TRegister>
+            typename TRegister::type apply( typename TRegister::type in1, typename TRegister::type in2 ) const
+            {
+                return TRegister::minimum( in1, in2 );
+            }
+        };
+
+        struct Subtract
+        {
+            template <typename TRegister>
+            typename TRegister::type apply( typename TRegister::type in1, typename TRegister::type in2 ) const
+            {
+                return TRegister::subtract( in1, in2 );
+            }
+        };
+
+        template <typename TColorDepth>
+        struct Threshold
+        {
+            explicit Threshold( TColorDepth threshold_ )
+                : threshold( threshold_ )
+            {}
+
+            template <typename TRegister>
+            typename TRegister::type apply( typename TRegister::type in ) const
+            {
+                return TRegister::isZero( TRegister::subtract( TRegister::set( threshold ), in ) );
+            }
+
+            TColorDepth threshold;
+        };
+
+        template <typename TColorDepth>
+        struct ThresholdDouble
+        {
+            ThresholdDouble( TColorDepth minThreshold_, TColorDepth maxThreshold_ )
+                : minThreshold( minThreshold_ )
+                , maxThreshold( maxThreshold_ )
+            {
+                if ( minThreshold > maxThreshold )
+                    throw penguinVException( "Minimum threshold value is bigger than maximum threshold value" );
+            }
+
+            template <typename TRegister>
+            typename TRegister::type apply( typename TRegister::type in ) const
+            {
+                return TRegister::bitwiseAnd( TRegister::isZero( TRegister::subtract( TRegister::set( minThreshold ), in ) ),
+                                              TRegister::isZero( TRegister::subtract( in, TRegister::set( maxThreshold ) ) ) );
+            }
+
+            TColorDepth minThreshold;
+            TColorDepth maxThreshold;
+        };
+    }
+
+    // Base class of all expressions
+    struct ExpressionTag
+    {};
+
+    template <typename TExpression>
+    ImageTemplate<typename TExpression::ColorDepth> Evaluate( const TExpression & expression );
+
+    // Leaf of an expression tree: an image or an image view
+    template <typename TColorDepth>
+    class ImageOperand : public ExpressionTag
+    {
+    public:
+        typedef TColorDepth ColorDepth;
+
+        ImageOperand( const TColorDepth * data, uint32_t rowSize_, uint32_t width_, uint32_t height_, uint8_t colorCount_ )
+            : _data( data )
+            , _row( data )
+            , _rowSize( rowSize_ )
+            , _width( width_ )
+            , _height( height_ )
+            , _colorCount( colorCount_ )
+        {
+            if ( data == nullptr || width_ == 0 || height_ == 0 )
+                throw penguinVException( "Bad input parameters in image function" );
+        }
+
+        uint32_t width() const
+        {
+            return _width;
+        }
+
+        uint32_t height() const
+        {
+            return _height;
+        }
+
+        uint8_t colorCount() const
+        {
+            return _colorCount;
+        }
+
+        void setRow( uint32_t y )
+        {
+            _row = _data + static_cast<size_t>( y ) * _rowSize;
+        }
+
+        // x is a position in the row counting every color channel
+        template <typename TRegister>
+        typename TRegister::type get( uint32_t x ) const
+        {
+            return TRegister::load( _row + x );
+        }
+
+    private:
+        const TColorDepth * _data;
+        const TColorDepth * _row;
+        uint32_t _rowSize;
+        uint32_t _width;
+        uint32_t _height;
+        uint8_t _colorCount;
+    };
+
+    template <typename TOperation, typename TOperand>
+    class UnaryExpression : public ExpressionTag
+    {
+    public:
+        typedef typename TOperand::ColorDepth ColorDepth;
+
+        UnaryExpression( const TOperand & operand, const TOperation & operation )
+            : _operand( operand )
+            , _operation( operation )
+        {}
+
+        uint32_t width() const
+        {
+            return _operand.width();
+        }
+
+        uint32_t height() const
+        {
+            return _operand.height();
+        }
+
+        uint8_t colorCount() const
+        {
+            return _operand.colorCount();
+        }
+
+        void setRow( uint32_t y )
+        {
+            _operand.setRow( y );
+        }
+
+        template <typename TRegister>
+        typename TRegister::type get( uint32_t x ) const
+        {
+            return _operation.template apply<TRegister>( _operand.template get<TRegister>( x ) );
+        }
+
+        operator ImageTemplate<ColorDepth>() const
+        {
+            return Evaluate( *this );
+        }
+
+    private:
+        TOperand _operand;
+        TOperation _operation;
+    };
+
+    template <typename TOperation, typename TOperand1, typename TOperand2>
+    class BinaryExpression : public ExpressionTag
+    {
+    public:
+        static_assert( std::is_same<typename TOperand1::ColorDepth, typename TOperand2::ColorDepth>::value, "Operands must have the same color depth" );
+
+        typedef typename TOperand1::ColorDepth ColorDepth;
+
+        BinaryExpression( const TOperand1 & operand1, const TOperand2 & operand2, const TOperation & operation )
+            : _operand1( operand1 )
+            , _operand2( operand2 )
+            , _operation( operation )
+        {
+            if ( operand1.width() != operand2.width() || operand1.height() != operand2.height() )
+                throw penguinVException( "Bad input parameters in image function: image views have different sizes" );
+
+            if ( operand1.colorCount() != operand2.colorCount() )
+                throw penguinVException( "The number of color channels in images is different" );
+        }
+
+        uint32_t width() const
+        {
+            return _operand1.width();
+        }
+
+        uint32_t height() const
+        {
+            return _operand1.height();
+        }
+
+        uint8_t colorCount() const
+        {
+            return _operand1.colorCount();
+        }
+
+        void setRow( uint32_t y )
+        {
+            _operand1.setRow( y );
+            _operand2.setRow( y );
+        }
+
+        template <typename TRegister>
+        typename TRegister::type get( uint32_t x ) const
+        {
+            return _operation.template apply<TRegister>( _operand1.template get<TRegister>( x ), _operand2.template get<TRegister>( x ) );
+        }
+
+        operator ImageTemplate<ColorDepth>() const
+        {
+            return Evaluate( *this );
+        }
+
+    private:
+        TOperand1 _operand1;
+        TOperand2 _operand2;
+        TOperation _operation;
+    };
+
+    // Conversion of function arguments into expression operands, unsupported types have no operand type
+    template <typename TType, typename TEnable = void>
+    struct Operand
+    {};
+
+    template <typename TColorDepth>
+    struct Operand<ImageTemplate<TColorDepth>>
+    {
+        typedef ImageOperand<TColorDepth> type;
+
+        static type make( const ImageTemplate<TColorDepth> & image )
+        {
+            return type( image.data(), image.rowSize(), image.width(), image.height(), image.colorCount() );
+        }
+    };
+
+    template <typename TImage>
+    struct Operand<ImageViewTemplate<TImage>>
+    {
+        typedef ImageOperand<typename std::remove_const<typename std::remove_pointer<decltype( std::declval<const TImage &>().data() )>::type>::type> type;
+
+        static type make( const ImageViewTemplate<TImage> & view )
+        {
+            return type( view.data(), view.rowSize(), view.width(), view.height(), view.colorCount() );
+        }
+    };
+
+    template <typename TExpression>
+    struct Operand<TExpression, typename std::enable_if<std::is_base_of<ExpressionTag, TExpression>::value>::type>
+    {
+        typedef TExpression type;
+
+        static const type & make( const TExpression & expression )
+        {
+            return expression;
+        }
+    };
+
+    template <typename TOperation, typename TIn>
+    using Unary = UnaryExpression<TOperation, typename Operand<TIn>::type>;
+
+    template <typename TOperation, typename TIn1, typename TIn2>
+    using Binary = BinaryExpression<TOperation, typename Operand<TIn1>::type, typename Operand<TIn2>::type>;
+
+    template <typename TIn>
+    using ColorDepthOf = typename Operand<TIn>::type::ColorDepth;
+
+    template <typename TIn1, typename TIn2>
+    Binary<Operation::AbsoluteDifference, TIn1, TIn2> AbsoluteDifference( const TIn1 & in1, const TIn2 & in2 )
+    {
+        return Binary<Operation::AbsoluteDifference, TIn1, TIn2>( Operand<TIn1>::make( in1 ), Operand<TIn2>::make( in2 ), Operation::AbsoluteDifference() );
+    }
+
+    template <typename TIn1, typename TIn2>
+    Binary<Operation::BitwiseAnd, TIn1, TIn2> BitwiseAnd( const TIn1 & in1, const TIn2 & in2 )
+    {
+        return Binary<Operation::BitwiseAnd, TIn1, TIn2>( Operand<TIn1>::make( in1 ), Operand<TIn2>::make( in2 ), Operation::BitwiseAnd() );
+    }
+
+    template <typename TIn1, typename TIn2>
+    Binary<Operation::BitwiseOr, TIn1, TIn2> BitwiseOr( const TIn1 & in1, const TIn2 & in2 )
+    {
+        return Binary<Operation::BitwiseOr, TIn1, TIn2>( Operand<TIn1>::make( in1 ), Operand<TIn2>::make( in2 ), Operation::BitwiseOr() );
+    }
+
+    template <typename TIn1, typename TIn2>
+    Binary<Operation::BitwiseXor, TIn1, TIn2> BitwiseXor( const TIn1 & in1, const TIn2 & in2 )
+    {
+        return Binary<Operation::BitwiseXor, TIn1, TIn2>( Operand<TIn1>::make( in1 ), Operand<TIn2>::make( in2 ), Operation::BitwiseXor() );
+    }
+
+    template <typename TIn>
+    Unary<Operation::Invert, TIn> Invert( const TIn & in )
+    {
+        return Unary<Operation::Invert, TIn>( Operand<TIn>::make( in ), Operation::Invert() );
+    }
+
+    template <typename TIn1, typename TIn2>
+    Binary<Operation::Maximum, TIn1, TIn2> Maximum( const TIn1 & in1, const TIn2 & in2 )
+    {
+        return Binary<Operation::Maximum, TIn1, TIn2>( Operand<TIn1>::make( in1 ), Operand<TIn2>::make( in2 ), Operation::Maximum() );
+    }
+
+    template <typename TIn1, typename TIn2>
+    Binary<Operation::Minimum, TIn1, TIn2> Minimum( const TIn1 & in1, const TIn2 & in2 )
+    {
+        return Binary<Operation::Minimum, TIn1, TIn2>( Operand<TIn1>::make( in1 ), Operand<TIn2>::make( in2 ), Operation::Minimum() );
+    }
+
+    template <typename TIn1, typename TIn2>
+    Binary<Operation::Subtract, TIn1, TIn2> Subtract( const TIn1 & in1, const TIn2 & in2 )
+    {
+        return Binary<Operation::Subtract, TIn1, TIn2>( Operand<TIn1>::make( in1 ), Operand<TIn2>::make( in2 ), Operation::Subtract() );
+    }
+
+    // Values lower than threshold become 0, others become maximum value of color depth
+    template <typename TIn>
+    Unary<Operation::Threshold<ColorDepthOf<TIn>>, TIn> Threshold( const TIn & in, ColorDepthOf<TIn> threshold )
+    {
+        return Unary<Operation::Threshold<ColorDepthOf<TIn>>, TIn>( Operand<TIn>::make( in ), Operation::Threshold<ColorDepthOf<TIn>>( threshold ) );
+    }
+
+    // Values within [minThreshold; maxThreshold] range become maximum value of color depth, others become 0
+    template <typename TIn>
+    Unary<Operation::ThresholdDouble<ColorDepthOf<TIn>>, TIn> Threshold( const TIn & in, ColorDepthOf<TIn> minThreshold, ColorDepthOf<TIn> maxThreshold )
+    {
+        return Unary<Operation::ThresholdDouble<ColorDepthOf<TIn>>, TIn>( Operand<TIn>::make( in ),
+                                                                          Operation::ThresholdDouble<ColorDepthOf<TIn>>( minThreshold, maxThreshold ) );
+    }
+
+    // Evaluates an expression row by row: every row is processed by SIMD registers and the rest of the row by CPU registers
+    template <typename TRegister, typename TExpression>
+    void EvaluateRows( TExpression expression, typename TExpression::ColorDepth * outY, uint32_t rowSizeOut )
+    {
+        typedef Register::Cpu<typename TExpression::ColorDepth> CpuRegister;
+
+        const uint32_t width = expression.width() * expression.colorCount();
+        const uint32_t height = expression.height();
+        const uint32_t totalSimdWidth = width - width % TRegister::size;
+
+        for ( uint32_t y = 0; y < height; ++y, outY += rowSizeOut ) {
+            expression.setRow( y );
+
+            uint32_t x = 0;
+            for ( ; x < totalSimdWidth; x += TRegister::size )
+                TRegister::store( outY + x, expression.template get<TRegister>( x ) );
+
+            for ( ; x < width; ++x )
+                CpuRegister::store( outY + x, expression.template get<CpuRegister>( x ) );
+        }
+    }
+
+    // SIMD type of registers used by Evaluate() function. SIMD functions are selected during runtime by CPU features while this header is compiled
+    // only with instruction sets enabled by compiler flags, so the selected type is lowered to the widest register available here
+    inline simd::SIMDType EvaluationSimdType()
+    {
+        switch ( simd::actualSimdType() ) {
+        case simd::avx512_function:
+#ifdef PENGUINV_AVX512_SKL_SET
+            return simd::avx512_function;
+#endif
+        case simd::avx_function:
+#ifdef PENGUINV_AVX_SET
+            return simd::avx_function;
+#endif
+        case simd::sse_function:
+#ifdef PENGUINV_SSE_SET
+            return simd::sse_function;
+#endif
+            break;
+        case simd::neon_function:
+#ifdef PENGUINV_NEON_SET
+            return simd::neon_function;
+#endif
+            break;
+        default:
+            break;
+        }
+
+        return simd::cpu_function;
+    }
+
+    // Evaluates an expression into an area of an image. Output could be the same as one of inputs
+    template <typename TExpression>
+    void Evaluate( const TExpression & expression, typename TExpression::ColorDepth * out, uint32_t rowSizeOut, uint32_t widthOut, uint32_t heightOut,
+                   uint8_t colorCountOut )
+    {
+        typedef typename TExpression::ColorDepth ColorDepth;
+
+        if ( out == nullptr || widthOut != expression.width() || heightOut != expression.height() )
+            throw penguinVException( "Bad input parameters in image function: image views have different sizes" );
+
+        if ( colorCountOut != expression.colorCount() )
+            throw penguinVException( "The number of color channels in images is different" );
+
+        switch ( EvaluationSimdType() ) {
+#ifdef PENGUINV_AVX512_SKL_SET
+        case simd::avx512_function:
+            EvaluateRows<Register::Avx512<ColorDepth>>( expression, out, rowSizeOut );
+            return;
+#endif
+#ifdef PENGUINV_AVX_SET
+        case simd::avx_function:
+            EvaluateRows<Register::Avx<ColorDepth>>( expression, out, rowSizeOut );
+            return;
+#endif
+#ifdef PENGUINV_SSE_SET
+        case simd::sse_function:
+            EvaluateRows<Register::Sse<ColorDepth>>( expression, out, rowSizeOut );
+            return;
+#endif
+#ifdef PENGUINV_NEON_SET
+        case simd::neon_function:
+            EvaluateRows<Register::Neon<ColorDepth>>( expression, out, rowSizeOut );
+            return;
+#endif
+        default:
+            EvaluateRows<Register::Cpu<ColorDepth>>( expression, out, rowSizeOut );
+        }
+    }
+
+    template <typename TExpression>
+    void Evaluate( const TExpression & expression, ImageTemplate<typename TExpression::ColorDepth> & out )
+    {
+        Evaluate( expression, out.data(), out.rowSize(), out.width(), out.height(), out.colorCount() );
+    }
+
+    template <typename TExpression>
+    void Evaluate( const TExpression & expression, const ImageViewTemplate<ImageTemplate<typename TExpression::ColorDepth>> & out )
+    {
+        Evaluate( expression, out.data(), out.rowSize(), out.width(), out.height(), out.colorCount() );
+    }
+
+    template <typename TExpression>
+    ImageTemplate<typename TExpression::ColorDepth> Evaluate( const TExpression & expression )
+    {
+        ImageTemplate<typename TExpression::ColorDepth> out( expression.width(), expression.height(), expression.colorCount() );
+
+        Evaluate( expression, out );
+
+        return out;
+    }
+}
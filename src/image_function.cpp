@@ -21,7 +21,9 @@
 #include "image_function.h"
 #include "image_function_helper.h"
 #include "parameter_validation.h"
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace
 {
@@ -236,6 +238,16 @@ namespace Image_Function
         }
     }
 
+    Image AbsoluteDifference( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::AbsoluteDifference( AbsoluteDifference, in1, in2 );
+    }
+
+    void AbsoluteDifference( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::AbsoluteDifference( AbsoluteDifference, in1, in2, out );
+    }
+
     void Accumulate( const Image & image, std::vector<uint32_t> & result )
     {
         Image_Function_Helper::Accumulate( Accumulate, image, result );
@@ -268,6 +280,38 @@ namespace Image_Function
         }
     }
 
+    void Accumulate64( const Image & image, std::vector<uint64_t> & result )
+    {
+        Image_Function_Helper::Accumulate64( Accumulate64, image, result );
+    }
+
+    void Accumulate64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint64_t> & result )
+    {
+        ValidateImageParameters( image, x, y, width, height );
+
+        const uint8_t colorCount = image.colorCount();
+        width = width * colorCount;
+
+        OptimiseRoi( width, height, image );
+
+        if ( result.size() != static_cast<size_t>( width ) * height )
+            throw penguinVException( "Array size is not equal to image ROI (width * height) size" );
+
+        const size_t rowSize = image.rowSize();
+
+        const uint8_t * imageY = image.data() + y * rowSize + x * colorCount;
+        const uint8_t * imageYEnd = imageY + height * rowSize;
+        std::vector<uint64_t>::iterator v = result.begin();
+
+        for ( ; imageY != imageYEnd; imageY += rowSize ) {
+            const uint8_t * imageX = imageY;
+            const uint8_t * imageXEnd = imageX + width;
+
+            for ( ; imageX != imageXEnd; ++imageX, ++v )
+                *v += ( *imageX );
+        }
+    }
+
     void BinaryDilate( Image & image, uint32_t dilationX, uint32_t dilationY )
     {
         ValidateImageParameters( image );
@@ -339,6 +383,16 @@ namespace Image_Function
         }
     }
 
+    Image BitwiseAnd( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::BitwiseAnd( BitwiseAnd, in1, in2 );
+    }
+
+    void BitwiseAnd( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::BitwiseAnd( BitwiseAnd, in1, in2, out );
+    }
+
     Image BitwiseOr( const Image & in1, const Image & in2 )
     {
         return Image_Function_Helper::BitwiseOr( BitwiseOr, in1, in2 );
@@ -386,6 +440,16 @@ namespace Image_Function
         }
     }
 
+    Image BitwiseOr( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::BitwiseOr( BitwiseOr, in1, in2 );
+    }
+
+    void BitwiseOr( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::BitwiseOr( BitwiseOr, in1, in2, out );
+    }
+
     Image BitwiseXor( const Image & in1, const Image & in2 )
     {
         return Image_Function_Helper::BitwiseXor( BitwiseXor, in1, in2 );
@@ -433,6 +497,16 @@ namespace Image_Function
         }
     }
 
+    Image BitwiseXor( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::BitwiseXor( BitwiseXor, in1, in2 );
+    }
+
+    void BitwiseXor( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::BitwiseXor( BitwiseXor, in1, in2, out );
+    }
+
     Image16Bit ConvertTo16Bit( const Image & in )
     {
         Image16Bit out = Image16Bit().generate( in.width(), in.height(), in.colorCount() );
@@ -891,7 +965,7 @@ namespace Image_Function
         else {
             for ( ; imageY != imageYEnd; imageY += rowSize ) {
                 const uint8_t * imageX = imageY;
-                const uint8_t * imageXEnd = imageX + width;
+                const uint8_t * imageXEnd = imageX + width * colorCount;
 
                 for ( ; imageX != imageXEnd; imageX += colorCount ) {
                     for ( uint32_t colorChannel = 0; colorChannel < colorCount; ++colorChannel )
@@ -901,6 +975,106 @@ namespace Image_Function
         }
     }
 
+    std::vector<std::vector<uint32_t>> Histogram( const Image & image, const std::vector<Roi> & roi )
+    {
+        std::vector<std::vector<uint32_t>> histogram;
+        Histogram( image, roi, histogram );
+        return histogram;
+    }
+
+    void Histogram( const Image & image, const std::vector<Roi> & roi, std::vector<std::vector<uint32_t>> & histogram )
+    {
+        ValidateImageParameters( image, roi );
+
+        Image_Function_Helper::RoiList::Histogram( image, roi, histogram );
+    }
+
+    std::vector<uint64_t> Histogram64( const Image & image )
+    {
+        return Image_Function_Helper::Histogram64( Histogram64, image );
+    }
+
+    void Histogram64( const Image & image, std::vector<uint64_t> & histogram )
+    {
+        Image_Function_Helper::Histogram64( Histogram64, image, histogram );
+    }
+
+    std::vector<uint64_t> Histogram64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height )
+    {
+        return Image_Function_Helper::Histogram64( Histogram64, image, x, y, width, height );
+    }
+
+    void Histogram64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint64_t> & histogram )
+    {
+        ValidateImageParameters( image, x, y, width, height );
+
+        const uint32_t colorCount = image.colorCount();
+        width = width * colorCount;
+
+        histogram.resize( 256u * colorCount );
+        std::fill( histogram.begin(), histogram.end(), 0u );
+
+        // Pixels are counted in 32-bit bins for a block of rows which can't overflow them and then moved into 64-bit bins.
+        // Gray-scale pixels are spread over 4 tables so increments of the same bin by neighbour pixels don't wait for each other
+        const uint32_t blockHeight = std::max( std::numeric_limits<uint32_t>::max() / width, 1u );
+        const size_t tableSize = histogram.size();
+        std::vector<uint32_t> blockHistogram( 4u * tableSize );
+        uint32_t * table1 = blockHistogram.data();
+        uint32_t * table2 = table1 + tableSize;
+        uint32_t * table3 = table2 + tableSize;
+        uint32_t * table4 = table3 + tableSize;
+
+        const size_t rowSize = image.rowSize();
+
+        const uint8_t * imageY = image.data() + y * rowSize + x * colorCount;
+
+        while ( height > 0 ) {
+            const uint32_t rowCount = std::min( height, blockHeight );
+            const uint8_t * imageYEnd = imageY + rowCount * rowSize;
+            height -= rowCount;
+
+            std::fill( blockHistogram.begin(), blockHistogram.end(), 0u );
+
+            for ( ; imageY != imageYEnd; imageY += rowSize ) {
+                const uint8_t * imageX = imageY;
+                const uint8_t * imageXEnd = imageX + width;
+
+                if ( colorCount == 1 ) {
+                    const uint8_t * imageXEnd4 = imageX + ( width & ~3u );
+
+                    for ( ; imageX != imageXEnd4; imageX += 4 ) {
+                        ++table1[imageX[0]];
+                        ++table2[imageX[1]];
+                        ++table3[imageX[2]];
+                        ++table4[imageX[3]];
+                    }
+
+                    for ( ; imageX != imageXEnd; ++imageX )
+                        ++table1[*imageX];
+                }
+                else {
+                    for ( ; imageX != imageXEnd; imageX += colorCount ) {
+                        for ( uint32_t colorChannel = 0; colorChannel < colorCount; ++colorChannel )
+                            ++table1[*( imageX + colorChannel ) * colorCount + colorChannel];
+                    }
+                }
+            }
+
+            for ( size_t i = 0; i < tableSize; ++i )
+                histogram[i] += static_cast<uint64_t>( table1[i] ) + table2[i] + table3[i] + table4[i];
+        }
+    }
+
+    std::vector<uint32_t> Histogram( const ConstImageView & image )
+    {
+        return Image_Function_Helper::Histogram( Histogram, image );
+    }
+
+    void Histogram( const ConstImageView & image, std::vector<uint32_t> & histogram )
+    {
+        Image_Function_Helper::Histogram( Histogram, image, histogram );
+    }
+
     std::vector<uint32_t> Histogram( const Image & image, const Image & mask )
     {
         return Image_Function_Helper::Histogram( Histogram, image, mask );
@@ -950,7 +1124,7 @@ namespace Image_Function
             for ( ; imageY != imageYEnd; imageY += rowSize, imageYMask += rowSizeMask ) {
                 const uint8_t * imageX = imageY;
                 const uint8_t * imageXMask = imageYMask;
-                const uint8_t * imageXEnd = imageX + width;
+                const uint8_t * imageXEnd = imageX + width * colorCount;
 
                 for ( ; imageX != imageXEnd; imageX += colorCount, ++imageXMask ) {
                     if ( ( *imageXMask ) > 0 ) {
@@ -1005,6 +1179,16 @@ namespace Image_Function
         }
     }
 
+    Image Invert( const ConstImageView & in )
+    {
+        return Image_Function_Helper::Invert( Invert, in );
+    }
+
+    void Invert( const ConstImageView & in, const ImageView & out )
+    {
+        Image_Function_Helper::Invert( Invert, in, out );
+    }
+
     bool IsBinary( const Image & image )
     {
         ValidateImageParameters( image );
@@ -1161,6 +1345,16 @@ namespace Image_Function
         }
     }
 
+    Image Maximum( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::Maximum( Maximum, in1, in2 );
+    }
+
+    void Maximum( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::Maximum( Maximum, in1, in2, out );
+    }
+
     Image Merge( const Image & in1, const Image & in2, const Image & in3 )
     {
         return Image_Function_Helper::Merge( Merge, in1, in2, in3 );
@@ -1267,6 +1461,16 @@ namespace Image_Function
         }
     }
 
+    Image Minimum( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::Minimum( Minimum, in1, in2 );
+    }
+
+    void Minimum( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::Minimum( Minimum, in1, in2, out );
+    }
+
     Image Normalize( const Image & in )
     {
         return Image_Function_Helper::Normalize( Normalize, in );
@@ -1384,6 +1588,79 @@ namespace Image_Function
         }
     }
 
+    std::vector<std::vector<uint32_t>> ProjectionProfile( const Image & image, const std::vector<Roi> & roi, bool horizontal )
+    {
+        std::vector<std::vector<uint32_t>> projection;
+        ProjectionProfile( image, roi, horizontal, projection );
+        return projection;
+    }
+
+    void ProjectionProfile( const Image & image, const std::vector<Roi> & roi, bool horizontal, std::vector<std::vector<uint32_t>> & projection )
+    {
+        ValidateImageParameters( image, roi );
+
+        Image_Function_Helper::RoiList::ProjectionProfile( image, roi, horizontal, projection );
+    }
+
+    std::vector<uint64_t> ProjectionProfile64( const Image & image, bool horizontal )
+    {
+        return Image_Function_Helper::ProjectionProfile64( ProjectionProfile64, image, horizontal );
+    }
+
+    void ProjectionProfile64( const Image & image, bool horizontal, std::vector<uint64_t> & projection )
+    {
+        ProjectionProfile64( image, 0, 0, image.width(), image.height(), horizontal, projection );
+    }
+
+    std::vector<uint64_t> ProjectionProfile64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal )
+    {
+        return Image_Function_Helper::ProjectionProfile64( ProjectionProfile64, image, x, y, width, height, horizontal );
+    }
+
+    void ProjectionProfile64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal, std::vector<uint64_t> & projection )
+    {
+        ValidateImageParameters( image, x, y, width, height );
+
+        const uint8_t colorCount = image.colorCount();
+
+        projection.resize( horizontal ? static_cast<size_t>( width ) * colorCount : height );
+        std::fill( projection.begin(), projection.end(), 0u );
+
+        const size_t rowSize = image.rowSize();
+
+        width = width * colorCount;
+
+        const uint8_t * imageY = image.data() + y * rowSize + x * colorCount;
+        const uint8_t * imageYEnd = imageY + height * rowSize;
+
+        if ( horizontal ) {
+            // Row by row traversal keeps memory access sequential for tall images
+            for ( ; imageY != imageYEnd; imageY += rowSize ) {
+                const uint8_t * imageX = imageY;
+                const uint8_t * imageXEnd = imageX + width;
+
+                std::vector<uint64_t>::iterator data = projection.begin();
+
+                for ( ; imageX != imageXEnd; ++imageX, ++data )
+                    ( *data ) += ( *imageX );
+            }
+        }
+        else {
+            std::vector<uint64_t>::iterator data = projection.begin();
+
+            for ( ; imageY != imageYEnd; imageY += rowSize, ++data ) {
+                const uint8_t * imageX = imageY;
+                const uint8_t * imageXEnd = imageX + width;
+
+                uint64_t sum = 0;
+                for ( ; imageX != imageXEnd; ++imageX )
+                    sum += ( *imageX );
+
+                ( *data ) = sum;
+            }
+        }
+    }
+
     void ReplaceChannel( const Image & channel, Image & rgb, uint8_t channelId )
     {
         ValidateImageParameters( channel, rgb );
@@ -1939,6 +2216,16 @@ namespace Image_Function
         }
     }
 
+    Image Subtract( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::Subtract( Subtract, in1, in2 );
+    }
+
+    void Subtract( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::Subtract( Subtract, in1, in2, out );
+    }
+
     uint32_t Sum( const Image & image )
     {
         return Sum( image, 0, 0, image.width(), image.height() );
@@ -1968,6 +2255,49 @@ namespace Image_Function
         return sum;
     }
 
+    uint32_t Sum( const ConstImageView & image )
+    {
+        return Image_Function_Helper::Sum( Sum, image );
+    }
+
+    std::vector<uint32_t> Sum( const Image & image, const std::vector<Roi> & roi )
+    {
+        ValidateImageParameters( image, roi );
+        if ( !roi.empty() )
+            VerifyGrayScaleImage( image );
+
+        return Image_Function_Helper::RoiList::Sum( image, roi );
+    }
+
+    uint64_t Sum64( const Image & image )
+    {
+        return Sum64( image, 0, 0, image.width(), image.height() );
+    }
+
+    uint64_t Sum64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height )
+    {
+        ValidateImageParameters( image, x, y, width, height );
+        VerifyGrayScaleImage( image );
+        OptimiseRoi( width, height, image );
+
+        const size_t rowSize = image.rowSize();
+
+        const uint8_t * imageY = image.data() + y * rowSize + x;
+        const uint8_t * imageYEnd = imageY + height * rowSize;
+
+        uint64_t sum = 0;
+
+        for ( ; imageY != imageYEnd; imageY += rowSize ) {
+            const uint8_t * imageX = imageY;
+            const uint8_t * imageXEnd = imageX + width;
+
+            for ( ; imageX != imageXEnd; ++imageX )
+                sum += ( *imageX );
+        }
+
+        return sum;
+    }
+
     Image Threshold( const Image & in, uint8_t threshold )
     {
         return Image_Function_Helper::Threshold( Threshold, in, threshold );
@@ -2009,6 +2339,16 @@ namespace Image_Function
         }
     }
 
+    Image Threshold( const ConstImageView & in, uint8_t threshold )
+    {
+        return Image_Function_Helper::Threshold( Threshold, in, threshold );
+    }
+
+    void Threshold( const ConstImageView & in, const ImageView & out, uint8_t threshold )
+    {
+        Image_Function_Helper::Threshold( Threshold, in, out, threshold );
+    }
+
     Image Threshold( const Image & in, uint8_t minThreshold, uint8_t maxThreshold )
     {
         return Image_Function_Helper::Threshold( Threshold, in, minThreshold, maxThreshold );
@@ -2053,6 +2393,16 @@ namespace Image_Function
         }
     }
 
+    Image Threshold( const ConstImageView & in, uint8_t minThreshold, uint8_t maxThreshold )
+    {
+        return Image_Function_Helper::Threshold( Threshold, in, minThreshold, maxThreshold );
+    }
+
+    void Threshold( const ConstImageView & in, const ImageView & out, uint8_t minThreshold, uint8_t maxThreshold )
+    {
+        Image_Function_Helper::Threshold( Threshold, in, out, minThreshold, maxThreshold );
+    }
+
     Image Transpose( const Image & in )
     {
         return Image_Function_Helper::Transpose( Transpose, in );
@@ -2093,3 +2443,79 @@ namespace Image_Function
         }
     }
 }
+
+namespace Image_Function_Helper
+{
+    namespace RoiList
+    {
+        void Histogram( const Image & image, const std::vector<Roi> & roi, std::vector<std::vector<uint32_t>> & histogram )
+        {
+            const uint32_t colorCount = image.colorCount();
+
+            histogram.resize( roi.size() );
+            for ( std::vector<std::vector<uint32_t>>::iterator data = histogram.begin(); data != histogram.end(); ++data )
+                data->assign( 256u * colorCount, 0u );
+
+            ProcessRoiRows( image, roi, [&]( size_t id, const uint8_t * imageX, uint32_t ) {
+                std::vector<uint32_t> & data = histogram[id];
+                const uint8_t * imageXEnd = imageX + roi[id].width * colorCount;
+
+                if ( colorCount == 1u ) {
+                    for ( ; imageX != imageXEnd; ++imageX )
+                        ++data[*imageX];
+                }
+                else {
+                    for ( ; imageX != imageXEnd; imageX += colorCount ) {
+                        for ( uint32_t colorChannel = 0; colorChannel < colorCount; ++colorChannel )
+                            ++data[*( imageX + colorChannel ) * colorCount + colorChannel];
+                    }
+                }
+            } );
+        }
+
+        void ProjectionProfile( const Image & image, const std::vector<Roi> & roi, bool horizontal, std::vector<std::vector<uint32_t>> & projection )
+        {
+            const uint32_t colorCount = image.colorCount();
+
+            projection.resize( roi.size() );
+            for ( size_t id = 0; id < roi.size(); ++id )
+                projection[id].assign( horizontal ? roi[id].width * colorCount : roi[id].height, 0u );
+
+            ProcessRoiRows( image, roi, [&]( size_t id, const uint8_t * imageX, uint32_t rowId ) {
+                const uint8_t * imageXEnd = imageX + roi[id].width * colorCount;
+
+                if ( horizontal ) {
+                    std::vector<uint32_t>::iterator data = projection[id].begin();
+
+                    for ( ; imageX != imageXEnd; ++imageX, ++data )
+                        ( *data ) += ( *imageX );
+                }
+                else {
+                    uint32_t sum = 0;
+
+                    for ( ; imageX != imageXEnd; ++imageX )
+                        sum += ( *imageX );
+
+                    projection[id][rowId] = sum;
+                }
+            } );
+        }
+
+        std::vector<uint32_t> Sum( const Image & image, const std::vector<Roi> & roi )
+        {
+            std::vector<uint32_t> sum( roi.size(), 0u );
+
+            ProcessRoiRows( image, roi, [&]( size_t id, const uint8_t * imageX, uint32_t ) {
+                const uint8_t * imageXEnd = imageX + roi[id].width;
+
+                uint32_t rowSum = 0;
+                for ( ; imageX != imageXEnd; ++imageX )
+                    rowSum += ( *imageX );
+
+                sum[id] += rowSum;
+            } );
+
+            return sum;
+        }
+    }
+}
@@ -33,10 +33,16 @@ namespace Image_Function
                               uint32_t height );
     void AbsoluteDifference( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out,
                              uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height );
+    Image AbsoluteDifference( const ConstImageView & in1, const ConstImageView & in2 );
+    void AbsoluteDifference( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     void Accumulate( const Image & image, std::vector<uint32_t> & result );
     void Accumulate( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint32_t> & result );
 
+    // 64-bit accumulators for images which could overflow 32-bit counters
+    void Accumulate64( const Image & image, std::vector<uint64_t> & result );
+    void Accumulate64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint64_t> & result );
+
     void BinaryDilate( Image & image, uint32_t dilationX, uint32_t dilationY );
     void BinaryDilate( Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t dilationX, uint32_t dilationY );
 
@@ -48,18 +54,24 @@ namespace Image_Function
     Image BitwiseAnd( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void BitwiseAnd( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                      uint32_t startYOut, uint32_t width, uint32_t height );
+    Image BitwiseAnd( const ConstImageView & in1, const ConstImageView & in2 );
+    void BitwiseAnd( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image BitwiseOr( const Image & in1, const Image & in2 );
     void BitwiseOr( const Image & in1, const Image & in2, Image & out );
     Image BitwiseOr( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void BitwiseOr( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                     uint32_t startYOut, uint32_t width, uint32_t height );
+    Image BitwiseOr( const ConstImageView & in1, const ConstImageView & in2 );
+    void BitwiseOr( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image BitwiseXor( const Image & in1, const Image & in2 );
     void BitwiseXor( const Image & in1, const Image & in2, Image & out );
     Image BitwiseXor( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void BitwiseXor( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                      uint32_t startYOut, uint32_t width, uint32_t height );
+    Image BitwiseXor( const ConstImageView & in1, const ConstImageView & in2 );
+    void BitwiseXor( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image16Bit ConvertTo16Bit( const Image & in );
     void ConvertTo16Bit( const Image & in, Image16Bit & out );
@@ -123,6 +135,13 @@ namespace Image_Function
     void Histogram( const Image & image, std::vector<uint32_t> & histogram );
     std::vector<uint32_t> Histogram( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
     void Histogram( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint32_t> & histogram );
+    std::vector<uint32_t> Histogram( const ConstImageView & image );
+    void Histogram( const ConstImageView & image, std::vector<uint32_t> & histogram );
+
+    // Functions taking a list of ROIs of one image return results per ROI in the same order as ROIs. ROIs are sorted by rows
+    // and the image is read once from top to bottom while all ROIs crossing a row are updated. ROIs could overlap
+    std::vector<std::vector<uint32_t>> Histogram( const Image & image, const std::vector<Roi> & roi );
+    void Histogram( const Image & image, const std::vector<Roi> & roi, std::vector<std::vector<uint32_t>> & histogram );
 
     std::vector<uint32_t> Histogram( const Image & image, const Image & mask );
     void Histogram( const Image & image, const Image & mask, std::vector<uint32_t> & histogram );
@@ -130,11 +149,18 @@ namespace Image_Function
     void Histogram( const Image & image, uint32_t x, uint32_t y, const Image & mask, uint32_t maskX, uint32_t maskY, uint32_t width, uint32_t height,
                     std::vector<uint32_t> & histogram );
 
+    std::vector<uint64_t> Histogram64( const Image & image );
+    void Histogram64( const Image & image, std::vector<uint64_t> & histogram );
+    std::vector<uint64_t> Histogram64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
+    void Histogram64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint64_t> & histogram );
+
     // Invert function is Bitwise NOT operation. But to make function name more user-friendly we named it like this
     Image Invert( const Image & in );
     void Invert( const Image & in, Image & out );
     Image Invert( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height );
     void Invert( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Invert( const ConstImageView & in );
+    void Invert( const ConstImageView & in, const ImageView & out );
 
     bool IsBinary( const Image & image );
     bool IsBinary( const Image & image, uint32_t startX, uint32_t startY, uint32_t width, uint32_t height );
@@ -153,6 +179,8 @@ namespace Image_Function
     Image Maximum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void Maximum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                   uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Maximum( const ConstImageView & in1, const ConstImageView & in2 );
+    void Maximum( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image Merge( const Image & in1, const Image & in2, const Image & in3 );
     void Merge( const Image & in1, const Image & in2, const Image & in3, Image & out );
@@ -166,6 +194,8 @@ namespace Image_Function
     Image Minimum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void Minimum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                   uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Minimum( const ConstImageView & in1, const ConstImageView & in2 );
+    void Minimum( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image Normalize( const Image & in );
     void Normalize( const Image & in, Image & out );
@@ -176,6 +206,13 @@ namespace Image_Function
     void ProjectionProfile( const Image & image, bool horizontal, std::vector<uint32_t> & projection );
     std::vector<uint32_t> ProjectionProfile( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal );
     void ProjectionProfile( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal, std::vector<uint32_t> & projection );
+    std::vector<std::vector<uint32_t>> ProjectionProfile( const Image & image, const std::vector<Roi> & roi, bool horizontal );
+    void ProjectionProfile( const Image & image, const std::vector<Roi> & roi, bool horizontal, std::vector<std::vector<uint32_t>> & projection );
+
+    std::vector<uint64_t> ProjectionProfile64( const Image & image, bool horizontal );
+    void ProjectionProfile64( const Image & image, bool horizontal, std::vector<uint64_t> & projection );
+    std::vector<uint64_t> ProjectionProfile64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal );
+    void ProjectionProfile64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal, std::vector<uint64_t> & projection );
 
     void ReplaceChannel( const Image & channel, Image & rgb, uint8_t channelId );
     void ReplaceChannel( const Image & channel, uint32_t startXChannel, uint32_t startYChannel, Image & rgb, uint32_t startXRgb, uint32_t startYRgb, uint32_t width,
@@ -227,11 +264,19 @@ namespace Image_Function
     Image Subtract( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void Subtract( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                    uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Subtract( const ConstImageView & in1, const ConstImageView & in2 );
+    void Subtract( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     // Make sure that your image is not so big to do not have overloaded uint32_t value
     // For example not bigger than [4096 * 4096] for 32-bit application
     uint32_t Sum( const Image & image );
     uint32_t Sum( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
+    uint32_t Sum( const ConstImageView & image );
+    std::vector<uint32_t> Sum( const Image & image, const std::vector<Roi> & roi );
+
+    // 64-bit version of Sum function suitable for images of any size
+    uint64_t Sum64( const Image & image );
+    uint64_t Sum64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
 
     // Thresholding works in such way:
     // if pixel intensity on input image is          less (  < ) than threshold then set pixel intensity on output image as 0
@@ -241,6 +286,8 @@ namespace Image_Function
     Image Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height, uint8_t threshold );
     void Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                     uint8_t threshold );
+    Image Threshold( const ConstImageView & in, uint8_t threshold );
+    void Threshold( const ConstImageView & in, const ImageView & out, uint8_t threshold );
 
     // Thresholding works in such way:
     // if pixel intensity on input image is less ( < ) than minimum threshold or more ( > ) than maximum threshold
@@ -251,6 +298,8 @@ namespace Image_Function
     Image Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height, uint8_t minThreshold, uint8_t maxThreshold );
     void Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                     uint8_t minThreshold, uint8_t maxThreshold );
+    Image Threshold( const ConstImageView & in, uint8_t minThreshold, uint8_t maxThreshold );
+    void Threshold( const ConstImageView & in, const ImageView & out, uint8_t minThreshold, uint8_t maxThreshold );
 
     // Swap columns and rows in input image. It is equivalent to 90 degree rotation
     // Output image (area) must be [height, width] compare to original [width, height]
@@ -21,7 +21,12 @@
 #include "image_function_helper.h"
 #include "parameter_validation.h"
 #include "penguinv/cpu_identification.h"
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
 
 namespace
 {
@@ -63,8 +68,11 @@ namespace
         SET_FUNCTION( ProjectionProfile )
         SET_FUNCTION( Resize )
         SET_FUNCTION( RgbToBgr )
+        SET_FUNCTION( RgbToRgba )
+        SET_FUNCTION( RgbaToRgb )
         SET_FUNCTION( SetPixel )
         SET_FUNCTION( SetPixel2 )
+        SET_FUNCTION( Shift )
         SET_FUNCTION( Split )
         SET_FUNCTION( Subtract )
         SET_FUNCTION( Sum )
@@ -72,6 +80,59 @@ namespace
         SET_FUNCTION( Threshold2 )
         SET_FUNCTION( Transpose )
     }
+
+    template <typename _Function>
+    void resolveFunction( _Function & F1, uint8_t & type, const _Function & F2, uint8_t newType )
+    {
+        if ( ( F1 == nullptr ) && ( F2 != nullptr ) ) {
+            F1 = F2;
+            type = newType;
+        }
+    }
+
+#define RESOLVE_FUNCTION( functionName ) resolveFunction( table.functionName, tableType.functionName, newTable.functionName, newType );
+
+    void resolveTable( Image_Function_Helper::FunctionTableHolder & table, Image_Function_Helper::FunctionTypeHolder & tableType,
+                       const Image_Function_Helper::FunctionTableHolder & newTable, uint8_t newType )
+    {
+        RESOLVE_FUNCTION( AbsoluteDifference )
+        RESOLVE_FUNCTION( Accumulate )
+        RESOLVE_FUNCTION( BitwiseAnd )
+        RESOLVE_FUNCTION( BitwiseOr )
+        RESOLVE_FUNCTION( BitwiseXor )
+        RESOLVE_FUNCTION( ConvertTo16Bit )
+        RESOLVE_FUNCTION( ConvertTo8Bit )
+        RESOLVE_FUNCTION( ConvertToGrayScale )
+        RESOLVE_FUNCTION( ConvertToRgb )
+        RESOLVE_FUNCTION( Copy )
+        RESOLVE_FUNCTION( ExtractChannel )
+        RESOLVE_FUNCTION( Fill )
+        RESOLVE_FUNCTION( Flip )
+        RESOLVE_FUNCTION( GammaCorrection )
+        RESOLVE_FUNCTION( GetPixel )
+        RESOLVE_FUNCTION( Histogram )
+        RESOLVE_FUNCTION( Invert )
+        RESOLVE_FUNCTION( IsEqual )
+        RESOLVE_FUNCTION( LookupTable )
+        RESOLVE_FUNCTION( Maximum )
+        RESOLVE_FUNCTION( Merge )
+        RESOLVE_FUNCTION( Minimum )
+        RESOLVE_FUNCTION( Normalize )
+        RESOLVE_FUNCTION( ProjectionProfile )
+        RESOLVE_FUNCTION( Resize )
+        RESOLVE_FUNCTION( RgbToBgr )
+        RESOLVE_FUNCTION( RgbToRgba )
+        RESOLVE_FUNCTION( RgbaToRgb )
+        RESOLVE_FUNCTION( SetPixel )
+        RESOLVE_FUNCTION( SetPixel2 )
+        RESOLVE_FUNCTION( Shift )
+        RESOLVE_FUNCTION( Split )
+        RESOLVE_FUNCTION( Subtract )
+        RESOLVE_FUNCTION( Sum )
+        RESOLVE_FUNCTION( Threshold )
+        RESOLVE_FUNCTION( Threshold2 )
+        RESOLVE_FUNCTION( Transpose )
+    }
 }
 
 namespace Image_Function_Helper
@@ -106,6 +167,20 @@ namespace Image_Function_Helper
         return out;
     }
 
+    Image AbsoluteDifference( FunctionTable::AbsoluteDifferenceForm4 absoluteDifference, const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        Image_Function::ValidateImageViewParameters( in1, in2 );
+
+        return AbsoluteDifference( absoluteDifference, in1.image(), in1.x(), in1.y(), in2.image(), in2.x(), in2.y(), in1.width(), in1.height() );
+    }
+
+    void AbsoluteDifference( FunctionTable::AbsoluteDifferenceForm4 absoluteDifference, const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function::ValidateImageViewParameters( in1, in2, out );
+
+        absoluteDifference( in1.image(), in1.x(), in1.y(), in2.image(), in2.x(), in2.y(), out.image(), out.x(), out.y(), out.width(), out.height() );
+    }
+
     void Accumulate( FunctionTable::AccumulateForm2 accumulate, const Image & image, std::vector<uint32_t> & result )
     {
         Image_Function::ValidateImageParameters( image );
@@ -113,6 +188,13 @@ namespace Image_Function_Helper
         accumulate( image, 0, 0, image.width(), image.height(), result );
     }
 
+    void Accumulate64( FunctionTable::Accumulate64Form2 accumulate, const Image & image, std::vector<uint64_t> & result )
+    {
+        Image_Function::ValidateImageParameters( image );
+
+        accumulate( image, 0, 0, image.width(), image.height(), result );
+    }
+
     Image BitwiseAnd( FunctionTable::BitwiseAndForm4 bitwiseAnd, const Image & in1, const Image & in2 )
     {
         Image_Function::ValidateImageParameters( in1, in2 );
@@ -143,6 +225,20 @@ namespace Image_Function_Helper
         return out;
     }
 
+    Image BitwiseAnd( FunctionTable::BitwiseAndForm4 bitwiseAnd, const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        Image_Function::ValidateImageViewParameters( in1, in2 );
+
+        return BitwiseAnd( bitwiseAnd, in1.image(), in1.x(), in1.y(), in2.image(), in2.x(), in2.y(), in1.width(), in1.height() );
+    }
+
+    void BitwiseAnd( FunctionTable::BitwiseAndForm4 bitwiseAnd, const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function::ValidateImageViewParameters( in1, in2, out );
+
+        bitwiseAnd( in1.image(), in1.x(), in1.y(), in2.image(), in2.x(), in2.y(), out.image(), out.x(), out.y(), out.width(), out.height() );
+    }
+
     Image BitwiseOr( FunctionTable::BitwiseOrForm4 bitwiseOr, const Image & in1, const Image & in2 )
     {
         Image_Function::ValidateImageParameters( in1, in2 );
@@ -173,6 +269,20 @@ namespace Image_Function_Helper
         return out;
     }
 
+    Image BitwiseOr( FunctionTable::BitwiseOrForm4 bitwiseOr, const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        Image_Function::ValidateImageViewParameters( in1, in2 );
+
+        return BitwiseOr( bitwiseOr, in1.image(), in1.x(), in1.y(), in2.image(), in2.x(), in2.y(), in1.width(), in1.height() );
+    }
+
+    void BitwiseOr( FunctionTable::BitwiseOrForm4 bitwiseOr, const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function::ValidateImageViewParameters( in1, in2, out );
+
+        bitwiseOr( in1.image(), in1.x(), in1.y(), in2.image(), in2.x(), in2.y(), out.image(), out.x(), out.y(), out.width(), out.height() );
+    }
+
     Image BitwiseXor( FunctionTable::BitwiseXorForm4 bitwiseXor, const Image & in1, const Image & in2 )
     {
         Image_Function::ValidateImageParameters( in1, in2 );
@@ -203,6 +313,20 @@ namespace Image_Function_Helper
         return out;
     }
 
+    Image BitwiseXor( FunctionTable::BitwiseXorForm4 bitwiseXor, const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        Image_Function::ValidateImageViewParameters( in1, in2 );
+
+        return BitwiseXor( bitwiseXor, in1.image(), in1.x(), in1.y(), in2.image(), in2.x(), in2.y(), in1.width(), in1.height() );
+    }
+
+    void BitwiseXor( FunctionTable::BitwiseXorForm4 bitwiseXor, const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function::ValidateImageViewParameters( in1, in2, out );
+
+        bitwiseXor( in1.image(), in1.x(), in1.y(), in2.image(), in2.x(), in2.y(), out.image(), out.x(), out.y(), out.width(), out.height() );
+    }
+
     void ConvertTo16Bit( FunctionTable::ConvertTo16BitForm4 convertTo16Bit, const Image & in, Image16Bit & out )
     {
         Image_Function::ValidateImageParameters( in );
@@ -466,6 +590,43 @@ namespace Image_Function_Helper
         return histogramTable;
     }
 
+    std::vector<uint32_t> Histogram( FunctionTable::HistogramForm4 histogram, const ConstImageView & image )
+    {
+        return Histogram( histogram, image.image(), image.x(), image.y(), image.width(), image.height() );
+    }
+
+    void Histogram( FunctionTable::HistogramForm4 histogram, const ConstImageView & image, std::vector<uint32_t> & histogramTable )
+    {
+        histogram( image.image(), image.x(), image.y(), image.width(), image.height(), histogramTable );
+    }
+
+    std::vector<uint64_t> Histogram64( FunctionTable::Histogram64Form4 histogram, const Image & image )
+    {
+        std::vector<uint64_t> histogramTable;
+
+        histogram( image, 0, 0, image.width(), image.height(), histogramTable );
+
+        return histogramTable;
+    }
+
+    void Histogram64( FunctionTable::Histogram64Form4 histogram, const Image & image, std::vector<uint64_t> & histogramTable )
+    {
+        Image_Function::ValidateImageParameters( image );
+
+        histogram( image, 0, 0, image.width(), image.height(), histogramTable );
+    }
+
+    std::vector<uint64_t> Histogram64( FunctionTable::Histogram64Form4 histogram, const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height )
+    {
+        Image_Function::ValidateImageParameters( image, x, y, width, height );
+
+        std::vector<uint64_t> histogramTable;
+
+        histogram( image, x, y, width, height, histogramTable );
+
+        return histogramTable;
+    }
+
     std::vector<uint32_t> Histogram( FunctionTable::HistogramForm8 histogram, const Image & image, const Image & mask )
     {
         Image_Function::ValidateImageParameters( image, mask );
@@ -525,6 +686,18 @@ namespace Image_Function_Helper
         return out;
     }
 
+    Image Invert( FunctionTable::InvertForm4 invert, const ConstImageView & in )
+    {
+        return Invert( invert, in.image(), in.x(), in.y(), in.width(), in.height() );
+    }
+
+    void Invert( FunctionTable::InvertForm4 invert, const ConstImageView & in, const ImageView & out )
+    {
+        Image_Function::ValidateImageViewParameters( in, out );
+
+        invert( in.image(), in.x(), in.y(), out.image(), out.x(), out.y(), out.width(), out.height() );
+    }
+
     bool IsEqual( FunctionTable::IsEqualForm2 isEqual, const Image & in1, const Image & in2 )
     {
         Image_Function::ValidateImageParameters( in1, in2 );
@@ -592,6 +765,20 @@ namespace Image_Function_Helper
         return out;
     }
 
+    Image Maximum( FunctionTable::MaximumForm4 maximum, const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        Image_Function::ValidateImageViewParameters( in1, in2 );
+
+        return Maximum( maximum, in1.image(), in1.x(), in1.y(), in2.image(), in2.x(), in2.y(), in1.width(), in1.height() );
+    }
+
+    void Maximum( FunctionTable::MaximumForm4 maximum, const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function::ValidateImageViewParameters( in1, in2, out );
+
+        maximum( in1.image(), in1.x(), in1.y(), in2.image(), in2.x(), in2.y(), out.image(), out.x(), out.y(), out.width(), out.height() );
+    }
+
     Image Merge( FunctionTable::MergeForm4 merge, const Image & in1, const Image & in2, const Image & in3 )
     {
         Image_Function::ValidateImageParameters( in1, in2, in3 );
@@ -653,6 +840,20 @@ namespace Image_Function_Helper
         return out;
     }
 
+    Image Minimum( FunctionTable::MinimumForm4 minimum, const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        Image_Function::ValidateImageViewParameters( in1, in2 );
+
+        return Minimum( minimum, in1.image(), in1.x(), in1.y(), in2.image(), in2.x(), in2.y(), in1.width(), in1.height() );
+    }
+
+    void Minimum( FunctionTable::MinimumForm4 minimum, const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function::ValidateImageViewParameters( in1, in2, out );
+
+        minimum( in1.image(), in1.x(), in1.y(), in2.image(), in2.x(), in2.y(), out.image(), out.x(), out.y(), out.width(), out.height() );
+    }
+
     Image Normalize( FunctionTable::NormalizeForm4 normalize, const Image & in )
     {
         Image_Function::ValidateImageParameters( in );
@@ -706,6 +907,30 @@ namespace Image_Function_Helper
         return projection;
     }
 
+    std::vector<uint64_t> ProjectionProfile64( FunctionTable::ProjectionProfile64Form4 projectionProfile, const Image & image, bool horizontal )
+    {
+        std::vector<uint64_t> projection;
+
+        projectionProfile( image, 0, 0, image.width(), image.height(), horizontal, projection );
+
+        return projection;
+    }
+
+    void ProjectionProfile64( FunctionTable::ProjectionProfile64Form4 projectionProfile, const Image & image, bool horizontal, std::vector<uint64_t> & projection )
+    {
+        projectionProfile( image, 0, 0, image.width(), image.height(), horizontal, projection );
+    }
+
+    std::vector<uint64_t> ProjectionProfile64( FunctionTable::ProjectionProfile64Form4 projectionProfile, const Image & image, uint32_t x, uint32_t y,
+                                               uint32_t width, uint32_t height, bool horizontal )
+    {
+        std::vector<uint64_t> projection;
+
+        projectionProfile( image, x, y, width, height, horizontal, projection );
+
+        return projection;
+    }
+
     Image Resize( FunctionTable::ResizeForm4 resize, const Image & in, uint32_t widthOut, uint32_t heightOut )
     {
         Image_Function::ValidateImageParameters( in );
@@ -929,6 +1154,25 @@ namespace Image_Function_Helper
         return out;
     }
 
+    Image Subtract( FunctionTable::SubtractForm4 subtract, const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        Image_Function::ValidateImageViewParameters( in1, in2 );
+
+        return Subtract( subtract, in1.image(), in1.x(), in1.y(), in2.image(), in2.x(), in2.y(), in1.width(), in1.height() );
+    }
+
+    void Subtract( FunctionTable::SubtractForm4 subtract, const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function::ValidateImageViewParameters( in1, in2, out );
+
+        subtract( in1.image(), in1.x(), in1.y(), in2.image(), in2.x(), in2.y(), out.image(), out.x(), out.y(), out.width(), out.height() );
+    }
+
+    uint32_t Sum( FunctionTable::SumForm2 sum, const ConstImageView & image )
+    {
+        return sum( image.image(), image.x(), image.y(), image.width(), image.height() );
+    }
+
     Image Threshold( FunctionTable::ThresholdForm4 threshold, const Image & in, uint8_t thresholdValue )
     {
         Image_Function::ValidateImageParameters( in );
@@ -959,6 +1203,18 @@ namespace Image_Function_Helper
         return out;
     }
 
+    Image Threshold( FunctionTable::ThresholdForm4 threshold, const ConstImageView & in, uint8_t thresholdValue )
+    {
+        return Threshold( threshold, in.image(), in.x(), in.y(), in.width(), in.height(), thresholdValue );
+    }
+
+    void Threshold( FunctionTable::ThresholdForm4 threshold, const ConstImageView & in, const ImageView & out, uint8_t thresholdValue )
+    {
+        Image_Function::ValidateImageViewParameters( in, out );
+
+        threshold( in.image(), in.x(), in.y(), out.image(), out.x(), out.y(), out.width(), out.height(), thresholdValue );
+    }
+
     Image Threshold( FunctionTable::ThresholdDoubleForm4 threshold, const Image & in, uint8_t minThreshold, uint8_t maxThreshold )
     {
         Image_Function::ValidateImageParameters( in );
@@ -989,6 +1245,19 @@ namespace Image_Function_Helper
         return out;
     }
 
+    Image Threshold( FunctionTable::ThresholdDoubleForm4 threshold, const ConstImageView & in, uint8_t minThreshold, uint8_t maxThreshold )
+    {
+        return Threshold( threshold, in.image(), in.x(), in.y(), in.width(), in.height(), minThreshold, maxThreshold );
+    }
+
+    void Threshold( FunctionTable::ThresholdDoubleForm4 threshold, const ConstImageView & in, const ImageView & out, uint8_t minThreshold,
+                    uint8_t maxThreshold )
+    {
+        Image_Function::ValidateImageViewParameters( in, out );
+
+        threshold( in.image(), in.x(), in.y(), out.image(), out.x(), out.y(), out.width(), out.height(), minThreshold, maxThreshold );
+    }
+
     Image Transpose( FunctionTable::TransposeForm4 transpose, const Image & in )
     {
         Image_Function::ValidateImageParameters( in );
@@ -1032,20 +1301,30 @@ ImageTypeManager & ImageTypeManager::instance()
 
 void ImageTypeManager::setFunctionTable( uint8_t type, const Image_Function_Helper::FunctionTableHolder & table, bool forceSetup )
 {
-    std::map<uint8_t, Image_Function_Helper::FunctionTableHolder>::iterator oldTable = _functionTableMap.find( type );
-    if ( oldTable != _functionTableMap.end() )
-        setupTable( oldTable->second, table, forceSetup );
-    else
-        _functionTableMap[type] = table;
+    if ( _functionTable[type] ) {
+        setupTable( _functionTable[type]->table, table, forceSetup );
+    }
+    else {
+        _functionTable[type].reset( new FunctionTableEntry );
+        _functionTable[type]->table = table;
+    }
+
+    _resolveIntertypeFunctions();
 }
 
 const Image_Function_Helper::FunctionTableHolder & ImageTypeManager::functionTable( uint8_t type ) const
 {
-    std::map<uint8_t, Image_Function_Helper::FunctionTableHolder>::const_iterator table = _functionTableMap.find( type );
-    if ( table == _functionTableMap.end() )
-        throw penguinVException( "Function table is not initialised" );
+    return _entry( type ).table;
+}
 
-    return table->second;
+const Image_Function_Helper::FunctionTableHolder & ImageTypeManager::intertypeFunctionTable( uint8_t type ) const
+{
+    return _entry( type ).intertypeTable;
+}
+
+const Image_Function_Helper::FunctionTypeHolder & ImageTypeManager::intertypeFunctionType( uint8_t type ) const
+{
+    return _entry( type ).intertypeType;
 }
 
 void ImageTypeManager::setConvertFunction( Image_Function_Helper::FunctionTable::CopyForm1 Copy, const penguinV::Image & in, const penguinV::Image & out )
@@ -1082,8 +1361,10 @@ std::vector<uint8_t> ImageTypeManager::imageTypes() const
 {
     std::vector<uint8_t> type;
 
-    for ( std::map<uint8_t, Image_Function_Helper::FunctionTableHolder>::const_iterator item = _functionTableMap.cbegin(); item != _functionTableMap.cend(); ++item )
-        type.push_back( item->first );
+    for ( size_t i = 0; i < _functionTable.size(); ++i ) {
+        if ( _functionTable[i] )
+            type.push_back( static_cast<uint8_t>( i ) );
+    }
 
     return type;
 }
@@ -1098,6 +1379,398 @@ bool ImageTypeManager::isIntertypeConversionEnabled() const
     return _enabledIntertypeConversion;
 }
 
+const ImageTypeManager::FunctionTableEntry & ImageTypeManager::_entry( uint8_t type ) const
+{
+    const FunctionTableEntry * entry = _functionTable[type].get();
+    if ( entry == nullptr )
+        throw penguinVException( "Function table is not initialised" );
+
+    return *entry;
+}
+
+void ImageTypeManager::_resolveIntertypeFunctions()
+{
+    for ( size_t i = 0; i < _functionTable.size(); ++i ) {
+        FunctionTableEntry * entry = _functionTable[i].get();
+        if ( entry == nullptr )
+            continue;
+
+        entry->intertypeTable = Image_Function_Helper::FunctionTableHolder();
+        entry->intertypeType = Image_Function_Helper::FunctionTypeHolder();
+
+        // functions of own type have priority over functions of other types
+        resolveTable( entry->intertypeTable, entry->intertypeType, entry->table, static_cast<uint8_t>( i ) );
+
+        for ( size_t j = 0; j < _functionTable.size(); ++j ) {
+            if ( _functionTable[j] && ( j != i ) )
+                resolveTable( entry->intertypeTable, entry->intertypeType, _functionTable[j]->table, static_cast<uint8_t>( j ) );
+        }
+    }
+}
+
+namespace
+{
+#define CALL_FUNCTION( functionName, ... )                                                                                                                               \
+    case BackendSelector::functionName:                                                                                                                                  \
+        if ( call && ( table.functionName != nullptr ) )                                                                                                                 \
+            table.functionName( __VA_ARGS__ );                                                                                                                           \
+        return table.functionName != nullptr;
+
+    // returns false if the function table does not contain the function
+    bool callFunction( BackendSelector::Function function, const Image_Function_Helper::FunctionTableHolder & table, const penguinV::Image & in1,
+                       const penguinV::Image & in2, penguinV::Image & out, bool call )
+    {
+        const uint32_t width = in1.width();
+        const uint32_t height = in1.height();
+        std::vector<uint32_t> histogram;
+
+        switch ( function ) {
+            CALL_FUNCTION( AbsoluteDifference, in1, 0, 0, in2, 0, 0, out, 0, 0, width, height )
+            CALL_FUNCTION( BitwiseAnd, in1, 0, 0, in2, 0, 0, out, 0, 0, width, height )
+            CALL_FUNCTION( BitwiseOr, in1, 0, 0, in2, 0, 0, out, 0, 0, width, height )
+            CALL_FUNCTION( BitwiseXor, in1, 0, 0, in2, 0, 0, out, 0, 0, width, height )
+            CALL_FUNCTION( Histogram, in1, 0, 0, width, height, histogram )
+            CALL_FUNCTION( Invert, in1, 0, 0, out, 0, 0, width, height )
+            CALL_FUNCTION( Maximum, in1, 0, 0, in2, 0, 0, out, 0, 0, width, height )
+            CALL_FUNCTION( Minimum, in1, 0, 0, in2, 0, 0, out, 0, 0, width, height )
+            CALL_FUNCTION( Subtract, in1, 0, 0, in2, 0, 0, out, 0, 0, width, height )
+            CALL_FUNCTION( Sum, in1, 0, 0, width, height )
+            CALL_FUNCTION( Threshold, in1, 0, 0, out, 0, 0, width, height, 128u )
+            CALL_FUNCTION( Threshold2, in1, 0, 0, out, 0, 0, width, height, 64u, 192u )
+        default:
+            return false;
+        }
+    }
+
+    // minimum time in seconds of several function calls
+    double measureTime( const std::function<void()> & function )
+    {
+        function(); // the first call warms up caches and allocates memory
+
+        double minimumTime = std::numeric_limits<double>::max();
+        double totalTime = 0;
+
+        for ( uint32_t i = 0; ( i < 3u ) || ( ( i < 100u ) && ( totalTime < 0.002 ) ); ++i ) {
+            const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+            function();
+            const double time = std::chrono::duration<double>( std::chrono::high_resolution_clock::now() - start ).count();
+
+            minimumTime = std::min( minimumTime, time );
+            totalTime += time;
+        }
+
+        return minimumTime;
+    }
+}
+
+BackendSelector::BackendSelector()
+    : _enabled( false )
+{
+    Backend backend;
+    backend.name = "simd";
+    backend.imageType = penguinV::Image().type();
+
+    _backend.push_back( backend );
+    _cost.push_back( CostTable() );
+    _updateDecision();
+}
+
+BackendSelector & BackendSelector::instance()
+{
+    static BackendSelector selector;
+    return selector;
+}
+
+void BackendSelector::registerBackend( const std::string & name, uint8_t imageType, const Image_Function_Helper::FunctionTableHolder & table )
+{
+    size_t id = _backendId( name );
+    if ( id == 0 )
+        throw penguinVException( "Function table of CPU images cannot be registered as a backend" );
+
+    if ( id == _backend.size() ) {
+        _backend.push_back( Backend() );
+        _cost.push_back( CostTable() );
+    }
+
+    _backend[id].name = name;
+    _backend[id].imageType = imageType;
+    _backend[id].table = table;
+
+    _updateDecision();
+}
+
+std::vector<std::string> BackendSelector::backends() const
+{
+    std::vector<std::string> name;
+
+    for ( std::vector<Backend>::const_iterator backend = _backend.begin(); backend != _backend.end(); ++backend )
+        name.push_back( backend->name );
+
+    return name;
+}
+
+void BackendSelector::enable( bool enable )
+{
+    _enabled = enable;
+}
+
+bool BackendSelector::isEnabled() const
+{
+    return _enabled;
+}
+
+void BackendSelector::calibrate( const std::vector<uint32_t> & size )
+{
+    ImageTypeManager & manager = ImageTypeManager::instance();
+
+    for ( std::vector<uint32_t>::const_iterator side = size.begin(); side != size.end(); ++side ) {
+        if ( *side == 0u )
+            continue;
+
+        penguinV::Image in1( *side, *side );
+        penguinV::Image in2( *side, *side );
+        penguinV::Image out( *side, *side );
+        in1.fill( 64u );
+        in2.fill( 192u );
+
+        const size_t sizeClass = _sizeClass( static_cast<uint64_t>( *side ) * *side );
+
+        for ( size_t id = 0; id < _backend.size(); ++id ) {
+            const Backend & backend = _backend[id];
+            const Image_Function_Helper::FunctionTableHolder & table = ( id == 0 ) ? manager.functionTable( backend.imageType ) : backend.table;
+
+            for ( size_t i = 0; i < FunctionCount; ++i ) {
+                const Function function = static_cast<Function>( i );
+                if ( !callFunction( function, table, in1, in2, out, false ) )
+                    continue;
+
+                double time = 0;
+
+                try {
+                    if ( backend.imageType == in1.type() ) {
+                        time = measureTime( [&]() { callFunction( function, table, in1, in2, out, true ); } );
+                    }
+                    else {
+                        // conversion of images is a part of the cost
+                        const penguinV::Image reference = manager.image( backend.imageType );
+                        time = measureTime( [&]() {
+                            penguinV::Image in1Converted = reference.generate( in1.width(), in1.height() );
+                            penguinV::Image in2Converted = reference.generate( in2.width(), in2.height() );
+                            penguinV::Image outConverted = reference.generate( out.width(), out.height() );
+
+                            manager.convert( in1, in1Converted );
+                            manager.convert( in2, in2Converted );
+                            callFunction( function, table, in1Converted, in2Converted, outConverted, true );
+                            manager.convert( outConverted, out );
+                        } );
+                    }
+                }
+                catch ( const penguinVException & ) {
+                    continue; // the backend is not ready to work, for example its thread pool or device is not initialized
+                }
+
+                _cost[id][function][sizeClass] = std::max( time, std::numeric_limits<double>::min() );
+            }
+        }
+    }
+
+    _updateDecision();
+}
+
+void BackendSelector::setCost( Function function, const std::string & backend, uint64_t pixelCount, double time )
+{
+    const size_t id = _backendId( backend );
+    if ( id == _backend.size() )
+        throw penguinVException( "Backend is not registered" );
+    if ( function >= FunctionCount || !( time > 0 ) )
+        throw penguinVException( "Invalid backend cost" );
+
+    _cost[id][function][_sizeClass( pixelCount )] = time;
+
+    _updateDecision();
+}
+
+double BackendSelector::cost( Function function, const std::string & backend, uint64_t pixelCount ) const
+{
+    const size_t id = _backendId( backend );
+    if ( id == _backend.size() )
+        throw penguinVException( "Backend is not registered" );
+    if ( function >= FunctionCount )
+        throw penguinVException( "Invalid function for backend selection" );
+
+    return _estimate( _cost[id], function, _sizeClass( pixelCount ) );
+}
+
+void BackendSelector::resetCost()
+{
+    for ( std::vector<CostTable>::iterator cost = _cost.begin(); cost != _cost.end(); ++cost )
+        cost->fill( std::array<double, SIZE_CLASS_COUNT>() );
+
+    _updateDecision();
+}
+
+void BackendSelector::save( const std::string & path ) const
+{
+    std::ofstream file( path.c_str() );
+    if ( !file )
+        throw penguinVException( "Cannot create a file for backend costs" );
+
+    file << "# function backend pixels seconds" << std::endl;
+    file.precision( 9 );
+
+    for ( size_t id = 0; id < _backend.size(); ++id ) {
+        for ( size_t function = 0; function < FunctionCount; ++function ) {
+            for ( size_t sizeClass = 0; sizeClass < SIZE_CLASS_COUNT; ++sizeClass ) {
+                if ( _cost[id][function][sizeClass] > 0 )
+                    file << functionName( static_cast<Function>( function ) ) << ' ' << _backend[id].name << ' ' << ( static_cast<uint64_t>( 1u ) << sizeClass )
+                         << ' ' << _cost[id][function][sizeClass] << std::endl;
+            }
+        }
+    }
+
+    if ( !file )
+        throw penguinVException( "Cannot write backend costs into a file" );
+}
+
+void BackendSelector::load( const std::string & path )
+{
+    std::ifstream file( path.c_str() );
+    if ( !file )
+        throw penguinVException( "Cannot open a file with backend costs" );
+
+    std::vector<CostTable> cost( _cost.size(), CostTable() );
+
+    std::string line;
+    while ( std::getline( file, line ) ) {
+        if ( line.empty() || line[0] == '#' )
+            continue;
+
+        std::istringstream stream( line );
+        std::string function;
+        std::string backend;
+        uint64_t pixelCount = 0;
+        double time = 0;
+
+        if ( !( stream >> function >> backend >> pixelCount >> time ) || !( time > 0 ) )
+            throw penguinVException( "Invalid format of backend cost file" );
+
+        size_t functionId = 0;
+        while ( ( functionId < FunctionCount ) && ( function != functionName( static_cast<Function>( functionId ) ) ) )
+            ++functionId;
+
+        if ( functionId == FunctionCount )
+            throw penguinVException( "Unknown function in backend cost file" );
+
+        // backends could be absent on this system
+        const size_t id = _backendId( backend );
+        if ( id < cost.size() )
+            cost[id][functionId][_sizeClass( pixelCount )] = time;
+    }
+
+    _cost.swap( cost );
+    _updateDecision();
+}
+
+const BackendSelector::Backend * BackendSelector::select( Function function, uint8_t imageType, uint32_t width, uint32_t height ) const
+{
+    if ( !_enabled || ( imageType != _backend[0].imageType ) )
+        return nullptr;
+
+    const size_t id = _decision[function][_sizeClass( static_cast<uint64_t>( width ) * height )];
+
+    if ( _hook ) {
+        const Decision decision = { function, width, height, _backend[id].name };
+        _hook( decision );
+    }
+
+    return ( id == 0 ) ? nullptr : &_backend[id];
+}
+
+void BackendSelector::setDecisionHook( const std::function<void( const Decision & )> & hook )
+{
+    _hook = hook;
+}
+
+const char * BackendSelector::functionName( Function function )
+{
+    static const char * name[FunctionCount] = { "AbsoluteDifference", "BitwiseAnd", "BitwiseOr", "BitwiseXor", "Histogram", "Invert",
+                                                "Maximum",            "Minimum",    "Subtract",  "Sum",        "Threshold", "Threshold2" };
+
+    if ( function >= FunctionCount )
+        throw penguinVException( "Invalid function for backend selection" );
+
+    return name[function];
+}
+
+size_t BackendSelector::_backendId( const std::string & name ) const
+{
+    size_t id = 0;
+    while ( ( id < _backend.size() ) && ( _backend[id].name != name ) )
+        ++id;
+
+    return id;
+}
+
+double BackendSelector::_estimate( const CostTable & cost, Function function, size_t sizeClass ) const
+{
+    const std::array<double, SIZE_CLASS_COUNT> & time = cost[function];
+    if ( time[sizeClass] > 0 )
+        return time[sizeClass];
+
+    size_t lower = sizeClass;
+    while ( ( lower > 0 ) && !( time[lower - 1] > 0 ) )
+        --lower;
+
+    size_t upper = sizeClass + 1;
+    while ( ( upper < SIZE_CLASS_COUNT ) && !( time[upper] > 0 ) )
+        ++upper;
+
+    if ( lower > 0 ) {
+        --lower;
+
+        // time of large areas is proportional to number of pixels
+        if ( upper == SIZE_CLASS_COUNT )
+            return time[lower] * static_cast<double>( static_cast<uint64_t>( 1u ) << ( sizeClass - lower ) );
+
+        return time[lower] + ( time[upper] - time[lower] ) * static_cast<double>( sizeClass - lower ) / static_cast<double>( upper - lower );
+    }
+
+    // time of small areas is mostly overhead of a call
+    if ( upper < SIZE_CLASS_COUNT )
+        return time[upper];
+
+    return -1;
+}
+
+void BackendSelector::_updateDecision()
+{
+    for ( size_t function = 0; function < FunctionCount; ++function ) {
+        for ( size_t sizeClass = 0; sizeClass < SIZE_CLASS_COUNT; ++sizeClass ) {
+            size_t selected = 0;
+            double selectedTime = _estimate( _cost[0], static_cast<Function>( function ), sizeClass );
+
+            for ( size_t id = 1; id < _backend.size(); ++id ) {
+                const double time = _estimate( _cost[id], static_cast<Function>( function ), sizeClass );
+                if ( ( time > 0 ) && ( !( selectedTime > 0 ) || ( time < selectedTime ) ) ) {
+                    selected = id;
+                    selectedTime = time;
+                }
+            }
+
+            _decision[function][sizeClass] = selected;
+        }
+    }
+}
+
+size_t BackendSelector::_sizeClass( uint64_t pixelCount )
+{
+    if ( pixelCount < 2u )
+        return 0u;
+
+    const size_t sizeClass = static_cast<size_t>( std::floor( std::log2( static_cast<double>( pixelCount ) ) + 0.5 ) );
+    return std::min( sizeClass, static_cast<size_t>( SIZE_CLASS_COUNT - 1 ) );
+}
+
 namespace simd
 {
     bool isAvx512Enabled = true;
@@ -1135,22 +1808,22 @@ namespace simd
 
     SIMDType actualSimdType()
     {
-#ifdef PENGUINV_AVX512_SKL_SET
+#ifdef PENGUINV_AVX512_SKL_DISPATCH
         if ( SimdInfo::isAVX512SKLAvailable() && isAvx512Enabled )
             return avx512_function;
 #endif
 
-#ifdef PENGUINV_AVX_SET
+#ifdef PENGUINV_AVX_DISPATCH
         if ( SimdInfo::isAvxAvailable() && isAvxEnabled )
             return avx_function;
 #endif
 
-#ifdef PENGUINV_SSE_SET
+#ifdef PENGUINV_SSE_DISPATCH
         if ( SimdInfo::isSseAvailable() && isSseEnabled )
             return sse_function;
 #endif
 
-#ifdef PENGUINV_NEON_SET
+#ifdef PENGUINV_NEON_DISPATCH
         if ( SimdInfo::isNeonAvailable() && isNeonEnabled )
             return neon_function;
 #endif
@@ -20,7 +20,12 @@
 
 #pragma once
 #include "image_buffer.h"
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace Image_Function_Helper
@@ -39,6 +44,8 @@ namespace Image_Function_Helper
 
         typedef void ( *AccumulateForm1 )( const Image & image, std::vector<uint32_t> & result );
         typedef void ( *AccumulateForm2 )( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint32_t> & result );
+        typedef void ( *Accumulate64Form1 )( const Image & image, std::vector<uint64_t> & result );
+        typedef void ( *Accumulate64Form2 )( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint64_t> & result );
 
         typedef void ( *BinaryDilateForm1 )( Image & image, uint32_t dilationX, uint32_t dilationY );
         typedef void ( *BinaryDilateForm2 )( Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t dilationX, uint32_t dilationY );
@@ -133,6 +140,11 @@ namespace Image_Function_Helper
         typedef void ( *HistogramForm8 )( const Image & image, uint32_t x, uint32_t y, const Image & mask, uint32_t maskX, uint32_t maskY, uint32_t width,
                                           uint32_t height, std::vector<uint32_t> & histogram );
 
+        typedef std::vector<uint64_t> ( *Histogram64Form1 )( const Image & image );
+        typedef void ( *Histogram64Form2 )( const Image & image, std::vector<uint64_t> & histogram );
+        typedef std::vector<uint64_t> ( *Histogram64Form3 )( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
+        typedef void ( *Histogram64Form4 )( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint64_t> & histogram );
+
         typedef Image ( *InvertForm1 )( const Image & in );
         typedef void ( *InvertForm2 )( const Image & in, Image & out );
         typedef Image ( *InvertForm3 )( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height );
@@ -187,6 +199,12 @@ namespace Image_Function_Helper
         typedef void ( *ProjectionProfileForm4 )( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal,
                                                   std::vector<uint32_t> & projection );
 
+        typedef std::vector<uint64_t> ( *ProjectionProfile64Form1 )( const Image & image, bool horizontal );
+        typedef void ( *ProjectionProfile64Form2 )( const Image & image, bool horizontal, std::vector<uint64_t> & projection );
+        typedef std::vector<uint64_t> ( *ProjectionProfile64Form3 )( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal );
+        typedef void ( *ProjectionProfile64Form4 )( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal,
+                                                    std::vector<uint64_t> & projection );
+
         typedef void ( *ReplaceChannelForm1 )( const Image & channel, Image & rgb, uint8_t channelId );
         typedef void ( *ReplaceChannelForm2 )( const Image & channel, uint32_t startXChannel, uint32_t startYChannel, Image & rgb, uint32_t startXRgb, uint32_t startYRgb,
                                                uint32_t width, uint32_t height, uint8_t channelId );
@@ -245,6 +263,9 @@ namespace Image_Function_Helper
         typedef uint32_t ( *SumForm1 )( const Image & image );
         typedef uint32_t ( *SumForm2 )( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
 
+        typedef uint64_t ( *Sum64Form1 )( const Image & image );
+        typedef uint64_t ( *Sum64Form2 )( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
+
         typedef Image ( *ThresholdForm1 )( const Image & in, uint8_t threshold );
         typedef void ( *ThresholdForm2 )( const Image & in, Image & out, uint8_t threshold );
         typedef Image ( *ThresholdForm3 )( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height, uint8_t threshold );
@@ -285,8 +306,14 @@ namespace Image_Function_Helper
     Image AbsoluteDifference( FunctionTable::AbsoluteDifferenceForm4 absoluteDifference, const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2,
                               uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
 
+    Image AbsoluteDifference( FunctionTable::AbsoluteDifferenceForm4 absoluteDifference, const ConstImageView & in1, const ConstImageView & in2 );
+
+    void AbsoluteDifference( FunctionTable::AbsoluteDifferenceForm4 absoluteDifference, const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
+
     void Accumulate( FunctionTable::AccumulateForm2 accumulate, const Image & image, std::vector<uint32_t> & result );
 
+    void Accumulate64( FunctionTable::Accumulate64Form2 accumulate, const Image & image, std::vector<uint64_t> & result );
+
     Image BitwiseAnd( FunctionTable::BitwiseAndForm4 bitwiseAnd, const Image & in1, const Image & in2 );
 
     void BitwiseAnd( FunctionTable::BitwiseAndForm4 bitwiseAnd, const Image & in1, const Image & in2, Image & out );
@@ -294,6 +321,10 @@ namespace Image_Function_Helper
     Image BitwiseAnd( FunctionTable::BitwiseAndForm4 bitwiseAnd, const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2,
                       uint32_t startY2, uint32_t width, uint32_t height );
 
+    Image BitwiseAnd( FunctionTable::BitwiseAndForm4 bitwiseAnd, const ConstImageView & in1, const ConstImageView & in2 );
+
+    void BitwiseAnd( FunctionTable::BitwiseAndForm4 bitwiseAnd, const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
+
     Image BitwiseOr( FunctionTable::BitwiseOrForm4 bitwiseOr, const Image & in1, const Image & in2 );
 
     void BitwiseOr( FunctionTable::BitwiseOrForm4 bitwiseOr, const Image & in1, const Image & in2, Image & out );
@@ -301,6 +332,10 @@ namespace Image_Function_Helper
     Image BitwiseOr( FunctionTable::BitwiseOrForm4 bitwiseOr, const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2,
                      uint32_t startY2, uint32_t width, uint32_t height );
 
+    Image BitwiseOr( FunctionTable::BitwiseOrForm4 bitwiseOr, const ConstImageView & in1, const ConstImageView & in2 );
+
+    void BitwiseOr( FunctionTable::BitwiseOrForm4 bitwiseOr, const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
+
     Image BitwiseXor( FunctionTable::BitwiseXorForm4 bitwiseXor, const Image & in1, const Image & in2 );
 
     void BitwiseXor( FunctionTable::BitwiseXorForm4 bitwiseXor, const Image & in1, const Image & in2, Image & out );
@@ -308,6 +343,10 @@ namespace Image_Function_Helper
     Image BitwiseXor( FunctionTable::BitwiseXorForm4 bitwiseXor, const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2,
                       uint32_t startY2, uint32_t width, uint32_t height );
 
+    Image BitwiseXor( FunctionTable::BitwiseXorForm4 bitwiseXor, const ConstImageView & in1, const ConstImageView & in2 );
+
+    void BitwiseXor( FunctionTable::BitwiseXorForm4 bitwiseXor, const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
+
     void ConvertTo16Bit( FunctionTable::ConvertTo16BitForm4 convertTo16Bit, const Image & in, Image16Bit & out );
 
     void ConvertTo8Bit( FunctionTable::ConvertTo8BitForm4 convertTo8Bit, const Image16Bit & in, Image & out );
@@ -357,6 +396,16 @@ namespace Image_Function_Helper
 
     std::vector<uint32_t> Histogram( FunctionTable::HistogramForm4 histogram, const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
 
+    std::vector<uint32_t> Histogram( FunctionTable::HistogramForm4 histogram, const ConstImageView & image );
+
+    void Histogram( FunctionTable::HistogramForm4 histogram, const ConstImageView & image, std::vector<uint32_t> & histogramTable );
+
+    std::vector<uint64_t> Histogram64( FunctionTable::Histogram64Form4 histogram, const Image & image );
+
+    void Histogram64( FunctionTable::Histogram64Form4 histogram, const Image & image, std::vector<uint64_t> & histogramTable );
+
+    std::vector<uint64_t> Histogram64( FunctionTable::Histogram64Form4 histogram, const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
+
     std::vector<uint32_t> Histogram( FunctionTable::HistogramForm8 histogram, const Image & image, const Image & mask );
 
     void Histogram( FunctionTable::HistogramForm8 histogram, const Image & image, const Image & mask, std::vector<uint32_t> & histogramTable );
@@ -370,6 +419,10 @@ namespace Image_Function_Helper
 
     Image Invert( FunctionTable::InvertForm4 invert, const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height );
 
+    Image Invert( FunctionTable::InvertForm4 invert, const ConstImageView & in );
+
+    void Invert( FunctionTable::InvertForm4 invert, const ConstImageView & in, const ImageView & out );
+
     bool IsEqual( FunctionTable::IsEqualForm2 isEqual, const Image & in1, const Image & in2 );
 
     Image LookupTable( FunctionTable::LookupTableForm4 lookupTable, const Image & in, const std::vector<uint8_t> & table );
@@ -386,6 +439,10 @@ namespace Image_Function_Helper
     Image Maximum( FunctionTable::MaximumForm4 maximum, const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2,
                    uint32_t width, uint32_t height );
 
+    Image Maximum( FunctionTable::MaximumForm4 maximum, const ConstImageView & in1, const ConstImageView & in2 );
+
+    void Maximum( FunctionTable::MaximumForm4 maximum, const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
+
     Image Merge( FunctionTable::MergeForm4 merge, const Image & in1, const Image & in2, const Image & in3 );
 
     void Merge( FunctionTable::MergeForm4 merge, const Image & in1, const Image & in2, const Image & in3, Image & out );
@@ -400,6 +457,10 @@ namespace Image_Function_Helper
     Image Minimum( FunctionTable::MinimumForm4 minimum, const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2,
                    uint32_t width, uint32_t height );
 
+    Image Minimum( FunctionTable::MinimumForm4 minimum, const ConstImageView & in1, const ConstImageView & in2 );
+
+    void Minimum( FunctionTable::MinimumForm4 minimum, const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
+
     Image Normalize( FunctionTable::NormalizeForm4 normalize, const Image & in );
 
     void Normalize( FunctionTable::NormalizeForm4 normalize, const Image & in, Image & out );
@@ -413,6 +474,13 @@ namespace Image_Function_Helper
     std::vector<uint32_t> ProjectionProfile( FunctionTable::ProjectionProfileForm4 projectionProfile, const Image & image, uint32_t x, uint32_t y, uint32_t width,
                                              uint32_t height, bool horizontal );
 
+    std::vector<uint64_t> ProjectionProfile64( FunctionTable::ProjectionProfile64Form4 projectionProfile, const Image & image, bool horizontal );
+
+    void ProjectionProfile64( FunctionTable::ProjectionProfile64Form4 projectionProfile, const Image & image, bool horizontal, std::vector<uint64_t> & projection );
+
+    std::vector<uint64_t> ProjectionProfile64( FunctionTable::ProjectionProfile64Form4 projectionProfile, const Image & image, uint32_t x, uint32_t y,
+                                               uint32_t width, uint32_t height, bool horizontal );
+
     Image Resize( FunctionTable::ResizeForm4 resize, const Image & in, uint32_t widthOut, uint32_t heightOut );
 
     void Resize( FunctionTable::ResizeForm4 resize, const Image & in, Image & out );
@@ -461,6 +529,12 @@ namespace Image_Function_Helper
     Image Subtract( FunctionTable::SubtractForm4 subtract, const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2,
                     uint32_t width, uint32_t height );
 
+    Image Subtract( FunctionTable::SubtractForm4 subtract, const ConstImageView & in1, const ConstImageView & in2 );
+
+    void Subtract( FunctionTable::SubtractForm4 subtract, const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
+
+    uint32_t Sum( FunctionTable::SumForm2 sum, const ConstImageView & image );
+
     Image Threshold( FunctionTable::ThresholdForm4 threshold, const Image & in, uint8_t thresholdValue );
 
     void Threshold( FunctionTable::ThresholdForm4 threshold, const Image & in, Image & out, uint8_t thresholdValue );
@@ -468,6 +542,10 @@ namespace Image_Function_Helper
     Image Threshold( FunctionTable::ThresholdForm4 threshold, const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height,
                      uint8_t thresholdValue );
 
+    Image Threshold( FunctionTable::ThresholdForm4 threshold, const ConstImageView & in, uint8_t thresholdValue );
+
+    void Threshold( FunctionTable::ThresholdForm4 threshold, const ConstImageView & in, const ImageView & out, uint8_t thresholdValue );
+
     Image Threshold( FunctionTable::ThresholdDoubleForm4 threshold, const Image & in, uint8_t minThreshold, uint8_t maxThreshold );
 
     void Threshold( FunctionTable::ThresholdDoubleForm4 threshold, const Image & in, Image & out, uint8_t minThreshold, uint8_t maxThreshold );
@@ -475,6 +553,11 @@ namespace Image_Function_Helper
     Image Threshold( FunctionTable::ThresholdDoubleForm4 threshold, const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height,
                      uint8_t minThreshold, uint8_t maxThreshold );
 
+    Image Threshold( FunctionTable::ThresholdDoubleForm4 threshold, const ConstImageView & in, uint8_t minThreshold, uint8_t maxThreshold );
+
+    void Threshold( FunctionTable::ThresholdDoubleForm4 threshold, const ConstImageView & in, const ImageView & out, uint8_t minThreshold,
+                    uint8_t maxThreshold );
+
     Image Transpose( FunctionTable::TransposeForm4 transpose, const Image & in );
 
     void Transpose( FunctionTable::TransposeForm4 transpose, const Image & in, Image & out );
@@ -521,6 +604,56 @@ namespace Image_Function_Helper
         FunctionTable::ThresholdDoubleForm4 Threshold2 = nullptr;
         FunctionTable::TransposeForm4 Transpose = nullptr;
     };
+
+    // Sets a function missing in a function table, for example to call it through penguinV dispatching
+    template <typename _Function>
+    void SetDefaultFunction( _Function & function, _Function defaultFunction )
+    {
+        if ( function == nullptr )
+            function = defaultFunction;
+    }
+
+    // Image types of functions in a function table
+    struct FunctionTypeHolder
+    {
+        uint8_t AbsoluteDifference = 0u;
+        uint8_t Accumulate = 0u;
+        uint8_t BitwiseAnd = 0u;
+        uint8_t BitwiseOr = 0u;
+        uint8_t BitwiseXor = 0u;
+        uint8_t ConvertTo16Bit = 0u;
+        uint8_t ConvertTo8Bit = 0u;
+        uint8_t ConvertToGrayScale = 0u;
+        uint8_t ConvertToRgb = 0u;
+        uint8_t Copy = 0u;
+        uint8_t ExtractChannel = 0u;
+        uint8_t Fill = 0u;
+        uint8_t Flip = 0u;
+        uint8_t GammaCorrection = 0u;
+        uint8_t GetPixel = 0u;
+        uint8_t Histogram = 0u;
+        uint8_t Invert = 0u;
+        uint8_t IsEqual = 0u;
+        uint8_t LookupTable = 0u;
+        uint8_t Maximum = 0u;
+        uint8_t Merge = 0u;
+        uint8_t Minimum = 0u;
+        uint8_t Normalize = 0u;
+        uint8_t ProjectionProfile = 0u;
+        uint8_t Resize = 0u;
+        uint8_t RgbToBgr = 0u;
+        uint8_t RgbToRgba = 0u;
+        uint8_t RgbaToRgb = 0u;
+        uint8_t SetPixel = 0u;
+        uint8_t SetPixel2 = 0u;
+        uint8_t Shift = 0u;
+        uint8_t Split = 0u;
+        uint8_t Subtract = 0u;
+        uint8_t Sum = 0u;
+        uint8_t Threshold = 0u;
+        uint8_t Threshold2 = 0u;
+        uint8_t Transpose = 0u;
+    };
 }
 
 class ImageTypeManager
@@ -533,6 +666,11 @@ public:
     void setFunctionTable( uint8_t type, const Image_Function_Helper::FunctionTableHolder & table, bool forceSetup = false );
     const Image_Function_Helper::FunctionTableHolder & functionTable( uint8_t type ) const;
 
+    // Function table of the type where missing functions are taken from other types in order of their IDs. Image types of taken functions
+    // are stored in intertypeFunctionType table. Both tables are calculated during registration so dispatching does not search through types
+    const Image_Function_Helper::FunctionTableHolder & intertypeFunctionTable( uint8_t type ) const;
+    const Image_Function_Helper::FunctionTypeHolder & intertypeFunctionType( uint8_t type ) const;
+
     void setConvertFunction( Image_Function_Helper::FunctionTable::CopyForm1 Copy, const penguinV::Image & in, const penguinV::Image & out );
     void convert( const penguinV::Image & in, penguinV::Image & out ) const;
 
@@ -543,12 +681,112 @@ public:
     bool isIntertypeConversionEnabled() const;
 
 private:
-    std::map<uint8_t, Image_Function_Helper::FunctionTableHolder> _functionTableMap;
+    struct FunctionTableEntry
+    {
+        Image_Function_Helper::FunctionTableHolder table;
+        Image_Function_Helper::FunctionTableHolder intertypeTable;
+        Image_Function_Helper::FunctionTypeHolder intertypeType;
+    };
+
+    std::array<std::unique_ptr<FunctionTableEntry>, 256> _functionTable; // index is image type, types without function table have no entry
     std::map<std::pair<uint8_t, uint8_t>, Image_Function_Helper::FunctionTable::CopyForm1> _intertypeConvertMap;
     std::map<uint8_t, penguinV::Image> _image;
     bool _enabledIntertypeConversion;
 
     ImageTypeManager();
+
+    const FunctionTableEntry & _entry( uint8_t type ) const;
+    void _resolveIntertypeFunctions();
+};
+
+// Automatic selection of backend for functions called through penguinV namespace for CPU images. A backend is a function table
+// working with images of some type: "simd" is the function table of CPU images and it is always present, other backends are registered
+// by their libraries, for example Function_Pool. Choice is made per call by a cost model keyed by function and size of processed area.
+// Costs are measured by calibrate() function or loaded from a file, functions without costs are called through the function table of image type.
+// Selection is disabled by default. Backends and costs must be set up before calling functions from several threads
+class BackendSelector
+{
+public:
+    enum Function
+    {
+        AbsoluteDifference,
+        BitwiseAnd,
+        BitwiseOr,
+        BitwiseXor,
+        Histogram,
+        Invert,
+        Maximum,
+        Minimum,
+        Subtract,
+        Sum,
+        Threshold,
+        Threshold2,
+        FunctionCount
+    };
+
+    struct Backend
+    {
+        std::string name;
+        uint8_t imageType; // images are converted into this type if it differs from CPU image type
+        Image_Function_Helper::FunctionTableHolder table;
+    };
+
+    // information passed to decision hook for every call with enabled selection
+    struct Decision
+    {
+        Function function;
+        uint32_t width;
+        uint32_t height;
+        const std::string & backend;
+    };
+
+    static BackendSelector & instance();
+
+    void registerBackend( const std::string & name, uint8_t imageType, const Image_Function_Helper::FunctionTableHolder & table );
+    std::vector<std::string> backends() const;
+
+    void enable( bool enable );
+    bool isEnabled() const;
+
+    // measures time of functions of every backend on square images with given sizes. Backends throwing exceptions are not measured
+    void calibrate( const std::vector<uint32_t> & size = std::vector<uint32_t>( { 16u, 64u, 256u, 1024u, 2048u } ) );
+
+    // time in seconds of processing area with given number of pixels. Unknown costs are estimated from the closest known ones, negative if none is known
+    void setCost( Function function, const std::string & backend, uint64_t pixelCount, double time );
+    double cost( Function function, const std::string & backend, uint64_t pixelCount ) const;
+    void resetCost();
+
+    // text file with a line per measurement: function name, backend name, number of pixels and time. Costs of unknown backends are skipped
+    void save( const std::string & path ) const;
+    void load( const std::string & path );
+
+    // nullptr means the function table of image type
+    const Backend * select( Function function, uint8_t imageType, uint32_t width, uint32_t height ) const;
+
+    void setDecisionHook( const std::function<void( const Decision & )> & hook );
+
+    static const char * functionName( Function function );
+
+private:
+    enum
+    {
+        SIZE_CLASS_COUNT = 41 // areas are classified by binary logarithm of pixel count
+    };
+
+    typedef std::array<std::array<double, SIZE_CLASS_COUNT>, FunctionCount> CostTable;
+
+    std::vector<Backend> _backend;
+    std::vector<CostTable> _cost; // measured costs of every backend, zero is unknown cost
+    std::array<std::array<size_t, SIZE_CLASS_COUNT>, FunctionCount> _decision; // index of selected backend
+    std::function<void( const Decision & )> _hook;
+    bool _enabled;
+
+    BackendSelector();
+
+    size_t _backendId( const std::string & name ) const; // returns number of backends if the backend does not exist
+    double _estimate( const CostTable & cost, Function function, size_t sizeClass ) const;
+    void _updateDecision();
+    static size_t _sizeClass( uint64_t pixelCount );
 };
 
 // This namespace is a helper namespace for SIMD instruction based code
@@ -572,3 +810,64 @@ namespace simd
 
     SIMDType actualSimdType();
 }
+
+namespace Image_Function_Helper
+{
+    // ROIs are visited row by row from top to bottom so every row of the image is read once while it stays in CPU cache for all ROIs crossing it.
+    // Function is called for every row of every ROI with ROI ID, pointer to the first pixel of the row in ROI and row index within ROI.
+    // ROIs must be validated by a caller
+    template <typename _Function>
+    void ProcessRoiRows( const Image & image, const std::vector<Roi> & roi, _Function function )
+    {
+        std::vector<size_t> order( roi.size() );
+        for ( size_t id = 0; id < order.size(); ++id )
+            order[id] = id;
+
+        std::stable_sort( order.begin(), order.end(), [&roi]( size_t left, size_t right ) { return roi[left].y < roi[right].y; } );
+
+        const uint32_t rowSize = image.rowSize();
+        const uint8_t colorCount = image.colorCount();
+
+        std::vector<size_t> active; // ROIs crossing current row
+        std::vector<size_t>::const_iterator next = order.cbegin();
+        uint32_t y = 0;
+
+        while ( next != order.cend() || !active.empty() ) {
+            if ( active.empty() )
+                y = roi[*next].y; // rows without ROIs are skipped
+
+            for ( ; next != order.cend() && roi[*next].y == y; ++next )
+                active.push_back( *next );
+
+            const uint8_t * imageY = image.data() + y * rowSize;
+
+            for ( size_t i = 0; i < active.size(); ) {
+                const Roi & area = roi[active[i]];
+
+                function( active[i], imageY + area.x * colorCount, y - area.y );
+
+                if ( y + 1u == area.y + area.height ) {
+                    active[i] = active.back();
+                    active.pop_back();
+                }
+                else {
+                    ++i;
+                }
+            }
+
+            ++y;
+        }
+    }
+
+    // Functions for a list of ROIs which don't validate ROIs. Callers validate ROIs once, for example before ROIs are split between threads.
+    // Functions with SIMD type process every row of ROI by row functions of the instruction set
+    namespace RoiList
+    {
+        void Histogram( const Image & image, const std::vector<Roi> & roi, std::vector<std::vector<uint32_t>> & histogram );
+        void ProjectionProfile( const Image & image, const std::vector<Roi> & roi, bool horizontal, std::vector<std::vector<uint32_t>> & projection );
+        void ProjectionProfile( const Image & image, const std::vector<Roi> & roi, bool horizontal, std::vector<std::vector<uint32_t>> & projection,
+                                simd::SIMDType simdType );
+        std::vector<uint32_t> Sum( const Image & image, const std::vector<Roi> & roi );
+        std::vector<uint32_t> Sum( const Image & image, const std::vector<Roi> & roi, simd::SIMDType simdType );
+    }
+}
@@ -32,27 +32,39 @@ namespace Image_Function_Simd
                               uint32_t height );
     void AbsoluteDifference( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out,
                              uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height );
+    Image AbsoluteDifference( const ConstImageView & in1, const ConstImageView & in2 );
+    void AbsoluteDifference( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     void Accumulate( const Image & image, std::vector<uint32_t> & result );
     void Accumulate( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint32_t> & result );
 
+    // 64-bit accumulators for images which could overflow 32-bit counters
+    void Accumulate64( const Image & image, std::vector<uint64_t> & result );
+    void Accumulate64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint64_t> & result );
+
     Image BitwiseAnd( const Image & in1, const Image & in2 );
     void BitwiseAnd( const Image & in1, const Image & in2, Image & out );
     Image BitwiseAnd( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void BitwiseAnd( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                      uint32_t startYOut, uint32_t width, uint32_t height );
+    Image BitwiseAnd( const ConstImageView & in1, const ConstImageView & in2 );
+    void BitwiseAnd( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image BitwiseOr( const Image & in1, const Image & in2 );
     void BitwiseOr( const Image & in1, const Image & in2, Image & out );
     Image BitwiseOr( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void BitwiseOr( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                     uint32_t startYOut, uint32_t width, uint32_t height );
+    Image BitwiseOr( const ConstImageView & in1, const ConstImageView & in2 );
+    void BitwiseOr( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image BitwiseXor( const Image & in1, const Image & in2 );
     void BitwiseXor( const Image & in1, const Image & in2, Image & out );
     Image BitwiseXor( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void BitwiseXor( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                      uint32_t startYOut, uint32_t width, uint32_t height );
+    Image BitwiseXor( const ConstImageView & in1, const ConstImageView & in2 );
+    void BitwiseXor( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image16Bit ConvertTo16Bit( const Image & in );
     void ConvertTo16Bit( const Image & in, Image16Bit & out );
@@ -85,23 +97,36 @@ namespace Image_Function_Simd
     void Invert( const Image & in, Image & out );
     Image Invert( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height );
     void Invert( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Invert( const ConstImageView & in );
+    void Invert( const ConstImageView & in, const ImageView & out );
 
     Image Maximum( const Image & in1, const Image & in2 );
     void Maximum( const Image & in1, const Image & in2, Image & out );
     Image Maximum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void Maximum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                   uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Maximum( const ConstImageView & in1, const ConstImageView & in2 );
+    void Maximum( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image Minimum( const Image & in1, const Image & in2 );
     void Minimum( const Image & in1, const Image & in2, Image & out );
     Image Minimum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void Minimum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                   uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Minimum( const ConstImageView & in1, const ConstImageView & in2 );
+    void Minimum( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     std::vector<uint32_t> ProjectionProfile( const Image & image, bool horizontal );
     void ProjectionProfile( const Image & image, bool horizontal, std::vector<uint32_t> & projection );
     std::vector<uint32_t> ProjectionProfile( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal );
     void ProjectionProfile( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal, std::vector<uint32_t> & projection );
+    std::vector<std::vector<uint32_t>> ProjectionProfile( const Image & image, const std::vector<Roi> & roi, bool horizontal );
+    void ProjectionProfile( const Image & image, const std::vector<Roi> & roi, bool horizontal, std::vector<std::vector<uint32_t>> & projection );
+
+    std::vector<uint64_t> ProjectionProfile64( const Image & image, bool horizontal );
+    void ProjectionProfile64( const Image & image, bool horizontal, std::vector<uint64_t> & projection );
+    std::vector<uint64_t> ProjectionProfile64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal );
+    void ProjectionProfile64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal, std::vector<uint64_t> & projection );
 
     Image RgbToBgr( const Image & in );
     void RgbToBgr( const Image & in, Image & out );
@@ -113,11 +138,19 @@ namespace Image_Function_Simd
     Image Subtract( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void Subtract( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                    uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Subtract( const ConstImageView & in1, const ConstImageView & in2 );
+    void Subtract( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     // Make sure that your image is not so big to do not have overloaded uint32_t value
     // For example not bigger than [4096 * 4096] for 32-bit application
     uint32_t Sum( const Image & image );
     uint32_t Sum( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
+    uint32_t Sum( const ConstImageView & image );
+    std::vector<uint32_t> Sum( const Image & image, const std::vector<Roi> & roi );
+
+    // 64-bit version of Sum function suitable for images of any size
+    uint64_t Sum64( const Image & image );
+    uint64_t Sum64( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
 
     // Thresholding works in such way:
     // if pixel intensity on input image is          less (  < ) than threshold then set pixel intensity on output image as 0
@@ -127,6 +160,8 @@ namespace Image_Function_Simd
     Image Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height, uint8_t threshold );
     void Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                     uint8_t threshold );
+    Image Threshold( const ConstImageView & in, uint8_t threshold );
+    void Threshold( const ConstImageView & in, const ImageView & out, uint8_t threshold );
 
     // Thresholding works in such way:
     // if pixel intensity on input image is less ( < ) than minimum threshold or more ( > ) than maximum threshold
@@ -137,4 +172,6 @@ namespace Image_Function_Simd
     Image Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height, uint8_t minThreshold, uint8_t maxThreshold );
     void Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                     uint8_t minThreshold, uint8_t maxThreshold );
+    Image Threshold( const ConstImageView & in, uint8_t minThreshold, uint8_t maxThreshold );
+    void Threshold( const ConstImageView & in, const ImageView & out, uint8_t minThreshold, uint8_t maxThreshold );
 }
@@ -0,0 +1,215 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include "penguinv/cpu_identification.h"
+#include <cstdint>
+
+// Row processing functions of SIMD instruction sets used by Image_Function_Simd namespace. Functions of every instruction set are placed
+// in their own translation unit compiled with compiler flags of the set, so the library built for older processors still contains
+// code for newer ones and the set is selected during runtime by simd::actualSimdType(). Such translation units must not use inline
+// functions shared with other translation units as the linker could keep a copy of a function compiled for a newer processor
+namespace avx512
+{
+    const uint32_t simdSize = 64u;
+
+#ifdef PENGUINV_AVX512_SKL_DISPATCH
+    void AbsoluteDifference( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY,
+                             const uint8_t * outYEnd, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Accumulate( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t * outY, uint32_t simdWidth, uint32_t totalSimdWidth,
+                     uint32_t nonSimdWidth );
+    void BitwiseAnd( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                     uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void BitwiseOr( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                    uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void BitwiseXor( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                     uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void ConvertTo16Bit( uint16_t * outY, const uint16_t * outYEnd, const uint8_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint32_t simdWidth,
+                         uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void ConvertTo8Bit( uint8_t * outY, const uint8_t * outYEnd, const uint16_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint32_t simdWidth,
+                        uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Invert( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint32_t simdWidth, uint32_t totalSimdWidth,
+                 uint32_t nonSimdWidth );
+    void Maximum( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                  uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Minimum( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                  uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void ProjectionProfile( uint32_t rowSize, const uint8_t * imageStart, uint32_t height, bool horizontal, uint32_t * out, uint32_t simdWidth, uint32_t totalSimdWidth,
+                            uint32_t nonSimdWidth );
+    void Subtract( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                   uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    uint32_t Sum( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Threshold( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint8_t threshold, uint32_t simdWidth,
+                    uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Threshold( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint8_t minThreshold, uint8_t maxThreshold,
+                    uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Accumulate64( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint64_t * outY, uint32_t simdWidth, uint32_t totalSimdWidth,
+                       uint32_t nonSimdWidth );
+    uint64_t Sum64( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void ProjectionProfile64( uint32_t rowSize, const uint8_t * imageStart, uint32_t height, bool horizontal, uint64_t * out, uint32_t simdWidth,
+                              uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+#endif
+}
+
+namespace avx
+{
+    const uint32_t simdSize = 32u;
+
+#ifdef PENGUINV_AVX_DISPATCH
+    void AbsoluteDifference( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY,
+                             const uint8_t * outYEnd, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Accumulate( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t * outY, uint32_t simdWidth, uint32_t totalSimdWidth,
+                     uint32_t nonSimdWidth );
+    void BitwiseAnd( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                     uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void BitwiseOr( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                    uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void BitwiseXor( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                     uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void ConvertTo16Bit( uint16_t * outY, const uint16_t * outYEnd, const uint8_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint32_t simdWidth,
+                         uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void ConvertTo8Bit( uint8_t * outY, const uint8_t * outYEnd, const uint16_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint32_t simdWidth,
+                        uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Invert( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint32_t simdWidth, uint32_t totalSimdWidth,
+                 uint32_t nonSimdWidth );
+    void Maximum( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                  uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Minimum( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                  uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void ProjectionProfile( uint32_t rowSize, const uint8_t * imageStart, uint32_t height, bool horizontal, uint32_t * out, uint32_t simdWidth, uint32_t totalSimdWidth,
+                            uint32_t nonSimdWidth );
+    void RgbToBgr( uint8_t * outY, const uint8_t * inY, const uint8_t * outYEnd, uint32_t rowSizeOut, uint32_t rowSizeIn, const uint8_t colorCount, uint32_t simdWidth,
+                   uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Subtract( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                   uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    uint32_t Sum( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Threshold( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint8_t threshold, uint32_t simdWidth,
+                    uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Threshold( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint8_t minThreshold, uint8_t maxThreshold,
+                    uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Accumulate64( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint64_t * outY, uint32_t simdWidth, uint32_t totalSimdWidth,
+                       uint32_t nonSimdWidth );
+    uint64_t Sum64( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void ProjectionProfile64( uint32_t rowSize, const uint8_t * imageStart, uint32_t height, bool horizontal, uint64_t * out, uint32_t simdWidth,
+                              uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+#endif
+}
+
+namespace sse
+{
+    const uint32_t simdSize = 16u;
+
+#ifdef PENGUINV_SSE_DISPATCH
+    void AbsoluteDifference( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY,
+                             const uint8_t * outYEnd, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Accumulate( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t * outY, uint32_t simdWidth, uint32_t totalSimdWidth,
+                     uint32_t nonSimdWidth );
+    void BitwiseAnd( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                     uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void BitwiseOr( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                    uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void BitwiseXor( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                     uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void ConvertTo16Bit( uint16_t * outY, const uint16_t * outYEnd, const uint8_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint32_t simdWidth,
+                         uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void ConvertTo8Bit( uint8_t * outY, const uint8_t * outYEnd, const uint16_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint32_t simdWidth,
+                        uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+#ifdef PENGUINV_SSSE3_DISPATCH
+    void ConvertToRgb( uint8_t * outY, const uint8_t * outYEnd, const uint8_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint8_t colorCount, uint32_t simdWidth,
+                       uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Flip( uint8_t * outData, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height, const uint32_t rowSizeIn, const uint32_t rowSizeOut,
+               const uint8_t * inY, const uint8_t * inYEnd, bool horizontal, bool vertical, const uint32_t simdWidth, const uint32_t totalSimdWidth,
+               const uint32_t nonSimdWidth );
+#endif
+    void Invert( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint32_t simdWidth, uint32_t totalSimdWidth,
+                 uint32_t nonSimdWidth );
+    void Maximum( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                  uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Minimum( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                  uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void ProjectionProfile( uint32_t rowSize, const uint8_t * imageStart, uint32_t height, bool horizontal, uint32_t * out, uint32_t simdWidth, uint32_t totalSimdWidth,
+                            uint32_t nonSimdWidth );
+#ifdef PENGUINV_SSSE3_DISPATCH
+    void RgbToBgr( uint8_t * outY, const uint8_t * inY, const uint8_t * outYEnd, uint32_t rowSizeOut, uint32_t rowSizeIn, const uint8_t colorCount, uint32_t simdWidth,
+                   uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+#endif
+    void Subtract( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                   uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    uint32_t Sum( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Threshold( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint8_t threshold, uint32_t simdWidth,
+                    uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Threshold( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint8_t minThreshold, uint8_t maxThreshold,
+                    uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Accumulate64( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint64_t * outY, uint32_t simdWidth, uint32_t totalSimdWidth,
+                       uint32_t nonSimdWidth );
+    uint64_t Sum64( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void ProjectionProfile64( uint32_t rowSize, const uint8_t * imageStart, uint32_t height, bool horizontal, uint64_t * out, uint32_t simdWidth,
+                              uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+#endif
+}
+
+namespace neon
+{
+    const uint32_t simdSize = 16u;
+
+#ifdef PENGUINV_NEON_DISPATCH
+    void AbsoluteDifference( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY,
+                             const uint8_t * outYEnd, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Accumulate( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t * outY, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void BitwiseAnd( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                     uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void BitwiseOr( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                    uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void BitwiseXor( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                     uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void ConvertTo16Bit( uint16_t * outY, const uint16_t * outYEnd, const uint8_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint32_t simdWidth, uint32_t totalSimdWidth,
+                         uint32_t nonSimdWidth );
+    void ConvertTo8Bit( uint8_t * outY, const uint8_t * outYEnd, const uint16_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint32_t simdWidth, uint32_t totalSimdWidth,
+                        uint32_t nonSimdWidth );
+    void ConvertToRgb( uint8_t * outY, const uint8_t * outYEnd, const uint8_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint8_t colorCount, uint32_t simdWidth,
+                       uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Flip( uint8_t * outData, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height, const uint32_t rowSizeIn, const uint32_t rowSizeOut,
+               const uint8_t * inY, const uint8_t * inYEnd, bool horizontal, bool vertical, const uint32_t simdWidth, const uint32_t totalSimdWidth,
+               const uint32_t nonSimdWidth );
+    void Invert( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint32_t simdWidth, uint32_t totalSimdWidth,
+                 uint32_t nonSimdWidth );
+    void Maximum( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                  uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Minimum( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                  uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void ProjectionProfile( uint32_t rowSize, const uint8_t * imageStart, uint32_t height, bool horizontal, uint32_t * out, uint32_t simdWidth, uint32_t totalSimdWidth,
+                            uint32_t nonSimdWidth );
+    void RgbToBgr( uint8_t * outY, const uint8_t * inY, const uint8_t * outYEnd, uint32_t rowSizeOut, uint32_t rowSizeIn, const uint8_t colorCount, uint32_t simdWidth,
+                   uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Subtract( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                   uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    uint32_t Sum( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Threshold( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint8_t threshold, uint32_t simdWidth,
+                    uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Threshold( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint8_t minThreshold, uint8_t maxThreshold,
+                    uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void Accumulate64( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint64_t * outY, uint32_t simdWidth, uint32_t totalSimdWidth,
+                       uint32_t nonSimdWidth );
+    uint64_t Sum64( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+    void ProjectionProfile64( uint32_t rowSize, const uint8_t * imageStart, uint32_t height, bool horizontal, uint64_t * out, uint32_t simdWidth,
+                              uint32_t totalSimdWidth, uint32_t nonSimdWidth );
+#endif
+}
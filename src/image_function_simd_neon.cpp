@@ -0,0 +1,772 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "image_function_simd_kernel.h"
+#include <cstring>
+#include <stdexcept>
+
+#ifdef PENGUINV_NEON_SET
+#include <arm_neon.h>
+#endif
+
+#if defined( PENGUINV_NEON_DISPATCH ) && !defined( PENGUINV_NEON_SET )
+#error "This file must be compiled with NEON instruction set"
+#endif
+
+namespace neon
+{
+#ifdef PENGUINV_NEON_SET
+    typedef uint8x16_t simd;
+
+    void AbsoluteDifference( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY,
+                             const uint8_t * outYEnd, uint32_t, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, in1Y += rowSizeIn1, in2Y += rowSizeIn2 ) {
+            const uint8_t * src1 = in1Y;
+            const uint8_t * src2 = in2Y;
+            uint8_t * dst = outY;
+
+            const uint8_t * src1End = src1 + totalSimdWidth;
+
+            for ( ; src1 != src1End; src1 += simdSize, src2 += simdSize, dst += simdSize )
+                vst1q_u8( dst, vabdq_u8( vld1q_u8( src1 ), vld1q_u8( src2 ) ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * in1X = in1Y + totalSimdWidth;
+                const uint8_t * in2X = in2Y + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++in1X, ++in2X )
+                    ( *outX ) = static_cast<uint8_t>( ( *in2X ) > ( *in1X ) ? ( *in2X ) - ( *in1X ) : ( *in1X ) - ( *in2X ) );
+            }
+        }
+    }
+
+    void Accumulate( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t * outY, uint32_t, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        const uint8x8_t zero_8 = vdup_n_u8( 0 );
+
+        const uint32_t width = totalSimdWidth + nonSimdWidth;
+
+        for ( ; imageY != imageYEnd; imageY += rowSize, outY += width ) {
+            const uint8_t * src = imageY;
+            const uint8_t * srcEnd = src + totalSimdWidth;
+            uint32_t * dst = outY;
+
+            for ( ; src != srcEnd; src += simdSize ) {
+                uint8x16_t data = vld1q_u8( src );
+
+                const uint16x8_t dataLo = vaddl_u8( vget_low_u8( data ), zero_8 );
+                const uint16x8_t dataHi = vaddl_u8( vget_high_u8( data ), zero_8 );
+
+                vst1q_u32( dst, vaddw_u16( vld1q_u32( dst ), vget_low_u16( dataLo ) ) );
+                dst += 4;
+                vst1q_u32( dst, vaddw_u16( vld1q_u32( dst ), vget_high_u16( dataLo ) ) );
+                dst += 4;
+                vst1q_u32( dst, vaddw_u16( vld1q_u32( dst ), vget_low_u16( dataHi ) ) );
+                dst += 4;
+                vst1q_u32( dst, vaddw_u16( vld1q_u32( dst ), vget_high_u16( dataHi ) ) );
+                dst += 4;
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * imageX = imageY + totalSimdWidth;
+                const uint8_t * imageXEnd = imageX + nonSimdWidth;
+                uint32_t * outX = outY + totalSimdWidth;
+
+                for ( ; imageX != imageXEnd; ++imageX, ++outX )
+                    ( *outX ) += ( *imageX );
+            }
+        }
+    }
+
+    void BitwiseAnd( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                     uint32_t, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, in1Y += rowSizeIn1, in2Y += rowSizeIn2 ) {
+            const uint8_t * src1 = in1Y;
+            const uint8_t * src2 = in2Y;
+            uint8_t * dst = outY;
+
+            const uint8_t * src1End = src1 + totalSimdWidth;
+
+            for ( ; src1 != src1End; src1 += simdSize, src2 += simdSize, dst += simdSize )
+                vst1q_u8( dst, vandq_u8( vld1q_u8( src1 ), vld1q_u8( src2 ) ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * in1X = in1Y + totalSimdWidth;
+                const uint8_t * in2X = in2Y + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++in1X, ++in2X )
+                    ( *outX ) = ( *in1X ) & ( *in2X );
+            }
+        }
+    }
+
+    void BitwiseOr( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                    uint32_t, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, in1Y += rowSizeIn1, in2Y += rowSizeIn2 ) {
+            const uint8_t * src1 = in1Y;
+            const uint8_t * src2 = in2Y;
+            uint8_t * dst = outY;
+
+            const uint8_t * src1End = src1 + totalSimdWidth;
+
+            for ( ; src1 != src1End; src1 += simdSize, src2 += simdSize, dst += simdSize )
+                vst1q_u8( dst, vorrq_u8( vld1q_u8( src1 ), vld1q_u8( src2 ) ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * in1X = in1Y + totalSimdWidth;
+                const uint8_t * in2X = in2Y + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++in1X, ++in2X )
+                    ( *outX ) = ( *in1X ) | ( *in2X );
+            }
+        }
+    }
+
+    void BitwiseXor( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                     uint32_t, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, in1Y += rowSizeIn1, in2Y += rowSizeIn2 ) {
+            const uint8_t * src1 = in1Y;
+            const uint8_t * src2 = in2Y;
+            uint8_t * dst = outY;
+
+            const uint8_t * src1End = src1 + totalSimdWidth;
+
+            for ( ; src1 != src1End; src1 += simdSize, src2 += simdSize, dst += simdSize )
+                vst1q_u8( dst, veorq_u8( vld1q_u8( src1 ), vld1q_u8( src2 ) ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * in1X = in1Y + totalSimdWidth;
+                const uint8_t * in2X = in2Y + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++in1X, ++in2X )
+                    ( *outX ) = ( *in1X ) ^ ( *in2X );
+            }
+        }
+    }
+
+    void ConvertTo16Bit( uint16_t * outY, const uint16_t * outYEnd, const uint8_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint32_t, uint32_t totalSimdWidth,
+                         uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, inY += rowSizeIn ) {
+            const uint8_t * src = inY;
+            uint16_t * dst = outY;
+            const uint8_t * srcEnd = src + totalSimdWidth;
+
+            for ( ; src != srcEnd; src += 8, dst += 8 ) {
+                vst1q_u16( dst, vshll_n_u8( vld1_u8( src ), 8 ) );
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * inX = inY + totalSimdWidth;
+                uint16_t * outX = outY + totalSimdWidth;
+                const uint16_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++inX )
+                    *outX = static_cast<uint16_t>( ( *inX ) << 8 );
+            }
+        }
+    }
+
+    void ConvertTo8Bit( uint8_t * outY, const uint8_t * outYEnd, const uint16_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint32_t, uint32_t totalSimdWidth,
+                        uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, inY += rowSizeIn ) {
+            const uint16_t * src = inY;
+            uint8_t * dst = outY;
+            const uint16_t * srcEnd = src + totalSimdWidth;
+
+            for ( ; src != srcEnd; src += 8, dst += 8 )
+                vst1_u8( dst, vshrn_n_u16( vld1q_u16( src ), 8 ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint16_t * inX = inY + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++inX )
+                    *outX = static_cast<uint8_t>( ( *inX ) >> 8 );
+            }
+        }
+    }
+
+    void ConvertToRgb( uint8_t * outY, const uint8_t * outYEnd, const uint8_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint8_t colorCount, uint32_t simdWidth,
+                       uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        const uint8_t ctrl1_array[8] = { 0, 0, 0, 1, 1, 1, 2, 2 };
+        const uint8_t ctrl2_array[8] = { 2, 3, 3, 3, 4, 4, 4, 5 };
+        const uint8_t ctrl3_array[8] = { 5, 5, 6, 6, 6, 7, 7, 7 };
+
+        const uint8x8_t ctrl1 = vld1_u8( ctrl1_array );
+        const uint8x8_t ctrl2 = vld1_u8( ctrl2_array );
+        const uint8x8_t ctrl3 = vld1_u8( ctrl3_array );
+
+        const uint32_t simdSize = totalSimdWidth / simdWidth;
+        const size_t rgbSize = sizeof( uint8_t ) * colorCount;
+
+        for ( ; outY != outYEnd; outY += rowSizeOut, inY += rowSizeIn ) {
+            const uint8_t * src = inY;
+            uint8_t * dst = outY;
+
+            const uint8_t * srcEnd = src + totalSimdWidth;
+
+            for ( ; src != srcEnd; src += simdSize ) {
+                const uint8x8_t src1 = vld1_u8( src );
+
+                vst1_u8( dst, vtbl1_u8( src1, ctrl1 ) );
+                dst += 8;
+                vst1_u8( dst, vtbl1_u8( src1, ctrl2 ) );
+                dst += 8;
+                vst1_u8( dst, vtbl1_u8( src1, ctrl3 ) );
+                dst += 8;
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * inX = inY + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth * colorCount;
+
+                const uint8_t * inXEnd = inX + nonSimdWidth;
+
+                for ( ; inX != inXEnd; outX += colorCount, ++inX )
+                    memset( outX, *inX, rgbSize );
+            }
+        }
+    }
+
+    void Flip( uint8_t * outData, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height, const uint32_t rowSizeIn, const uint32_t rowSizeOut,
+               const uint8_t * inY, const uint8_t * inYEnd, bool horizontal, bool vertical, const uint32_t simdWidth, const uint32_t totalSimdWidth,
+               const uint32_t nonSimdWidth )
+    {
+        if ( horizontal && !vertical ) {
+            uint8_t * outYSimd = outData + startYOut * rowSizeOut + startXOut + width - 8;
+            uint8_t * outY = outData + startYOut * rowSizeOut + startXOut + width - 1;
+
+            for ( ; inY != inYEnd; inY += rowSizeIn, outY += rowSizeOut, outYSimd += rowSizeOut ) {
+                const uint8_t * inXSimd = inY;
+                uint8_t * outXSimd = outYSimd;
+                const uint8_t * inXEndSimd = inXSimd + simdWidth * 8;
+
+                for ( ; inXSimd != inXEndSimd; inXSimd += 8, outXSimd -= 8 )
+                    vst1_u8( outXSimd, vrev64_u8( vld1_u8( inXSimd ) ) );
+
+                if ( nonSimdWidth > 0 ) {
+                    const uint8_t * inX = inY + totalSimdWidth;
+                    uint8_t * outX = outY - totalSimdWidth;
+                    const uint8_t * inXEnd = inX + nonSimdWidth;
+
+                    for ( ; inX != inXEnd; ++inX, --outX )
+                        ( *outX ) = ( *inX );
+                }
+            }
+        }
+        else if ( !horizontal && vertical ) {
+            throw std::logic_error( "This case should not be handled in this function" );
+        }
+        else {
+            uint8_t * outYSimd = outData + ( startYOut + height - 1 ) * rowSizeOut + startXOut + width - 8;
+            uint8_t * outY = outData + ( startYOut + height - 1 ) * rowSizeOut + startXOut + width - 1;
+
+            for ( ; inY != inYEnd; inY += rowSizeIn, outY -= rowSizeOut, outYSimd -= rowSizeOut ) {
+                const uint8_t * inXSimd = inY;
+                uint8_t * outXSimd = outYSimd;
+                const uint8_t * inXEndSimd = inXSimd + simdWidth * 8;
+
+                for ( ; inXSimd != inXEndSimd; inXSimd += 8, outXSimd -= 8 )
+                    vst1_u8( outXSimd, vrev64_u8( vld1_u8( inXSimd ) ) );
+
+                if ( nonSimdWidth > 0 ) {
+                    const uint8_t * inX = inY + totalSimdWidth;
+                    uint8_t * outX = outY - totalSimdWidth;
+                    const uint8_t * inXEnd = inX + nonSimdWidth;
+
+                    for ( ; inX != inXEnd; ++inX, --outX )
+                        ( *outX ) = ( *inX );
+                }
+            }
+        }
+    }
+
+    void Invert( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint32_t, uint32_t totalSimdWidth,
+                 uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, inY += rowSizeIn ) {
+            const uint8_t * src1 = inY;
+            uint8_t * dst = outY;
+
+            const uint8_t * src1End = src1 + totalSimdWidth;
+
+            for ( ; src1 != src1End; src1 += simdSize, dst += simdSize )
+                vst1q_u8( dst, vmvnq_u8( vld1q_u8( src1 ) ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * inX = inY + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++inX )
+                    ( *outX ) = static_cast<uint8_t>( ~( *inX ) );
+            }
+        }
+    }
+
+    void Maximum( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                  uint32_t, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, in1Y += rowSizeIn1, in2Y += rowSizeIn2 ) {
+            const uint8_t * src1 = in1Y;
+            const uint8_t * src2 = in2Y;
+            uint8_t * dst = outY;
+
+            const uint8_t * src1End = src1 + totalSimdWidth;
+
+            for ( ; src1 != src1End; src1 += simdSize, src2 += simdSize, dst += simdSize )
+                vst1q_u8( dst, vmaxq_u8( vld1q_u8( src1 ), vld1q_u8( src2 ) ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * in1X = in1Y + totalSimdWidth;
+                const uint8_t * in2X = in2Y + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++in1X, ++in2X ) {
+                    if ( ( *in2X ) < ( *in1X ) )
+                        ( *outX ) = ( *in1X );
+                    else
+                        ( *outX ) = ( *in2X );
+                }
+            }
+        }
+    }
+
+    void Minimum( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                  uint32_t, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, in1Y += rowSizeIn1, in2Y += rowSizeIn2 ) {
+            const uint8_t * src1 = in1Y;
+            const uint8_t * src2 = in2Y;
+            uint8_t * dst = outY;
+
+            const uint8_t * src1End = src1 + totalSimdWidth;
+
+            for ( ; src1 != src1End; src1 += simdSize, src2 += simdSize, dst += simdSize )
+                vst1q_u8( dst, vminq_u8( vld1q_u8( src1 ), vld1q_u8( src2 ) ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * in1X = in1Y + totalSimdWidth;
+                const uint8_t * in2X = in2Y + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++in1X, ++in2X ) {
+                    if ( ( *in2X ) > ( *in1X ) )
+                        ( *outX ) = ( *in1X );
+                    else
+                        ( *outX ) = ( *in2X );
+                }
+            }
+        }
+    }
+
+    void ProjectionProfile( uint32_t rowSize, const uint8_t * imageStart, uint32_t height, bool horizontal, uint32_t * out, uint32_t, uint32_t totalSimdWidth,
+                            uint32_t nonSimdWidth )
+    {
+        const uint8x8_t zero = vdup_n_u8( 0 );
+        const uint16x4_t zero_16 = vdup_n_u16( 0 );
+
+        if ( horizontal ) {
+            const uint8_t * imageSimdXEnd = imageStart + totalSimdWidth;
+
+            for ( ; imageStart != imageSimdXEnd; imageStart += simdSize, out += simdSize ) {
+                const uint8_t * imageSimdY = imageStart;
+                const uint8_t * imageSimdYEnd = imageSimdY + height * rowSize;
+                uint32x4_t simdSum_1 = vdupq_n_u32( 0 );
+                uint32x4_t simdSum_2 = vdupq_n_u32( 0 );
+                uint32x4_t simdSum_3 = vdupq_n_u32( 0 );
+                uint32x4_t simdSum_4 = vdupq_n_u32( 0 );
+
+                uint32_t * dst = out;
+
+                for ( ; imageSimdY != imageSimdYEnd; imageSimdY += rowSize ) {
+                    const uint8_t * src = imageSimdY;
+
+                    const uint8x16_t data = vld1q_u8( src );
+
+                    const uint16x8_t dataLo = vaddl_u8( vget_low_u8( data ), zero );
+
+                    const uint32x4_t data_1 = vaddl_u16( vget_low_u16( dataLo ), zero_16 );
+                    const uint32x4_t data_2 = vaddl_u16( vget_high_u16( dataLo ), zero_16 );
+                    const uint32x4_t data_3 = vaddl_u16( vget_low_u16( dataLo ), zero_16 );
+                    const uint32x4_t data_4 = vaddl_u16( vget_high_u16( dataLo ), zero_16 );
+
+                    simdSum_1 = vaddq_u32( simdSum_1, data_1 );
+                    simdSum_2 = vaddq_u32( simdSum_2, data_2 );
+                    simdSum_3 = vaddq_u32( simdSum_3, data_3 );
+                    simdSum_4 = vaddq_u32( simdSum_4, data_4 );
+                }
+
+                vst1q_u32( dst, vaddq_u32( vld1q_u32( dst ), simdSum_1 ) );
+                dst += 4;
+                vst1q_u32( dst, vaddq_u32( vld1q_u32( dst ), simdSum_2 ) );
+                dst += 4;
+                vst1q_u32( dst, vaddq_u32( vld1q_u32( dst ), simdSum_3 ) );
+                dst += 4;
+                vst1q_u32( dst, vaddq_u32( vld1q_u32( dst ), simdSum_4 ) );
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * imageXEnd = imageStart + nonSimdWidth;
+
+                for ( ; imageStart != imageXEnd; ++imageStart, ++out ) {
+                    const uint8_t * imageY = imageStart;
+                    const uint8_t * imageYEnd = imageY + height * rowSize;
+
+                    for ( ; imageY != imageYEnd; imageY += rowSize )
+                        ( *out ) += ( *imageY );
+                }
+            }
+        }
+        else {
+            const uint8_t * imageYEnd = imageStart + height * rowSize;
+
+            for ( ; imageStart != imageYEnd; imageStart += rowSize, ++out ) {
+                const uint8_t * src = imageStart;
+                const uint8_t * srcEnd = src + totalSimdWidth;
+                uint32x4_t simdSum = vdupq_n_u32( 0 );
+
+                for ( ; src != srcEnd; src += simdSize ) {
+                    const uint8x16_t data = vld1q_u8( src );
+
+                    const uint16x8_t dataLo = vaddl_u8( vget_low_u8( data ), zero );
+                    const uint16x8_t dataHi = vaddl_u8( vget_high_u8( data ), zero );
+                    const uint16x8_t sumLoHi = vaddq_u16( dataHi, dataLo );
+
+                    const uint32x4_t sum = vaddl_u16( vadd_u16( vget_low_u16( sumLoHi ), vget_high_u16( sumLoHi ) ), zero_16 );
+
+                    simdSum = vaddq_u32( simdSum, sum );
+                }
+
+                if ( nonSimdWidth > 0 ) {
+                    const uint8_t * imageX = imageStart + totalSimdWidth;
+                    const uint8_t * imageXEnd = imageX + nonSimdWidth;
+
+                    for ( ; imageX != imageXEnd; ++imageX )
+                        ( *out ) += ( *imageX );
+                }
+
+                uint32_t output[4] = { 0 };
+                vst1q_u32( output, simdSum );
+
+                ( *out ) += output[0] + output[1] + output[2] + output[3];
+            }
+        }
+    }
+
+    void RgbToBgr( uint8_t * outY, const uint8_t * inY, const uint8_t * outYEnd, uint32_t rowSizeOut, uint32_t rowSizeIn, const uint8_t colorCount, uint32_t simdWidth,
+                   uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        const uint8_t ctrl_array[8] = { 2, 1, 0, 5, 4, 3, 6, 7 };
+        const uint8x8_t ctrl = vld1_u8( ctrl_array );
+        for ( ; outY != outYEnd; outY += rowSizeOut, inY += rowSizeIn ) {
+            const uint8_t * inX = inY;
+            uint8_t * outX = outY;
+
+            const uint8_t * outXEnd = outX + totalSimdWidth;
+
+            for ( ; outX != outXEnd; outX += simdWidth, inX += simdWidth ) {
+                uint8x8_t result = vld1_u8( inX );
+                result = vtbl1_u8( result, ctrl );
+                vst1_u8( outX, result );
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * outXEndNonSimd = outXEnd + nonSimdWidth;
+                for ( ; outX != outXEndNonSimd; outX += colorCount, inX += colorCount ) {
+                    *( outX + 2 ) = *( inX );
+                    *( outX + 1 ) = *( inX + 1 );
+                    *( outX ) = *( inX + 2 );
+                }
+            }
+        }
+    }
+
+    void Subtract( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                   uint32_t, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, in1Y += rowSizeIn1, in2Y += rowSizeIn2 ) {
+            const uint8_t * src1 = in1Y;
+            const uint8_t * src2 = in2Y;
+            uint8_t * dst = outY;
+
+            const uint8_t * src1End = src1 + totalSimdWidth;
+
+            for ( ; src1 != src1End; src1 += simdSize, src2 += simdSize, dst += simdSize ) {
+                const simd data = vld1q_u8( src1 );
+                vst1q_u8( dst, vsubq_u8( data, vminq_u8( data, vld1q_u8( src2 ) ) ) );
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * in1X = in1Y + totalSimdWidth;
+                const uint8_t * in2X = in2Y + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++in1X, ++in2X )
+                    ( *outX ) = static_cast<uint8_t>( ( *in2X ) > ( *in1X ) ? 0u : static_cast<uint32_t>( *in1X ) - static_cast<uint32_t>( *in2X ) );
+            }
+        }
+    }
+
+    uint32_t Sum( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        uint32_t sum = 0;
+        uint32x4_t simdSum = vdupq_n_u32( 0 );
+
+        for ( ; imageY != imageYEnd; imageY += rowSize ) {
+            const uint8_t * src = imageY;
+            const uint8_t * srcEnd = src + totalSimdWidth;
+
+            for ( ; src != srcEnd; src += simdSize ) {
+                const uint8x16_t data = vld1q_u8( src );
+                const uint16x8_t data8Sum = vaddl_u8( vget_high_u8( data ), vget_low_u8( data ) );
+                const uint32x4_t data16Sum = vaddl_u16( vget_high_u16( data8Sum ), vget_low_u16( data8Sum ) );
+                simdSum = vaddq_u32( simdSum, data16Sum );
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * imageX = imageY + totalSimdWidth;
+                const uint8_t * imageXEnd = imageX + nonSimdWidth;
+
+                for ( ; imageX != imageXEnd; ++imageX )
+                    sum += ( *imageX );
+            }
+        }
+
+        uint32_t output[4] = { 0 };
+        vst1q_u32( output, simdSum );
+        return ( sum + output[0] + output[1] + output[2] + output[3] );
+    }
+
+    void Threshold( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint8_t threshold, uint32_t,
+                    uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        const uint8_t thresholdValue[16] = { threshold, threshold, threshold, threshold, threshold, threshold, threshold, threshold,
+                                             threshold, threshold, threshold, threshold, threshold, threshold, threshold, threshold };
+        const simd compare = vld1q_u8( thresholdValue );
+
+        for ( ; outY != outYEnd; outY += rowSizeOut, inY += rowSizeIn ) {
+            const uint8_t * src = inY;
+            uint8_t * dst = outY;
+
+            const uint8_t * srcEnd = src + totalSimdWidth;
+
+            for ( ; src != srcEnd; src += simdSize, dst += simdSize )
+                vst1q_u8( dst, vcgeq_u8( vld1q_u8( src ), compare ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * inX = inY + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++inX )
+                    ( *outX ) = ( *inX ) < threshold ? 0 : 255;
+            }
+        }
+    }
+
+    void Threshold( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint8_t minThreshold, uint8_t maxThreshold,
+                    uint32_t, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        const uint8_t thresholdMinValue[16] = { minThreshold, minThreshold, minThreshold, minThreshold, minThreshold, minThreshold, minThreshold, minThreshold,
+                                                minThreshold, minThreshold, minThreshold, minThreshold, minThreshold, minThreshold, minThreshold, minThreshold };
+        const simd compareMin = vld1q_u8( thresholdMinValue );
+
+        const uint8_t thresholdMaxValue[16] = { maxThreshold, maxThreshold, maxThreshold, maxThreshold, maxThreshold, maxThreshold, maxThreshold, maxThreshold,
+                                                maxThreshold, maxThreshold, maxThreshold, maxThreshold, maxThreshold, maxThreshold, maxThreshold, maxThreshold };
+        const simd compareMax = vld1q_u8( thresholdMaxValue );
+
+        for ( ; outY != outYEnd; outY += rowSizeOut, inY += rowSizeIn ) {
+            const uint8_t * src = inY;
+            uint8_t * dst = outY;
+
+            const uint8_t * srcEnd = src + totalSimdWidth;
+
+            for ( ; src != srcEnd; src += simdSize, dst += simdSize ) {
+                const simd data = vld1q_u8( src );
+                vst1q_u8( dst, vandq_u8( vcgeq_u8( data, compareMin ), vcleq_u8( data, compareMax ) ) );
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * inX = inY + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++inX )
+                    ( *outX ) = ( *inX ) < minThreshold || ( *inX ) > maxThreshold ? 0 : 255;
+            }
+        }
+    }
+
+    void Accumulate64( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint64_t * outY, uint32_t, uint32_t totalSimdWidth,
+                       uint32_t nonSimdWidth )
+    {
+        const uint32_t width = totalSimdWidth + nonSimdWidth;
+
+        for ( ; imageY != imageYEnd; imageY += rowSize, outY += width ) {
+            const uint8_t * src = imageY;
+            const uint8_t * srcEnd = src + totalSimdWidth;
+            uint64_t * dst = outY;
+
+            // Widening moves keep pixel order so every 16 pixels are added to eight vectors of 2 values
+            for ( ; src != srcEnd; src += simdSize ) {
+                const uint8x16_t data = vld1q_u8( src );
+                const uint16x8_t data16[2] = { vmovl_u8( vget_low_u8( data ) ), vmovl_u8( vget_high_u8( data ) ) };
+
+                for ( uint32_t i = 0; i < 2u; ++i ) {
+                    const uint32x4_t data32[2] = { vmovl_u16( vget_low_u16( data16[i] ) ), vmovl_u16( vget_high_u16( data16[i] ) ) };
+
+                    for ( uint32_t j = 0; j < 2u; ++j ) {
+                        vst1q_u64( dst, vaddw_u32( vld1q_u64( dst ), vget_low_u32( data32[j] ) ) );
+                        dst += 2;
+                        vst1q_u64( dst, vaddw_u32( vld1q_u64( dst ), vget_high_u32( data32[j] ) ) );
+                        dst += 2;
+                    }
+                }
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * imageX = imageY + totalSimdWidth;
+                const uint8_t * imageXEnd = imageX + nonSimdWidth;
+                uint64_t * outX = outY + totalSimdWidth;
+
+                for ( ; imageX != imageXEnd; ++imageX, ++outX )
+                    ( *outX ) += ( *imageX );
+            }
+        }
+    }
+
+    uint64_t Sum64( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        uint64_t sum = 0;
+        uint64x2_t simdSum = vdupq_n_u64( 0 );
+
+        for ( ; imageY != imageYEnd; imageY += rowSize ) {
+            const uint8_t * src = imageY;
+            const uint8_t * srcEnd = src + totalSimdWidth;
+
+            // Pairwise widening additions accumulate every 8 pixels into a 64-bit lane
+            for ( ; src != srcEnd; src += simdSize )
+                simdSum = vpadalq_u32( simdSum, vpaddlq_u16( vpaddlq_u8( vld1q_u8( src ) ) ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * imageX = imageY + totalSimdWidth;
+                const uint8_t * imageXEnd = imageX + nonSimdWidth;
+
+                for ( ; imageX != imageXEnd; ++imageX )
+                    sum += ( *imageX );
+            }
+        }
+
+        uint64_t output[2] = { 0 };
+        vst1q_u64( output, simdSum );
+        return ( sum + output[0] + output[1] );
+    }
+
+    void ProjectionProfile64( uint32_t rowSize, const uint8_t * imageStart, uint32_t height, bool horizontal, uint64_t * out, uint32_t simdWidth,
+                              uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        if ( horizontal ) {
+            const uint8_t * imageSimdXEnd = imageStart + totalSimdWidth;
+
+            for ( ; imageStart != imageSimdXEnd; imageStart += simdSize, out += simdSize ) {
+                const uint8_t * imageSimdY = imageStart;
+                uint32_t rowCount = height;
+
+                while ( rowCount > 0 ) {
+                    // 32-bit sums can't overflow within this block of rows
+                    const uint32_t blockHeight = ( rowCount < ( 1u << 24 ) ) ? rowCount : ( 1u << 24 );
+                    const uint8_t * imageSimdYEnd = imageSimdY + static_cast<size_t>( blockHeight ) * rowSize;
+                    rowCount -= blockHeight;
+
+                    uint32x4_t simdSum[4] = { vdupq_n_u32( 0 ), vdupq_n_u32( 0 ), vdupq_n_u32( 0 ), vdupq_n_u32( 0 ) };
+
+                    for ( ; imageSimdY != imageSimdYEnd; imageSimdY += rowSize ) {
+                        const uint8x16_t data = vld1q_u8( imageSimdY );
+                        const uint16x8_t dataLo = vmovl_u8( vget_low_u8( data ) );
+                        const uint16x8_t dataHi = vmovl_u8( vget_high_u8( data ) );
+
+                        simdSum[0] = vaddw_u16( simdSum[0], vget_low_u16( dataLo ) );
+                        simdSum[1] = vaddw_u16( simdSum[1], vget_high_u16( dataLo ) );
+                        simdSum[2] = vaddw_u16( simdSum[2], vget_low_u16( dataHi ) );
+                        simdSum[3] = vaddw_u16( simdSum[3], vget_high_u16( dataHi ) );
+                    }
+
+                    uint64_t * dst = out;
+
+                    for ( uint32_t i = 0; i < 4u; ++i ) {
+                        vst1q_u64( dst, vaddw_u32( vld1q_u64( dst ), vget_low_u32( simdSum[i] ) ) );
+                        dst += 2;
+                        vst1q_u64( dst, vaddw_u32( vld1q_u64( dst ), vget_high_u32( simdSum[i] ) ) );
+                        dst += 2;
+                    }
+                }
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * imageXEnd = imageStart + nonSimdWidth;
+
+                for ( ; imageStart != imageXEnd; ++imageStart, ++out ) {
+                    const uint8_t * imageY = imageStart;
+                    const uint8_t * imageYEnd = imageY + static_cast<size_t>( height ) * rowSize;
+
+                    for ( ; imageY != imageYEnd; imageY += rowSize )
+                        ( *out ) += ( *imageY );
+                }
+            }
+        }
+        else {
+            const uint8_t * imageYEnd = imageStart + static_cast<size_t>( height ) * rowSize;
+
+            for ( ; imageStart != imageYEnd; imageStart += rowSize, ++out )
+                ( *out ) = Sum64( rowSize, imageStart, imageStart + rowSize, simdWidth, totalSimdWidth, nonSimdWidth );
+        }
+    }
+#endif
+}
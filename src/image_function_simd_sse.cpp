@@ -0,0 +1,840 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "image_function_simd_kernel.h"
+#include <cstring>
+#include <stdexcept>
+
+#ifdef PENGUINV_SSE_SET
+#include <emmintrin.h>
+#endif
+
+#ifdef PENGUINV_SSSE3_SET
+#include <tmmintrin.h>
+#endif
+
+#if defined( PENGUINV_SSE_DISPATCH ) && !defined( PENGUINV_SSE_SET )
+#error "This file must be compiled with SSE2 instruction set, for example with -msse2 flag"
+#endif
+
+#if defined( PENGUINV_SSSE3_DISPATCH ) && !defined( PENGUINV_SSSE3_SET )
+#error "This file must be compiled with SSSE3 instruction set, for example with -mssse3 flag"
+#endif
+
+namespace sse
+{
+#ifdef PENGUINV_SSE_SET
+    typedef __m128i simd;
+
+    // We are not sure that input data is aligned by 16 bytes so we use loadu() functions instead of load()
+
+    void AbsoluteDifference( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY,
+                             const uint8_t * outYEnd, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, in1Y += rowSizeIn1, in2Y += rowSizeIn2 ) {
+            const simd * src1 = reinterpret_cast<const simd *>( in1Y );
+            const simd * src2 = reinterpret_cast<const simd *>( in2Y );
+            simd * dst = reinterpret_cast<simd *>( outY );
+
+            const simd * src1End = src1 + simdWidth;
+
+            for ( ; src1 != src1End; ++src1, ++src2, ++dst ) {
+                simd data1 = _mm_loadu_si128( src1 );
+                simd data2 = _mm_loadu_si128( src2 );
+                _mm_storeu_si128( dst, _mm_sub_epi8( _mm_max_epu8( data1, data2 ), _mm_min_epu8( data1, data2 ) ) );
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * in1X = in1Y + totalSimdWidth;
+                const uint8_t * in2X = in2Y + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++in1X, ++in2X )
+                    ( *outX ) = static_cast<uint8_t>( ( *in2X ) > ( *in1X ) ? ( *in2X ) - ( *in1X ) : ( *in1X ) - ( *in2X ) );
+            }
+        }
+    }
+
+    void Accumulate( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t * outY, uint32_t simdWidth, uint32_t totalSimdWidth,
+                     uint32_t nonSimdWidth )
+    {
+        simd zero = _mm_setzero_si128();
+
+        const uint32_t width = totalSimdWidth + nonSimdWidth;
+
+        for ( ; imageY != imageYEnd; imageY += rowSize, outY += width ) {
+            const simd * src = reinterpret_cast<const simd *>( imageY );
+            const simd * srcEnd = src + simdWidth;
+            simd * dst = reinterpret_cast<simd *>( outY );
+
+            for ( ; src != srcEnd; ++src ) {
+                simd data = _mm_loadu_si128( src );
+
+                const simd dataLo = _mm_unpacklo_epi8( data, zero );
+                const simd dataHi = _mm_unpackhi_epi8( data, zero );
+
+                const simd data_1 = _mm_unpacklo_epi16( dataLo, zero );
+                const simd data_2 = _mm_unpackhi_epi16( dataLo, zero );
+                const simd data_3 = _mm_unpacklo_epi16( dataHi, zero );
+                const simd data_4 = _mm_unpackhi_epi16( dataHi, zero );
+
+                _mm_storeu_si128( dst, _mm_add_epi32( data_1, _mm_loadu_si128( dst ) ) );
+                ++dst;
+                _mm_storeu_si128( dst, _mm_add_epi32( data_2, _mm_loadu_si128( dst ) ) );
+                ++dst;
+                _mm_storeu_si128( dst, _mm_add_epi32( data_3, _mm_loadu_si128( dst ) ) );
+                ++dst;
+                _mm_storeu_si128( dst, _mm_add_epi32( data_4, _mm_loadu_si128( dst ) ) );
+                ++dst;
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * imageX = imageY + totalSimdWidth;
+                const uint8_t * imageXEnd = imageX + nonSimdWidth;
+                uint32_t * outX = outY + totalSimdWidth;
+
+                for ( ; imageX != imageXEnd; ++imageX, ++outX )
+                    ( *outX ) += ( *imageX );
+            }
+        }
+    }
+
+    void BitwiseAnd( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                     uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, in1Y += rowSizeIn1, in2Y += rowSizeIn2 ) {
+            const simd * src1 = reinterpret_cast<const simd *>( in1Y );
+            const simd * src2 = reinterpret_cast<const simd *>( in2Y );
+            simd * dst = reinterpret_cast<simd *>( outY );
+
+            const simd * src1End = src1 + simdWidth;
+
+            for ( ; src1 != src1End; ++src1, ++src2, ++dst )
+                _mm_storeu_si128( dst, _mm_and_si128( _mm_loadu_si128( src1 ), _mm_loadu_si128( src2 ) ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * in1X = in1Y + totalSimdWidth;
+                const uint8_t * in2X = in2Y + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++in1X, ++in2X )
+                    ( *outX ) = ( *in1X ) & ( *in2X );
+            }
+        }
+    }
+
+    void BitwiseOr( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                    uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, in1Y += rowSizeIn1, in2Y += rowSizeIn2 ) {
+            const simd * src1 = reinterpret_cast<const simd *>( in1Y );
+            const simd * src2 = reinterpret_cast<const simd *>( in2Y );
+            simd * dst = reinterpret_cast<simd *>( outY );
+
+            const simd * src1End = src1 + simdWidth;
+
+            for ( ; src1 != src1End; ++src1, ++src2, ++dst )
+                _mm_storeu_si128( dst, _mm_or_si128( _mm_loadu_si128( src1 ), _mm_loadu_si128( src2 ) ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * in1X = in1Y + totalSimdWidth;
+                const uint8_t * in2X = in2Y + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++in1X, ++in2X )
+                    ( *outX ) = ( *in1X ) | ( *in2X );
+            }
+        }
+    }
+
+    void BitwiseXor( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                     uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, in1Y += rowSizeIn1, in2Y += rowSizeIn2 ) {
+            const simd * src1 = reinterpret_cast<const simd *>( in1Y );
+            const simd * src2 = reinterpret_cast<const simd *>( in2Y );
+            simd * dst = reinterpret_cast<simd *>( outY );
+
+            const simd * src1End = src1 + simdWidth;
+
+            for ( ; src1 != src1End; ++src1, ++src2, ++dst )
+                _mm_storeu_si128( dst, _mm_xor_si128( _mm_loadu_si128( src1 ), _mm_loadu_si128( src2 ) ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * in1X = in1Y + totalSimdWidth;
+                const uint8_t * in2X = in2Y + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++in1X, ++in2X )
+                    ( *outX ) = ( *in1X ) ^ ( *in2X );
+            }
+        }
+    }
+
+    void ConvertTo16Bit( uint16_t * outY, const uint16_t * outYEnd, const uint8_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint32_t simdWidth,
+                         uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        const simd zero = _mm_setzero_si128();
+        for ( ; outY != outYEnd; outY += rowSizeOut, inY += rowSizeIn ) {
+            const simd * src = reinterpret_cast<const simd *>( inY );
+            simd * dst = reinterpret_cast<simd *>( outY );
+            const simd * srcEnd = src + simdWidth;
+
+            for ( ; src != srcEnd; ++src ) {
+                const simd srcData = _mm_loadu_si128( src );
+
+                _mm_storeu_si128( dst++, _mm_unpacklo_epi8( zero, srcData ) );
+                _mm_storeu_si128( dst++, _mm_unpacklo_epi8( zero, srcData ) );
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * inX = inY + totalSimdWidth;
+                uint16_t * outX = outY + totalSimdWidth;
+                const uint16_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++inX )
+                    *outX = static_cast<uint16_t>( ( *inX ) << 8 );
+            }
+        }
+    }
+
+    void ConvertTo8Bit( uint8_t * outY, const uint8_t * outYEnd, const uint16_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint32_t simdWidth,
+                        uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, inY += rowSizeIn ) {
+            const simd * src = reinterpret_cast<const simd *>( inY );
+            simd * dst = reinterpret_cast<simd *>( outY );
+            const simd * dstEnd = dst + simdWidth;
+
+            for ( ; dst != dstEnd; ++dst ) {
+                const simd srcData1 = _mm_loadu_si128( src );
+                ++src;
+                const simd srcData2 = _mm_loadu_si128( src );
+                ++src;
+
+                _mm_storeu_si128( dst, _mm_packus_epi16( _mm_srli_epi16( srcData1, 8 ), _mm_srli_epi16( srcData2, 8 ) ) );
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint16_t * inX = inY + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++inX )
+                    *outX = static_cast<uint8_t>( ( *inX ) >> 8 );
+            }
+        }
+    }
+
+#ifdef PENGUINV_SSSE3_SET
+    void ConvertToRgb( uint8_t * outY, const uint8_t * outYEnd, const uint8_t * inY, uint32_t rowSizeOut, uint32_t rowSizeIn, uint8_t colorCount, uint32_t simdWidth,
+                       uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        const simd ctrl1 = _mm_setr_epi8( 0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5 );
+        const simd ctrl2 = _mm_setr_epi8( 5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10 );
+        const simd ctrl3 = _mm_setr_epi8( 10, 11, 11, 11, 12, 12, 12, 13, 13, 13, 14, 14, 14, 15, 15, 15 );
+        const size_t rgbSize = sizeof( uint8_t ) * colorCount;
+
+        for ( ; outY != outYEnd; outY += rowSizeOut, inY += rowSizeIn ) {
+            const simd * src = reinterpret_cast<const simd *>( inY );
+            simd * dst = reinterpret_cast<simd *>( outY );
+
+            const simd * srcEnd = src + simdWidth;
+
+            for ( ; src != srcEnd; ++src ) {
+                const simd src1 = _mm_loadu_si128( src );
+
+                _mm_storeu_si128( dst++, _mm_shuffle_epi8( src1, ctrl1 ) );
+                _mm_storeu_si128( dst++, _mm_shuffle_epi8( src1, ctrl2 ) );
+                _mm_storeu_si128( dst++, _mm_shuffle_epi8( src1, ctrl3 ) );
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * inX = inY + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth * colorCount;
+
+                const uint8_t * inXEnd = inX + nonSimdWidth;
+
+                for ( ; inX != inXEnd; outX += colorCount, ++inX )
+                    memset( outX, *inX, rgbSize );
+            }
+        }
+    }
+#endif
+
+#ifdef PENGUINV_SSSE3_SET
+    void Flip( uint8_t * outData, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height, const uint32_t rowSizeIn, const uint32_t rowSizeOut,
+               const uint8_t * inY, const uint8_t * inYEnd, bool horizontal, bool vertical, const uint32_t simdWidth, const uint32_t totalSimdWidth,
+               const uint32_t nonSimdWidth )
+    {
+        const simd ctrl = _mm_setr_epi8( 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 );
+
+        if ( horizontal && !vertical ) {
+            uint8_t * outYSimd = outData + startYOut * rowSizeOut + startXOut + width - simdSize;
+            uint8_t * outY = outData + startYOut * rowSizeOut + startXOut + width - 1;
+
+            for ( ; inY != inYEnd; inY += rowSizeIn, outY += rowSizeOut, outYSimd += rowSizeOut ) {
+                const simd * inXSimd = reinterpret_cast<const simd *>( inY );
+                simd * outXSimd = reinterpret_cast<simd *>( outYSimd );
+                const simd * inXEndSimd = inXSimd + simdWidth;
+
+                for ( ; inXSimd != inXEndSimd; ++inXSimd, --outXSimd )
+                    _mm_storeu_si128( outXSimd, _mm_shuffle_epi8( _mm_loadu_si128( inXSimd ), ctrl ) );
+
+                if ( nonSimdWidth > 0 ) {
+                    const uint8_t * inX = inY + totalSimdWidth;
+                    uint8_t * outX = outY - totalSimdWidth;
+                    const uint8_t * inXEnd = inX + nonSimdWidth;
+
+                    for ( ; inX != inXEnd; ++inX, --outX )
+                        ( *outX ) = ( *inX );
+                }
+            }
+        }
+        else if ( !horizontal && vertical ) {
+            throw std::logic_error( "This case should not be handled in this function" );
+        }
+        else {
+            uint8_t * outYSimd = outData + ( startYOut + height - 1 ) * rowSizeOut + startXOut + width - simdSize;
+            uint8_t * outY = outData + ( startYOut + height - 1 ) * rowSizeOut + startXOut + width - 1;
+
+            for ( ; inY != inYEnd; inY += rowSizeIn, outY -= rowSizeOut, outYSimd -= rowSizeOut ) {
+                const simd * inXSimd = reinterpret_cast<const simd *>( inY );
+                simd * outXSimd = reinterpret_cast<simd *>( outYSimd );
+                const simd * inXEndSimd = inXSimd + simdWidth;
+
+                for ( ; inXSimd != inXEndSimd; ++inXSimd, --outXSimd )
+                    _mm_storeu_si128( outXSimd, _mm_shuffle_epi8( _mm_loadu_si128( inXSimd ), ctrl ) );
+
+                if ( nonSimdWidth > 0 ) {
+                    const uint8_t * inX = inY + totalSimdWidth;
+                    uint8_t * outX = outY - totalSimdWidth;
+                    const uint8_t * inXEnd = inX + nonSimdWidth;
+
+                    for ( ; inX != inXEnd; ++inX, --outX )
+                        ( *outX ) = ( *inX );
+                }
+            }
+        }
+    }
+#endif
+
+    void Invert( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint32_t simdWidth, uint32_t totalSimdWidth,
+                 uint32_t nonSimdWidth )
+    {
+        const char maskValue = static_cast<char>( 0xffu );
+        const simd mask = _mm_set_epi8( maskValue, maskValue, maskValue, maskValue, maskValue, maskValue, maskValue, maskValue, maskValue, maskValue, maskValue,
+                                        maskValue, maskValue, maskValue, maskValue, maskValue );
+
+        for ( ; outY != outYEnd; outY += rowSizeOut, inY += rowSizeIn ) {
+            const simd * src1 = reinterpret_cast<const simd *>( inY );
+            simd * dst = reinterpret_cast<simd *>( outY );
+
+            const simd * src1End = src1 + simdWidth;
+
+            for ( ; src1 != src1End; ++src1, ++dst )
+                _mm_storeu_si128( dst, _mm_andnot_si128( _mm_loadu_si128( src1 ), mask ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * inX = inY + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++inX )
+                    ( *outX ) = static_cast<uint8_t>( ~( *inX ) );
+            }
+        }
+    }
+
+    void Maximum( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                  uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, in1Y += rowSizeIn1, in2Y += rowSizeIn2 ) {
+            const simd * src1 = reinterpret_cast<const simd *>( in1Y );
+            const simd * src2 = reinterpret_cast<const simd *>( in2Y );
+            simd * dst = reinterpret_cast<simd *>( outY );
+
+            const simd * src1End = src1 + simdWidth;
+
+            for ( ; src1 != src1End; ++src1, ++src2, ++dst )
+                _mm_storeu_si128( dst, _mm_max_epu8( _mm_loadu_si128( src1 ), _mm_loadu_si128( src2 ) ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * in1X = in1Y + totalSimdWidth;
+                const uint8_t * in2X = in2Y + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++in1X, ++in2X ) {
+                    if ( ( *in2X ) < ( *in1X ) )
+                        ( *outX ) = ( *in1X );
+                    else
+                        ( *outX ) = ( *in2X );
+                }
+            }
+        }
+    }
+
+    void Minimum( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                  uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, in1Y += rowSizeIn1, in2Y += rowSizeIn2 ) {
+            const simd * src1 = reinterpret_cast<const simd *>( in1Y );
+            const simd * src2 = reinterpret_cast<const simd *>( in2Y );
+            simd * dst = reinterpret_cast<simd *>( outY );
+
+            const simd * src1End = src1 + simdWidth;
+
+            for ( ; src1 != src1End; ++src1, ++src2, ++dst )
+                _mm_storeu_si128( dst, _mm_min_epu8( _mm_loadu_si128( src1 ), _mm_loadu_si128( src2 ) ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * in1X = in1Y + totalSimdWidth;
+                const uint8_t * in2X = in2Y + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++in1X, ++in2X ) {
+                    if ( ( *in2X ) > ( *in1X ) )
+                        ( *outX ) = ( *in1X );
+                    else
+                        ( *outX ) = ( *in2X );
+                }
+            }
+        }
+    }
+
+    void ProjectionProfile( uint32_t rowSize, const uint8_t * imageStart, uint32_t height, bool horizontal, uint32_t * out, uint32_t simdWidth, uint32_t totalSimdWidth,
+                            uint32_t nonSimdWidth )
+    {
+        const simd zero = _mm_setzero_si128();
+
+        if ( horizontal ) {
+            const uint8_t * imageSimdXEnd = imageStart + totalSimdWidth;
+
+            for ( ; imageStart != imageSimdXEnd; imageStart += simdSize, out += simdSize ) {
+                const uint8_t * imageSimdY = imageStart;
+                const uint8_t * imageSimdYEnd = imageSimdY + height * rowSize;
+                simd simdSum_1 = _mm_setzero_si128();
+                simd simdSum_2 = _mm_setzero_si128();
+                simd simdSum_3 = _mm_setzero_si128();
+                simd simdSum_4 = _mm_setzero_si128();
+
+                simd * dst = reinterpret_cast<simd *>( out );
+
+                for ( ; imageSimdY != imageSimdYEnd; imageSimdY += rowSize ) {
+                    const simd * src = reinterpret_cast<const simd *>( imageSimdY );
+
+                    const simd data = _mm_loadu_si128( src );
+
+                    const simd dataLo = _mm_unpacklo_epi8( data, zero );
+                    const simd dataHi = _mm_unpackhi_epi8( data, zero );
+
+                    const simd data_1 = _mm_unpacklo_epi16( dataLo, zero );
+                    const simd data_2 = _mm_unpackhi_epi16( dataLo, zero );
+                    const simd data_3 = _mm_unpacklo_epi16( dataHi, zero );
+                    const simd data_4 = _mm_unpackhi_epi16( dataHi, zero );
+                    simdSum_1 = _mm_add_epi32( data_1, simdSum_1 );
+                    simdSum_2 = _mm_add_epi32( data_2, simdSum_2 );
+                    simdSum_3 = _mm_add_epi32( data_3, simdSum_3 );
+                    simdSum_4 = _mm_add_epi32( data_4, simdSum_4 );
+                }
+
+                _mm_storeu_si128( dst, _mm_add_epi32( simdSum_1, _mm_loadu_si128( dst ) ) );
+                ++dst;
+                _mm_storeu_si128( dst, _mm_add_epi32( simdSum_2, _mm_loadu_si128( dst ) ) );
+                ++dst;
+                _mm_storeu_si128( dst, _mm_add_epi32( simdSum_3, _mm_loadu_si128( dst ) ) );
+                ++dst;
+                _mm_storeu_si128( dst, _mm_add_epi32( simdSum_4, _mm_loadu_si128( dst ) ) );
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * imageXEnd = imageStart + nonSimdWidth;
+
+                for ( ; imageStart != imageXEnd; ++imageStart, ++out ) {
+                    const uint8_t * imageY = imageStart;
+                    const uint8_t * imageYEnd = imageY + height * rowSize;
+
+                    for ( ; imageY != imageYEnd; imageY += rowSize )
+                        ( *out ) += ( *imageY );
+                }
+            }
+        }
+        else {
+            const uint8_t * imageYEnd = imageStart + height * rowSize;
+
+            for ( ; imageStart != imageYEnd; imageStart += rowSize, ++out ) {
+                const simd * src = reinterpret_cast<const simd *>( imageStart );
+                const simd * srcEnd = src + simdWidth;
+                simd simdSum = _mm_setzero_si128();
+
+                for ( ; src != srcEnd; ++src ) {
+                    simd data = _mm_loadu_si128( src );
+
+                    simd dataLo = _mm_unpacklo_epi8( data, zero );
+                    simd dataHi = _mm_unpackhi_epi8( data, zero );
+                    simd sumLoHi = _mm_add_epi16( dataLo, dataHi );
+
+                    simdSum = _mm_add_epi32( simdSum, _mm_add_epi32( _mm_unpacklo_epi16( sumLoHi, zero ), _mm_unpackhi_epi16( sumLoHi, zero ) ) );
+                }
+
+                if ( nonSimdWidth > 0 ) {
+                    const uint8_t * imageX = imageStart + totalSimdWidth;
+                    const uint8_t * imageXEnd = imageX + nonSimdWidth;
+
+                    for ( ; imageX != imageXEnd; ++imageX )
+                        ( *out ) += ( *imageX );
+                }
+
+                uint32_t output[4] = { 0 };
+                _mm_storeu_si128( reinterpret_cast<simd *>( output ), simdSum );
+
+                ( *out ) += output[0] + output[1] + output[2] + output[3];
+            }
+        }
+    }
+
+#ifdef PENGUINV_SSSE3_SET
+    void RgbToBgr( uint8_t * outY, const uint8_t * inY, const uint8_t * outYEnd, uint32_t rowSizeOut, uint32_t rowSizeIn, const uint8_t colorCount, uint32_t simdWidth,
+                   uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        const simd ctrl = _mm_set_epi8( 15, 12, 13, 14, 9, 10, 11, 6, 7, 8, 3, 4, 5, 0, 1, 2 );
+        for ( ; outY != outYEnd; outY += rowSizeOut, inY += rowSizeIn ) {
+            const uint8_t * inX = inY;
+            uint8_t * outX = outY;
+
+            const uint8_t * outXEnd = outX + totalSimdWidth;
+
+            for ( ; outX != outXEnd; outX += simdWidth, inX += simdWidth ) {
+                const simd * src = reinterpret_cast<const simd *>( inX );
+                simd * dst = reinterpret_cast<simd *>( outX );
+                simd result = _mm_loadu_si128( src );
+                result = _mm_shuffle_epi8( result, ctrl );
+                _mm_storeu_si128( dst, result );
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * outXEndNonSimd = outXEnd + nonSimdWidth;
+                for ( ; outX != outXEndNonSimd; outX += colorCount, inX += colorCount ) {
+                    *( outX + 2 ) = *( inX );
+                    *( outX + 1 ) = *( inX + 1 );
+                    *( outX ) = *( inX + 2 );
+                }
+            }
+        }
+    }
+#endif
+
+    void Subtract( uint32_t rowSizeIn1, uint32_t rowSizeIn2, uint32_t rowSizeOut, const uint8_t * in1Y, const uint8_t * in2Y, uint8_t * outY, const uint8_t * outYEnd,
+                   uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        for ( ; outY != outYEnd; outY += rowSizeOut, in1Y += rowSizeIn1, in2Y += rowSizeIn2 ) {
+            const simd * src1 = reinterpret_cast<const simd *>( in1Y );
+            const simd * src2 = reinterpret_cast<const simd *>( in2Y );
+            simd * dst = reinterpret_cast<simd *>( outY );
+
+            const simd * src1End = src1 + simdWidth;
+
+            for ( ; src1 != src1End; ++src1, ++src2, ++dst ) {
+                simd data = _mm_loadu_si128( src1 );
+                _mm_storeu_si128( dst, _mm_sub_epi8( data, _mm_min_epu8( data, _mm_loadu_si128( src2 ) ) ) );
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * in1X = in1Y + totalSimdWidth;
+                const uint8_t * in2X = in2Y + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++in1X, ++in2X )
+                    ( *outX ) = static_cast<uint8_t>( ( *in2X ) > ( *in1X ) ? 0u : static_cast<uint32_t>( *in1X ) - static_cast<uint32_t>( *in2X ) );
+            }
+        }
+    }
+
+    uint32_t Sum( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        uint32_t sum = 0;
+        simd simdSum = _mm_setzero_si128();
+        simd zero = _mm_setzero_si128();
+
+        for ( ; imageY != imageYEnd; imageY += rowSize ) {
+            const simd * src = reinterpret_cast<const simd *>( imageY );
+            const simd * srcEnd = src + simdWidth;
+
+            for ( ; src != srcEnd; ++src ) {
+                simd data = _mm_loadu_si128( src );
+
+                simd dataLo = _mm_unpacklo_epi8( data, zero );
+                simd dataHi = _mm_unpackhi_epi8( data, zero );
+                simd sumLoHi = _mm_add_epi16( dataLo, dataHi );
+
+                simdSum = _mm_add_epi32( simdSum, _mm_add_epi32( _mm_unpacklo_epi16( sumLoHi, zero ), _mm_unpackhi_epi16( sumLoHi, zero ) ) );
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * imageX = imageY + totalSimdWidth;
+                const uint8_t * imageXEnd = imageX + nonSimdWidth;
+
+                for ( ; imageX != imageXEnd; ++imageX )
+                    sum += ( *imageX );
+            }
+        }
+
+        uint32_t output[4] = { 0 };
+
+        _mm_storeu_si128( reinterpret_cast<simd *>( output ), simdSum );
+
+        return sum + output[0] + output[1] + output[2] + output[3];
+    }
+
+    void Threshold( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint8_t threshold, uint32_t simdWidth,
+                    uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        // SSE does not have command "great or equal to" so we have 2 situations:
+        // when threshold value is 0 and it is not
+        if ( threshold > 0 ) {
+            const char maskValue = static_cast<char>( 0x80u );
+            const simd mask = _mm_set_epi8( maskValue, maskValue, maskValue, maskValue, maskValue, maskValue, maskValue, maskValue, maskValue, maskValue, maskValue,
+                                            maskValue, maskValue, maskValue, maskValue, maskValue );
+
+            const char compareValue = static_cast<char>( ( threshold - 1 ) ^ 0x80 );
+            const simd compare = _mm_set_epi8( compareValue, compareValue, compareValue, compareValue, compareValue, compareValue, compareValue, compareValue,
+                                               compareValue, compareValue, compareValue, compareValue, compareValue, compareValue, compareValue, compareValue );
+
+            for ( ; outY != outYEnd; outY += rowSizeOut, inY += rowSizeIn ) {
+                const simd * src1 = reinterpret_cast<const simd *>( inY );
+                simd * dst = reinterpret_cast<simd *>( outY );
+
+                const simd * src1End = src1 + simdWidth;
+
+                for ( ; src1 != src1End; ++src1, ++dst )
+                    _mm_storeu_si128( dst, _mm_cmpgt_epi8( _mm_xor_si128( _mm_loadu_si128( src1 ), mask ), compare ) );
+
+                if ( nonSimdWidth > 0 ) {
+                    const uint8_t * inX = inY + totalSimdWidth;
+                    uint8_t * outX = outY + totalSimdWidth;
+
+                    const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                    for ( ; outX != outXEnd; ++outX, ++inX )
+                        ( *outX ) = ( *inX ) < threshold ? 0 : 255;
+                }
+            }
+        }
+        else {
+            const size_t lineSize = sizeof( uint8_t ) * ( totalSimdWidth + nonSimdWidth );
+            for ( ; outY != outYEnd; outY += rowSizeOut )
+                memset( outY, 255u, lineSize );
+        }
+    }
+
+    void Threshold( uint32_t rowSizeIn, uint32_t rowSizeOut, const uint8_t * inY, uint8_t * outY, const uint8_t * outYEnd, uint8_t minThreshold, uint8_t maxThreshold,
+                    uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        const char shiftMaskValue = static_cast<char>( 0x80u );
+        const simd shiftMask
+            = _mm_set_epi8( shiftMaskValue, shiftMaskValue, shiftMaskValue, shiftMaskValue, shiftMaskValue, shiftMaskValue, shiftMaskValue, shiftMaskValue,
+                            shiftMaskValue, shiftMaskValue, shiftMaskValue, shiftMaskValue, shiftMaskValue, shiftMaskValue, shiftMaskValue, shiftMaskValue );
+
+        const char notMaskValue = static_cast<char>( 0xffu );
+        const simd notMask = _mm_set_epi8( notMaskValue, notMaskValue, notMaskValue, notMaskValue, notMaskValue, notMaskValue, notMaskValue, notMaskValue, notMaskValue,
+                                           notMaskValue, notMaskValue, notMaskValue, notMaskValue, notMaskValue, notMaskValue, notMaskValue );
+
+        const char minCompareValue = static_cast<char>( minThreshold ^ 0x80u );
+        const simd minCompare
+            = _mm_set_epi8( minCompareValue, minCompareValue, minCompareValue, minCompareValue, minCompareValue, minCompareValue, minCompareValue, minCompareValue,
+                            minCompareValue, minCompareValue, minCompareValue, minCompareValue, minCompareValue, minCompareValue, minCompareValue, minCompareValue );
+
+        const char maxCompareValue = static_cast<char>( maxThreshold ^ 0x80u );
+        const simd maxCompare
+            = _mm_set_epi8( maxCompareValue, maxCompareValue, maxCompareValue, maxCompareValue, maxCompareValue, maxCompareValue, maxCompareValue, maxCompareValue,
+                            maxCompareValue, maxCompareValue, maxCompareValue, maxCompareValue, maxCompareValue, maxCompareValue, maxCompareValue, maxCompareValue );
+
+        for ( ; outY != outYEnd; outY += rowSizeOut, inY += rowSizeIn ) {
+            const simd * src1 = reinterpret_cast<const simd *>( inY );
+            simd * dst = reinterpret_cast<simd *>( outY );
+
+            const simd * src1End = src1 + simdWidth;
+
+            for ( ; src1 != src1End; ++src1, ++dst ) {
+                simd data = _mm_xor_si128( _mm_loadu_si128( src1 ), shiftMask );
+
+                _mm_storeu_si128( dst, _mm_andnot_si128( _mm_or_si128( _mm_cmplt_epi8( data, minCompare ), _mm_cmpgt_epi8( data, maxCompare ) ), notMask ) );
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * inX = inY + totalSimdWidth;
+                uint8_t * outX = outY + totalSimdWidth;
+
+                const uint8_t * outXEnd = outX + nonSimdWidth;
+
+                for ( ; outX != outXEnd; ++outX, ++inX )
+                    ( *outX ) = ( *inX ) < minThreshold || ( *inX ) > maxThreshold ? 0 : 255;
+            }
+        }
+    }
+
+    void Accumulate64( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint64_t * outY, uint32_t simdWidth, uint32_t totalSimdWidth,
+                       uint32_t nonSimdWidth )
+    {
+        const simd zero = _mm_setzero_si128();
+
+        const uint32_t width = totalSimdWidth + nonSimdWidth;
+
+        for ( ; imageY != imageYEnd; imageY += rowSize, outY += width ) {
+            const simd * src = reinterpret_cast<const simd *>( imageY );
+            const simd * srcEnd = src + simdWidth;
+            simd * dst = reinterpret_cast<simd *>( outY );
+
+            // Unpacking with zero keeps pixel order so every 16 pixels are added to eight vectors of 2 values
+            for ( ; src != srcEnd; ++src ) {
+                const simd data = _mm_loadu_si128( src );
+                const simd data16[2] = { _mm_unpacklo_epi8( data, zero ), _mm_unpackhi_epi8( data, zero ) };
+
+                for ( uint32_t i = 0; i < 2u; ++i ) {
+                    const simd data32[2] = { _mm_unpacklo_epi16( data16[i], zero ), _mm_unpackhi_epi16( data16[i], zero ) };
+
+                    for ( uint32_t j = 0; j < 2u; ++j ) {
+                        _mm_storeu_si128( dst, _mm_add_epi64( _mm_unpacklo_epi32( data32[j], zero ), _mm_loadu_si128( dst ) ) );
+                        ++dst;
+                        _mm_storeu_si128( dst, _mm_add_epi64( _mm_unpackhi_epi32( data32[j], zero ), _mm_loadu_si128( dst ) ) );
+                        ++dst;
+                    }
+                }
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * imageX = imageY + totalSimdWidth;
+                const uint8_t * imageXEnd = imageX + nonSimdWidth;
+                uint64_t * outX = outY + totalSimdWidth;
+
+                for ( ; imageX != imageXEnd; ++imageX, ++outX )
+                    ( *outX ) += ( *imageX );
+            }
+        }
+    }
+
+    uint64_t Sum64( uint32_t rowSize, const uint8_t * imageY, const uint8_t * imageYEnd, uint32_t simdWidth, uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        uint64_t sum = 0;
+        simd simdSum = _mm_setzero_si128();
+        const simd zero = _mm_setzero_si128();
+
+        for ( ; imageY != imageYEnd; imageY += rowSize ) {
+            const simd * src = reinterpret_cast<const simd *>( imageY );
+            const simd * srcEnd = src + simdWidth;
+
+            // Sum of absolute differences with zero adds every 8 pixels into a 64-bit lane
+            for ( ; src != srcEnd; ++src )
+                simdSum = _mm_add_epi64( simdSum, _mm_sad_epu8( _mm_loadu_si128( src ), zero ) );
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * imageX = imageY + totalSimdWidth;
+                const uint8_t * imageXEnd = imageX + nonSimdWidth;
+
+                for ( ; imageX != imageXEnd; ++imageX )
+                    sum += ( *imageX );
+            }
+        }
+
+        uint64_t output[2] = { 0 };
+
+        _mm_storeu_si128( reinterpret_cast<simd *>( output ), simdSum );
+
+        return sum + output[0] + output[1];
+    }
+
+    void ProjectionProfile64( uint32_t rowSize, const uint8_t * imageStart, uint32_t height, bool horizontal, uint64_t * out, uint32_t simdWidth,
+                              uint32_t totalSimdWidth, uint32_t nonSimdWidth )
+    {
+        const simd zero = _mm_setzero_si128();
+
+        if ( horizontal ) {
+            const uint8_t * imageSimdXEnd = imageStart + totalSimdWidth;
+
+            for ( ; imageStart != imageSimdXEnd; imageStart += simdSize, out += simdSize ) {
+                const uint8_t * imageSimdY = imageStart;
+                uint32_t rowCount = height;
+
+                while ( rowCount > 0 ) {
+                    // 32-bit sums can't overflow within this block of rows
+                    const uint32_t blockHeight = ( rowCount < ( 1u << 24 ) ) ? rowCount : ( 1u << 24 );
+                    const uint8_t * imageSimdYEnd = imageSimdY + static_cast<size_t>( blockHeight ) * rowSize;
+                    rowCount -= blockHeight;
+
+                    simd simdSum[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+
+                    for ( ; imageSimdY != imageSimdYEnd; imageSimdY += rowSize ) {
+                        const simd data = _mm_loadu_si128( reinterpret_cast<const simd *>( imageSimdY ) );
+                        const simd dataLo = _mm_unpacklo_epi8( data, zero );
+                        const simd dataHi = _mm_unpackhi_epi8( data, zero );
+
+                        simdSum[0] = _mm_add_epi32( simdSum[0], _mm_unpacklo_epi16( dataLo, zero ) );
+                        simdSum[1] = _mm_add_epi32( simdSum[1], _mm_unpackhi_epi16( dataLo, zero ) );
+                        simdSum[2] = _mm_add_epi32( simdSum[2], _mm_unpacklo_epi16( dataHi, zero ) );
+                        simdSum[3] = _mm_add_epi32( simdSum[3], _mm_unpackhi_epi16( dataHi, zero ) );
+                    }
+
+                    simd * dst = reinterpret_cast<simd *>( out );
+
+                    for ( uint32_t i = 0; i < 4u; ++i ) {
+                        _mm_storeu_si128( dst, _mm_add_epi64( _mm_unpacklo_epi32( simdSum[i], zero ), _mm_loadu_si128( dst ) ) );
+                        ++dst;
+                        _mm_storeu_si128( dst, _mm_add_epi64( _mm_unpackhi_epi32( simdSum[i], zero ), _mm_loadu_si128( dst ) ) );
+                        ++dst;
+                    }
+                }
+            }
+
+            if ( nonSimdWidth > 0 ) {
+                const uint8_t * imageXEnd = imageStart + nonSimdWidth;
+
+                for ( ; imageStart != imageXEnd; ++imageStart, ++out ) {
+                    const uint8_t * imageY = imageStart;
+                    const uint8_t * imageYEnd = imageY + static_cast<size_t>( height ) * rowSize;
+
+                    for ( ; imageY != imageYEnd; imageY += rowSize )
+                        ( *out ) += ( *imageY );
+                }
+            }
+        }
+        else {
+            const uint8_t * imageYEnd = imageStart + static_cast<size_t>( height ) * rowSize;
+
+            for ( ; imageStart != imageYEnd; imageStart += rowSize, ++out )
+                ( *out ) = Sum64( rowSize, imageStart, imageStart + rowSize, simdWidth, totalSimdWidth, nonSimdWidth );
+        }
+    }
+#endif
+}
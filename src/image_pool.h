@@ -0,0 +1,228 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include "image_buffer.h"
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace penguinV
+{
+    // Pool of image buffers for pipelines which process images of the same geometry frame after frame.
+    // While a pool exists it serves memory allocation of its image type: buffers of registered geometries (width, height, color count
+    // and alignment of images of the pool type) are taken from the pool and returned back to it when images are destroyed. This includes
+    // images returned by value from Image_Function functions so a pipeline does not allocate memory after the first frame. Buffers of other
+    // geometries are allocated as usual and buffer sizes which are not registered are not synchronized with the pool.
+    // Only one pool per pixel type could exist at the same time. A pool must be created and destroyed while no images of its type
+    // are created or destroyed by other threads
+    template <typename TColorDepth>
+    class ImagePoolTemplate
+    {
+    public:
+        explicit ImagePoolTemplate( const ImageTemplate<TColorDepth> & reference = ImageTemplate<TColorDepth>() )
+            : _reference( reference.generate() )
+            , _sizeFilter( 0u )
+        {
+            if ( _activePool() != nullptr )
+                throw penguinVException( "Only one image pool per pixel type could exist" );
+
+            _activePool() = this;
+
+            typename ImageTemplate<TColorDepth>::PoolFunctions & functions = ImageTemplate<TColorDepth>::_poolFunctions();
+            functions.type = _reference.type();
+            functions.allocate = _allocateMemory;
+            functions.deallocate = _deallocateMemory;
+        }
+
+        // Images which are still alive release their buffers through memory functions of the image type
+        ~ImagePoolTemplate()
+        {
+            typename ImageTemplate<TColorDepth>::PoolFunctions & functions = ImageTemplate<TColorDepth>::_poolFunctions();
+            functions.allocate = nullptr;
+            functions.deallocate = nullptr;
+
+            _activePool() = nullptr;
+
+            for ( typename std::map<Geometry, std::vector<TColorDepth *>>::iterator geometry = _freeBuffer.begin(); geometry != _freeBuffer.end(); ++geometry ) {
+                for ( typename std::vector<TColorDepth *>::iterator buffer = geometry->second.begin(); buffer != geometry->second.end(); ++buffer )
+                    _reference._deallocate( *buffer );
+            }
+        }
+
+        // Registers a geometry of images which buffers are recycled by the pool and preallocates given number of buffers
+        void reserve( uint32_t width, uint32_t height, uint8_t colorCount = 1u, uint8_t alignment = 1u, size_t count = 0u )
+        {
+            if ( width == 0 || height == 0 || colorCount == 0 || alignment == 0 )
+                throw penguinVException( "Invalid image pool parameters" );
+
+            // the same size calculation as for images, it raises an exception if the size overflows
+            const size_t size
+                = ImageTemplate<TColorDepth>::_calculateSize( ImageTemplate<TColorDepth>::_calculateRowSize( width, colorCount, alignment ), height );
+
+            const Geometry geometry( width, height, colorCount, alignment );
+
+            std::lock_guard<std::mutex> lock( _lock );
+
+            // the filter is updated before the geometry is registered so allocation of the geometry always takes the lock
+            _sizeFilter |= _sizeBit( size );
+
+            std::vector<TColorDepth *> & freeBuffer = _freeBuffer[geometry];
+            while ( freeBuffer.size() < count ) {
+                TColorDepth * buffer = _reference._allocate( size );
+                _buffer[buffer] = geometry;
+                freeBuffer.push_back( buffer );
+            }
+        }
+
+        // Returns an image which buffer is taken from the pool. The buffer is returned back to the pool when the image is destroyed
+        ImageTemplate<TColorDepth> acquire( uint32_t width, uint32_t height, uint8_t colorCount = 1u, uint8_t alignment = 1u )
+        {
+            reserve( width, height, colorCount, alignment );
+
+            return _reference.generate( width, height, colorCount, alignment );
+        }
+
+        // Returns an overall number of buffers owned by the pool including buffers of alive images
+        size_t bufferCount()
+        {
+            std::lock_guard<std::mutex> lock( _lock );
+            return _buffer.size();
+        }
+
+        size_t freeBufferCount()
+        {
+            std::lock_guard<std::mutex> lock( _lock );
+
+            size_t count = 0;
+            for ( typename std::map<Geometry, std::vector<TColorDepth *>>::const_iterator geometry = _freeBuffer.begin(); geometry != _freeBuffer.end();
+                  ++geometry )
+                count += geometry->second.size();
+
+            return count;
+        }
+
+    private:
+        struct Geometry
+        {
+            Geometry( uint32_t width_ = 0u, uint32_t height_ = 0u, uint8_t colorCount_ = 0u, uint8_t alignment_ = 0u )
+                : width( width_ )
+                , height( height_ )
+                , colorCount( colorCount_ )
+                , alignment( alignment_ )
+            {}
+
+            bool operator<( const Geometry & geometry ) const
+            {
+                if ( width != geometry.width )
+                    return width < geometry.width;
+                if ( height != geometry.height )
+                    return height < geometry.height;
+                if ( colorCount != geometry.colorCount )
+                    return colorCount < geometry.colorCount;
+                return alignment < geometry.alignment;
+            }
+
+            uint32_t width;
+            uint32_t height;
+            uint8_t colorCount;
+            uint8_t alignment;
+        };
+
+        const ImageTemplate<TColorDepth> _reference; // an empty image of the type served by the pool, its memory functions allocate buffers
+
+        std::map<Geometry, std::vector<TColorDepth *>> _freeBuffer; // free buffers for every registered geometry
+        std::map<const TColorDepth *, Geometry> _buffer; // all buffers owned by the pool and their geometries
+        std::mutex _lock;
+
+        // bit mask of registered buffer sizes. Allocation and deallocation of sizes without a bit do not take the lock
+        std::atomic<uint64_t> _sizeFilter;
+
+        static uint64_t _sizeBit( size_t size )
+        {
+            // sizes are often multiples of big powers of 2 so the bit is taken from the top bits of the multiplicative hash
+            return static_cast<uint64_t>( 1u ) << ( ( static_cast<uint64_t>( size ) * 0x9E3779B97F4A7C15u ) >> 58u );
+        }
+
+        static ImagePoolTemplate *& _activePool()
+        {
+            static ImagePoolTemplate * pool = nullptr;
+            return pool;
+        }
+
+        static TColorDepth * _allocateMemory( uint32_t width, uint32_t height, uint8_t colorCount, uint8_t alignment, size_t size )
+        {
+            ImagePoolTemplate * pool = _activePool();
+
+            if ( ( pool->_sizeFilter & _sizeBit( size ) ) == 0u )
+                return pool->_reference._allocate( size );
+
+            const Geometry geometry( width, height, colorCount, alignment );
+
+            std::lock_guard<std::mutex> lock( pool->_lock );
+
+            typename std::map<Geometry, std::vector<TColorDepth *>>::iterator freeBuffer = pool->_freeBuffer.find( geometry );
+            if ( freeBuffer == pool->_freeBuffer.end() )
+                return pool->_reference._allocate( size );
+
+            if ( !freeBuffer->second.empty() ) {
+                TColorDepth * buffer = freeBuffer->second.back();
+                freeBuffer->second.pop_back();
+                return buffer;
+            }
+
+            TColorDepth * buffer = pool->_reference._allocate( size );
+            pool->_buffer[buffer] = geometry;
+            return buffer;
+        }
+
+        // an image could change its geometry without reallocation keeping the size so a buffer returns to the geometry it was allocated for
+        static void _deallocateMemory( TColorDepth * data, size_t size )
+        {
+            ImagePoolTemplate * pool = _activePool();
+
+            if ( ( pool->_sizeFilter & _sizeBit( size ) ) == 0u ) {
+                pool->_reference._deallocate( data );
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock( pool->_lock );
+
+            typename std::map<const TColorDepth *, Geometry>::const_iterator buffer = pool->_buffer.find( data );
+            if ( buffer == pool->_buffer.end() )
+                pool->_reference._deallocate( data );
+            else
+                pool->_freeBuffer[buffer->second].push_back( data );
+        }
+
+        ImagePoolTemplate( const ImagePoolTemplate & )
+            : _sizeFilter( 0u )
+        {}
+        ImagePoolTemplate & operator=( const ImagePoolTemplate & )
+        {
+            return ( *this );
+        }
+    };
+
+    typedef ImagePoolTemplate<uint8_t> ImagePool;
+    typedef ImagePoolTemplate<uint16_t> ImagePool16Bit;
+}
@@ -21,18 +21,72 @@
 #pragma once
 
 #include "memory_allocator.h"
-#include <map>
+#include <algorithm>
 #include <mutex>
+#include <new>
+#include <vector>
+
+#if defined( __linux__ )
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace cpu_Memory
 {
-    // Class for memory allocation on CPU
+    // Source of preallocated memory. Memory mapped arenas are available only on Linux, other systems use heap memory
+    enum ArenaType
+    {
+        heap_arena, // usual heap memory
+        page_arena, // memory mapped pages
+        huge_page_arena // memory mapped huge pages, transparent huge pages are used if the system has no reserved huge pages
+    };
+
+    // Returns a number of NUMA nodes in the system
+    inline uint32_t nodeCount()
+    {
+#if defined( __linux__ )
+        std::ifstream file( "/sys/devices/system/node/online" );
+        std::string nodes;
+        if ( !( file >> nodes ) || nodes.empty() )
+            return 1u;
+
+        // the list looks like "0-3" or "0,2-3", the last value is the biggest node id
+        const size_t position = nodes.find_last_of( ",-" );
+        return static_cast<uint32_t>( std::stoul( position == std::string::npos ? nodes : nodes.substr( position + 1 ) ) ) + 1u;
+#else
+        return 1u;
+#endif
+    }
+
+    // Returns a NUMA node of CPU core on which a thread is currently running
+    inline uint32_t currentNode()
+    {
+#if defined( __linux__ ) && defined( SYS_getcpu )
+        unsigned cpu = 0;
+        unsigned node = 0;
+        if ( syscall( SYS_getcpu, &cpu, &node, nullptr ) == 0 )
+            return node;
+#endif
+        return 0u;
+    }
+
+    // Class for memory allocation on CPU. Preallocated and heap memory is aligned by 64 bytes so every chunk of 64 bytes or bigger is aligned
+    // for any SIMD access and starts at cache line boundary. Minimum chunk size is 32 bytes
+    // Every thread keeps small magazines of recently freed chunks grouped by level (power of 2) in front of the preallocated memory
+    // so most allocations and deallocations of same sized objects do not require to lock the allocator.
+    // Chunks cached in magazines are counted as used in statistics and allocations served by magazines are not counted.
+    // Preallocated memory could be taken from memory mapped (huge) pages and bound to a NUMA node, see ArenaType
     class MemoryAllocator : public BaseMemoryAllocator
     {
     public:
         MemoryAllocator()
             : _data( nullptr )
             , _alignedData( nullptr )
+            , _mappedSize( 0 )
+            , _arenaType( heap_arena )
+            , _arenaNode( -1 )
         {}
 
         static MemoryAllocator & instance()
@@ -43,37 +97,100 @@ namespace cpu_Memory
 
         virtual ~MemoryAllocator()
         {
+            std::lock_guard<std::mutex> registryLock( _magazineRegistryLock() );
+
             _lock.lock();
+            for ( std::vector<Magazine *>::iterator magazine = _magazine.begin(); magazine != _magazine.end(); ++magazine )
+                ( *magazine )->allocator = nullptr;
+            _magazine.clear();
+
             _free();
             _lock.unlock();
         }
 
+        using BaseMemoryAllocator::reserve;
+
+        // Allocates a chunk of memory from given type of arena. Negative node means that memory is not bound to any NUMA node.
+        // Memory binding is a hint: if the system does not support it memory is allocated from any node
+        void reserve( size_t size, ArenaType type, int32_t node = -1 )
+        {
+            if ( type != _arenaType || node != _arenaNode ) {
+                // memory of previous arena must be released even if the size is the same
+                _lock.lock();
+                _releaseMemory();
+                _arenaType = type;
+                _arenaNode = node;
+                _lock.unlock();
+            }
+
+            BaseMemoryAllocator::reserve( size );
+        }
+
+        ArenaType arenaType() const
+        {
+            return _arenaType;
+        }
+
+        int32_t arenaNode() const
+        {
+            return _arenaNode;
+        }
+
+        // Returns true if an address belongs to preallocated memory of the allocator
+        bool contains( const void * address ) const
+        {
+            const uint8_t * data = reinterpret_cast<const uint8_t *>( address );
+            return _data != nullptr && data >= _alignedData && data < _alignedData + _size;
+        }
+
         // Returns a pointer to an allocated memory. If memory size of allocated memory chuck is enough for requested size
         // then return a point from preallocated memory, otherwise allocate heap memory
         template <typename _DataType = uint8_t>
         _DataType * allocate( size_t size = 1 )
         {
+            const size_t overallSize = size * sizeof( _DataType );
+            const uint8_t level = _getChunkLevel( overallSize );
+
+            const bool recording = _isRecording();
+            Magazine * magazine = nullptr;
+
+            if ( !recording ) {
+                magazine = &_threadMagazine();
+                if ( level < magazine->chunk.size() && !magazine->chunk[level].empty() ) {
+                    const size_t offset = magazine->chunk[level].back();
+                    magazine->chunk[level].pop_back();
+                    return reinterpret_cast<_DataType *>( _alignedData + offset );
+                }
+            }
+
             _lock.lock();
-            if ( _data != nullptr ) {
-                const size_t overallSize = size * sizeof( _DataType );
-
-                if ( overallSize < _size ) {
-                    const uint8_t level = _getAllocationLevel( overallSize );
-
-                    if ( _split( level ) ) {
-                        std::set<size_t>::iterator chunk = _freeChunk[level].begin();
-                        _DataType * address = reinterpret_cast<_DataType *>( _alignedData + *chunk );
-                        _allocatedChunk.insert( std::pair<size_t, uint8_t>( *chunk, level ) );
-                        _freeChunk[level].erase( chunk );
-                        _lock.unlock();
-                        return address;
-                    }
+            if ( _data != nullptr && overallSize < _size ) {
+                size_t offset = 0;
+                bool allocated = _allocateChunk( level, offset );
+
+                // chunks cached by the thread could be merged into a bigger one
+                if ( !allocated && magazine != nullptr && _flushMagazine( *magazine ) )
+                    allocated = _allocateChunk( level, offset );
+
+                if ( allocated ) {
+                    _registerChunkAllocation( overallSize, level );
+                    _recordEvent( reinterpret_cast<std::uintptr_t>( _alignedData + offset ), overallSize > 0 ? overallSize : 1u );
+                    _lock.unlock();
+                    return reinterpret_cast<_DataType *>( _alignedData + offset );
                 }
             }
+            _registerHeapAllocation();
             _lock.unlock();
 
             // if no space in preallocated memory, allocate as usual memory
-            return new _DataType[size];
+            _DataType * address = reinterpret_cast<_DataType *>( _allocateHeap( overallSize ) );
+
+            if ( recording ) {
+                std::lock_guard<std::mutex> lock( _lock );
+                _recordEvent( reinterpret_cast<std::uintptr_t>( address ), overallSize > 0 ? overallSize : 1u );
+            }
+
+            return address;
         }
 
         // Deallocates a memory by input address. If a pointer points on allocated chuck of memory inside the allocator then
@@ -81,68 +198,450 @@ namespace cpu_Memory
         template <typename _DataType>
         void free( _DataType * address )
         {
-            _lock.lock();
-            if ( _data != nullptr && reinterpret_cast<uint8_t *>( address ) >= _alignedData ) {
-                std::map<size_t, uint8_t>::iterator pos = _allocatedChunk.find( static_cast<size_t>( reinterpret_cast<uint8_t *>( address ) - _alignedData ) );
+            const uint8_t * data = reinterpret_cast<uint8_t *>( address );
+
+            if ( contains( data ) ) {
+                const size_t offset = static_cast<size_t>( data - _alignedData );
+
+                if ( _isChunkAllocated( offset ) ) {
+                    const uint8_t level = _allocatedChunkLevel( offset );
 
-                if ( pos != _allocatedChunk.end() ) {
-                    _freeChunk[pos->second].insert( pos->first );
-                    _merge( pos->first, pos->second );
-                    _allocatedChunk.erase( pos );
+                    if ( !_isRecording() ) {
+                        Magazine & magazine = _threadMagazine();
+                        if ( _isCacheable( level ) && magazine.chunk[level].size() < _magazineCapacity ) {
+                            magazine.chunk[level].push_back( offset );
+                            return;
+                        }
+                    }
+
+                    _lock.lock();
+                    _recordEvent( reinterpret_cast<std::uintptr_t>( address ), 0u );
+                    _releaseChunk( offset );
                     _lock.unlock();
                     return;
                 }
             }
-            _lock.unlock();
 
-            delete[] address;
+            if ( _isRecording() ) {
+                std::lock_guard<std::mutex> lock( _lock );
+                _recordEvent( reinterpret_cast<std::uintptr_t>( address ), 0u );
+            }
+
+            _freeHeap( reinterpret_cast<uint8_t *>( address ) );
+        }
+
+        virtual Statistics statistics()
+        {
+            std::lock_guard<std::mutex> lock( _lock );
+            return BaseMemoryAllocator::statistics();
+        }
+
+        virtual void resetStatistics()
+        {
+            std::lock_guard<std::mutex> lock( _lock );
+            BaseMemoryAllocator::resetStatistics();
+        }
+
+        // magazines are not used while recording so every allocation and deallocation is visible to the allocator
+        virtual void startRecording()
+        {
+            std::lock_guard<std::mutex> lock( _lock );
+            BaseMemoryAllocator::startRecording();
+        }
+
+        virtual void stopRecording()
+        {
+            std::lock_guard<std::mutex> lock( _lock );
+            BaseMemoryAllocator::stopRecording();
+        }
+
+        // magazines reuse chunks in a different order than preallocated memory gives them so the suggestion has extra 25% of headroom
+        virtual size_t suggestedReserveSize()
+        {
+            std::lock_guard<std::mutex> lock( _lock );
+
+            const size_t size = BaseMemoryAllocator::suggestedReserveSize();
+            const size_t headroom = size / 4u;
+
+            return size + headroom - headroom % ( static_cast<size_t>( 1 ) << _minimumLevel );
         }
 
     private:
+        // Free chunks of preallocated memory owned by one thread. Chunks are still marked as allocated from allocator's point of view
+        struct Magazine
+        {
+            MemoryAllocator * allocator;
+            std::vector<std::vector<size_t>> chunk; // offsets of free chunks for every level
+        };
+
+        // Owner of all magazines of a thread. Magazines are returned back to allocators when a thread finishes
+        struct MagazineHolder
+        {
+            ~MagazineHolder()
+            {
+                std::lock_guard<std::mutex> registryLock( _magazineRegistryLock() );
+
+                for ( std::vector<Magazine *>::iterator entry = magazine.begin(); entry != magazine.end(); ++entry ) {
+                    if ( ( *entry )->allocator != nullptr )
+                        ( *entry )->allocator->_removeMagazine( *entry );
+
+                    delete *entry;
+                }
+            }
+
+            std::vector<Magazine *> magazine;
+        };
+
         uint8_t * _data; // a pointer to memory allocated chunk
         uint8_t * _alignedData; // aligned pointer for SIMD access
+        size_t _mappedSize; // a size of memory mapped arena, 0 for heap memory
+        ArenaType _arenaType;
+        int32_t _arenaNode;
         std::mutex _lock;
 
-        // a map which holds an information about allocated memory in preallocated memory chunk
-        // first parameter is an offset from preallocated memory, second parameter is a power of 2 (level)
-        std::map<size_t, uint8_t> _allocatedChunk;
+        // magazines of all threads which use the allocator
+        std::vector<Magazine *> _magazine;
+
+        static const size_t _magazineCapacity = 4u; // maximum number of chunks per level in a magazine
+        static const size_t _alignment = 64u; // AVX-512 and cache line alignment requirement
+        static const size_t _hugePageSize = 2 * 1024 * 1024u;
+
+        static std::mutex & _magazineRegistryLock()
+        {
+            static std::mutex lock;
+            return lock;
+        }
+
+        uint8_t _getChunkLevel( size_t size ) const
+        {
+            const uint8_t level = _getAllocationLevel( size );
+            if ( level < _minimumLevel )
+                return _minimumLevel;
+
+            return level;
+        }
+
+        // big chunks are not cached to avoid holding big part of preallocated memory by one thread
+        bool _isCacheable( uint8_t level ) const
+        {
+            return ( static_cast<size_t>( 1 ) << level ) <= _size / 16;
+        }
+
+        Magazine & _threadMagazine()
+        {
+            thread_local MagazineHolder holder;
+
+            for ( std::vector<Magazine *>::iterator magazine = holder.magazine.begin(); magazine != holder.magazine.end(); ++magazine ) {
+                if ( ( *magazine )->allocator == this )
+                    return *( *magazine );
+            }
+
+            Magazine * magazine = new Magazine;
+            magazine->allocator = this;
+            magazine->chunk.resize( sizeof( size_t ) * 8u );
+
+            std::lock_guard<std::mutex> registryLock( _magazineRegistryLock() );
+
+            _lock.lock();
+            _magazine.push_back( magazine );
+            _lock.unlock();
+
+            holder.magazine.push_back( magazine );
+
+            return *magazine;
+        }
+
+        // returns all chunks cached in a magazine back to preallocated memory, must be called under the lock
+        // returns false if the magazine was empty
+        bool _flushMagazine( Magazine & magazine )
+        {
+            bool released = false;
+
+            for ( uint8_t level = 0; level < magazine.chunk.size(); ++level ) {
+                for ( std::vector<size_t>::const_iterator offset = magazine.chunk[level].begin(); offset != magazine.chunk[level].end(); ++offset ) {
+                    _releaseChunk( *offset );
+                    released = true;
+                }
+
+                magazine.chunk[level].clear();
+            }
+
+            return released;
+        }
+
+        void _removeMagazine( Magazine * magazine )
+        {
+            _lock.lock();
+            _flushMagazine( *magazine );
+            _magazine.erase( std::find( _magazine.begin(), _magazine.end(), magazine ) );
+            _lock.unlock();
+        }
+
+        // heap memory is aligned in the same way as preallocated memory, a shift from the start of allocated block is stored in the byte before returned address
+        static uint8_t * _allocateHeap( size_t size )
+        {
+            uint8_t * data = new uint8_t[size + _alignment];
+
+            const size_t shift = _alignment - ( reinterpret_cast<std::uintptr_t>( data ) % _alignment );
+            data += shift;
+            *( data - 1 ) = static_cast<uint8_t>( shift );
+
+            return data;
+        }
+
+        static void _freeHeap( uint8_t * data )
+        {
+            if ( data != nullptr )
+                delete[]( data - *( data - 1 ) );
+        }
 
         // true memory allocation on CPU
+        // the function must not be called while other threads allocate or deallocate memory through this allocator
         virtual void _allocate( size_t size )
         {
             _lock.lock();
             if ( _size != size && size > 0 ) {
-                if ( !_allocatedChunk.empty() )
-                    throw std::logic_error( "Cannot free a memory on CPU. Not all objects were previously deallocated from allocator." );
+                _releaseMemory();
 
-                _free();
-
-                const size_t alignment = 32u; // AVX alignment requirement
-                _data = new uint8_t[size + alignment];
-                const std::uintptr_t dataAddress = reinterpret_cast<std::uintptr_t>( _data );
-                _alignedData = ( ( dataAddress % alignment ) == 0 ) ? _data : _data + ( alignment - ( dataAddress % alignment ) );
+#if defined( __linux__ )
+                const bool isMapped = ( _arenaType != heap_arena );
+#else
+                const bool isMapped = false;
+#endif
+                if ( !isMapped ) {
+                    _data = new uint8_t[size + _alignment];
+                    const std::uintptr_t dataAddress = reinterpret_cast<std::uintptr_t>( _data );
+                    _alignedData = ( ( dataAddress % _alignment ) == 0 ) ? _data : _data + ( _alignment - ( dataAddress % _alignment ) );
+                }
+                else {
+                    _data = _mapArena( size );
+                    _alignedData = _data;
+                }
 
                 _size = size;
             }
             _lock.unlock();
         }
 
+        // frees preallocated memory, must be called under the lock. The lock is released if an exception is thrown
+        void _releaseMemory()
+        {
+            for ( std::vector<Magazine *>::iterator magazine = _magazine.begin(); magazine != _magazine.end(); ++magazine )
+                _flushMagazine( *( *magazine ) );
+
+            if ( _hasAllocatedChunks() ) {
+                _lock.unlock();
+                throw std::logic_error( "Cannot free a memory on CPU. Not all objects were previously deallocated from allocator." );
+            }
+
+            _free();
+        }
+
         // true memory deallocation on CPU
         virtual void _deallocate()
         {
             if ( _data != nullptr ) {
+#if defined( __linux__ )
+                if ( _mappedSize > 0 )
+                    munmap( _data, _mappedSize );
+                else
+                    delete[] _data;
+#else
                 delete[] _data;
+#endif
                 _data = nullptr;
                 _alignedData = nullptr;
+                _mappedSize = 0;
             }
+        }
 
-            _allocatedChunk.clear();
+        // maps anonymous memory for preallocated memory and sets _mappedSize, must be called under the lock
+        uint8_t * _mapArena( size_t size )
+        {
+#if defined( __linux__ )
+            const size_t pageSize = ( _arenaType == huge_page_arena ) ? _hugePageSize : static_cast<size_t>( sysconf( _SC_PAGESIZE ) );
+            const size_t mappedSize = ( ( size + pageSize - 1 ) / pageSize ) * pageSize;
+
+            void * data = MAP_FAILED;
+
+#if defined( MAP_HUGETLB )
+            // reserved huge pages are used only if the system has enough of them
+            if ( _arenaType == huge_page_arena )
+                data = mmap( nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+#endif
+
+            if ( data == MAP_FAILED ) {
+                // transparent huge pages require an address aligned by huge page size so extra memory is mapped and unmapped back
+                const size_t extraSize = ( _arenaType == huge_page_arena ) ? _hugePageSize : 0u;
+
+                void * block = mmap( nullptr, mappedSize + extraSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+                if ( block == MAP_FAILED ) {
+                    _lock.unlock();
+                    throw std::bad_alloc();
+                }
+
+                uint8_t * start = reinterpret_cast<uint8_t *>( block );
+                const size_t shift = ( extraSize > 0 ) ? ( extraSize - reinterpret_cast<std::uintptr_t>( start ) % extraSize ) % extraSize : 0u;
+
+                if ( shift > 0 )
+                    munmap( start, shift );
+                if ( extraSize > shift )
+                    munmap( start + shift + mappedSize, extraSize - shift );
+
+                data = start + shift;
+
+#if defined( MADV_HUGEPAGE )
+                if ( _arenaType == huge_page_arena )
+                    madvise( data, mappedSize, MADV_HUGEPAGE );
+#endif
+            }
+
+            if ( _arenaNode >= 0 )
+                _bindToNode( data, mappedSize, static_cast<uint32_t>( _arenaNode ) );
+
+            _mappedSize = mappedSize;
+            return reinterpret_cast<uint8_t *>( data );
+#else
+            (void)size;
+            _lock.unlock();
+            throw std::logic_error( "Memory mapped arenas are not supported on this system" );
+#endif
+        }
+
+#if defined( __linux__ )
+        // pages are not touched yet so the policy places them on the node at first access. Failure is ignored as binding is only a hint
+        static void _bindToNode( void * data, size_t size, uint32_t node )
+        {
+#if defined( SYS_mbind )
+            const size_t bitCount = sizeof( unsigned long ) * 8u;
+            std::vector<unsigned long> mask( node / bitCount + 1u, 0 );
+            mask[node / bitCount] = 1ul << ( node % bitCount );
+
+            const int bindPolicy = 2; // MPOL_BIND
+            syscall( SYS_mbind, data, size, bindPolicy, mask.data(), mask.size() * bitCount + 1u, 0u );
+#else
+            (void)data;
+            (void)size;
+            (void)node;
+#endif
         }
+#endif
 
-        MemoryAllocator( const MemoryAllocator & ) {}
+        MemoryAllocator( const MemoryAllocator & )
+            : BaseMemoryAllocator()
+            , _data( nullptr )
+            , _alignedData( nullptr )
+            , _mappedSize( 0 )
+            , _arenaType( heap_arena )
+            , _arenaNode( -1 )
+        {}
         MemoryAllocator & operator=( const MemoryAllocator & )
         {
             return ( *this );
         }
     };
+
+    // Set of allocators with one arena per NUMA node. Every thread allocates memory from an arena of its node,
+    // by default it is a node on which the thread runs at the moment of first allocation. Memory could be freed from any thread.
+    // If arenas are not reserved all requests are forwarded to MemoryAllocator::instance()
+    class NodeMemoryAllocator
+    {
+    public:
+        NodeMemoryAllocator() {}
+
+        ~NodeMemoryAllocator()
+        {
+            for ( std::vector<MemoryAllocator *>::iterator allocator = _allocator.begin(); allocator != _allocator.end(); ++allocator )
+                delete *allocator;
+        }
+
+        static NodeMemoryAllocator & instance()
+        {
+            static NodeMemoryAllocator allocator;
+            return allocator;
+        }
+
+        // Allocates an arena of given size on every NUMA node. The function must be called before any allocation through this allocator
+        void reserve( size_t sizePerNode, ArenaType type = huge_page_arena )
+        {
+            if ( _allocator.empty() ) {
+                const uint32_t count = nodeCount();
+                for ( uint32_t node = 0; node < count; ++node )
+                    _allocator.push_back( new MemoryAllocator );
+            }
+
+            for ( size_t node = 0; node < _allocator.size(); ++node )
+                _allocator[node]->reserve( sizePerNode, type, static_cast<int32_t>( node ) );
+        }
+
+        template <typename _DataType = uint8_t>
+        _DataType * allocate( size_t size = 1 )
+        {
+            if ( _allocator.empty() )
+                return MemoryAllocator::instance().allocate<_DataType>( size );
+
+            return _allocator[threadNode() % _allocator.size()]->allocate<_DataType>( size );
+        }
+
+        template <typename _DataType>
+        void free( _DataType * address )
+        {
+            for ( std::vector<MemoryAllocator *>::iterator allocator = _allocator.begin(); allocator != _allocator.end(); ++allocator ) {
+                if ( ( *allocator )->contains( address ) ) {
+                    ( *allocator )->free( address );
+                    return;
+                }
+            }
+
+            // memory of the default allocator or heap memory
+            MemoryAllocator::instance().free( address );
+        }
+
+        // Returns an allocator of a node or MemoryAllocator::instance() if arenas are not reserved
+        MemoryAllocator & allocator( uint32_t node )
+        {
+            if ( _allocator.empty() )
+                return MemoryAllocator::instance();
+
+            if ( node >= _allocator.size() )
+                throw std::logic_error( "NUMA node ID is out of range" );
+
+            return *_allocator[node];
+        }
+
+        size_t arenaCount() const
+        {
+            return _allocator.size();
+        }
+
+        // Selects a NUMA node for all following allocations of the calling thread
+        static void setThreadNode( uint32_t node )
+        {
+            _threadNode() = static_cast<int32_t>( node );
+        }
+
+        static uint32_t threadNode()
+        {
+            int32_t & node = _threadNode();
+            if ( node < 0 )
+                node = static_cast<int32_t>( currentNode() );
+
+            return static_cast<uint32_t>( node );
+        }
+
+    private:
+        std::vector<MemoryAllocator *> _allocator; // an allocator per NUMA node
+
+        static int32_t & _threadNode()
+        {
+            thread_local int32_t node = -1;
+            return node;
+        }
+
+        NodeMemoryAllocator( const NodeMemoryAllocator & ) {}
+        NodeMemoryAllocator & operator=( const NodeMemoryAllocator & )
+        {
+            return ( *this );
+        }
+    };
 }
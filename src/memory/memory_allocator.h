@@ -20,17 +20,63 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
-#include <set>
+#include <map>
 #include <stdexcept>
 #include <vector>
 
+#if defined( _MSC_VER ) && defined( _WIN64 )
+#include <intrin.h>
+#endif
+
 // Base class for memory allocation
+// Preallocated memory is managed by buddy system: free chunks of every level (power of 2) are stored in bitmaps
+// and levels of allocated chunks are stored in a side table. No heap allocation happens during chunk allocation or deallocation
 class BaseMemoryAllocator
 {
 public:
-    BaseMemoryAllocator()
+    // Usage statistics of an allocator
+    struct Statistics
+    {
+        Statistics()
+            : reservedSize( 0 )
+            , usedSize( 0 )
+            , peakUsedSize( 0 )
+            , requestedSize( 0 )
+            , roundedSize( 0 )
+            , heapAllocationCount( 0 )
+            , failedSplitCount( 0 )
+        {}
+
+        // a fraction of memory lost due to rounding of requested sizes to power of 2
+        double fragmentation() const
+        {
+            return roundedSize > 0 ? 1.0 - static_cast<double>( requestedSize ) / static_cast<double>( roundedSize ) : 0.0;
+        }
+
+        size_t reservedSize; // a size of preallocated memory
+        size_t usedSize; // bytes of allocated chunks in preallocated memory
+        size_t peakUsedSize; // maximum value of usedSize since reservation or the last reset of statistics
+        size_t requestedSize; // bytes requested by allocations which took a chunk from preallocated memory
+        size_t roundedSize; // bytes of chunks given to these allocations
+        size_t heapAllocationCount; // number of allocations which did not fit into preallocated memory
+        size_t failedSplitCount; // number of allocations which did not find a free chunk of required or bigger level
+        std::vector<size_t> freeSize; // bytes of free chunks for every level (power of 2)
+    };
+
+    explicit BaseMemoryAllocator( uint8_t minimumLevel = 5u )
         : _size( 0 )
+        , _minimumLevel( minimumLevel )
+        , _allocatedChunkCount( 0 )
+        , _usedSize( 0 )
+        , _peakUsedSize( 0 )
+        , _requestedSize( 0 )
+        , _roundedSize( 0 )
+        , _heapAllocationCount( 0 )
+        , _failedSplitCount( 0 )
+        , _recording( false )
     {}
 
     virtual ~BaseMemoryAllocator() {}
@@ -47,34 +93,201 @@ public:
 
         _allocate( size );
 
+        uint8_t topLevel = _getAllocationLevel( size );
+        if ( ( static_cast<size_t>( 1 ) << topLevel ) > size )
+            --topLevel;
+
+        _freeChunk.resize( topLevel + 1u );
+        for ( uint8_t level = _minimumLevel; level <= topLevel; ++level )
+            _freeChunk[level].resize( size >> level );
+
+        _chunkLevel.resize( ( size >> _minimumLevel ) + 1u, 0u );
+
+        // the memory is split into chunks of different levels starting from the biggest one
+        // every chunk has an offset which is a multiple of its size
         size_t usedSize = 0;
 
-        while ( size > 0 ) {
-            uint8_t levelCount = _getAllocationLevel( size );
-            size_t value = static_cast<size_t>( 1 ) << levelCount;
+        for ( uint8_t level = static_cast<uint8_t>( topLevel + 1u ); level > _minimumLevel; ) {
+            --level;
 
-            if ( value > size ) {
-                value >>= 1;
-                --levelCount;
+            const size_t value = static_cast<size_t>( 1 ) << level;
+
+            if ( size - usedSize >= value ) {
+                _freeChunk[level].set( usedSize >> level );
+                usedSize += value;
             }
+        }
+    }
 
-            if ( usedSize == 0 )
-                _freeChunk.resize( levelCount + 1u );
+    virtual Statistics statistics()
+    {
+        Statistics info;
 
-            _freeChunk[levelCount].insert( usedSize );
+        info.reservedSize = _size;
+        info.usedSize = _usedSize;
+        info.peakUsedSize = _peakUsedSize;
+        info.requestedSize = _requestedSize;
+        info.roundedSize = _roundedSize;
+        info.heapAllocationCount = _heapAllocationCount;
+        info.failedSplitCount = _failedSplitCount;
 
-            usedSize += value;
-            size -= value;
-        }
+        info.freeSize.resize( _freeChunk.size(), 0u );
+        for ( uint8_t level = 0; level < _freeChunk.size(); ++level )
+            info.freeSize[level] = _freeChunk[level].count() << level;
+
+        return info;
+    }
+
+    // resets all counters, peak usage becomes equal to current usage
+    virtual void resetStatistics()
+    {
+        _peakUsedSize = _usedSize;
+        _requestedSize = 0;
+        _roundedSize = 0;
+        _heapAllocationCount = 0;
+        _failedSplitCount = 0;
+    }
+
+    // Starts recording of all allocations and deallocations including the ones which go to heap.
+    // Recording must start before any object is allocated through the allocator to give a correct suggestion
+    virtual void startRecording()
+    {
+        _allocationEvent.clear();
+        _recording = true;
+    }
+
+    virtual void stopRecording()
+    {
+        _recording = false;
+    }
+
+    // returns a size of preallocated memory which is enough to fit all recorded allocations without heap allocation
+    virtual size_t suggestedReserveSize()
+    {
+        return _suggestReserveSize( _allocationEvent, _minimumLevel );
     }
 
 protected:
+    // Hierarchical bitmap which finds any set bit for O(log64(n)) operations
+    class ChunkBitmap
+    {
+    public:
+        ChunkBitmap()
+            : _size( 0 )
+        {}
+
+        void resize( size_t size )
+        {
+            _layer.clear();
+            _size = size;
+
+            do {
+                size = ( size + 63u ) / 64u;
+                _layer.push_back( std::vector<uint64_t>( size, 0u ) );
+            } while ( size > 1u );
+        }
+
+        bool empty() const
+        {
+            return _layer.empty() || _layer.back()[0] == 0u;
+        }
+
+        bool test( size_t index ) const
+        {
+            return index < _size && ( _layer[0][index / 64u] & ( static_cast<uint64_t>( 1 ) << ( index % 64u ) ) ) != 0u;
+        }
+
+        void set( size_t index )
+        {
+            for ( std::vector<std::vector<uint64_t>>::iterator layer = _layer.begin(); layer != _layer.end(); ++layer, index /= 64u ) {
+                uint64_t & word = ( *layer )[index / 64u];
+                const bool wasEmpty = ( word == 0u );
+
+                word |= static_cast<uint64_t>( 1 ) << ( index % 64u );
+
+                if ( !wasEmpty )
+                    break;
+            }
+        }
+
+        void reset( size_t index )
+        {
+            for ( std::vector<std::vector<uint64_t>>::iterator layer = _layer.begin(); layer != _layer.end(); ++layer, index /= 64u ) {
+                uint64_t & word = ( *layer )[index / 64u];
+
+                word &= ~( static_cast<uint64_t>( 1 ) << ( index % 64u ) );
+
+                if ( word != 0u )
+                    break;
+            }
+        }
+
+        size_t count() const
+        {
+            size_t total = 0;
+
+            if ( !_layer.empty() ) {
+                for ( std::vector<uint64_t>::const_iterator word = _layer[0].begin(); word != _layer[0].end(); ++word )
+                    total += _bitCount( *word );
+            }
+
+            return total;
+        }
+
+        // returns the lowest set bit, the bitmap must not be empty
+        size_t first() const
+        {
+            size_t index = 0;
+
+            for ( std::vector<std::vector<uint64_t>>::const_reverse_iterator layer = _layer.rbegin(); layer != _layer.rend(); ++layer )
+                index = index * 64u + _lowestBit( ( *layer )[index] );
+
+            return index;
+        }
+
+    private:
+        std::vector<std::vector<uint64_t>> _layer; // the first layer contains actual bits, every next layer marks non-zero words of previous layer
+        size_t _size;
+
+        static size_t _lowestBit( uint64_t value )
+        {
+#if defined( _MSC_VER ) && defined( _WIN64 )
+            unsigned long index = 0;
+            _BitScanForward64( &index, value );
+            return index;
+#elif defined( __GNUC__ )
+            return static_cast<size_t>( __builtin_ctzll( value ) );
+#else
+            size_t index = 0;
+            while ( ( value & 1u ) == 0u ) {
+                value >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+
+        static size_t _bitCount( uint64_t value )
+        {
+            size_t count = 0;
+            for ( ; value != 0u; value &= value - 1u )
+                ++count;
+
+            return count;
+        }
+    };
+
     void _free()
     {
         _deallocate();
 
         _freeChunk.clear();
+        _chunkLevel.clear();
+        _allocatedChunkCount = 0;
         _size = 0;
+
+        _usedSize = 0;
+        _peakUsedSize = 0;
     }
 
     // returns a level (power of 2) needed for a required size
@@ -91,76 +304,218 @@ protected:
         return level;
     }
 
-    // splits the preallocated memory by levels
-    bool _split( uint8_t from )
+    // takes a free chunk of required level from preallocated memory splitting bigger chunks if needed
+    // returns false if no free chunk exists
+    bool _allocateChunk( uint8_t level, size_t & offset )
     {
-        bool levelFound = false;
-        uint8_t startLevel = from;
+        if ( level < _minimumLevel )
+            level = _minimumLevel;
+
+        for ( uint8_t startLevel = level; startLevel < _freeChunk.size(); ++startLevel ) {
+            if ( _freeChunk[startLevel].empty() )
+                continue;
 
-        for ( uint8_t i = from; i < _freeChunk.size(); ++i ) {
-            if ( !_freeChunk[i].empty() ) {
-                startLevel = i;
-                levelFound = true;
-                break;
+            size_t index = _freeChunk[startLevel].first();
+            _freeChunk[startLevel].reset( index );
+
+            // every split leaves the right half (buddy) free
+            for ( ; startLevel > level; --startLevel ) {
+                index <<= 1;
+                _freeChunk[startLevel - 1u].set( index + 1u );
             }
+
+            offset = index << level;
+            _chunkLevel[offset >> _minimumLevel] = static_cast<uint8_t>( level + 1u );
+            ++_allocatedChunkCount;
+
+            _usedSize += static_cast<size_t>( 1 ) << level;
+            if ( _peakUsedSize < _usedSize )
+                _peakUsedSize = _usedSize;
+
+            return true;
         }
 
-        if ( !levelFound )
-            return false;
+        if ( !_freeChunk.empty() )
+            ++_failedSplitCount;
 
-        if ( startLevel > from ) {
-            size_t memorySize = static_cast<size_t>( 1 ) << ( startLevel - 1 );
+        return false;
+    }
 
-            for ( ; startLevel > from; --startLevel, memorySize >>= 1 ) {
-                const size_t previousLevelValue = *_freeChunk[startLevel].begin();
-                _freeChunk[startLevel - 1u].insert( previousLevelValue );
-                _freeChunk[startLevel - 1u].insert( previousLevelValue + memorySize );
-                _freeChunk[startLevel].erase( _freeChunk[startLevel].begin() );
-            }
+    // returns a chunk back to preallocated memory merging it with free neighbours (buddies)
+    void _releaseChunk( size_t offset )
+    {
+        uint8_t level = _allocatedChunkLevel( offset );
+        _chunkLevel[offset >> _minimumLevel] = 0u;
+        --_allocatedChunkCount;
+        _usedSize -= static_cast<size_t>( 1 ) << level;
+
+        size_t index = offset >> level;
+
+        for ( ; level + 1u < _freeChunk.size() && _freeChunk[level].test( index ^ 1u ); ++level ) {
+            _freeChunk[level].reset( index ^ 1u );
+            index >>= 1;
         }
 
-        return true;
+        _freeChunk[level].set( index );
     }
 
-    // merges preallocated memory by levels
-    void _merge( size_t offset, uint8_t from )
+    // returns true if a chunk is allocated at given offset of preallocated memory
+    bool _isChunkAllocated( size_t offset ) const
     {
-        size_t memorySize = static_cast<size_t>( 1 ) << from;
+        return ( offset % ( static_cast<size_t>( 1 ) << _minimumLevel ) ) == 0u && ( offset >> _minimumLevel ) < _chunkLevel.size()
+               && _chunkLevel[offset >> _minimumLevel] != 0u;
+    }
 
-        for ( std::vector<std::set<size_t>>::iterator level = _freeChunk.begin() + from; level < _freeChunk.end(); ++level, memorySize <<= 1 ) {
-            std::set<size_t>::iterator pos = level->find( offset );
-            std::set<size_t>::iterator neighbour = pos;
-            ++neighbour;
+    // returns a level of allocated chunk at given offset
+    uint8_t _allocatedChunkLevel( size_t offset ) const
+    {
+        return static_cast<uint8_t>( _chunkLevel[offset >> _minimumLevel] - 1u );
+    }
 
-            if ( neighbour != level->end() ) {
-                if ( *( neighbour ) - *( pos ) == memorySize ) {
-                    offset = *pos;
-                    ( level + 1 )->insert( offset );
-                    level->erase( pos, ++neighbour );
-                    continue;
-                }
-            }
+    bool _hasAllocatedChunks() const
+    {
+        return _allocatedChunkCount > 0u;
+    }
 
-            if ( pos != level->begin() ) {
-                neighbour = pos;
-                --neighbour;
+    // counts an allocation placed in preallocated memory
+    void _registerChunkAllocation( size_t requestedSize, uint8_t level )
+    {
+        _requestedSize += requestedSize;
+        _roundedSize += static_cast<size_t>( 1 ) << ( level < _minimumLevel ? _minimumLevel : level );
+    }
 
-                if ( *( pos ) - *( neighbour ) == memorySize ) {
-                    offset = *neighbour;
-                    ( level + 1 )->insert( offset );
-                    level->erase( neighbour, ++pos );
-                    continue;
-                }
-            }
+    void _registerHeapAllocation()
+    {
+        ++_heapAllocationCount;
+    }
 
-            return;
-        }
+    bool _isRecording() const
+    {
+        return _recording;
+    }
+
+    // stores an allocation or deallocation (size is 0) of an object with given identifier (usually an address)
+    void _recordEvent( std::uintptr_t id, size_t size )
+    {
+        if ( _recording )
+            _allocationEvent.push_back( AllocationEvent( id, size ) );
     }
 
     size_t _size; // a size of memory allocated chunk
-    std::vector<std::set<size_t>> _freeChunk; // free memory in preallocated memory
+    const uint8_t _minimumLevel; // a level of the smallest chunk which could be allocated
+    std::vector<ChunkBitmap> _freeChunk; // free memory in preallocated memory, one bitmap per level
+    std::vector<uint8_t> _chunkLevel; // levels of allocated chunks + 1 indexed by offset / minimum chunk size, 0 means no chunk
 
 private:
+    struct AllocationEvent
+    {
+        AllocationEvent( std::uintptr_t id_ = 0, size_t size_ = 0 )
+            : id( id_ )
+            , size( size_ )
+        {}
+
+        std::uintptr_t id;
+        size_t size; // 0 for deallocation
+    };
+
+    size_t _allocatedChunkCount;
+
+    size_t _usedSize;
+    size_t _peakUsedSize;
+    size_t _requestedSize;
+    size_t _roundedSize;
+    size_t _heapAllocationCount;
+    size_t _failedSplitCount;
+
+    std::atomic<bool> _recording; // could be checked without a lock
+    std::vector<AllocationEvent> _allocationEvent;
+
     virtual void _allocate( size_t size ) = 0; // true memory allocation
     virtual void _deallocate() = 0; // true memory deallocation
+
+    // Replays recorded events on an allocator without real memory. The search starts from the peak of simultaneously used chunks
+    // and grows the size until buddy system fits all allocations
+    static size_t _suggestReserveSize( const std::vector<AllocationEvent> & event, uint8_t minimumLevel )
+    {
+        class SimulatedAllocator : public BaseMemoryAllocator
+        {
+        public:
+            explicit SimulatedAllocator( uint8_t level )
+                : BaseMemoryAllocator( level )
+            {}
+
+            // returns true if all allocations fit into preallocated memory
+            bool replay( const std::vector<AllocationEvent> & event )
+            {
+                std::map<std::uintptr_t, size_t> offset;
+
+                for ( std::vector<AllocationEvent>::const_iterator info = event.begin(); info != event.end(); ++info ) {
+                    if ( info->size > 0 ) {
+                        size_t chunkOffset = 0;
+                        if ( info->size >= _size || !_allocateChunk( _getAllocationLevel( info->size ), chunkOffset ) )
+                            return false;
+
+                        offset[info->id] = chunkOffset;
+                    }
+                    else {
+                        std::map<std::uintptr_t, size_t>::iterator pos = offset.find( info->id );
+                        if ( pos != offset.end() ) {
+                            _releaseChunk( pos->second );
+                            offset.erase( pos );
+                        }
+                    }
+                }
+
+                return true;
+            }
+
+        private:
+            virtual void _allocate( size_t size )
+            {
+                _free();
+                _size = size;
+            }
+
+            virtual void _deallocate() {}
+        };
+
+        const size_t minimumSize = static_cast<size_t>( 1 ) << minimumLevel;
+
+        std::map<std::uintptr_t, size_t> chunkSize;
+        size_t usedSize = 0;
+        size_t peakSize = 0;
+
+        for ( std::vector<AllocationEvent>::const_iterator info = event.begin(); info != event.end(); ++info ) {
+            if ( info->size > 0 ) {
+                const size_t size = std::max( static_cast<size_t>( 1 ) << _getAllocationLevel( info->size ), minimumSize );
+                chunkSize[info->id] = size;
+                usedSize += size;
+                peakSize = std::max( peakSize, usedSize );
+            }
+            else {
+                std::map<std::uintptr_t, size_t>::iterator pos = chunkSize.find( info->id );
+                if ( pos != chunkSize.end() ) {
+                    usedSize -= pos->second;
+                    chunkSize.erase( pos );
+                }
+            }
+        }
+
+        if ( peakSize == 0 )
+            return 0;
+
+        // an allocator does not give a chunk of the whole preallocated memory
+        size_t size = peakSize + minimumSize;
+
+        while ( true ) {
+            SimulatedAllocator allocator( minimumLevel );
+            allocator.reserve( size );
+
+            if ( allocator.replay( event ) )
+                return size;
+
+            size += std::max( size / 8u, minimumSize );
+            size -= size % minimumSize;
+        }
+    }
 };
@@ -63,6 +63,7 @@ namespace
             ImageTypeManager::instance().setFunctionTable( penguinV::ImageOpenCL().type(), table );
             ImageTypeManager::instance().setConvertFunction( Image_Function_OpenCL::ConvertToOpenCL, penguinV::Image(), penguinV::ImageOpenCL() );
             ImageTypeManager::instance().setConvertFunction( Image_Function_OpenCL::ConvertFromOpenCL, penguinV::ImageOpenCL(), penguinV::Image() );
+            BackendSelector::instance().registerBackend( "opencl", penguinV::ImageOpenCL().type(), table );
         }
     };
 
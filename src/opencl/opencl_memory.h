@@ -61,23 +61,28 @@ namespace multiCL
             if ( _data != NULL && size < _size ) {
                 const uint8_t level = _getAllocationLevel( size < _minimumSizeChunk ? _minimumSizeChunk : size );
 
-                if ( _split( level ) ) {
+                size_t offset = 0;
+
+                if ( _allocateChunk( level, offset ) ) {
                     cl_buffer_region region;
-                    region.origin = *( _freeChunk[level].begin() );
+                    region.origin = offset;
                     region.size = size;
 
                     cl_int error;
                     cl_mem memory = clCreateSubBuffer( _data, CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, &region, &error );
-                    if ( error != CL_SUCCESS )
+                    if ( error != CL_SUCCESS ) {
+                        _releaseChunk( offset );
                         throw std::logic_error( "Cannot allocate a subbuffer memory for OpenCL device" );
+                    }
 
-                    _allocatedChunk.insert(
-                        std::pair<cl_mem, std::pair<size_t, uint8_t>>( memory, std::pair<size_t, uint8_t>( *( _freeChunk[level].begin() ), level ) ) );
-                    _freeChunk[level].erase( _freeChunk[level].begin() );
+                    _registerChunkAllocation( size, level );
+                    _allocatedChunk.insert( std::pair<cl_mem, size_t>( memory, offset ) );
                     return memory;
                 }
             }
 
+            _registerHeapAllocation();
+
             // if no space is in preallocated memory just allocate as usual memory
             cl_int error;
             cl_mem memory = clCreateBuffer( _context, CL_MEM_READ_WRITE, size, NULL, &error );
@@ -94,11 +99,10 @@ namespace multiCL
         void free( cl_mem memory )
         {
             if ( _data != NULL ) {
-                std::map<cl_mem, std::pair<size_t, uint8_t>>::iterator pos = _allocatedChunk.find( memory );
+                std::map<cl_mem, size_t>::iterator pos = _allocatedChunk.find( memory );
 
                 if ( pos != _allocatedChunk.end() ) {
-                    _freeChunk[pos->second.second].insert( pos->second.first );
-                    _merge( pos->second.first, pos->second.second );
+                    _releaseChunk( pos->second );
                     _allocatedChunk.erase( pos );
                 }
             }
@@ -122,8 +126,7 @@ namespace multiCL
         // a map which holds an information about allocated memory in preallocated memory chunk
         // first paramter is a pointer to allocated memory in OpenCL terms
         // second parameter is an offset from preallocated memory
-        // third parameter is a power of 2 (level)
-        std::map<cl_mem, std::pair<size_t, uint8_t>> _allocatedChunk;
+        std::map<cl_mem, size_t> _allocatedChunk;
 
         // true memory allocation on OpenCL devices
         virtual void _allocate( size_t size )
@@ -159,8 +162,8 @@ namespace multiCL
             _allocatedChunk.clear();
         }
 
-        MemoryAllocator( const MemoryAllocator & allocator )
-            : BaseMemoryAllocator( allocator )
+        MemoryAllocator( const MemoryAllocator & )
+            : BaseMemoryAllocator()
             , _availableSize( 0 )
         {}
         MemoryAllocator & operator=( const MemoryAllocator & )
@@ -22,6 +22,7 @@
 
 #include <limits>
 #include <utility>
+#include <vector>
 
 namespace Image_Function
 {
@@ -64,7 +65,7 @@ namespace Image_Function
     }
 
     template <typename TImage, typename... Args>
-    void VerifyRGBImage( const TImage & image, Args... args )
+    void VerifyRGBImage( const TImage & image, const Args &... args )
     {
         VerifyRGBImage( image );
         VerifyRGBImage( args... );
@@ -78,7 +79,7 @@ namespace Image_Function
     }
 
     template <typename TImage, typename... Args>
-    void VerifyGrayScaleImage( const TImage & image, Args... args )
+    void VerifyGrayScaleImage( const TImage & image, const Args &... args )
     {
         VerifyGrayScaleImage( image );
         VerifyGrayScaleImage( args... );
@@ -100,12 +101,26 @@ namespace Image_Function
     }
 
     template <typename TImage, typename... Args>
-    void ValidateImageParameters( const TImage & image1, const TImage & image2, Args... args )
+    void ValidateImageParameters( const TImage & image1, const TImage & image2, const Args &... args )
     {
         ValidateImageParameters( image1, image2 );
         ValidateImageParameters( image2, args... );
     }
 
+    template <typename TView1, typename TView2>
+    void ValidateImageViewParameters( const TView1 & view1, const TView2 & view2 )
+    {
+        if ( view1.width() != view2.width() || view1.height() != view2.height() )
+            throw penguinVException( "Bad input parameters in image function: image views have different sizes" );
+    }
+
+    template <typename TView1, typename TView2, typename... Args>
+    void ValidateImageViewParameters( const TView1 & view1, const TView2 & view2, const Args &... args )
+    {
+        ValidateImageViewParameters( view1, view2 );
+        ValidateImageViewParameters( view2, args... );
+    }
+
     template <typename _Type>
     std::pair<_Type, _Type> ExtractRoiSize( _Type width, _Type height )
     {
@@ -113,7 +128,7 @@ namespace Image_Function
     }
 
     template <typename TImage, typename... Args>
-    std::pair<uint32_t, uint32_t> ExtractRoiSize( const TImage &, uint32_t, uint32_t, Args... args )
+    std::pair<uint32_t, uint32_t> ExtractRoiSize( const TImage &, uint32_t, uint32_t, const Args &... args )
     {
         return ExtractRoiSize( args... );
     }
@@ -127,7 +142,7 @@ namespace Image_Function
     }
 
     template <typename TImage, typename... Args>
-    void ValidateImageParameters( const TImage & image1, uint32_t startX1, uint32_t startY1, Args... args )
+    void ValidateImageParameters( const TImage & image1, uint32_t startX1, uint32_t startY1, const Args &... args )
     {
         const std::pair<uint32_t, uint32_t> & dimensions = ExtractRoiSize( args... );
 
@@ -135,6 +150,13 @@ namespace Image_Function
         ValidateImageParameters( args... );
     }
 
+    template <typename TImage>
+    void ValidateImageParameters( const TImage & image, const std::vector<penguinV::Roi> & roi )
+    {
+        for ( std::vector<penguinV::Roi>::const_iterator area = roi.cbegin(); area != roi.cend(); ++area )
+            ValidateImageParameters( image, area->x, area->y, area->width, area->height );
+    }
+
     template <typename TImage>
     bool IsFullImageRow( uint32_t width, const TImage & image )
     {
@@ -142,7 +164,7 @@ namespace Image_Function
     }
 
     template <typename TImage, typename... Args>
-    bool IsFullImageRow( uint32_t width, const TImage & image, Args... args )
+    bool IsFullImageRow( uint32_t width, const TImage & image, const Args &... args )
     {
         if ( !IsFullImageRow( width, image ) )
             return false;
@@ -151,11 +173,34 @@ namespace Image_Function
     }
 
     template <typename TImage, typename... Args>
-    void OptimiseRoi( uint32_t & width, uint32_t & height, const TImage & image, Args... args )
+    void OptimiseRoi( uint32_t & width, uint32_t & height, const TImage & image, const Args &... args )
     {
         if ( IsFullImageRow( width, image, args... ) && ( width < ( std::numeric_limits<uint32_t>::max() / height ) ) ) {
             width = width * height;
             height = 1u;
         }
     }
+
+    template <typename TImage>
+    bool IsSimdAlignedRoi( const TImage & image, uint32_t startX )
+    {
+        return image.isSimdAligned() && ( static_cast<size_t>( startX ) * image.colorCount() * sizeof( *image.data() ) ) % penguinV::SIMD_ALIGNMENT == 0u;
+    }
+
+    template <typename TImage, typename... Args>
+    bool IsSimdAlignedRoi( const TImage & image, uint32_t startX, const Args &... args )
+    {
+        return IsSimdAlignedRoi( image, startX ) && IsSimdAlignedRoi( args... );
+    }
+
+    // Extends ROI width (including color channels) to a multiple of SIMD alignment when all images are SIMD aligned and ROI of output image
+    // ends at the end of rows. Extra pixels lie in padding of rows so functions could process rows without tails
+    template <typename TImage, typename... Args>
+    void OptimiseAlignedRoi( uint32_t & width, const TImage & out, uint32_t startXOut, const Args &... args )
+    {
+        if ( ( startXOut * out.colorCount() + width == out.width() * out.colorCount() ) && IsSimdAlignedRoi( out, startXOut, args... ) ) {
+            const uint32_t alignment = out.simdAlignment();
+            width = ( ( width + alignment - 1u ) / alignment ) * alignment;
+        }
+    }
 }
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #if !defined( __arm__ ) && !defined( __aarch64__ )
 #include <cpuid.h>
 #endif
@@ -41,6 +43,21 @@ struct CpuInformation
         return false;
     }
 
+    static bool isSsse3Supported()
+    {
+#if !defined( __arm__ ) && !defined( __aarch64__ )
+        int info[4];
+        __cpuid_count( 0, 0, info[0], info[1], info[2], info[3] );
+        const int id = info[0];
+
+        if ( id >= 0x00000001 ) {
+            __cpuid_count( 0x00000001, 0, info[0], info[1], info[2], info[3] );
+            return ( info[2] & ( (int)1 << 9 ) ) != 0;
+        }
+#endif
+        return false;
+    }
+
     static bool isAvxSupported()
     {
 #if !defined( __arm__ ) && !defined( __aarch64__ )
@@ -50,7 +67,7 @@ struct CpuInformation
 
         if ( id >= 0x00000007 ) {
             __cpuid_count( 0x00000007, 0, info[0], info[1], info[2], info[3] );
-            return ( info[1] & ( (int)1 << 5 ) ) != 0;
+            return ( ( info[1] & ( (int)1 << 5 ) ) != 0 ) && _isOsStateEnabled( 0x6u ); // XMM and YMM registers are saved by OS
         }
 #endif
         return false;
@@ -65,7 +82,9 @@ struct CpuInformation
 
         if ( id >= 0x00000007 ) {
             __cpuid_count( 0x00000007, 0, info[0], info[1], info[2], info[3] );
-            return ( info[1] & ( ( (int)1 << 31 ) | ( (int)1 << 30 ) | ( (int)1 << 28 ) | ( (int)1 << 17 ) | ( (int)1 << 16 ) ) ) != 0;
+            // all of AVX512F, AVX512DQ, AVX512CD, AVX512BW and AVX512VL must be supported
+            const int mask = ( (int)1 << 31 ) | ( (int)1 << 30 ) | ( (int)1 << 28 ) | ( (int)1 << 17 ) | ( (int)1 << 16 );
+            return ( ( info[1] & mask ) == mask ) && _isOsStateEnabled( 0xE6u ); // XMM, YMM and ZMM registers are saved by OS
         }
 #endif
         return false;
@@ -79,4 +98,23 @@ struct CpuInformation
         return true;
 #endif
     }
+
+private:
+    // Operating system must save extended registers during context switch, otherwise AVX instructions cannot be used
+    static bool _isOsStateEnabled( uint32_t mask )
+    {
+#if !defined( __arm__ ) && !defined( __aarch64__ )
+        int info[4];
+        __cpuid_count( 0x00000001, 0, info[0], info[1], info[2], info[3] );
+        if ( ( info[2] & ( (int)1 << 27 ) ) == 0 ) // OSXSAVE
+            return false;
+
+        uint32_t eax = 0;
+        uint32_t edx = 0;
+        __asm__ __volatile__( "xgetbv" : "=a"( eax ), "=d"( edx ) : "c"( 0 ) );
+        return ( eax & mask ) == mask;
+#else
+        return mask == 0;
+#endif
+    }
 };
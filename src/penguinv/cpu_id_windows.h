@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <intrin.h>
 
 struct CpuInformation
@@ -38,6 +39,20 @@ struct CpuInformation
         return false;
     }
 
+    static bool isSsse3Supported()
+    {
+        int info[4];
+        __cpuidex( info, 0, 0 );
+        const int id = info[0];
+
+        if ( id >= 0x00000001 ) {
+            __cpuidex( info, 0x00000001, 0 );
+            return ( info[2] & ( (int)1 << 9 ) ) != 0;
+        }
+
+        return false;
+    }
+
     static bool isAvxSupported()
     {
         int info[4];
@@ -46,7 +61,7 @@ struct CpuInformation
 
         if ( id >= 0x00000007 ) {
             __cpuidex( info, 0x00000007, 0 );
-            return ( info[1] & ( (int)1 << 5 ) ) != 0;
+            return ( ( info[1] & ( (int)1 << 5 ) ) != 0 ) && _isOsStateEnabled( 0x6u ); // XMM and YMM registers are saved by OS
         }
 
         return false;
@@ -60,7 +75,9 @@ struct CpuInformation
 
         if ( id >= 0x00000007 ) {
             __cpuidex( info, 0x00000007, 0 );
-            return ( info[1] & ( ( (int)1 << 31 ) | ( (int)1 << 30 ) | ( (int)1 << 28 ) | ( (int)1 << 17 ) | ( (int)1 << 16 ) ) ) != 0;
+            // all of AVX512F, AVX512DQ, AVX512CD, AVX512BW and AVX512VL must be supported
+            const int mask = ( (int)1 << 31 ) | ( (int)1 << 30 ) | ( (int)1 << 28 ) | ( (int)1 << 17 ) | ( (int)1 << 16 );
+            return ( ( info[1] & mask ) == mask ) && _isOsStateEnabled( 0xE6u ); // XMM, YMM and ZMM registers are saved by OS
         }
 
         return false;
@@ -74,4 +91,16 @@ struct CpuInformation
         return false;
 #endif
     }
+
+private:
+    // Operating system must save extended registers during context switch, otherwise AVX instructions cannot be used
+    static bool _isOsStateEnabled( uint32_t mask )
+    {
+        int info[4];
+        __cpuidex( info, 0x00000001, 0 );
+        if ( ( info[2] & ( (int)1 << 27 ) ) == 0 ) // OSXSAVE
+            return false;
+
+        return ( static_cast<uint32_t>( _xgetbv( 0 ) ) & mask ) == mask;
+    }
 };
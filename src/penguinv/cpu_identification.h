@@ -99,12 +99,46 @@
 #endif
 #endif
 
+// Instruction sets for which the library contains code selected during runtime. Code of such sets is placed in separate source files
+// compiled with own compiler flags so a binary built for any baseline processor uses the best instruction set of the actual processor.
+// Compiler flags of the rest of source files define only instruction sets which could be used directly by inline code
+#if defined( _MSC_VER ) // Visual Studio sets instruction sets per project so we rely on the same definitions
+
+#ifdef PENGUINV_NEON_SET
+#define PENGUINV_NEON_DISPATCH
+#endif
+#ifdef PENGUINV_SSE_SET
+#define PENGUINV_SSE_DISPATCH
+#endif
+#ifdef PENGUINV_SSSE3_SET
+#define PENGUINV_SSSE3_DISPATCH
+#endif
+#ifdef PENGUINV_AVX_SET
+#define PENGUINV_AVX_DISPATCH
+#endif
+#ifdef PENGUINV_AVX512_SKL_SET
+#define PENGUINV_AVX512_SKL_DISPATCH
+#endif
+
+#elif defined( __arm__ ) || defined( __aarch64__ )
+
+#ifdef PENGUINV_NEON_SET
+#define PENGUINV_NEON_DISPATCH
+#endif
+
+#elif defined( __x86_64__ ) || defined( __i386__ )
+#define PENGUINV_SSE_DISPATCH
+#define PENGUINV_SSSE3_DISPATCH
+#define PENGUINV_AVX_DISPATCH
+#define PENGUINV_AVX512_SKL_DISPATCH
+#endif
+
 // Identify available technologies during runtime
 struct SimdInfo
 {
     static bool isSseAvailable()
     {
-#ifdef PENGUINV_SSE_SET
+#ifdef PENGUINV_SSE_DISPATCH
         static const bool isAvailable = CpuInformation::isSseSupported();
         return isAvailable;
 #else
@@ -112,9 +146,19 @@ struct SimdInfo
 #endif
     }
 
+    static bool isSsse3Available()
+    {
+#ifdef PENGUINV_SSSE3_DISPATCH
+        static const bool isAvailable = CpuInformation::isSsse3Supported();
+        return isAvailable;
+#else
+        return false;
+#endif
+    }
+
     static bool isAvxAvailable()
     {
-#ifdef PENGUINV_AVX_SET
+#ifdef PENGUINV_AVX_DISPATCH
         static const bool isAvailable = CpuInformation::isAvxSupported();
         return isAvailable;
 #else
@@ -124,7 +168,7 @@ struct SimdInfo
 
     static bool isNeonAvailable()
     {
-#ifdef PENGUINV_NEON_SET
+#ifdef PENGUINV_NEON_DISPATCH
         static const bool isAvailable = CpuInformation::isNeonSupported();
         return isAvailable;
 #else
@@ -134,7 +178,7 @@ struct SimdInfo
 
     static bool isAVX512SKLAvailable()
     {
-#ifdef PENGUINV_AVX512_SKL_SET
+#ifdef PENGUINV_AVX512_SKL_DISPATCH
         static const bool isAvailable = CpuInformation::isAvx512SKLSupported();
         return isAvailable;
 #else
@@ -21,6 +21,9 @@
 #pragma once
 
 #include "../image_buffer.h"
+#include <list>
+#include <map>
+#include <memory>
 #include <vector>
 
 template <typename _Type>
@@ -41,6 +44,203 @@ struct ConstReferenceOwner
     const penguinV::ImageTemplate<_Type> & data;
 };
 
+// Keeps tracked images converted into other image types between function calls, so a chain of functions executed on another device
+// converts every tracked image there and back only once. Images written by functions are converted back in synchronize() or release()
+// functions. Residency is active for the current thread between activate() and deactivate() calls, untracked images are converted per call
+template <typename _Type>
+class ImageResidency
+{
+public:
+    typedef penguinV::ImageTemplate<_Type> ( *GenerateImage )( uint8_t imageType );
+    typedef void ( *ConvertImage )( const penguinV::ImageTemplate<_Type> & in, penguinV::ImageTemplate<_Type> & out );
+
+    ImageResidency()
+        : _conversionCount( 0u )
+    {}
+
+    static ImageResidency * current()
+    {
+        return _current();
+    }
+
+    void activate()
+    {
+        _current() = this;
+    }
+
+    void deactivate()
+    {
+        if ( _current() == this )
+            _current() = nullptr;
+    }
+
+    void track( penguinV::ImageTemplate<_Type> & image )
+    {
+        if ( _find( image ) == nullptr )
+            _entries.emplace_back( new Entry( image ) );
+    }
+
+    // image of required type containing the same data as original image, nullptr if the image is not tracked
+    const penguinV::ImageTemplate<_Type> * input( const penguinV::ImageTemplate<_Type> & image, uint8_t type, GenerateImage generateImage,
+                                                   ConvertImage convertImage )
+    {
+        Entry * entry = _find( image );
+        if ( entry == nullptr )
+            return nullptr;
+
+        if ( image.type() == type ) {
+            _synchronize( *entry, convertImage );
+            return &image;
+        }
+
+        return &_copy( *entry, type, generateImage, convertImage );
+    }
+
+    // image of required type which is going to be modified, the original image becomes outdated. nullptr if the image is not tracked
+    penguinV::ImageTemplate<_Type> * output( penguinV::ImageTemplate<_Type> & image, uint8_t type, GenerateImage generateImage, ConvertImage convertImage )
+    {
+        Entry * entry = _find( image );
+        if ( entry == nullptr )
+            return nullptr;
+
+        if ( image.type() == type ) {
+            _synchronize( *entry, convertImage );
+
+            for ( typename std::map<uint8_t, Copy>::iterator copy = entry->copy.begin(); copy != entry->copy.end(); ++copy )
+                copy->second.valid = false;
+
+            return &image;
+        }
+
+        // a function could modify only a part of the image so the copy must have actual data
+        penguinV::ImageTemplate<_Type> & copy = _copy( *entry, type, generateImage, convertImage );
+
+        for ( typename std::map<uint8_t, Copy>::iterator other = entry->copy.begin(); other != entry->copy.end(); ++other )
+            other->second.valid = ( other->first == type );
+
+        entry->valid = false;
+        entry->newest = type;
+
+        return &copy;
+    }
+
+    // converts all modified images back into original images
+    void synchronize( ConvertImage convertImage )
+    {
+        for ( typename std::vector<std::unique_ptr<Entry>>::iterator entry = _entries.begin(); entry != _entries.end(); ++entry )
+            _synchronize( **entry, convertImage );
+    }
+
+    // converts the image back if it was modified and stops tracking it
+    void release( const penguinV::ImageTemplate<_Type> & image, ConvertImage convertImage )
+    {
+        for ( typename std::vector<std::unique_ptr<Entry>>::iterator entry = _entries.begin(); entry != _entries.end(); ++entry ) {
+            if ( ( *entry )->image == &image ) {
+                _synchronize( **entry, convertImage );
+                _entries.erase( entry );
+                return;
+            }
+        }
+    }
+
+    size_t conversionCount() const
+    {
+        return _conversionCount;
+    }
+
+private:
+    struct Copy
+    {
+        Copy()
+            : valid( false )
+        {}
+
+        penguinV::ImageTemplate<_Type> image;
+        bool valid;
+    };
+
+    struct Entry
+    {
+        explicit Entry( penguinV::ImageTemplate<_Type> & image_ )
+            : image( &image_ )
+            , data( image_.data() )
+            , width( image_.width() )
+            , height( image_.height() )
+            , colorCount( image_.colorCount() )
+            , valid( true )
+            , newest( image_.type() )
+        {}
+
+        bool isActual( const penguinV::ImageTemplate<_Type> & image_ ) const
+        {
+            return data == image_.data() && width == image_.width() && height == image_.height() && colorCount == image_.colorCount();
+        }
+
+        penguinV::ImageTemplate<_Type> * image;
+
+        // original image parameters to detect reallocated images
+        const _Type * data;
+        uint32_t width;
+        uint32_t height;
+        uint8_t colorCount;
+
+        bool valid; // original image contains actual data, otherwise the copy of newest type does
+        uint8_t newest;
+        std::map<uint8_t, Copy> copy; // index is image type
+    };
+
+    std::vector<std::unique_ptr<Entry>> _entries;
+    size_t _conversionCount;
+
+    static ImageResidency *& _current()
+    {
+        static thread_local ImageResidency * residency = nullptr;
+        return residency;
+    }
+
+    Entry * _find( const penguinV::ImageTemplate<_Type> & image )
+    {
+        for ( typename std::vector<std::unique_ptr<Entry>>::iterator entry = _entries.begin(); entry != _entries.end(); ++entry ) {
+            if ( ( *entry )->image == &image ) {
+                if ( !( *entry )->isActual( image ) ) // the image was reassigned so its copies are outdated
+                    entry->reset( new Entry( *( *entry )->image ) );
+
+                return entry->get();
+            }
+        }
+
+        return nullptr;
+    }
+
+    penguinV::ImageTemplate<_Type> & _copy( Entry & entry, uint8_t type, GenerateImage generateImage, ConvertImage convertImage )
+    {
+        Copy & copy = entry.copy[type];
+
+        if ( !copy.valid ) {
+            _synchronize( entry, convertImage );
+
+            if ( copy.image.type() != type || copy.image.width() != entry.width || copy.image.height() != entry.height
+                 || copy.image.colorCount() != entry.colorCount )
+                copy.image = generateImage( type ).generate( entry.width, entry.height, entry.colorCount );
+
+            convertImage( *entry.image, copy.image );
+            ++_conversionCount;
+            copy.valid = true;
+        }
+
+        return copy.image;
+    }
+
+    void _synchronize( Entry & entry, ConvertImage convertImage )
+    {
+        if ( !entry.valid ) {
+            convertImage( entry.copy[entry.newest].image, *entry.image );
+            ++_conversionCount;
+            entry.valid = true;
+        }
+    }
+};
+
 template <typename _Type>
 class ImageManager
 {
@@ -52,6 +252,7 @@ public:
         : _type( requiredType )
         , _generateImage( generateImage )
         , _convertImage( convertImage )
+        , _residency( ImageResidency<_Type>::current() )
     {}
 
     ~ImageManager()
@@ -59,8 +260,9 @@ public:
         for ( typename std::vector<ConstReferenceOwner<_Type> *>::iterator data = _input.begin(); data != _input.end(); ++data )
             delete *data;
 
-        for ( size_t i = 0u; i < _output.size(); ++i ) {
-            _restore( _outputClone[i], _output[i]->data );
+        typename std::list<penguinV::ImageTemplate<_Type>>::iterator clone = _outputClone.begin();
+        for ( size_t i = 0u; i < _output.size(); ++i, ++clone ) {
+            _restore( *clone, _output[i]->data );
 
             delete _output[i];
         }
@@ -68,6 +270,12 @@ public:
 
     const penguinV::Image & operator()( const penguinV::ImageTemplate<_Type> & image )
     {
+        if ( _residency != nullptr ) {
+            const penguinV::ImageTemplate<_Type> * resident = _residency->input( image, _type, _generateImage, _convertImage );
+            if ( resident != nullptr )
+                return *resident;
+        }
+
         if ( image.type() != _type ) {
             _inputClone.push_back( _clone( image ) );
             return _inputClone.back();
@@ -79,6 +287,12 @@ public:
 
     penguinV::ImageTemplate<_Type> & operator()( penguinV::ImageTemplate<_Type> & image )
     {
+        if ( _residency != nullptr ) {
+            penguinV::ImageTemplate<_Type> * resident = _residency->output( image, _type, _generateImage, _convertImage );
+            if ( resident != nullptr )
+                return *resident;
+        }
+
         if ( image.type() != _type ) {
             _output.push_back( new ReferenceOwner<_Type>( image ) );
             _outputClone.push_back( _clone( image ) );
@@ -93,10 +307,12 @@ private:
     uint8_t _type;
     GenerateImage _generateImage;
     ConvertImage _convertImage;
+    ImageResidency<_Type> * _residency;
     std::vector<ConstReferenceOwner<_Type> *> _input;
     std::vector<ReferenceOwner<_Type> *> _output;
-    std::vector<penguinV::ImageTemplate<_Type>> _inputClone;
-    std::vector<penguinV::ImageTemplate<_Type>> _outputClone;
+    // lists keep references to previously returned clones valid
+    std::list<penguinV::ImageTemplate<_Type>> _inputClone;
+    std::list<penguinV::ImageTemplate<_Type>> _outputClone;
 
     penguinV::Image _clone( const penguinV::ImageTemplate<_Type> & in )
     {
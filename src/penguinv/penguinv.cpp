@@ -45,18 +45,26 @@ namespace
 
 #define initialize( image, func_ )                                                                                                                                       \
     ImageTypeManager & registrator = ImageTypeManager::instance();                                                                                                       \
-    auto func = registrator.functionTable( image.type() ).func_;                                                                                                         \
     uint8_t imageType = image.type();                                                                                                                                    \
+    auto func = registrator.functionTable( imageType ).func_;                                                                                                            \
+    resolveFunction( func_ )
+
+// functions with costs for automatic backend selection
+#define initializeSelected( image, func_, width, height )                                                                                                                \
+    ImageTypeManager & registrator = ImageTypeManager::instance();                                                                                                       \
+    uint8_t imageType = image.type();                                                                                                                                    \
+    auto func = registrator.functionTable( imageType ).func_;                                                                                                            \
+    const BackendSelector::Backend * backend = BackendSelector::instance().select( BackendSelector::func_, imageType, width, height );                                   \
+    if ( backend != nullptr && backend->table.func_ != nullptr ) {                                                                                                       \
+        func = backend->table.func_;                                                                                                                                     \
+        imageType = backend->imageType;                                                                                                                                  \
+    }                                                                                                                                                                    \
+    resolveFunction( func_ )
+
+#define resolveFunction( func_ )                                                                                                                                         \
     if ( func == nullptr && registrator.isIntertypeConversionEnabled() ) {                                                                                               \
-        const std::vector<uint8_t> & types = registrator.imageTypes();                                                                                                   \
-        for ( std::vector<uint8_t>::const_iterator type = types.cbegin(); type != types.cend(); ++type ) {                                                               \
-            auto funcTemp = registrator.functionTable( *type ).func_;                                                                                                    \
-            if ( funcTemp != nullptr ) {                                                                                                                                 \
-                func = funcTemp;                                                                                                                                         \
-                imageType = *type;                                                                                                                                       \
-                break;                                                                                                                                                   \
-            }                                                                                                                                                            \
-        }                                                                                                                                                                \
+        func = registrator.intertypeFunctionTable( imageType ).func_;                                                                                                    \
+        imageType = registrator.intertypeFunctionType( imageType ).func_;                                                                                                \
     }                                                                                                                                                                    \
     verifyFunction( func, #func_ );                                                                                                                                      \
     ImageManager<uint8_t> manager( imageType, generateImage, convertImage );
@@ -64,6 +72,54 @@ namespace
 
 namespace penguinV
 {
+    ResidencyScope::ResidencyScope()
+        : _residency( new ImageResidency<uint8_t> )
+        , _previous( ImageResidency<uint8_t>::current() )
+    {
+        _residency->activate();
+    }
+
+    ResidencyScope::ResidencyScope( const std::vector<Image *> & image )
+        : ResidencyScope()
+    {
+        for ( std::vector<Image *>::const_iterator im = image.begin(); im != image.end(); ++im )
+            add( **im );
+    }
+
+    ResidencyScope::~ResidencyScope()
+    {
+        _residency->deactivate();
+
+        if ( _previous != nullptr )
+            _previous->activate();
+
+        try {
+            _residency->synchronize( convertImage );
+        }
+        catch ( ... ) {
+        }
+    }
+
+    void ResidencyScope::add( Image & image )
+    {
+        _residency->track( image );
+    }
+
+    void ResidencyScope::release( const Image & image )
+    {
+        _residency->release( image, convertImage );
+    }
+
+    void ResidencyScope::synchronize()
+    {
+        _residency->synchronize( convertImage );
+    }
+
+    size_t ResidencyScope::conversionCount() const
+    {
+        return _residency->conversionCount();
+    }
+
     Image AbsoluteDifference( const Image & in1, const Image & in2 )
     {
         return Image_Function_Helper::AbsoluteDifference( AbsoluteDifference, in1, in2 );
@@ -83,10 +139,20 @@ namespace penguinV
     void AbsoluteDifference( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out,
                              uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
     {
-        initialize( in1, AbsoluteDifference )
+        initializeSelected( in1, AbsoluteDifference, width, height )
             func( manager( in1 ), startX1, startY1, manager( in2 ), startX2, startY2, manager( out ), startXOut, startYOut, width, height );
     }
 
+    Image AbsoluteDifference( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::AbsoluteDifference( AbsoluteDifference, in1, in2 );
+    }
+
+    void AbsoluteDifference( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::AbsoluteDifference( AbsoluteDifference, in1, in2, out );
+    }
+
     void Accumulate( const Image & image, std::vector<uint32_t> & result )
     {
         Image_Function_Helper::Accumulate( Accumulate, image, result );
@@ -94,7 +160,7 @@ namespace penguinV
 
     void Accumulate( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint32_t> & result )
     {
-        initialize( image, Accumulate ) func( image, x, y, width, height, result );
+        initialize( image, Accumulate ) func( manager( image ), x, y, width, height, result );
     }
 
     Image BitwiseAnd( const Image & in1, const Image & in2 )
@@ -115,7 +181,18 @@ namespace penguinV
     void BitwiseAnd( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                      uint32_t startYOut, uint32_t width, uint32_t height )
     {
-        initialize( in1, BitwiseAnd ) func( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
+        initializeSelected( in1, BitwiseAnd, width, height )
+            func( manager( in1 ), startX1, startY1, manager( in2 ), startX2, startY2, manager( out ), startXOut, startYOut, width, height );
+    }
+
+    Image BitwiseAnd( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::BitwiseAnd( BitwiseAnd, in1, in2 );
+    }
+
+    void BitwiseAnd( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::BitwiseAnd( BitwiseAnd, in1, in2, out );
     }
 
     Image BitwiseOr( const Image & in1, const Image & in2 )
@@ -136,7 +213,18 @@ namespace penguinV
     void BitwiseOr( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                     uint32_t startYOut, uint32_t width, uint32_t height )
     {
-        initialize( in1, BitwiseOr ) func( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
+        initializeSelected( in1, BitwiseOr, width, height )
+            func( manager( in1 ), startX1, startY1, manager( in2 ), startX2, startY2, manager( out ), startXOut, startYOut, width, height );
+    }
+
+    Image BitwiseOr( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::BitwiseOr( BitwiseOr, in1, in2 );
+    }
+
+    void BitwiseOr( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::BitwiseOr( BitwiseOr, in1, in2, out );
     }
 
     Image BitwiseXor( const Image & in1, const Image & in2 )
@@ -157,7 +245,18 @@ namespace penguinV
     void BitwiseXor( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                      uint32_t startYOut, uint32_t width, uint32_t height )
     {
-        initialize( in1, BitwiseXor ) func( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
+        initializeSelected( in1, BitwiseXor, width, height )
+            func( manager( in1 ), startX1, startY1, manager( in2 ), startX2, startY2, manager( out ), startXOut, startYOut, width, height );
+    }
+
+    Image BitwiseXor( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::BitwiseXor( BitwiseXor, in1, in2 );
+    }
+
+    void BitwiseXor( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::BitwiseXor( BitwiseXor, in1, in2, out );
     }
 
     Image ConvertToGrayScale( const Image & in )
@@ -198,7 +297,7 @@ namespace penguinV
 
     void ConvertToRgb( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
     {
-        initialize( in, ConvertToRgb ) func( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
+        initialize( in, ConvertToRgb ) func( manager( in ), startXIn, startYIn, manager( out ), startXOut, startYOut, width, height );
     }
 
     void Copy( const Image & in, Image & out )
@@ -213,7 +312,7 @@ namespace penguinV
 
     void Copy( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
     {
-        initialize( in, Copy ) func( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
+        initialize( in, Copy ) func( manager( in ), startXIn, startYIn, manager( out ), startXOut, startYOut, width, height );
     }
 
     Image ExtractChannel( const Image & in, uint8_t channelId )
@@ -234,7 +333,7 @@ namespace penguinV
     void ExtractChannel( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                          uint8_t channelId )
     {
-        initialize( in, ExtractChannel ) func( in, startXIn, startYIn, out, startXOut, startYOut, width, height, channelId );
+        initialize( in, ExtractChannel ) func( manager( in ), startXIn, startYIn, manager( out ), startXOut, startYOut, width, height, channelId );
     }
 
     void Fill( Image & image, uint8_t value )
@@ -244,7 +343,7 @@ namespace penguinV
 
     void Fill( Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint8_t value )
     {
-        initialize( image, Fill ) func( image, x, y, width, height, value );
+        initialize( image, Fill ) func( manager( image ), x, y, width, height, value );
     }
 
     Image Flip( const Image & in, bool horizontal, bool vertical )
@@ -265,7 +364,7 @@ namespace penguinV
     void Flip( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                bool horizontal, bool vertical )
     {
-        initialize( in, Flip ) func( in, startXIn, startYIn, out, startXOut, startYOut, width, height, horizontal, vertical );
+        initialize( in, Flip ) func( manager( in ), startXIn, startYIn, manager( out ), startXOut, startYOut, width, height, horizontal, vertical );
     }
 
     Image GammaCorrection( const Image & in, double a, double gamma )
@@ -286,13 +385,13 @@ namespace penguinV
     void GammaCorrection( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                           double a, double gamma )
     {
-        initialize( in, GammaCorrection ) func( in, startXIn, startYIn, out, startXOut, startYOut, width, height, a, gamma );
+        initialize( in, GammaCorrection ) func( manager( in ), startXIn, startYIn, manager( out ), startXOut, startYOut, width, height, a, gamma );
     }
 
     uint8_t GetPixel( const Image & image, uint32_t x, uint32_t y )
     {
         initialize( image, GetPixel );
-        return func( image, x, y );
+        return func( manager( image ), x, y );
     }
 
     uint8_t GetThreshold( const std::vector<uint32_t> & histogram )
@@ -317,7 +416,17 @@ namespace penguinV
 
     void Histogram( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint32_t> & histogram )
     {
-        initialize( image, Histogram ) func( manager( image ), x, y, width, height, histogram );
+        initializeSelected( image, Histogram, width, height ) func( manager( image ), x, y, width, height, histogram );
+    }
+
+    std::vector<uint32_t> Histogram( const ConstImageView & image )
+    {
+        return Image_Function_Helper::Histogram( Histogram, image );
+    }
+
+    void Histogram( const ConstImageView & image, std::vector<uint32_t> & histogram )
+    {
+        Image_Function_Helper::Histogram( Histogram, image, histogram );
     }
 
     Image Invert( const Image & in )
@@ -337,7 +446,17 @@ namespace penguinV
 
     void Invert( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
     {
-        initialize( in, Invert ) func( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
+        initializeSelected( in, Invert, width, height ) func( manager( in ), startXIn, startYIn, manager( out ), startXOut, startYOut, width, height );
+    }
+
+    Image Invert( const ConstImageView & in )
+    {
+        return Image_Function_Helper::Invert( Invert, in );
+    }
+
+    void Invert( const ConstImageView & in, const ImageView & out )
+    {
+        Image_Function_Helper::Invert( Invert, in, out );
     }
 
     bool IsEqual( const Image & in1, const Image & in2 )
@@ -348,7 +467,7 @@ namespace penguinV
     bool IsEqual( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height )
     {
         initialize( in1, IsEqual );
-        return func( in1, startX1, startY1, in2, startX2, startY2, width, height );
+        return func( manager( in1 ), startX1, startY1, manager( in2 ), startX2, startY2, width, height );
     }
 
     Image LookupTable( const Image & in, const std::vector<uint8_t> & table )
@@ -369,7 +488,7 @@ namespace penguinV
     void LookupTable( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                       const std::vector<uint8_t> & table )
     {
-        initialize( in, LookupTable ) func( in, startXIn, startYIn, out, startXOut, startYOut, width, height, table );
+        initialize( in, LookupTable ) func( manager( in ), startXIn, startYIn, manager( out ), startXOut, startYOut, width, height, table );
     }
 
     Image Maximum( const Image & in1, const Image & in2 )
@@ -390,7 +509,18 @@ namespace penguinV
     void Maximum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                   uint32_t startYOut, uint32_t width, uint32_t height )
     {
-        initialize( in1, Maximum ) func( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
+        initializeSelected( in1, Maximum, width, height )
+            func( manager( in1 ), startX1, startY1, manager( in2 ), startX2, startY2, manager( out ), startXOut, startYOut, width, height );
+    }
+
+    Image Maximum( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::Maximum( Maximum, in1, in2 );
+    }
+
+    void Maximum( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::Maximum( Maximum, in1, in2, out );
     }
 
     Image Merge( const Image & in1, const Image & in2, const Image & in3 )
@@ -412,7 +542,9 @@ namespace penguinV
     void Merge( const Image & in1, uint32_t startXIn1, uint32_t startYIn1, const Image & in2, uint32_t startXIn2, uint32_t startYIn2, const Image & in3,
                 uint32_t startXIn3, uint32_t startYIn3, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
     {
-        initialize( in1, Merge ) func( in1, startXIn1, startYIn1, in2, startXIn2, startYIn2, in3, startXIn3, startYIn3, out, startXOut, startYOut, width, height );
+        initialize( in1, Merge )
+            func( manager( in1 ), startXIn1, startYIn1, manager( in2 ), startXIn2, startYIn2, manager( in3 ), startXIn3, startYIn3, manager( out ), startXOut, startYOut,
+                  width, height );
     }
 
     Image Minimum( const Image & in1, const Image & in2 )
@@ -433,7 +565,18 @@ namespace penguinV
     void Minimum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                   uint32_t startYOut, uint32_t width, uint32_t height )
     {
-        initialize( in1, Minimum ) func( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
+        initializeSelected( in1, Minimum, width, height )
+            func( manager( in1 ), startX1, startY1, manager( in2 ), startX2, startY2, manager( out ), startXOut, startYOut, width, height );
+    }
+
+    Image Minimum( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::Minimum( Minimum, in1, in2 );
+    }
+
+    void Minimum( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::Minimum( Minimum, in1, in2, out );
     }
 
     Image Normalize( const Image & in )
@@ -453,7 +596,7 @@ namespace penguinV
 
     void Normalize( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
     {
-        initialize( in, Normalize ) func( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
+        initialize( in, Normalize ) func( manager( in ), startXIn, startYIn, manager( out ), startXOut, startYOut, width, height );
     }
 
     std::vector<uint32_t> ProjectionProfile( const Image & image, bool horizontal )
@@ -473,7 +616,7 @@ namespace penguinV
 
     void ProjectionProfile( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool horizontal, std::vector<uint32_t> & projection )
     {
-        initialize( image, ProjectionProfile ) func( image, x, y, width, height, horizontal, projection );
+        initialize( image, ProjectionProfile ) func( manager( image ), x, y, width, height, horizontal, projection );
     }
 
     Image Resize( const Image & in, uint32_t widthOut, uint32_t heightOut )
@@ -494,7 +637,7 @@ namespace penguinV
     void Resize( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t widthIn, uint32_t heightIn, Image & out, uint32_t startXOut, uint32_t startYOut,
                  uint32_t widthOut, uint32_t heightOut )
     {
-        initialize( in, Resize ) func( in, startXIn, startYIn, widthIn, heightIn, out, startXOut, startYOut, widthOut, heightOut );
+        initialize( in, Resize ) func( manager( in ), startXIn, startYIn, widthIn, heightIn, manager( out ), startXOut, startYOut, widthOut, heightOut );
     }
 
     Image RgbToBgr( const Image & in )
@@ -514,17 +657,17 @@ namespace penguinV
 
     void RgbToBgr( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
     {
-        initialize( in, RgbToBgr ) func( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
+        initialize( in, RgbToBgr ) func( manager( in ), startXIn, startYIn, manager( out ), startXOut, startYOut, width, height );
     }
 
     void SetPixel( Image & image, uint32_t x, uint32_t y, uint8_t value )
     {
-        initialize( image, SetPixel ) func( image, x, y, value );
+        initialize( image, SetPixel ) func( manager( image ), x, y, value );
     }
 
     void SetPixel( Image & image, const std::vector<uint32_t> & X, const std::vector<uint32_t> & Y, uint8_t value )
     {
-        initialize( image, SetPixel2 ) func( image, X, Y, value );
+        initialize( image, SetPixel2 ) func( manager( image ), X, Y, value );
     }
 
     void Split( const Image & in, Image & out1, Image & out2, Image & out3 )
@@ -535,7 +678,9 @@ namespace penguinV
     void Split( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out1, uint32_t startXOut1, uint32_t startYOut1, Image & out2, uint32_t startXOut2,
                 uint32_t startYOut2, Image & out3, uint32_t startXOut3, uint32_t startYOut3, uint32_t width, uint32_t height )
     {
-        initialize( in, Split ) func( in, startXIn, startYIn, out1, startXOut1, startYOut1, out2, startXOut2, startYOut2, out3, startXOut3, startYOut3, width, height );
+        initialize( in, Split )
+            func( manager( in ), startXIn, startYIn, manager( out1 ), startXOut1, startYOut1, manager( out2 ), startXOut2, startYOut2, manager( out3 ), startXOut3,
+                  startYOut3, width, height );
     }
 
     Image Subtract( const Image & in1, const Image & in2 )
@@ -556,7 +701,18 @@ namespace penguinV
     void Subtract( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                    uint32_t startYOut, uint32_t width, uint32_t height )
     {
-        initialize( in1, Subtract ) func( in1, startX1, startY1, in2, startX2, startY2, out, startXOut, startYOut, width, height );
+        initializeSelected( in1, Subtract, width, height )
+            func( manager( in1 ), startX1, startY1, manager( in2 ), startX2, startY2, manager( out ), startXOut, startYOut, width, height );
+    }
+
+    Image Subtract( const ConstImageView & in1, const ConstImageView & in2 )
+    {
+        return Image_Function_Helper::Subtract( Subtract, in1, in2 );
+    }
+
+    void Subtract( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out )
+    {
+        Image_Function_Helper::Subtract( Subtract, in1, in2, out );
     }
 
     uint32_t Sum( const Image & image )
@@ -566,8 +722,13 @@ namespace penguinV
 
     uint32_t Sum( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height )
     {
-        initialize( image, Sum );
-        return func( image, x, y, width, height );
+        initializeSelected( image, Sum, width, height );
+        return func( manager( image ), x, y, width, height );
+    }
+
+    uint32_t Sum( const ConstImageView & image )
+    {
+        return Image_Function_Helper::Sum( Sum, image );
     }
 
     Image Threshold( const Image & in, uint8_t threshold )
@@ -588,7 +749,17 @@ namespace penguinV
     void Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                     uint8_t threshold )
     {
-        initialize( in, Threshold ) func( manager( in ), startXIn, startYIn, manager( out ), startXOut, startYOut, width, height, threshold );
+        initializeSelected( in, Threshold, width, height ) func( manager( in ), startXIn, startYIn, manager( out ), startXOut, startYOut, width, height, threshold );
+    }
+
+    Image Threshold( const ConstImageView & in, uint8_t threshold )
+    {
+        return Image_Function_Helper::Threshold( Threshold, in, threshold );
+    }
+
+    void Threshold( const ConstImageView & in, const ImageView & out, uint8_t threshold )
+    {
+        Image_Function_Helper::Threshold( Threshold, in, out, threshold );
     }
 
     Image Threshold( const Image & in, uint8_t minThreshold, uint8_t maxThreshold )
@@ -609,7 +780,18 @@ namespace penguinV
     void Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                     uint8_t minThreshold, uint8_t maxThreshold )
     {
-        initialize( in, Threshold2 ) func( in, startXIn, startYIn, out, startXOut, startYOut, width, height, minThreshold, maxThreshold );
+        initializeSelected( in, Threshold2, width, height )
+            func( manager( in ), startXIn, startYIn, manager( out ), startXOut, startYOut, width, height, minThreshold, maxThreshold );
+    }
+
+    Image Threshold( const ConstImageView & in, uint8_t minThreshold, uint8_t maxThreshold )
+    {
+        return Image_Function_Helper::Threshold( Threshold, in, minThreshold, maxThreshold );
+    }
+
+    void Threshold( const ConstImageView & in, const ImageView & out, uint8_t minThreshold, uint8_t maxThreshold )
+    {
+        Image_Function_Helper::Threshold( Threshold, in, out, minThreshold, maxThreshold );
     }
 
     Image Transpose( const Image & in )
@@ -629,6 +811,6 @@ namespace penguinV
 
     void Transpose( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height )
     {
-        initialize( in, Transpose ) func( in, startXIn, startYIn, out, startXOut, startYOut, width, height );
+        initialize( in, Transpose ) func( manager( in ), startXIn, startYIn, manager( out ), startXOut, startYOut, width, height );
     }
 }
@@ -21,16 +21,47 @@
 #pragma once
 
 #include "../image_buffer.h"
+#include <memory>
 #include <vector>
 
+template <typename _Type>
+class ImageResidency;
+
 namespace penguinV
 {
+    // Keeps added images converted into image type of called functions while the scope exists in current thread. By default every function call
+    // converts images of a type without required function into another type and back. Within the scope an added image is converted only
+    // when it is used by a function of another type for the first time, and written images are converted back only once in synchronize() function
+    // or in destructor. Added images must not be modified directly or destroyed before release() function is called for them
+    class ResidencyScope
+    {
+    public:
+        ResidencyScope();
+        explicit ResidencyScope( const std::vector<Image *> & image );
+        ~ResidencyScope();
+
+        void add( Image & image );
+        void release( const Image & image ); // converts the image back if needed and stops tracking it
+        void synchronize(); // converts all modified images back
+
+        size_t conversionCount() const; // number of conversions between image types made for added images
+
+    private:
+        std::unique_ptr<ImageResidency<uint8_t>> _residency;
+        ImageResidency<uint8_t> * _previous;
+
+        ResidencyScope( const ResidencyScope & ) = delete;
+        ResidencyScope & operator=( const ResidencyScope & ) = delete;
+    };
+
     Image AbsoluteDifference( const Image & in1, const Image & in2 );
     void AbsoluteDifference( const Image & in1, const Image & in2, Image & out );
     Image AbsoluteDifference( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width,
                               uint32_t height );
     void AbsoluteDifference( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out,
                              uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height );
+    Image AbsoluteDifference( const ConstImageView & in1, const ConstImageView & in2 );
+    void AbsoluteDifference( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     void Accumulate( const Image & image, std::vector<uint32_t> & result );
     void Accumulate( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint32_t> & result );
@@ -40,18 +71,24 @@ namespace penguinV
     Image BitwiseAnd( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void BitwiseAnd( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                      uint32_t startYOut, uint32_t width, uint32_t height );
+    Image BitwiseAnd( const ConstImageView & in1, const ConstImageView & in2 );
+    void BitwiseAnd( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image BitwiseOr( const Image & in1, const Image & in2 );
     void BitwiseOr( const Image & in1, const Image & in2, Image & out );
     Image BitwiseOr( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void BitwiseOr( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                     uint32_t startYOut, uint32_t width, uint32_t height );
+    Image BitwiseOr( const ConstImageView & in1, const ConstImageView & in2 );
+    void BitwiseOr( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image BitwiseXor( const Image & in1, const Image & in2 );
     void BitwiseXor( const Image & in1, const Image & in2, Image & out );
     Image BitwiseXor( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void BitwiseXor( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                      uint32_t startYOut, uint32_t width, uint32_t height );
+    Image BitwiseXor( const ConstImageView & in1, const ConstImageView & in2 );
+    void BitwiseXor( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image ConvertToGrayScale( const Image & in );
     void ConvertToGrayScale( const Image & in, Image & out );
@@ -103,12 +140,16 @@ namespace penguinV
     void Histogram( const Image & image, std::vector<uint32_t> & histogram );
     std::vector<uint32_t> Histogram( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
     void Histogram( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, std::vector<uint32_t> & histogram );
+    std::vector<uint32_t> Histogram( const ConstImageView & image );
+    void Histogram( const ConstImageView & image, std::vector<uint32_t> & histogram );
 
     // Invert function is Bitwise NOT operation. But to make function name more user-friendly we named it like this
     Image Invert( const Image & in );
     void Invert( const Image & in, Image & out );
     Image Invert( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height );
     void Invert( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Invert( const ConstImageView & in );
+    void Invert( const ConstImageView & in, const ImageView & out );
 
     bool IsEqual( const Image & in1, const Image & in2 );
     bool IsEqual( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
@@ -124,6 +165,8 @@ namespace penguinV
     Image Maximum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void Maximum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                   uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Maximum( const ConstImageView & in1, const ConstImageView & in2 );
+    void Maximum( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image Merge( const Image & in1, const Image & in2, const Image & in3 );
     void Merge( const Image & in1, const Image & in2, const Image & in3, Image & out );
@@ -137,6 +180,8 @@ namespace penguinV
     Image Minimum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void Minimum( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                   uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Minimum( const ConstImageView & in1, const ConstImageView & in2 );
+    void Minimum( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     Image Normalize( const Image & in );
     void Normalize( const Image & in, Image & out );
@@ -172,11 +217,14 @@ namespace penguinV
     Image Subtract( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, uint32_t width, uint32_t height );
     void Subtract( const Image & in1, uint32_t startX1, uint32_t startY1, const Image & in2, uint32_t startX2, uint32_t startY2, Image & out, uint32_t startXOut,
                    uint32_t startYOut, uint32_t width, uint32_t height );
+    Image Subtract( const ConstImageView & in1, const ConstImageView & in2 );
+    void Subtract( const ConstImageView & in1, const ConstImageView & in2, const ImageView & out );
 
     // Make sure that your image is not so big to do not have overloaded uint32_t value
     // For example not bigger than [4096 * 4096] for 32-bit application
     uint32_t Sum( const Image & image );
     uint32_t Sum( const Image & image, uint32_t x, uint32_t y, uint32_t width, uint32_t height );
+    uint32_t Sum( const ConstImageView & image );
 
     // Thresholding works in such way:
     // if pixel intensity on input image is          less (  < ) than threshold then set pixel intensity on output image as 0
@@ -186,6 +234,8 @@ namespace penguinV
     Image Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height, uint8_t threshold );
     void Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                     uint8_t threshold );
+    Image Threshold( const ConstImageView & in, uint8_t threshold );
+    void Threshold( const ConstImageView & in, const ImageView & out, uint8_t threshold );
 
     // Thresholding works in such way:
     // if pixel intensity on input image is less ( < ) than minimum threshold or more ( > ) than maximum threshold
@@ -196,6 +246,8 @@ namespace penguinV
     Image Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, uint32_t width, uint32_t height, uint8_t minThreshold, uint8_t maxThreshold );
     void Threshold( const Image & in, uint32_t startXIn, uint32_t startYIn, Image & out, uint32_t startXOut, uint32_t startYOut, uint32_t width, uint32_t height,
                     uint8_t minThreshold, uint8_t maxThreshold );
+    Image Threshold( const ConstImageView & in, uint8_t minThreshold, uint8_t maxThreshold );
+    void Threshold( const ConstImageView & in, const ImageView & out, uint8_t minThreshold, uint8_t maxThreshold );
 
     // Swap columns and rows in input image. It is equivalent to 90 degree rotation
     // Output image (area) must be [height, width] compare to original [width, height]
@@ -19,23 +19,101 @@
  ***************************************************************************/
 
 #include "thread_pool.h"
+#include "memory/cpu_memory.h"
 #include "penguinv_exception.h"
 #include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#if defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+#include <immintrin.h>
+#endif
+
+#if defined( __linux__ )
+#include <sched.h>
+#include <sys/resource.h>
+#elif defined( _WIN32 )
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace
+{
+    const size_t initialQueueSize = 256u;
+
+    thread_local ThreadPool * selectedPool = nullptr;
+
+    // thread pool and ID of a calling thread if it is a worker thread
+    thread_local ThreadPool * workerPool = nullptr;
+    thread_local size_t workerId = 0u;
+
+    // Hints CPU that a thread spins in a loop waiting for other threads
+    void cpuRelax()
+    {
+#if defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+        _mm_pause();
+#elif defined( __aarch64__ ) || defined( __arm__ )
+        __asm__ __volatile__( "yield" );
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    // Returns IDs of CPU cores belonging to a NUMA node, empty list means that the information is not available
+    std::vector<uint32_t> nodeCpu( uint32_t node )
+    {
+        std::vector<uint32_t> cpu;
+#if defined( __linux__ )
+        std::ifstream file( "/sys/devices/system/node/node" + std::to_string( node ) + "/cpulist" );
+        std::string list;
+        if ( !( file >> list ) )
+            return cpu;
+
+        // the list looks like "0-3,8-11"
+        std::istringstream stream( list );
+        std::string range;
+        while ( std::getline( stream, range, ',' ) ) {
+            const size_t position = range.find( '-' );
+            const uint32_t first = static_cast<uint32_t>( std::stoul( range.substr( 0, position ) ) );
+            const uint32_t last = ( position == std::string::npos ) ? first : static_cast<uint32_t>( std::stoul( range.substr( position + 1 ) ) );
+
+            for ( uint32_t id = first; id <= last; ++id )
+                cpu.push_back( id );
+        }
+#else
+        (void)node;
+#endif
+        return cpu;
+    }
+}
 
 AbstractTaskProvider::AbstractTaskProvider()
     : _taskCount( 0 )
     , _givenTaskCount( 0 )
     , _completedTaskCount( 0 )
-    , _running( false )
+    , _descriptorCount( 0 )
+    , _queuedDescriptorCount( 0 )
+    , _running( idle_state )
+    , _completed( false )
+    , _spinCount( 0 )
     , _exceptionRaised( false )
+    , _notifyCompletion( false )
 {}
 
 AbstractTaskProvider::AbstractTaskProvider( const AbstractTaskProvider & )
     : _taskCount( 0 )
     , _givenTaskCount( 0 )
     , _completedTaskCount( 0 )
-    , _running( false )
+    , _descriptorCount( 0 )
+    , _queuedDescriptorCount( 0 )
+    , _running( idle_state )
+    , _completed( false )
+    , _spinCount( 0 )
     , _exceptionRaised( false )
+    , _notifyCompletion( false )
 {}
 
 AbstractTaskProvider::~AbstractTaskProvider()
@@ -48,28 +126,58 @@ AbstractTaskProvider & AbstractTaskProvider::operator=( const AbstractTaskProvid
     return ( *this );
 }
 
-void AbstractTaskProvider::_taskRun( bool skip )
+void AbstractTaskProvider::_taskRun( size_t chunkSize, bool skip )
 {
-    const size_t taskId = _givenTaskCount++;
+    const size_t taskCount = _taskCount;
+    const bool notifyCompletion = _notifyCompletion;
+    size_t completedTasks = 1u; // the descriptor itself is retired at the end
 
-    if ( taskId < _taskCount ) {
-        if ( !skip ) {
-            try {
-                _task( taskId );
-            }
-            catch ( ... ) {
-                // here should be some logging code stating about an exception
-                // or add your code to feedback about an exception
-                _exceptionRaised = true;
+    while ( true ) {
+        const size_t startTaskId = _givenTaskCount.fetch_add( chunkSize );
+        if ( startTaskId >= taskCount )
+            break;
+
+        const size_t endTaskId = std::min( startTaskId + chunkSize, taskCount );
+
+        if ( skip ) {
+            // results of removed tasks are not computed so a waiting thread must know about it
+            _exceptionRaised = true;
+        }
+        else {
+            for ( size_t taskId = startTaskId; taskId < endTaskId; ++taskId ) {
+                try {
+                    _task( taskId );
+                }
+                catch ( ... ) {
+                    // here should be some logging code stating about an exception
+                    // or add your code to feedback about an exception
+                    _exceptionRaised = true;
+                }
             }
         }
 
-        const size_t completedTasks = ( ++_completedTaskCount );
+        completedTasks += endTaskId - startTaskId;
+    }
+
+    // the provider must not be accessed after the last task or descriptor is completed as the provider could be destroyed
+    const size_t completionCount = taskCount + _descriptorCount;
 
-        if ( completedTasks == _taskCount ) {
+    if ( ( _completedTaskCount += completedTasks ) == completionCount ) {
+        if ( notifyCompletion ) {
+            const bool noException = !_exceptionRaised;
+            _exceptionRaised = false;
+            _running = idle_state;
+
+            _onCompletion( noException );
+            return;
+        }
+
+        // a spinning thread in _wait() could destroy the provider right after the state is changed.
+        // A sleeping thread does not leave _wait() until it is notified under the mutex
+        if ( _running.exchange( idle_state ) == parked_state ) {
             _completion.lock();
 
-            _running = false;
+            _completed = true;
             _waiting.notify_one();
 
             _completion.unlock();
@@ -79,8 +187,25 @@ void AbstractTaskProvider::_taskRun( bool skip )
 
 bool AbstractTaskProvider::_wait()
 {
-    std::unique_lock<std::mutex> _mutexLock( _completion );
-    _waiting.wait( _mutexLock, [&] { return !_running; } );
+    if ( workerPool != nullptr ) {
+        while ( _running != idle_state ) {
+            if ( !workerPool->_runTask( workerId ) )
+                std::this_thread::yield();
+        }
+    }
+
+    for ( uint32_t i = 0; ( i < _spinCount ) && ( _running != idle_state ); ++i )
+        cpuRelax();
+
+    if ( _running != idle_state ) {
+        std::unique_lock<std::mutex> _mutexLock( _completion );
+
+        int state = running_state;
+        if ( _running.compare_exchange_strong( state, parked_state ) ) {
+            _waiting.wait( _mutexLock, [&] { return _completed; } );
+            _completed = false;
+        }
+    }
 
     const bool noException = !_exceptionRaised;
     _exceptionRaised = false;
@@ -90,7 +215,7 @@ bool AbstractTaskProvider::_wait()
 
 bool AbstractTaskProvider::_ready() const
 {
-    return !_running;
+    return _running == idle_state;
 }
 
 TaskProvider::TaskProvider()
@@ -141,10 +266,178 @@ bool TaskProvider::_ready() const
     return AbstractTaskProvider::_ready() && _threadPool != nullptr;
 }
 
+ThreadPoolConfiguration::ThreadPoolConfiguration()
+    : pinThreads( false )
+    , groupByNode( false )
+    , priority( default_priority )
+    , spinCount( ( std::thread::hardware_concurrency() > 1u ) ? 1024u : 0u ) // spinning on a single core only delays a thread which does the work
+{}
+
+TaskQueue::Buffer::Buffer( size_t size )
+    : mask( size - 1u )
+    , data( new std::atomic<AbstractTaskProvider *>[size] )
+{}
+
+TaskQueue::TaskQueue()
+    : _top( 0 )
+    , _bottom( 0 )
+    , _buffer( nullptr )
+    , _inboxSize( 0 )
+{
+    _oldBuffer.emplace_back( new Buffer( initialQueueSize ) );
+    _buffer = _oldBuffer.back().get();
+}
+
+void TaskQueue::push( AbstractTaskProvider * task )
+{
+    const int64_t bottom = _bottom.load( std::memory_order_relaxed );
+    const int64_t top = _top.load( std::memory_order_acquire );
+    Buffer * buffer = _buffer.load( std::memory_order_relaxed );
+
+    if ( static_cast<size_t>( bottom - top ) > buffer->mask ) {
+        Buffer * grown = new Buffer( ( buffer->mask + 1u ) * 2u );
+        for ( int64_t i = top; i != bottom; ++i )
+            grown->data[static_cast<size_t>( i ) & grown->mask].store( buffer->data[static_cast<size_t>( i ) & buffer->mask].load( std::memory_order_relaxed ),
+                                                                       std::memory_order_relaxed );
+
+        _oldBuffer.emplace_back( grown );
+        _buffer.store( grown, std::memory_order_release );
+        buffer = grown;
+    }
+
+    buffer->data[static_cast<size_t>( bottom ) & buffer->mask].store( task, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+    _bottom.store( bottom + 1, std::memory_order_relaxed );
+}
+
+AbstractTaskProvider * TaskQueue::pop()
+{
+    const int64_t bottom = _bottom.load( std::memory_order_relaxed ) - 1;
+    Buffer * buffer = _buffer.load( std::memory_order_relaxed );
+    _bottom.store( bottom, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    int64_t top = _top.load( std::memory_order_relaxed );
+
+    AbstractTaskProvider * task = nullptr;
+
+    if ( top <= bottom ) {
+        task = buffer->data[static_cast<size_t>( bottom ) & buffer->mask].load( std::memory_order_relaxed );
+
+        if ( top == bottom ) {
+            // the last task in the queue: compete with thieves
+            if ( !_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+                task = nullptr;
+
+            _bottom.store( bottom + 1, std::memory_order_relaxed );
+        }
+    }
+    else {
+        _bottom.store( bottom + 1, std::memory_order_relaxed );
+    }
+
+    return task;
+}
+
+AbstractTaskProvider * TaskQueue::steal()
+{
+    int64_t top = _top.load( std::memory_order_acquire );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    const int64_t bottom = _bottom.load( std::memory_order_acquire );
+
+    if ( top >= bottom )
+        return nullptr;
+
+    Buffer * buffer = _buffer.load( std::memory_order_acquire );
+    AbstractTaskProvider * task = buffer->data[static_cast<size_t>( top ) & buffer->mask].load( std::memory_order_relaxed );
+
+    if ( !_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+        return nullptr;
+
+    return task;
+}
+
+bool TaskQueue::empty() const
+{
+    return _top.load( std::memory_order_acquire ) >= _bottom.load( std::memory_order_acquire ) && _inboxSize == 0u;
+}
+
+void TaskQueue::post( AbstractTaskProvider * task )
+{
+    std::lock_guard<std::mutex> lock( _inboxLock );
+
+    _inbox.push_back( task );
+    _inboxSize = _inbox.size();
+}
+
+size_t TaskQueue::receive()
+{
+    if ( _inboxSize == 0u )
+        return 0u;
+
+    // inbox keeps its capacity so posting of descriptors does not allocate memory in a steady state
+    std::lock_guard<std::mutex> lock( _inboxLock );
+
+    const size_t taskCount = _inbox.size();
+
+    for ( std::vector<AbstractTaskProvider *>::const_iterator task = _inbox.cbegin(); task != _inbox.cend(); ++task )
+        push( *task );
+
+    _inbox.clear();
+    _inboxSize = 0u;
+
+    return taskCount;
+}
+
+AbstractTaskProvider * TaskQueue::take()
+{
+    if ( _inboxSize == 0u )
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock( _inboxLock );
+
+    if ( _inbox.empty() )
+        return nullptr;
+
+    AbstractTaskProvider * task = _inbox.back();
+    _inbox.pop_back();
+    _inboxSize = _inbox.size();
+
+    return task;
+}
+
+std::vector<AbstractTaskProvider *> TaskQueue::takeAll()
+{
+    std::vector<AbstractTaskProvider *> inbox;
+
+    std::lock_guard<std::mutex> lock( _inboxLock );
+    inbox.swap( _inbox );
+    _inboxSize = 0u;
+
+    return inbox;
+}
+
 ThreadPool::ThreadPool( size_t threads )
-    : _runningThreadCount( 0 )
+    : _exit( false )
+    , _runningThreadCount( 0 )
+    , _threadCount( 0 )
+    , _threadsCreated( false )
+    , _descriptorCount( 0 )
+    , _sleepingThreadCount( 0 )
+    , _nextQueueId( 0 )
+{
+    if ( threads > 0 )
+        resize( threads );
+}
+
+ThreadPool::ThreadPool( size_t threads, const ThreadPoolConfiguration & configuration )
+    : _exit( false )
+    , _runningThreadCount( 0 )
     , _threadCount( 0 )
     , _threadsCreated( false )
+    , _configuration( configuration )
+    , _descriptorCount( 0 )
+    , _sleepingThreadCount( 0 )
+    , _nextQueueId( 0 )
 {
     if ( threads > 0 )
         resize( threads );
@@ -160,47 +453,58 @@ void ThreadPool::resize( size_t threads )
     if ( threads == 0 )
         throw penguinVException( "Try to set zero threads in thread pool" );
 
-    if ( threads > threadCount() ) {
-        _taskInfo.lock();
-        _run.resize( threads, 1 );
-        _exit.resize( threads, 0 );
-        _taskInfo.unlock();
+    if ( threads == threadCount() )
+        return;
+
+    // threads are restarted with new queues, tasks which are not done yet are spread over new queues
+    _stopThreads();
+    _startThreads( threads );
+}
+
+size_t ThreadPool::threadCount() const
+{
+    return _worker.size();
+}
 
-        _threadCount = threads;
+void ThreadPool::setConfiguration( const ThreadPoolConfiguration & configuration )
+{
+    const size_t threads = threadCount();
 
-        while ( threads > threadCount() )
-            _worker.push_back( std::thread( ThreadPool::_workerThread, this, threadCount() ) );
+    _stopThreads();
 
-        std::unique_lock<std::mutex> _mutexLock( _creation );
-        _completeCreation.wait( _mutexLock, [&] { return _threadsCreated; } );
-    }
-    else if ( threads < threadCount() ) {
-        _taskInfo.lock();
+    _configuration = configuration;
 
-        std::fill( _exit.begin() + static_cast<std::vector<uint8_t>::difference_type>( threads ), _exit.end(), 1 );
-        std::fill( _run.begin() + static_cast<std::vector<uint8_t>::difference_type>( threads ), _run.end(), 1 );
-        _waiting.notify_all();
+    if ( threads > 0 )
+        _startThreads( threads );
+}
 
-        _taskInfo.unlock();
+const ThreadPoolConfiguration & ThreadPool::configuration() const
+{
+    return _configuration;
+}
 
-        while ( threads < threadCount() ) {
-            _worker.back().join();
+void ThreadPool::_startThreads( size_t threads )
+{
+    std::lock_guard<std::mutex> lock( _taskInfo );
 
-            _worker.pop_back();
+    const std::vector<AbstractTaskProvider *> task = _takeAllTasks();
 
-            _taskInfo.lock();
+    _queue.clear();
+    for ( size_t i = 0; i < threads; ++i )
+        _queue.emplace_back( new TaskQueue );
 
-            _exit.pop_back();
-            _run.pop_back();
+    for ( size_t i = 0; i < task.size(); ++i )
+        _queue[i % threads]->post( task[i] );
 
-            _taskInfo.unlock();
-        }
-    }
-}
+    _runningThreadCount = 0;
+    _threadsCreated = false;
+    _threadCount = threads;
 
-size_t ThreadPool::threadCount() const
-{
-    return _worker.size();
+    for ( size_t i = 0; i < threads; ++i )
+        _worker.push_back( std::thread( ThreadPool::_workerThread, this, i ) );
+
+    std::unique_lock<std::mutex> _mutexLock( _creation );
+    _completeCreation.wait( _mutexLock, [&] { return _threadsCreated; } );
 }
 
 void ThreadPool::add( AbstractTaskProvider * provider, size_t taskCount )
@@ -211,72 +515,268 @@ void ThreadPool::add( AbstractTaskProvider * provider, size_t taskCount )
     if ( threadCount() == 0 )
         throw penguinVException( "No threads in thread pool" );
 
-    provider->_completion.lock();
-    provider->_running = true;
-    provider->_completion.unlock();
+    provider->_running = AbstractTaskProvider::running_state;
+    provider->_spinCount = _configuration.spinCount;
 
-    _taskInfo.lock();
+    std::lock_guard<std::mutex> lock( _taskInfo );
 
-    _task.insert( _task.end(), taskCount, provider );
+    // one descriptor per queue is enough for all workers to start from their own queues without stealing
+    const size_t queueCount = _queue.size();
+    const size_t descriptorCount = std::min( taskCount, queueCount );
 
-    std::fill( _run.begin(), _run.end(), 1 );
-    _waiting.notify_all();
+    provider->_descriptorCount = descriptorCount;
+    provider->_queuedDescriptorCount += descriptorCount;
 
-    _taskInfo.unlock();
-}
+    for ( size_t i = 0; i < descriptorCount; ++i )
+        _queue[( _nextQueueId + i ) % queueCount]->post( provider );
 
-bool ThreadPool::empty()
-{
-    _taskInfo.lock();
+    _nextQueueId = ( _nextQueueId + descriptorCount ) % queueCount;
 
-    const bool emp = _task.empty();
+    _descriptorCount += descriptorCount;
 
-    _taskInfo.unlock();
+    if ( _sleepingThreadCount > 0u )
+        _waiting.notify_all();
+}
 
-    return emp;
+bool ThreadPool::empty()
+{
+    return _descriptorCount == 0u;
 }
 
 void ThreadPool::remove( AbstractTaskProvider * provider )
 {
-    _taskInfo.lock();
+    // a provider which waited for completion of its tasks has no descriptors in queues so it does not lock the pool
+    if ( provider->_queuedDescriptorCount == 0u )
+        return;
 
-    _task.remove( provider );
+    size_t removedCount = 0u;
 
-    _taskInfo.unlock();
+    {
+        std::lock_guard<std::mutex> lock( _taskInfo );
+
+        for ( std::vector<std::unique_ptr<TaskQueue>>::iterator queue = _queue.begin(); queue != _queue.end(); ++queue ) {
+            std::vector<AbstractTaskProvider *> task = ( *queue )->takeAll();
+
+            while ( !( *queue )->empty() ) {
+                AbstractTaskProvider * stolen = ( *queue )->steal();
+                if ( stolen != nullptr )
+                    task.push_back( stolen );
+            }
+
+            for ( std::vector<AbstractTaskProvider *>::const_iterator t = task.cbegin(); t != task.cend(); ++t ) {
+                if ( *t == provider ) {
+                    --_descriptorCount;
+                    --provider->_queuedDescriptorCount;
+                    ++removedCount;
+                }
+                else {
+                    ( *queue )->post( *t );
+                }
+            }
+        }
+    }
+
+    // remaining tasks are completed without real computations to release a provider waiting for completion.
+    // It is done without the lock as completion could destroy the provider which calls remove() again
+    for ( size_t i = 0; i < removedCount; ++i )
+        provider->_taskRun( _chunkSize( provider ), true );
 }
 
 void ThreadPool::clear()
 {
-    _taskInfo.lock();
-    // complete all tasks without real computations. It helps to avoid a deadlock in a case when thread pool is destroyed
-    std::for_each( _task.begin(), _task.end(), []( AbstractTaskProvider * task ) { task->_task( true ); } );
-    _task.clear();
+    std::vector<AbstractTaskProvider *> removed;
 
-    _taskInfo.unlock();
+    {
+        std::lock_guard<std::mutex> lock( _taskInfo );
+
+        for ( std::vector<std::unique_ptr<TaskQueue>>::iterator queue = _queue.begin(); queue != _queue.end(); ++queue ) {
+            const std::vector<AbstractTaskProvider *> task = ( *queue )->takeAll();
+            removed.insert( removed.end(), task.begin(), task.end() );
+
+            while ( !( *queue )->empty() ) {
+                AbstractTaskProvider * stolen = ( *queue )->steal();
+                if ( stolen != nullptr )
+                    removed.push_back( stolen );
+            }
+        }
+
+        for ( std::vector<AbstractTaskProvider *>::const_iterator t = removed.cbegin(); t != removed.cend(); ++t ) {
+            --_descriptorCount;
+            --( *t )->_queuedDescriptorCount;
+        }
+    }
+
+    // complete all tasks without real computations. It helps to avoid a deadlock in a case when thread pool is destroyed.
+    // It is done without the lock as completion could destroy a provider which calls remove() function
+    for ( std::vector<AbstractTaskProvider *>::const_iterator t = removed.cbegin(); t != removed.cend(); ++t )
+        ( *t )->_taskRun( _chunkSize( *t ), true );
 }
 
 void ThreadPool::stop()
 {
     clear();
 
-    if ( !_worker.empty() ) {
-        _taskInfo.lock();
+    _stopThreads();
+}
 
-        std::fill( _exit.begin(), _exit.end(), 1 );
-        std::fill( _run.begin(), _run.end(), 1 );
-        _waiting.notify_all();
+AbstractTaskProvider * ThreadPool::_getTask( size_t threadId )
+{
+    TaskQueue & queue = *_queue[threadId];
+
+    AbstractTaskProvider * task = queue.pop();
+
+    if ( task == nullptr && queue.receive() > 0u )
+        task = queue.pop();
+
+    // steal from other workers starting from the neighbour to spread thieves over queues
+    const size_t queueCount = _queue.size();
+
+    for ( size_t i = 1; ( task == nullptr ) && ( i < queueCount ); ++i )
+        task = _queue[( threadId + i ) % queueCount]->steal();
+
+    for ( size_t i = 1; ( task == nullptr ) && ( i < queueCount ); ++i )
+        task = _queue[( threadId + i ) % queueCount]->take();
+
+    if ( task != nullptr ) {
+        --_descriptorCount;
+        --task->_queuedDescriptorCount;
+    }
+
+    return task;
+}
+
+bool ThreadPool::_runTask( size_t threadId )
+{
+    AbstractTaskProvider * task = _getTask( threadId );
+    if ( task == nullptr )
+        return false;
+
+    task->_taskRun( _chunkSize( task ), false );
+    return true;
+}
+
+size_t ThreadPool::_chunkSize( const AbstractTaskProvider * provider ) const
+{
+    // a few chunks per thread keep load balanced while threads rarely compete for the same counter
+    return std::max<size_t>( provider->_taskCount / ( 4u * _queue.size() ), 1u );
+}
+
+void ThreadPool::_stopThreads()
+{
+    if ( _worker.empty() )
+        return;
+
+    _taskInfo.lock();
+    _exit = true;
+    _waiting.notify_all();
+    _taskInfo.unlock();
+
+    for ( std::vector<std::thread>::iterator thread = _worker.begin(); thread != _worker.end(); ++thread )
+        thread->join();
 
-        _taskInfo.unlock();
+    _worker.clear();
+    _exit = false;
+}
+
+std::vector<uint32_t> ThreadPool::_threadCpu( size_t threadId ) const
+{
+    std::vector<uint32_t> cpu = _configuration.cpu;
+    size_t groupThreadId = threadId; // ID of thread within a group of threads running on the same cores
+
+    if ( _configuration.groupByNode ) {
+        // neighbour threads are placed on the same node so they steal tasks from each other first
+        const size_t nodeCount = cpu_Memory::nodeCount();
+        const size_t node = threadId * nodeCount / _threadCount;
+        groupThreadId = threadId - ( node * _threadCount + nodeCount - 1u ) / nodeCount;
+
+        const std::vector<uint32_t> nodeCores = nodeCpu( static_cast<uint32_t>( node ) );
+        std::vector<uint32_t> allowedCores;
+
+        if ( cpu.empty() ) {
+            allowedCores = nodeCores;
+        }
+        else {
+            for ( std::vector<uint32_t>::const_iterator id = cpu.cbegin(); id != cpu.cend(); ++id ) {
+                if ( std::find( nodeCores.cbegin(), nodeCores.cend(), *id ) != nodeCores.cend() )
+                    allowedCores.push_back( *id );
+            }
+        }
+
+        if ( !allowedCores.empty() )
+            cpu = allowedCores;
+    }
+
+    if ( _configuration.pinThreads ) {
+        if ( cpu.empty() ) {
+            const uint32_t coreCount = std::max( std::thread::hardware_concurrency(), 1u );
+            return std::vector<uint32_t>( 1u, static_cast<uint32_t>( groupThreadId % coreCount ) );
+        }
+
+        return std::vector<uint32_t>( 1u, cpu[groupThreadId % cpu.size()] );
+    }
+
+    return cpu;
+}
+
+void ThreadPool::_configureThread( size_t threadId ) const
+{
+    // failures are ignored as threads are still able to run tasks without requested scheduling
+    const std::vector<uint32_t> cpu = _threadCpu( threadId );
+
+#if defined( __linux__ )
+    if ( !cpu.empty() ) {
+        cpu_set_t cpuSet;
+        CPU_ZERO( &cpuSet );
+
+        for ( std::vector<uint32_t>::const_iterator id = cpu.cbegin(); id != cpu.cend(); ++id ) {
+            if ( *id < CPU_SETSIZE )
+                CPU_SET( *id, &cpuSet );
+        }
+
+        sched_setaffinity( 0, sizeof( cpuSet ), &cpuSet );
+    }
+
+    // niceness on Linux is set per thread
+    if ( _configuration.priority == low_priority )
+        setpriority( PRIO_PROCESS, 0, 10 );
+    else if ( _configuration.priority == high_priority )
+        setpriority( PRIO_PROCESS, 0, -10 );
+#elif defined( _WIN32 )
+    DWORD_PTR mask = 0;
+    for ( std::vector<uint32_t>::const_iterator id = cpu.cbegin(); id != cpu.cend(); ++id ) {
+        if ( *id < sizeof( DWORD_PTR ) * 8u )
+            mask |= static_cast<DWORD_PTR>( 1u ) << *id;
+    }
+
+    if ( mask != 0 )
+        SetThreadAffinityMask( GetCurrentThread(), mask );
 
-        for ( std::vector<std::thread>::iterator thread = _worker.begin(); thread != _worker.end(); ++thread )
-            thread->join();
+    if ( _configuration.priority == low_priority )
+        SetThreadPriority( GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL );
+    else if ( _configuration.priority == high_priority )
+        SetThreadPriority( GetCurrentThread(), THREAD_PRIORITY_ABOVE_NORMAL );
+#endif
+}
+
+std::vector<AbstractTaskProvider *> ThreadPool::_takeAllTasks()
+{
+    std::vector<AbstractTaskProvider *> task;
+
+    for ( std::vector<std::unique_ptr<TaskQueue>>::iterator queue = _queue.begin(); queue != _queue.end(); ++queue ) {
+        const std::vector<AbstractTaskProvider *> inbox = ( *queue )->takeAll();
+        task.insert( task.end(), inbox.begin(), inbox.end() );
 
-        _worker.clear();
+        for ( AbstractTaskProvider * t = ( *queue )->pop(); t != nullptr; t = ( *queue )->pop() )
+            task.push_back( t );
     }
+
+    return task;
 }
 
 void ThreadPool::_workerThread( ThreadPool * pool, size_t threadId )
 {
+    pool->_configureThread( threadId );
+
     if ( ++( pool->_runningThreadCount ) == pool->_threadCount ) {
         pool->_creation.lock();
         pool->_threadsCreated = true;
@@ -284,29 +784,32 @@ void ThreadPool::_workerThread( ThreadPool * pool, size_t threadId )
         pool->_creation.unlock();
     }
 
-    while ( !pool->_exit[threadId] ) {
-        std::unique_lock<std::mutex> _mutexLock( pool->_taskInfo );
-        pool->_waiting.wait( _mutexLock, [&] { return pool->_run[threadId]; } );
-        _mutexLock.unlock();
-
-        if ( pool->_exit[threadId] )
-            break;
-
-        pool->_taskInfo.lock();
-
-        if ( !pool->_task.empty() ) {
-            AbstractTaskProvider * task = pool->_task.front();
-
-            pool->_task.pop_front();
+    workerPool = pool;
+    workerId = threadId;
 
-            pool->_taskInfo.unlock();
-
-            task->_taskRun( false );
+    while ( !pool->_exit ) {
+        if ( pool->_runTask( threadId ) ) {
+            continue;
+        }
+        else if ( pool->_descriptorCount > 0u ) {
+            // remaining descriptors are being moved between queues by other threads
+            std::this_thread::yield();
         }
         else {
-            pool->_run[threadId] = 0;
+            // new tasks usually come soon after previous ones so a thread spins for a while before sleeping
+            bool taskFound = false;
+            for ( uint32_t i = 0; ( i < pool->_configuration.spinCount ) && !taskFound && !pool->_exit; ++i ) {
+                cpuRelax();
+                taskFound = ( pool->_descriptorCount > 0u );
+            }
 
-            pool->_taskInfo.unlock();
+            if ( !taskFound ) {
+                std::unique_lock<std::mutex> _mutexLock( pool->_taskInfo );
+
+                ++pool->_sleepingThreadCount;
+                pool->_waiting.wait( _mutexLock, [&] { return pool->_exit || pool->_descriptorCount > 0u; } );
+                --pool->_sleepingThreadCount;
+            }
         }
     }
 
@@ -315,20 +818,38 @@ void ThreadPool::_workerThread( ThreadPool * pool, size_t threadId )
 
 ThreadPool & ThreadPoolMonoid::instance()
 {
+    if ( selectedPool != nullptr )
+        return *selectedPool;
+
     static ThreadPoolMonoid provider; // one and only monoid object
 
     return provider._pool;
 }
 
-TaskProviderSingleton::TaskProviderSingleton() {}
+ThreadPoolSelection::ThreadPoolSelection( ThreadPool & pool )
+    : _previousPool( selectedPool )
+{
+    selectedPool = &pool;
+}
+
+ThreadPoolSelection::~ThreadPoolSelection()
+{
+    selectedPool = _previousPool;
+}
+
+TaskProviderSingleton::TaskProviderSingleton()
+    : _threadPool( nullptr )
+{}
 
 TaskProviderSingleton::TaskProviderSingleton( const TaskProviderSingleton & provider )
     : AbstractTaskProvider( provider )
+    , _threadPool( nullptr )
 {}
 
 TaskProviderSingleton::~TaskProviderSingleton()
 {
-    ThreadPoolMonoid::instance().remove( this );
+    if ( _threadPool != nullptr )
+        _threadPool->remove( this );
 }
 
 TaskProviderSingleton & TaskProviderSingleton::operator=( const TaskProviderSingleton & )
@@ -343,6 +864,7 @@ void TaskProviderSingleton::_run( size_t taskCount )
         _givenTaskCount = 0;
         _completedTaskCount = 0;
 
-        ThreadPoolMonoid::instance().add( this, _taskCount );
+        _threadPool = &ThreadPoolMonoid::instance();
+        _threadPool->add( this, _taskCount );
     }
 }
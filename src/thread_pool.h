@@ -23,7 +23,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
-#include <list>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -47,22 +47,46 @@ public:
 protected:
     virtual void _task( size_t ) = 0; // this function must be overrided in child class and should contain a code specific to task ID
                                       // parameter in the function is task ID. This function must be called by thread pool
-    bool _wait(); // waits for all task execution completions. Returns true in case of success, false when an exception is raised
+    bool _wait(); // waits for all task execution completions. Returns true in case of success, false when an exception is raised or tasks are removed
+                  // a calling thread spins for a short time before sleeping as small tasks are usually completed quickly.
+                  // A worker thread of thread pool does not sleep but runs other tasks of its pool as all workers could wait for each other
+
+    // function is called instead of waking up _wait() function by a thread which completed all tasks when _notifyCompletion is set.
+    // Nobody waits for such provider so it could be destroyed inside of the function
+    virtual void _onCompletion( bool ) {} // parameter is true in case of success, false when an exception is raised or tasks are removed
 
     bool _ready() const; // this function tells whether class is able to use thread pool
 private:
     std::atomic<size_t> _taskCount; // number of tasks to do
-    std::atomic<size_t> _givenTaskCount; // number of tasks which were given to thread pool
-    std::atomic<size_t> _completedTaskCount; // number of completed tasks
+    std::atomic<size_t> _givenTaskCount; // ID of next task to be claimed by a thread. Threads claim tasks in chunks by incrementing it
+    std::atomic<size_t> _completedTaskCount; // number of completed tasks plus number of retired task descriptors
+    size_t _descriptorCount; // number of task descriptors given to thread pool, every descriptor points to the same range of tasks
+    std::atomic<size_t> _queuedDescriptorCount; // number of task descriptors which are still in queues of thread pool and not taken by any thread
+
+    enum RunState
+    {
+        idle_state, // no tasks are being processed
+        running_state, // tasks are being processed
+        parked_state // tasks are being processed and a thread sleeps in _wait() function
+    };
 
-    bool _running; // boolean variable specifies the state of tasks processing
+    std::atomic<int> _running; // state of tasks processing, one of RunState values
     std::mutex _completion; // mutex for synchronization reporting about completion of all tasks
                             // this mutex is waited in _wait() function
     std::condition_variable _waiting; // condition variable for verification that all tasks are really completed
+    bool _completed; // tells a sleeping thread in _wait() function that all tasks are completed, protected by _completion mutex
+    uint32_t _spinCount; // number of checks of completion in _wait() function before sleeping, it is taken from thread pool
 
     bool _exceptionRaised; // notifies whether an exception raised during task execution
 
-    void _taskRun( bool skip ); // function is called only by thread pool to call _task() function and increment counters
+protected:
+    bool _notifyCompletion; // completion of all tasks is reported by _onCompletion() function, it must be set before running tasks
+
+private:
+
+    // function is called only by thread pool for a task descriptor: it claims chunks of tasks until all tasks are claimed,
+    // calls _task() function for them (or skips them) and retires the descriptor. The provider must not be used by the caller afterwards
+    void _taskRun( size_t chunkSize, bool skip );
 };
 
 // Concrete class of task provider for case when thread pool is not a singleton
@@ -87,10 +111,76 @@ private:
     ThreadPool * _threadPool; // a pointer to a thread pool
 };
 
+// Double-ended queue of task descriptors owned by one worker thread of thread pool. The owner pushes and pops tasks from the bottom of the queue
+// without locks while other threads steal tasks from the top (Chase-Lev algorithm). Tasks from other threads are put into a small
+// inbox which the owner moves into the queue
+class TaskQueue
+{
+public:
+    TaskQueue();
+    TaskQueue & operator=( const TaskQueue & ) = delete;
+    TaskQueue( const TaskQueue & ) = delete;
+
+    void push( AbstractTaskProvider * task ); // must be called only by the owner
+    AbstractTaskProvider * pop(); // must be called only by the owner, returns nullptr if the queue is empty
+    AbstractTaskProvider * steal(); // could be called by any thread, returns nullptr if the queue is empty or another thread won the race
+    bool empty() const;
+
+    void post( AbstractTaskProvider * task ); // put a task descriptor into inbox, could be called by any thread
+    size_t receive(); // move all tasks from inbox into the queue, must be called only by the owner. Returns the number of moved tasks
+    AbstractTaskProvider * take(); // take one task descriptor from inbox, could be called by any thread
+    std::vector<AbstractTaskProvider *> takeAll(); // take all tasks from inbox
+
+private:
+    struct Buffer
+    {
+        explicit Buffer( size_t size );
+
+        size_t mask; // size of buffer minus 1, size is a power of 2
+        std::unique_ptr<std::atomic<AbstractTaskProvider *>[]> data;
+    };
+
+    std::atomic<int64_t> _top;
+    std::atomic<int64_t> _bottom;
+    std::atomic<Buffer *> _buffer;
+    std::vector<std::unique_ptr<Buffer>> _oldBuffer; // grown buffers are kept as thieves could still read them
+
+    std::mutex _inboxLock;
+    std::vector<AbstractTaskProvider *> _inbox;
+    std::atomic<size_t> _inboxSize;
+};
+
+// Priority of worker threads of thread pool. Priorities are applied on best effort basis: higher priority could require
+// special privileges (CAP_SYS_NICE on Linux) and it is silently ignored if the system refuses it
+enum ThreadPriority
+{
+    default_priority, // priority of threads is not changed
+    low_priority, // background processing which must not disturb other threads
+    high_priority // latency critical processing
+};
+
+// Configuration of worker threads of thread pool. Default configuration does not change scheduling of threads
+struct ThreadPoolConfiguration
+{
+    ThreadPoolConfiguration();
+
+    std::vector<uint32_t> cpu; // IDs of CPU cores on which worker threads are allowed to run, empty list means all cores
+    bool pinThreads; // every worker thread runs only on one core from the list of allowed cores, cores are given to threads in order
+    bool groupByNode; // worker threads are split into groups per NUMA node, every group runs only on cores of its node
+    ThreadPriority priority;
+    uint32_t spinCount; // number of checks with CPU pause which idle worker threads and threads waiting for tasks make before sleeping.
+                        // Spinning saves context switches for small tasks. By default it is 0 on single core systems
+};
+
+// Thread pool with work stealing: every worker thread has its own task queue. A worker runs tasks from its queue and when
+// it is empty the worker steals tasks from queues of other workers so no common lock is taken per task.
+// Tasks of a provider are not queued one by one: up to one descriptor per worker is queued and workers holding descriptors
+// claim tasks from the provider in chunks so adding of any number of tasks takes constant time and no memory allocation
 class ThreadPool
 {
 public:
     explicit ThreadPool( size_t threads = 0u );
+    ThreadPool( size_t threads, const ThreadPoolConfiguration & configuration );
     ThreadPool & operator=( const ThreadPool & ) = delete;
     ThreadPool( const ThreadPool & ) = delete;
     ~ThreadPool();
@@ -98,16 +188,20 @@ public:
     void resize( size_t threads );
     size_t threadCount() const;
 
+    // worker threads are restarted with new configuration, queued tasks are kept
+    void setConfiguration( const ThreadPoolConfiguration & configuration );
+    const ThreadPoolConfiguration & configuration() const;
+
     void add( AbstractTaskProvider * provider, size_t taskCount ); // add tasks for specific provider
-    void remove( AbstractTaskProvider * provider ); // remove all tasks related to specific provider
+    void remove( AbstractTaskProvider * provider ); // remove all tasks related to specific provider. Queues are searched only if the provider has queued tasks
     bool empty(); // tells whether thread pool contains any tasks
     void clear(); // remove all tasks from thread pool
 
     void stop(); // stop all working threads
 private:
     std::vector<std::thread> _worker; // an array of worker threads
-    std::vector<uint8_t> _run; // indicator for threads to run tasks
-    std::vector<uint8_t> _exit; // indicator for threads to close themselfs
+    std::vector<std::unique_ptr<TaskQueue>> _queue; // task queue per worker thread
+    std::atomic<bool> _exit; // indicator for threads to close themselfs
     std::condition_variable _waiting; // condition variable for synchronization of threads
 
     std::mutex _creation; // mutex for thread creation verification
@@ -115,19 +209,34 @@ private:
     std::condition_variable _completeCreation; // condition variable for verification that all threads are created
     std::size_t _threadCount; // current number of threads in pool
     bool _threadsCreated; // indicator for pool that all threads are created
+    ThreadPoolConfiguration _configuration;
+
+    std::atomic<size_t> _descriptorCount; // number of task descriptors in all queues
+    size_t _sleepingThreadCount; // number of worker threads waiting for new tasks on condition variable, protected by _taskInfo mutex
+    size_t _nextQueueId; // queue which receives the first descriptor of next added tasks
+    std::mutex _taskInfo; // mutex for synchronization between pool functions and for sleeping of idle threads
+
+    friend class AbstractTaskProvider;
 
-    std::list<AbstractTaskProvider *> _task; // a list of tasks to perform
-    std::mutex _taskInfo; // mutex for synchronization between threads and pool to manage tasks
+    AbstractTaskProvider * _getTask( size_t threadId );
+    bool _runTask( size_t threadId ); // runs tasks of one descriptor if any. Returns false when no task is found
+    size_t _chunkSize( const AbstractTaskProvider * provider ) const; // number of tasks claimed by a thread at once
+    void _startThreads( size_t threads ); // all tasks are moved into new queues
+    void _stopThreads();
+    std::vector<uint32_t> _threadCpu( size_t threadId ) const; // cores on which a worker thread could run, empty list means all cores
+    void _configureThread( size_t threadId ) const; // must be called by the worker thread
+    std::vector<AbstractTaskProvider *> _takeAllTasks(); // must be called when no other thread takes tasks from queues
 
     static void _workerThread( ThreadPool * pool, size_t threadId );
 };
 
 // Thread pool singleton (or monoid class) for whole application
-// In most situations thread pool must be one
+// In most situations thread pool must be one. Other pools (for example, with different priority) could be selected
+// for a calling thread by ThreadPoolSelection so TaskProviderSingleton based code like Function_Pool runs on them
 class ThreadPoolMonoid
 {
 public:
-    static ThreadPool & instance(); // function returns a reference to global (static) thread pool
+    static ThreadPool & instance(); // function returns a reference to thread pool selected for calling thread or to global (static) thread pool
 
     ThreadPoolMonoid & operator=( const ThreadPoolMonoid & ) = delete;
     ThreadPoolMonoid( const ThreadPoolMonoid & ) = delete;
@@ -139,6 +248,19 @@ private:
     ThreadPool _pool; // one and only thread pool
 };
 
+// Selects a thread pool returned by ThreadPoolMonoid::instance() in calling thread while the object exists
+class ThreadPoolSelection
+{
+public:
+    explicit ThreadPoolSelection( ThreadPool & pool );
+    ThreadPoolSelection & operator=( const ThreadPoolSelection & ) = delete;
+    ThreadPoolSelection( const ThreadPoolSelection & ) = delete;
+    ~ThreadPoolSelection();
+
+private:
+    ThreadPool * _previousPool; // selection is restored on destruction
+};
+
 // Concrete class of task provider with thread pool singleton
 class TaskProviderSingleton : public AbstractTaskProvider
 {
@@ -151,4 +273,7 @@ public:
 
 protected:
     void _run( size_t taskCount );
+
+private:
+    ThreadPool * _threadPool; // thread pool which was selected on last run
 };
@@ -20,6 +20,8 @@
 
 #include "performance_test_filtering.h"
 #include "../../src/filtering.h"
+#include "../../src/function_pool.h"
+#include "../../src/thread_pool.h"
 #include "performance_test_framework.h"
 #include "performance_test_helper.h"
 
@@ -42,6 +44,16 @@ namespace
         Image_Function::Sobel( input, output );
     }
 
+    void FunctionPoolMedianFilter3x3( const penguinV::Image & input, penguinV::Image & output )
+    {
+        Function_Pool::Median( input, output, 3 );
+    }
+
+    void FunctionPoolSobelFilter( const penguinV::Image & input, penguinV::Image & output )
+    {
+        Function_Pool::Sobel( input, output );
+    }
+
     std::pair<double, double> FilterFunctionTest( filterFunction Filter, uint32_t size )
     {
         Performance_Test::TimerContainer timer;
@@ -59,6 +71,13 @@ namespace
 
         return timer.mean();
     }
+
+    std::pair<double, double> FunctionPoolFilterTest( filterFunction Filter, uint32_t size, uint32_t threadCount )
+    {
+        ThreadPoolMonoid::instance().resize( threadCount );
+
+        return FilterFunctionTest( Filter, size );
+    }
 }
 
 // Function naming: _functionName_imageSize
@@ -83,11 +102,41 @@ namespace
         }                                                                                                                                                                \
     }
 
+// Function naming: _functionName_imageSize_threadCount
+#define SET_FUNCTION_POOL_SIZE( function, size )                                                                                                                         \
+    std::pair<double, double> _##size##_1()                                                                                                                              \
+    {                                                                                                                                                                    \
+        return FunctionPoolFilterTest( function, size, 1 );                                                                                                              \
+    }                                                                                                                                                                    \
+    std::pair<double, double> _##size##_2()                                                                                                                              \
+    {                                                                                                                                                                    \
+        return FunctionPoolFilterTest( function, size, 2 );                                                                                                              \
+    }                                                                                                                                                                    \
+    std::pair<double, double> _##size##_4()                                                                                                                              \
+    {                                                                                                                                                                    \
+        return FunctionPoolFilterTest( function, size, 4 );                                                                                                              \
+    }                                                                                                                                                                    \
+    std::pair<double, double> _##size##_8()                                                                                                                              \
+    {                                                                                                                                                                    \
+        return FunctionPoolFilterTest( function, size, 8 );                                                                                                              \
+    }
+
+#define SET_FUNCTION_POOL( function )                                                                                                                                    \
+    namespace filtering_##function                                                                                                                                       \
+    {                                                                                                                                                                    \
+        SET_FUNCTION_POOL_SIZE( function, 256 )                                                                                                                          \
+        SET_FUNCTION_POOL_SIZE( function, 512 )                                                                                                                          \
+        SET_FUNCTION_POOL_SIZE( function, 1024 )                                                                                                                         \
+        SET_FUNCTION_POOL_SIZE( function, 2048 )                                                                                                                         \
+    }
+
 namespace
 {
     SET_FUNCTION( MedianFilter3x3 )
     SET_FUNCTION( PrewittFilter )
     SET_FUNCTION( SobelFilter )
+    SET_FUNCTION_POOL( FunctionPoolMedianFilter3x3 )
+    SET_FUNCTION_POOL( FunctionPoolSobelFilter )
 }
 
 #define ADD_TEST_FUNCTION( framework, function )                                                                                                                         \
@@ -96,9 +145,24 @@ namespace
     ADD_TEST( framework, filtering_##function::_1024 );                                                                                                                  \
     ADD_TEST( framework, filtering_##function::_2048 );
 
+// Function_Pool filters are measured with 1, 2, 4 and 8 threads in thread pool
+#define ADD_TEST_FUNCTION_POOL_SIZE( framework, function, size )                                                                                                         \
+    ADD_TEST( framework, filtering_##function::_##size##_1 );                                                                                                            \
+    ADD_TEST( framework, filtering_##function::_##size##_2 );                                                                                                            \
+    ADD_TEST( framework, filtering_##function::_##size##_4 );                                                                                                            \
+    ADD_TEST( framework, filtering_##function::_##size##_8 );
+
+#define ADD_TEST_FUNCTION_POOL( framework, function )                                                                                                                    \
+    ADD_TEST_FUNCTION_POOL_SIZE( framework, function, 256 )                                                                                                              \
+    ADD_TEST_FUNCTION_POOL_SIZE( framework, function, 512 )                                                                                                              \
+    ADD_TEST_FUNCTION_POOL_SIZE( framework, function, 1024 )                                                                                                             \
+    ADD_TEST_FUNCTION_POOL_SIZE( framework, function, 2048 )
+
 void addTests_Filtering( PerformanceTestFramework & framework )
 {
     ADD_TEST_FUNCTION( framework, MedianFilter3x3 )
     ADD_TEST_FUNCTION( framework, PrewittFilter )
     ADD_TEST_FUNCTION( framework, SobelFilter )
+    ADD_TEST_FUNCTION_POOL( framework, FunctionPoolMedianFilter3x3 )
+    ADD_TEST_FUNCTION_POOL( framework, FunctionPoolSobelFilter )
 }
@@ -20,6 +20,8 @@
 
 #include "performance_test_image_function.h"
 #include "../../src/function_pool.h"
+#include "../../src/function_pool_batch.h"
+#include "../../src/image_expression.h"
 #include "../../src/image_function.h"
 #include "../../src/image_function_helper.h"
 #include "../../src/image_function_simd.h"
@@ -64,7 +66,7 @@ namespace Function_Template
 
     void SetupFunction( const std::string & namespaceName )
     {
-        if ( namespaceName == "function_pool" ) {
+        if ( ( namespaceName == "function_pool" ) || ( namespaceName == "function_pool_batch" ) || ( namespaceName == "roi_list" ) ) {
             simd::EnableSimd( true );
             ThreadPoolMonoid::instance().resize( 4 );
         }
@@ -387,6 +389,361 @@ namespace function_pool
     SET_FUNCTION( Transpose )
 }
 
+#define SCALING_FUNCTION_REGISTRATION( functionName, threads, size )                                                                                                     \
+    struct Register_##functionName##_##threads##_##size                                                                                                                  \
+    {                                                                                                                                                                    \
+        explicit Register_##functionName##_##threads##_##size( bool makeRegistration )                                                                                   \
+        {                                                                                                                                                                \
+            if ( makeRegistration )                                                                                                                                      \
+                FunctionRegistrator::instance().add( scaling##threads##_##size##_##functionName,                                                                         \
+                                                     namespaceName + std::string( "::" ) + std::string( #functionName ) + std::string( " (" ) + std::string( #size )     \
+                                                         + std::string( "x" ) + std::string( #size ) + std::string( ", " ) + std::string( #threads )                     \
+                                                         + std::string( " threads)" ) );                                                                                 \
+        }                                                                                                                                                                \
+    };                                                                                                                                                                   \
+    const Register_##functionName##_##threads##_##size registrator_##functionName##_##threads##_##size( isSupported );
+
+#define REGISTER_SCALING_FUNCTION( functionName, threads, size )                                                                                                         \
+    std::pair<double, double> scaling##threads##_##size##_##functionName()                                                                                               \
+    {                                                                                                                                                                    \
+        ThreadPoolMonoid::instance().resize( threads );                                                                                                                  \
+        return Function_Template::template_##functionName( functionName, namespaceName, size );                                                                          \
+    }                                                                                                                                                                    \
+    SCALING_FUNCTION_REGISTRATION( functionName, threads, size )
+
+#define SET_SCALING_FUNCTION( functionName, size )                                                                                                                       \
+    REGISTER_SCALING_FUNCTION( functionName, 1, size )                                                                                                                   \
+    REGISTER_SCALING_FUNCTION( functionName, 2, size )                                                                                                                   \
+    REGISTER_SCALING_FUNCTION( functionName, 4, size )                                                                                                                   \
+    REGISTER_SCALING_FUNCTION( functionName, 8, size )                                                                                                                   \
+    REGISTER_SCALING_FUNCTION( functionName, 16, size )                                                                                                                  \
+    REGISTER_SCALING_FUNCTION( functionName, 32, size )                                                                                                                  \
+    REGISTER_SCALING_FUNCTION( functionName, 64, size )
+
+// the same functions with different number of threads in thread pool to show how thread pool scales
+namespace function_pool_scaling
+{
+    using namespace Function_Pool;
+
+    const bool isSupported = true;
+    const std::string namespaceName = "function_pool_scaling";
+
+    SET_SCALING_FUNCTION( Histogram, 2048 )
+    SET_SCALING_FUNCTION( Sum, 2048 )
+    SET_SCALING_FUNCTION( Threshold, 2048 )
+
+    // small images show the overhead of splitting a function into tasks
+    SET_SCALING_FUNCTION( Histogram, 512 )
+    SET_SCALING_FUNCTION( Sum, 512 )
+    SET_SCALING_FUNCTION( Threshold, 512 )
+}
+
+// fused expressions compared to the same SIMD functions called one by one on 4K frames
+namespace image_expression
+{
+    using namespace Function_Template;
+
+    const std::string namespaceName = "image_expression";
+    const uint32_t width = 3840u;
+    const uint32_t height = 2160u;
+
+    std::pair<double, double> ThresholdAbsoluteDifference()
+    {
+        const std::vector<penguinV::Image> image = Performance_Test::uniformImages( 2, width, height );
+        penguinV::Image out( width, height );
+        const uint8_t threshold = Performance_Test::randomValue<uint8_t>( 256 );
+
+        TEST_FUNCTION_LOOP( Image_Expression::Evaluate( Image_Expression::Threshold( Image_Expression::AbsoluteDifference( image[0], image[1] ), threshold ), out ),
+                            namespaceName )
+    }
+
+    std::pair<double, double> ThresholdAbsoluteDifferenceChained()
+    {
+        const std::vector<penguinV::Image> image = Performance_Test::uniformImages( 2, width, height );
+        penguinV::Image temp( width, height );
+        penguinV::Image out( width, height );
+        const uint8_t threshold = Performance_Test::randomValue<uint8_t>( 256 );
+
+        TEST_FUNCTION_LOOP( Image_Function_Simd::AbsoluteDifference( image[0], image[1], temp ); Image_Function_Simd::Threshold( temp, out, threshold ), namespaceName )
+    }
+
+    std::pair<double, double> MaximumInvert()
+    {
+        const std::vector<penguinV::Image> image = Performance_Test::uniformImages( 2, width, height );
+        penguinV::Image out( width, height );
+
+        TEST_FUNCTION_LOOP( Image_Expression::Evaluate( Image_Expression::Maximum( Image_Expression::Invert( image[0] ), image[1] ), out ), namespaceName )
+    }
+
+    std::pair<double, double> MaximumInvertChained()
+    {
+        const std::vector<penguinV::Image> image = Performance_Test::uniformImages( 2, width, height );
+        penguinV::Image temp( width, height );
+        penguinV::Image out( width, height );
+
+        TEST_FUNCTION_LOOP( Image_Function_Simd::Invert( image[0], temp ); Image_Function_Simd::Maximum( temp, image[1], out ), namespaceName )
+    }
+
+    struct Registrator
+    {
+        Registrator()
+        {
+            FunctionRegistrator::instance().add( ThresholdAbsoluteDifference, namespaceName + "::ThresholdAbsoluteDifference (3840x2160)" );
+            FunctionRegistrator::instance().add( ThresholdAbsoluteDifferenceChained, namespaceName + "::ThresholdAbsoluteDifference chained (3840x2160)" );
+            FunctionRegistrator::instance().add( MaximumInvert, namespaceName + "::MaximumInvert (3840x2160)" );
+            FunctionRegistrator::instance().add( MaximumInvertChained, namespaceName + "::MaximumInvert chained (3840x2160)" );
+        }
+    };
+
+    const Registrator registrator;
+}
+
+// batches of small patches processed by one call compared to calls of Function_Pool functions per patch
+namespace function_pool_batch
+{
+    using namespace Function_Template;
+
+    const std::string namespaceName = "function_pool_batch";
+    const uint32_t patchCount = 1000u;
+    const uint32_t patchSize = 64u;
+
+    std::pair<double, double> Threshold()
+    {
+        const std::vector<penguinV::Image> image = Performance_Test::uniformImages( patchCount, patchSize, patchSize );
+        std::vector<penguinV::Image> out = Performance_Test::uniformImages( patchCount, patchSize, patchSize );
+        const uint8_t threshold = Performance_Test::randomValue<uint8_t>( 256 );
+
+        TEST_FUNCTION_LOOP( Function_Pool::Batch::Threshold( image, out, threshold ), namespaceName )
+    }
+
+    std::pair<double, double> ThresholdPerImage()
+    {
+        const std::vector<penguinV::Image> image = Performance_Test::uniformImages( patchCount, patchSize, patchSize );
+        std::vector<penguinV::Image> out = Performance_Test::uniformImages( patchCount, patchSize, patchSize );
+        const uint8_t threshold = Performance_Test::randomValue<uint8_t>( 256 );
+
+        TEST_FUNCTION_LOOP( for ( uint32_t id = 0; id < patchCount; ++id ) Function_Pool::Threshold( image[id], out[id], threshold ), namespaceName )
+    }
+
+    std::pair<double, double> Sum()
+    {
+        const std::vector<penguinV::Image> image = Performance_Test::uniformImages( patchCount, patchSize, patchSize );
+
+        TEST_FUNCTION_LOOP( Function_Pool::Batch::Sum( image ), namespaceName )
+    }
+
+    std::pair<double, double> SumPerImage()
+    {
+        const std::vector<penguinV::Image> image = Performance_Test::uniformImages( patchCount, patchSize, patchSize );
+
+        TEST_FUNCTION_LOOP( for ( uint32_t id = 0; id < patchCount; ++id ) Function_Pool::Sum( image[id] ), namespaceName )
+    }
+
+    struct Registrator
+    {
+        Registrator()
+        {
+            FunctionRegistrator::instance().add( Threshold, namespaceName + "::Threshold (1000 x 64x64)" );
+            FunctionRegistrator::instance().add( ThresholdPerImage, namespaceName + "::Threshold per image (1000 x 64x64)" );
+            FunctionRegistrator::instance().add( Sum, namespaceName + "::Sum (1000 x 64x64)" );
+            FunctionRegistrator::instance().add( SumPerImage, namespaceName + "::Sum per image (1000 x 64x64)" );
+        }
+    };
+
+    const Registrator registrator;
+}
+
+// statistics of many ROIs of one frame computed by one call compared to calls per ROI
+namespace roi_list
+{
+    using namespace Function_Template;
+
+    const std::string namespaceName = "roi_list";
+    const uint32_t size = 2048u;
+    const uint32_t largeSize = 8192u; // image which doesn't fit into CPU cache
+    const uint32_t roiCount = 300u;
+
+    std::vector<penguinV::Roi> generateRoi( uint32_t imageSize = size, uint32_t maximumRoiSize = 256u )
+    {
+        std::vector<penguinV::Roi> roi( roiCount );
+
+        for ( std::vector<penguinV::Roi>::iterator area = roi.begin(); area != roi.end(); ++area ) {
+            area->width = Performance_Test::randomValue<uint32_t>( 16u, maximumRoiSize );
+            area->height = Performance_Test::randomValue<uint32_t>( 16u, maximumRoiSize );
+            area->x = Performance_Test::randomValue<uint32_t>( imageSize - area->width );
+            area->y = Performance_Test::randomValue<uint32_t>( imageSize - area->height );
+        }
+
+        return roi;
+    }
+
+    std::pair<double, double> Histogram()
+    {
+        const penguinV::Image image = Performance_Test::uniformImage( size, size );
+        const std::vector<penguinV::Roi> roi = generateRoi();
+        std::vector<std::vector<uint32_t>> histogram;
+
+        TEST_FUNCTION_LOOP( Image_Function::Histogram( image, roi, histogram ), namespaceName )
+    }
+
+    std::pair<double, double> HistogramPerRoi()
+    {
+        const penguinV::Image image = Performance_Test::uniformImage( size, size );
+        const std::vector<penguinV::Roi> roi = generateRoi();
+        std::vector<uint32_t> histogram;
+
+        TEST_FUNCTION_LOOP( for ( uint32_t id = 0; id < roiCount; ++id )
+                                Image_Function::Histogram( image, roi[id].x, roi[id].y, roi[id].width, roi[id].height, histogram ),
+                            namespaceName )
+    }
+
+    std::pair<double, double> ProjectionProfile()
+    {
+        const penguinV::Image image = Performance_Test::uniformImage( size, size );
+        const std::vector<penguinV::Roi> roi = generateRoi();
+        std::vector<std::vector<uint32_t>> projection;
+
+        TEST_FUNCTION_LOOP( Image_Function::ProjectionProfile( image, roi, false, projection ), namespaceName )
+    }
+
+    std::pair<double, double> ProjectionProfilePerRoi()
+    {
+        const penguinV::Image image = Performance_Test::uniformImage( size, size );
+        const std::vector<penguinV::Roi> roi = generateRoi();
+        std::vector<uint32_t> projection;
+
+        TEST_FUNCTION_LOOP( for ( uint32_t id = 0; id < roiCount; ++id )
+                                Image_Function::ProjectionProfile( image, roi[id].x, roi[id].y, roi[id].width, roi[id].height, false, projection ),
+                            namespaceName )
+    }
+
+    std::pair<double, double> template_ProjectionProfileSimd( uint32_t imageSize, uint32_t maximumRoiSize )
+    {
+        const penguinV::Image image = Performance_Test::uniformImage( imageSize, imageSize );
+        const std::vector<penguinV::Roi> roi = generateRoi( imageSize, maximumRoiSize );
+        std::vector<std::vector<uint32_t>> projection;
+
+        TEST_FUNCTION_LOOP( Image_Function_Simd::ProjectionProfile( image, roi, false, projection ), namespaceName )
+    }
+
+    std::pair<double, double> template_ProjectionProfilePerRoiSimd( uint32_t imageSize, uint32_t maximumRoiSize )
+    {
+        const penguinV::Image image = Performance_Test::uniformImage( imageSize, imageSize );
+        const std::vector<penguinV::Roi> roi = generateRoi( imageSize, maximumRoiSize );
+        std::vector<uint32_t> projection;
+
+        TEST_FUNCTION_LOOP( for ( uint32_t id = 0; id < roiCount; ++id )
+                                Image_Function_Simd::ProjectionProfile( image, roi[id].x, roi[id].y, roi[id].width, roi[id].height, false, projection ),
+                            namespaceName )
+    }
+
+    std::pair<double, double> Sum()
+    {
+        const penguinV::Image image = Performance_Test::uniformImage( size, size );
+        const std::vector<penguinV::Roi> roi = generateRoi();
+
+        TEST_FUNCTION_LOOP( Image_Function::Sum( image, roi ), namespaceName )
+    }
+
+    std::pair<double, double> SumPerRoi()
+    {
+        const penguinV::Image image = Performance_Test::uniformImage( size, size );
+        const std::vector<penguinV::Roi> roi = generateRoi();
+
+        TEST_FUNCTION_LOOP( for ( uint32_t id = 0; id < roiCount; ++id ) Image_Function::Sum( image, roi[id].x, roi[id].y, roi[id].width, roi[id].height ),
+                            namespaceName )
+    }
+
+    std::pair<double, double> template_SumSimd( uint32_t imageSize, uint32_t maximumRoiSize )
+    {
+        const penguinV::Image image = Performance_Test::uniformImage( imageSize, imageSize );
+        const std::vector<penguinV::Roi> roi = generateRoi( imageSize, maximumRoiSize );
+
+        TEST_FUNCTION_LOOP( Image_Function_Simd::Sum( image, roi ), namespaceName )
+    }
+
+    std::pair<double, double> template_SumPerRoiSimd( uint32_t imageSize, uint32_t maximumRoiSize )
+    {
+        const penguinV::Image image = Performance_Test::uniformImage( imageSize, imageSize );
+        const std::vector<penguinV::Roi> roi = generateRoi( imageSize, maximumRoiSize );
+
+        TEST_FUNCTION_LOOP( for ( uint32_t id = 0; id < roiCount; ++id ) Image_Function_Simd::Sum( image, roi[id].x, roi[id].y, roi[id].width, roi[id].height ),
+                            namespaceName )
+    }
+
+    std::pair<double, double> SumFunctionPool()
+    {
+        const penguinV::Image image = Performance_Test::uniformImage( size, size );
+        const std::vector<penguinV::Roi> roi = generateRoi();
+
+        TEST_FUNCTION_LOOP( Function_Pool::Sum( image, roi ), namespaceName )
+    }
+
+    std::pair<double, double> ProjectionProfileSimd()
+    {
+        return template_ProjectionProfileSimd( size, 256u );
+    }
+
+    std::pair<double, double> ProjectionProfileSimdLarge()
+    {
+        return template_ProjectionProfileSimd( largeSize, 1024u );
+    }
+
+    std::pair<double, double> ProjectionProfilePerRoiSimd()
+    {
+        return template_ProjectionProfilePerRoiSimd( size, 256u );
+    }
+
+    std::pair<double, double> ProjectionProfilePerRoiSimdLarge()
+    {
+        return template_ProjectionProfilePerRoiSimd( largeSize, 1024u );
+    }
+
+    std::pair<double, double> SumSimd()
+    {
+        return template_SumSimd( size, 256u );
+    }
+
+    std::pair<double, double> SumSimdLarge()
+    {
+        return template_SumSimd( largeSize, 1024u );
+    }
+
+    std::pair<double, double> SumPerRoiSimd()
+    {
+        return template_SumPerRoiSimd( size, 256u );
+    }
+
+    std::pair<double, double> SumPerRoiSimdLarge()
+    {
+        return template_SumPerRoiSimd( largeSize, 1024u );
+    }
+
+    struct Registrator
+    {
+        Registrator()
+        {
+            FunctionRegistrator::instance().add( Histogram, namespaceName + "::Histogram (300 ROIs of 2048x2048)" );
+            FunctionRegistrator::instance().add( HistogramPerRoi, namespaceName + "::Histogram per ROI (300 ROIs of 2048x2048)" );
+            FunctionRegistrator::instance().add( ProjectionProfile, namespaceName + "::ProjectionProfile (300 ROIs of 2048x2048)" );
+            FunctionRegistrator::instance().add( ProjectionProfilePerRoi, namespaceName + "::ProjectionProfile per ROI (300 ROIs of 2048x2048)" );
+            FunctionRegistrator::instance().add( ProjectionProfileSimd, namespaceName + "::ProjectionProfile SIMD (300 ROIs of 2048x2048)" );
+            FunctionRegistrator::instance().add( ProjectionProfilePerRoiSimd, namespaceName + "::ProjectionProfile SIMD per ROI (300 ROIs of 2048x2048)" );
+            FunctionRegistrator::instance().add( ProjectionProfileSimdLarge, namespaceName + "::ProjectionProfile SIMD (300 ROIs of 8192x8192)" );
+            FunctionRegistrator::instance().add( ProjectionProfilePerRoiSimdLarge, namespaceName + "::ProjectionProfile SIMD per ROI (300 ROIs of 8192x8192)" );
+            FunctionRegistrator::instance().add( Sum, namespaceName + "::Sum (300 ROIs of 2048x2048)" );
+            FunctionRegistrator::instance().add( SumPerRoi, namespaceName + "::Sum per ROI (300 ROIs of 2048x2048)" );
+            FunctionRegistrator::instance().add( SumSimd, namespaceName + "::Sum SIMD (300 ROIs of 2048x2048)" );
+            FunctionRegistrator::instance().add( SumPerRoiSimd, namespaceName + "::Sum SIMD per ROI (300 ROIs of 2048x2048)" );
+            FunctionRegistrator::instance().add( SumSimdLarge, namespaceName + "::Sum SIMD (300 ROIs of 8192x8192)" );
+            FunctionRegistrator::instance().add( SumPerRoiSimdLarge, namespaceName + "::Sum SIMD per ROI (300 ROIs of 8192x8192)" );
+            FunctionRegistrator::instance().add( SumFunctionPool, namespaceName + "::Sum function_pool (300 ROIs of 2048x2048)" );
+        }
+    };
+
+    const Registrator registrator;
+}
+
 #ifdef PENGUIV_AV512BW_SET
 namespace image_function_avx512
 {
@@ -406,10 +763,12 @@ namespace image_function_avx512
     SET_FUNCTION( ProjectionProfile )
     SET_FUNCTION( Subtract )
     SET_FUNCTION( Sum )
+    SET_FUNCTION( Threshold )
+    REGISTER_FUNCTION( ThresholdDouble, Threshold )
 }
 #endif
 
-#ifdef PENGUINV_AVX_SET
+#ifdef PENGUINV_AVX_DISPATCH
 namespace image_function_avx
 {
     using namespace Image_Function_Simd;
@@ -434,7 +793,7 @@ namespace image_function_avx
 }
 #endif
 
-#ifdef PENGUINV_NEON_SET
+#ifdef PENGUINV_NEON_DISPATCH
 namespace image_function_neon
 {
     using namespace Image_Function_Simd;
@@ -461,7 +820,7 @@ namespace image_function_neon
 }
 #endif
 
-#ifdef PENGUINV_SSE_SET
+#ifdef PENGUINV_SSE_DISPATCH
 namespace image_function_sse
 {
     using namespace Image_Function_Simd;
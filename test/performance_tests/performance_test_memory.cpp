@@ -0,0 +1,176 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "performance_test_memory.h"
+#include "../../src/image_buffer.h"
+#include "../../src/image_function.h"
+#include "../../src/memory/cpu_memory.h"
+#include "performance_test_framework.h"
+#include "performance_test_helper.h"
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Every thread creates and destroys small images of different sizes at the same time
+    std::pair<double, double> AllocationContention( uint32_t threadCount )
+    {
+        const uint32_t allocationCount = 4096u;
+
+        Performance_Test::TimerContainer timer;
+
+        for ( uint32_t i = 0; i < Performance_Test::runCount(); ++i ) {
+            timer.start();
+
+            std::vector<std::thread> worker;
+            for ( uint32_t threadId = 0; threadId < threadCount; ++threadId ) {
+                worker.emplace_back( [allocationCount]() {
+                    for ( uint32_t j = 0; j < allocationCount; ++j ) {
+                        const uint32_t size = 32u << ( j % 3u );
+                        penguinV::Image image( size, size );
+                    }
+                } );
+            }
+
+            for ( std::vector<std::thread>::iterator thread = worker.begin(); thread != worker.end(); ++thread )
+                thread->join();
+
+            timer.stop();
+        }
+
+        return timer.mean();
+    }
+
+    void ArenaCopy( const penguinV::Image & in, penguinV::Image & out )
+    {
+        Image_Function::Copy( in, out );
+    }
+
+    void ArenaTranspose( const penguinV::Image & in, penguinV::Image & out )
+    {
+        Image_Function::Transpose( in, out );
+    }
+
+    void ArenaHistogram( const penguinV::Image & in, penguinV::Image & )
+    {
+        std::vector<uint32_t> histogram;
+        Image_Function::Histogram( in, histogram );
+    }
+
+    // Runs a function over images which do not fit into TLB reach of 4 KB pages. Images are placed in preallocated memory of given type
+    std::pair<double, double> ArenaFunction( void ( *function )( const penguinV::Image &, penguinV::Image & ), cpu_Memory::ArenaType type )
+    {
+        const uint32_t size = 4096u;
+
+        cpu_Memory::MemoryAllocator & allocator = cpu_Memory::MemoryAllocator::instance();
+        const size_t reservedSize = allocator.statistics().reservedSize;
+        const cpu_Memory::ArenaType reservedType = allocator.arenaType();
+
+        allocator.reserve( 4u * size * size, type );
+
+        Performance_Test::TimerContainer timer;
+
+        {
+            const penguinV::Image in = Performance_Test::uniformImage( size, size );
+            penguinV::Image out( size, size );
+
+            function( in, out ); // all pages are touched before measurements
+
+            for ( uint32_t i = 0; i < Performance_Test::runCount(); ++i ) {
+                timer.start();
+
+                function( in, out );
+
+                timer.stop();
+            }
+        }
+
+        allocator.reserve( reservedSize, reservedType );
+
+        return timer.mean();
+    }
+}
+
+// Function naming: _functionName_threadCount
+#define SET_FUNCTION( function )                                                                                                                                         \
+    namespace memory_##function                                                                                                                                          \
+    {                                                                                                                                                                    \
+        std::pair<double, double> _1_thread()                                                                                                                            \
+        {                                                                                                                                                                \
+            return function( 1 );                                                                                                                                        \
+        }                                                                                                                                                                \
+        std::pair<double, double> _4_threads()                                                                                                                           \
+        {                                                                                                                                                                \
+            return function( 4 );                                                                                                                                        \
+        }                                                                                                                                                                \
+        std::pair<double, double> _8_threads()                                                                                                                           \
+        {                                                                                                                                                                \
+            return function( 8 );                                                                                                                                        \
+        }                                                                                                                                                                \
+        std::pair<double, double> _16_threads()                                                                                                                          \
+        {                                                                                                                                                                \
+            return function( 16 );                                                                                                                                       \
+        }                                                                                                                                                                \
+    }
+
+// Function naming: _functionName_arenaType
+#define SET_ARENA_FUNCTION( function )                                                                                                                                   \
+    namespace memory_##function                                                                                                                                          \
+    {                                                                                                                                                                    \
+        std::pair<double, double> _heap_arena()                                                                                                                          \
+        {                                                                                                                                                                \
+            return ArenaFunction( function, cpu_Memory::heap_arena );                                                                                                    \
+        }                                                                                                                                                                \
+        std::pair<double, double> _page_arena()                                                                                                                          \
+        {                                                                                                                                                                \
+            return ArenaFunction( function, cpu_Memory::page_arena );                                                                                                    \
+        }                                                                                                                                                                \
+        std::pair<double, double> _huge_page_arena()                                                                                                                     \
+        {                                                                                                                                                                \
+            return ArenaFunction( function, cpu_Memory::huge_page_arena );                                                                                               \
+        }                                                                                                                                                                \
+    }
+
+namespace
+{
+    SET_FUNCTION( AllocationContention )
+    SET_ARENA_FUNCTION( ArenaCopy )
+    SET_ARENA_FUNCTION( ArenaTranspose )
+    SET_ARENA_FUNCTION( ArenaHistogram )
+}
+
+#define ADD_TEST_FUNCTION( framework, function )                                                                                                                         \
+    ADD_TEST( framework, memory_##function::_1_thread );                                                                                                                 \
+    ADD_TEST( framework, memory_##function::_4_threads );                                                                                                                \
+    ADD_TEST( framework, memory_##function::_8_threads );                                                                                                                \
+    ADD_TEST( framework, memory_##function::_16_threads );
+
+#define ADD_ARENA_TEST_FUNCTION( framework, function )                                                                                                                   \
+    ADD_TEST( framework, memory_##function::_heap_arena );                                                                                                               \
+    ADD_TEST( framework, memory_##function::_page_arena );                                                                                                               \
+    ADD_TEST( framework, memory_##function::_huge_page_arena );
+
+void addTests_Memory( PerformanceTestFramework & framework )
+{
+    ADD_TEST_FUNCTION( framework, AllocationContention )
+    ADD_ARENA_TEST_FUNCTION( framework, ArenaCopy )
+    ADD_ARENA_TEST_FUNCTION( framework, ArenaTranspose )
+    ADD_ARENA_TEST_FUNCTION( framework, ArenaHistogram )
+}
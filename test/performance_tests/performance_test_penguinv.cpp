@@ -0,0 +1,87 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "performance_test_penguinv.h"
+#include "../../src/image_function_helper.h"
+#include "../../src/image_function_simd.h"
+#include "../../src/penguinv/penguinv.h"
+#include "performance_test_framework.h"
+#include "performance_test_helper.h"
+
+namespace
+{
+    // Measures overhead of dispatching through function tables on small areas where the function itself takes little time.
+    // Every measurement contains many calls as a single call is too short for a timer
+    std::pair<double, double> Threshold( Image_Function_Helper::FunctionTable::ThresholdForm4 Threshold, uint32_t roiSize )
+    {
+        const uint32_t callCount = 1024u;
+
+        std::vector<penguinV::Image> image = Performance_Test::uniformImages( 2, 256, 256 );
+        const uint8_t threshold = Performance_Test::randomValue<uint8_t>( 256 );
+
+        Performance_Test::TimerContainer timer;
+
+        for ( uint32_t i = 0; i < Performance_Test::runCount(); ++i ) {
+            timer.start();
+
+            for ( uint32_t call = 0; call < callCount; ++call )
+                Threshold( image[0], call % 64u, 0, image[1], 0, call % 64u, roiSize, roiSize, threshold );
+
+            timer.stop();
+        }
+
+        return timer.mean();
+    }
+}
+
+// Function naming: _functionName_roiSize
+namespace penguinv_dispatch
+{
+    std::pair<double, double> Threshold_16x16()
+    {
+        return Threshold( penguinV::Threshold, 16u );
+    }
+
+    std::pair<double, double> Threshold_64x64()
+    {
+        return Threshold( penguinV::Threshold, 64u );
+    }
+}
+
+namespace image_function_simd_direct
+{
+    std::pair<double, double> Threshold_16x16()
+    {
+        return Threshold( Image_Function_Simd::Threshold, 16u );
+    }
+
+    std::pair<double, double> Threshold_64x64()
+    {
+        return Threshold( Image_Function_Simd::Threshold, 64u );
+    }
+}
+
+void addTests_Penguinv( PerformanceTestFramework & framework )
+{
+    ADD_TEST( framework, penguinv_dispatch::Threshold_16x16 );
+    ADD_TEST( framework, penguinv_dispatch::Threshold_64x64 );
+    ADD_TEST( framework, image_function_simd_direct::Threshold_16x16 );
+    ADD_TEST( framework, image_function_simd_direct::Threshold_64x64 );
+}
@@ -0,0 +1,106 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "performance_test_thread_pool.h"
+#include "../../src/thread_pool.h"
+#include "performance_test_framework.h"
+#include "performance_test_helper.h"
+
+namespace
+{
+    class EmptyTaskProvider : public TaskProvider
+    {
+    public:
+        explicit EmptyTaskProvider( ThreadPool * pool )
+            : TaskProvider( pool )
+        {}
+
+        void run( size_t taskCount )
+        {
+            _run( taskCount );
+            _wait();
+        }
+
+    protected:
+        virtual void _task( size_t ) {}
+    };
+
+    // Measures time between giving empty tasks (one per thread) to thread pool and receiving their completion
+    std::pair<double, double> EmptyTask( uint32_t threadCount, bool spinning )
+    {
+        ThreadPoolConfiguration configuration;
+        configuration.spinCount = spinning ? 1024u : 0u;
+
+        ThreadPool pool( threadCount, configuration );
+        EmptyTaskProvider provider( &pool );
+
+        provider.run( threadCount ); // all threads are woken up before measurements
+
+        Performance_Test::TimerContainer timer;
+
+        for ( uint32_t i = 0; i < Performance_Test::runCount(); ++i ) {
+            timer.start();
+
+            provider.run( threadCount );
+
+            timer.stop();
+        }
+
+        return timer.mean();
+    }
+}
+
+// Function naming: _functionName_threadCount_waitingMode
+#define SET_FUNCTION( function )                                                                                                                                         \
+    namespace thread_pool_##function                                                                                                                                     \
+    {                                                                                                                                                                    \
+        std::pair<double, double> _1_thread_sleeping()                                                                                                                   \
+        {                                                                                                                                                                \
+            return function( 1, false );                                                                                                                                 \
+        }                                                                                                                                                                \
+        std::pair<double, double> _1_thread_spinning()                                                                                                                   \
+        {                                                                                                                                                                \
+            return function( 1, true );                                                                                                                                  \
+        }                                                                                                                                                                \
+        std::pair<double, double> _4_threads_sleeping()                                                                                                                  \
+        {                                                                                                                                                                \
+            return function( 4, false );                                                                                                                                 \
+        }                                                                                                                                                                \
+        std::pair<double, double> _4_threads_spinning()                                                                                                                  \
+        {                                                                                                                                                                \
+            return function( 4, true );                                                                                                                                  \
+        }                                                                                                                                                                \
+    }
+
+namespace
+{
+    SET_FUNCTION( EmptyTask )
+}
+
+#define ADD_TEST_FUNCTION( framework, function )                                                                                                                         \
+    ADD_TEST( framework, thread_pool_##function::_1_thread_sleeping );                                                                                                   \
+    ADD_TEST( framework, thread_pool_##function::_1_thread_spinning );                                                                                                   \
+    ADD_TEST( framework, thread_pool_##function::_4_threads_sleeping );                                                                                                  \
+    ADD_TEST( framework, thread_pool_##function::_4_threads_spinning );
+
+void addTests_Thread_Pool( PerformanceTestFramework & framework )
+{
+    ADD_TEST_FUNCTION( framework, EmptyTask )
+}
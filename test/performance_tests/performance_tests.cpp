@@ -24,6 +24,9 @@
 #include "performance_test_framework.h"
 #include "performance_test_helper.h"
 #include "performance_test_image_function.h"
+#include "performance_test_memory.h"
+#include "performance_test_penguinv.h"
+#include "performance_test_thread_pool.h"
 #include <iostream>
 
 int main( int argc, char * argv[] )
@@ -37,6 +40,9 @@ int main( int argc, char * argv[] )
     addTests_Edge_Detection( framework );
     addTests_Filtering( framework );
     addTests_Image_Function( framework );
+    addTests_Memory( framework );
+    addTests_Penguinv( framework );
+    addTests_Thread_Pool( framework );
     framework.run();
 
     return 0;
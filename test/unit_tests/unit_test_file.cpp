@@ -25,6 +25,7 @@
 #include "../../src/file/raw_image.h"
 #include "unit_test_framework.h"
 #include "unit_test_helper.h"
+#include <fstream>
 #include <stdio.h>
 
 namespace file_operation
@@ -102,6 +103,75 @@ namespace file_operation
         return true;
     }
 
+    bool MappedRawRGBImage()
+    {
+        const std::string fileName = "raw.raw";
+        const penguinV::Image original = Unit_Test::randomRGBImage();
+        Raw_Operation::Save( fileName, original );
+
+        bool isValid = true;
+        {
+            const penguinV::ImageMapped mapped
+                = Raw_Operation::Map<uint8_t>( fileName, original.width(), original.height(), original.colorCount(), penguinV::read_only_mapping );
+
+            isValid = Unit_Test::equalSize<penguinV::Image>( original, mapped ) && Unit_Test::equalData( original, mapped );
+        }
+
+        remove( fileName.data() );
+
+        return isValid;
+    }
+
+    bool MappedCopyOnWriteImage()
+    {
+        const std::string fileName = "raw.raw";
+        const penguinV::Image original = Unit_Test::randomImage();
+        Raw_Operation::Save( fileName, original );
+
+        bool isValid = true;
+        {
+            penguinV::ImageMapped mapped = Raw_Operation::Map<uint8_t>( fileName, original.width(), original.height(), original.colorCount() );
+            const uint8_t value = Unit_Test::randomValue<uint8_t>( 256 );
+            mapped.fill( value );
+
+            // changes of the image must not be written into the file
+            const penguinV::Image loaded = Raw_Operation::Load<uint8_t>( fileName, original.width(), original.height(), original.colorCount() );
+
+            isValid = Unit_Test::verifyImage( mapped, value ) && Unit_Test::equalData( original, loaded );
+        }
+
+        remove( fileName.data() );
+
+        return isValid;
+    }
+
+    bool MappedImageWithOffset()
+    {
+        const std::string fileName = "raw.raw";
+        const penguinV::Image original = Unit_Test::randomImage();
+        const uint32_t headerSize = Unit_Test::randomValue<uint32_t>( 1u, 8192u );
+
+        {
+            std::fstream file( fileName, std::fstream::out | std::fstream::trunc | std::fstream::binary );
+            const std::vector<char> header( headerSize, 1 );
+            file.write( header.data(), static_cast<std::streamsize>( header.size() ) );
+            file.write( reinterpret_cast<const char *>( original.data() ), static_cast<std::streamsize>( original.rowSize() * original.height() ) );
+        }
+
+        bool isValid = true;
+        {
+            const penguinV::ImageMapped mapped( fileName, original.width(), original.height(), original.colorCount(), original.alignment(), penguinV::read_only_mapping,
+                                                headerSize );
+            const penguinV::ImageMapped copy( mapped );
+
+            isValid = Unit_Test::equalSize<penguinV::Image>( original, mapped ) && Unit_Test::equalData( original, mapped ) && Unit_Test::equalData( original, copy );
+        }
+
+        remove( fileName.data() );
+
+        return isValid;
+    }
+
     bool WhiteGrayScaleImageBitmap()
     {
         return WhiteGrayScaleImage( "bitmap.bmp", Bitmap_Operation::Load, Bitmap_Operation::Save );
@@ -158,4 +228,9 @@ void addTests_File( UnitTestFramework & framework )
     framework.add( file_operation::BlackGrayScaleImageJpeg, "File: Save and load black gray-scale jpeg image" );
 #endif
     framework.add( file_operation::RawRGBImage, "File: Save and load raw RGB image" );
+#if !defined( _WIN32 )
+    framework.add( file_operation::MappedRawRGBImage, "File: Map raw RGB image" );
+    framework.add( file_operation::MappedCopyOnWriteImage, "File: Modify copy-on-write mapped image" );
+    framework.add( file_operation::MappedImageWithOffset, "File: Map image with offset in file" );
+#endif
 }
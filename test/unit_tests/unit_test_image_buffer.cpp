@@ -19,7 +19,15 @@
  ***************************************************************************/
 
 #include "unit_test_image_buffer.h"
+#include <cstring>
+#include "../../src/file/mapped_image.h"
+#include "../../src/function_pool.h"
 #include "../../src/image_function.h"
+#include "../../src/image_function_helper.h"
+#include "../../src/image_function_simd.h"
+#include "../../src/image_pool.h"
+#include "../../src/penguinv/penguinv.h"
+#include "../../src/thread_pool.h"
 #include "unit_test_framework.h"
 #include "unit_test_helper.h"
 
@@ -109,6 +117,404 @@ namespace template_image
 
         return true;
     }
+
+    template <typename _Type>
+    bool _SimdAlignedConstructor()
+    {
+        for ( uint32_t i = 0; i < Unit_Test::runCount(); ++i ) {
+            const uint32_t width = Unit_Test::randomValue<uint32_t>( 1, 2048 );
+            const uint32_t height = Unit_Test::randomValue<uint32_t>( 1, 2048 );
+            const uint8_t colorCount = Unit_Test::randomValue<uint8_t>( 1, 4 );
+
+            const penguinV::ImageTemplate<_Type> image( width, height, colorCount, penguinV::ImageTemplate<_Type>::simdAlignment() );
+
+            if ( !image.isSimdAligned() || ( reinterpret_cast<std::uintptr_t>( image.data() ) % penguinV::SIMD_ALIGNMENT ) != 0
+                 || ( image.rowSize() * sizeof( _Type ) ) % penguinV::SIMD_ALIGNMENT != 0 )
+                return false;
+        }
+
+        return true;
+    }
+
+    bool SimdAlignedThreshold()
+    {
+        for ( uint32_t i = 0; i < Unit_Test::runCount(); ++i ) {
+            const uint32_t width = Unit_Test::randomValue<uint32_t>( 1, 2048 );
+            const uint32_t height = Unit_Test::randomValue<uint32_t>( 1, 64 );
+
+            penguinV::Image input( width, height, 1u, penguinV::Image::simdAlignment() );
+            penguinV::Image output( width, height, 1u, penguinV::Image::simdAlignment() );
+
+            const std::vector<uint8_t> intensity = Unit_Test::intensityArray( 2 );
+            input.fill( intensity[0] );
+            output.fill( intensity[1] );
+
+            // ROI which reaches the end of rows lets functions overwrite row padding
+            const uint32_t roiX = Unit_Test::randomValue<uint32_t>( 2 ) == 0 ? 0 : Unit_Test::randomValue<uint32_t>( width );
+            const uint32_t roiY = Unit_Test::randomValue<uint32_t>( height );
+            const uint32_t roiHeight = Unit_Test::randomValue<uint32_t>( 1, height - roiY + 1 );
+
+            const uint8_t thresholdValue = Unit_Test::randomValue<uint8_t>( 255 );
+
+            Image_Function_Simd::Threshold( input, roiX, roiY, output, roiX, roiY, width - roiX, roiHeight, thresholdValue );
+
+            if ( !Unit_Test::verifyImage( output, roiX, roiY, width - roiX, roiHeight, intensity[0] < thresholdValue ? 0 : 255 )
+                 || ( roiX > 0 && !Unit_Test::verifyImage( output, 0, 0, roiX, height, intensity[1] ) )
+                 || ( roiY > 0 && !Unit_Test::verifyImage( output, 0, 0, width, roiY, intensity[1] ) )
+                 || ( roiY + roiHeight < height && !Unit_Test::verifyImage( output, 0, roiY + roiHeight, width, height - roiY - roiHeight, intensity[1] ) ) )
+                return false;
+        }
+
+        return true;
+    }
+
+    bool ImagePoolRecycling()
+    {
+        for ( uint32_t i = 0; i < Unit_Test::runCount(); ++i ) {
+            const uint32_t width = Unit_Test::randomValue<uint32_t>( 1, 512 );
+            const uint32_t height = Unit_Test::randomValue<uint32_t>( 1, 512 );
+            const size_t count = Unit_Test::randomValue<uint32_t>( 1, 4 );
+
+            penguinV::ImagePool pool;
+            pool.reserve( width, height, 1u, 1u, count );
+            pool.reserve( height, width );
+
+            const uint8_t * data = nullptr;
+            {
+                const penguinV::Image image = pool.acquire( width, height );
+                data = image.data();
+            }
+
+            // buffers are recycled per geometry so an image of other geometry but the same buffer size gets own buffer
+            const penguinV::Image image = pool.acquire( height, width );
+            const bool isSameGeometry = ( width == height );
+
+            if ( ( image.data() == data ) != isSameGeometry || pool.bufferCount() != ( isSameGeometry ? count : count + 1u )
+                 || pool.freeBufferCount() != ( isSameGeometry ? count - 1u : count ) )
+                return false;
+
+            // row size of 2^33 bytes can't be represented by 32-bit row size
+            try {
+                pool.reserve( 0x80000000u, 1u, penguinV::RGBA );
+                return false;
+            }
+            catch ( const penguinVException & ) {
+            }
+        }
+
+        return true;
+    }
+
+    bool ImagePoolPipelineAllocation()
+    {
+        cpu_Memory::MemoryAllocator & allocator = cpu_Memory::MemoryAllocator::instance();
+
+        for ( uint32_t i = 0; i < Unit_Test::runCount(); ++i ) {
+            const penguinV::Image frame = Unit_Test::randomImage();
+            const uint8_t thresholdValue = Unit_Test::randomValue<uint8_t>( 255 );
+            const uint32_t frameCount = Unit_Test::randomValue<uint32_t>( 2, 8 );
+
+            penguinV::ImagePool pool;
+            pool.reserve( frame.width(), frame.height() );
+
+            // allocations served by thread magazines are visible only while recording
+            allocator.startRecording();
+
+            bool isValid = true;
+            for ( uint32_t frameId = 0; frameId < frameCount; ++frameId ) {
+                if ( frameId == 1u )
+                    allocator.resetStatistics();
+
+                const penguinV::Image thresholded = Image_Function::Threshold( frame, thresholdValue );
+                const penguinV::Image inverted = Image_Function::Invert( thresholded );
+                const penguinV::Image combined = Image_Function::BitwiseAnd( frame, inverted );
+
+                if ( !Unit_Test::equalSize( frame, combined ) )
+                    isValid = false;
+            }
+
+            const cpu_Memory::MemoryAllocator::Statistics info = allocator.statistics();
+            allocator.stopRecording();
+
+            if ( !isValid || info.requestedSize != 0u || info.heapAllocationCount != 0u || pool.bufferCount() != 3u || pool.freeBufferCount() != 3u )
+                return false;
+        }
+
+        return true;
+    }
+
+    bool OversizedImageRejected()
+    {
+        try {
+            // row size of 2^33 bytes can't be represented by 32-bit row size
+            const penguinV::Image image( 0x80000000u, 1u, penguinV::RGBA );
+            return false;
+        }
+        catch ( const penguinVException & ) {
+            return true;
+        }
+    }
+
+#if !defined( _WIN32 )
+    bool LargeImageAccumulation()
+    {
+        if ( sizeof( size_t ) < 8u )
+            return true;
+
+        // 4 GB + 64 KB image is never filled so untouched pages share the same zero page
+        const uint32_t width = 65536u;
+        const uint32_t height = 65537u;
+
+        penguinV::ImageMapped image( width, height );
+        image.data()[0] = 7u;
+        image.data()[static_cast<size_t>( height - 1u ) * image.rowSize() + width - 1u] = 255u;
+
+        const std::vector<uint64_t> histogram = Image_Function::Histogram64( image );
+        const uint64_t lastRowSum = Image_Function_Simd::Sum64( image, 0, height - 1u, width, 1u );
+        const std::vector<uint64_t> projection = Image_Function_Simd::ProjectionProfile64( image, width - 16u, height - 16u, 16u, 16u, false );
+
+        return Image_Function_Simd::Sum64( image ) == 262u && lastRowSum == 255u && projection.back() == 255u && histogram[7] == 1u && histogram[255] == 1u
+               && histogram[0] == static_cast<uint64_t>( width ) * height - 2u;
+    }
+#endif
+
+    bool ViewConstructor()
+    {
+        for ( uint32_t i = 0; i < Unit_Test::runCount(); ++i ) {
+            penguinV::Image image = Unit_Test::uniformImage();
+
+            uint32_t roiX, roiY, roiWidth, roiHeight;
+            Unit_Test::generateRoi( image, roiX, roiY, roiWidth, roiHeight );
+
+            const penguinV::ImageView view( image, roiX, roiY, roiWidth, roiHeight );
+
+            if ( view.width() != roiWidth || view.height() != roiHeight || view.rowSize() != image.rowSize() || view.colorCount() != image.colorCount()
+                 || view.data() != image.data() + roiY * image.rowSize() + roiX * image.colorCount() )
+                return false;
+
+            uint32_t subX, subY, subWidth, subHeight;
+            Unit_Test::generateRoi( penguinV::Image( roiWidth, roiHeight ), subX, subY, subWidth, subHeight );
+
+            const penguinV::ConstImageView subView = view.view( subX, subY, subWidth, subHeight );
+
+            if ( subView.x() != roiX + subX || subView.y() != roiY + subY || subView.width() != subWidth || subView.height() != subHeight )
+                return false;
+        }
+
+        return true;
+    }
+
+    bool ViewInvalidParameters()
+    {
+        penguinV::Image image = Unit_Test::uniformImage();
+
+        try {
+            const penguinV::ImageView view( image, image.width(), 0, 1, 1 );
+        }
+        catch ( penguinVException & ) {
+            return true;
+        }
+
+        return false;
+    }
+
+    typedef void ( *ViewThresholdForm )( const penguinV::ConstImageView & in, const penguinV::ImageView & out, uint8_t threshold );
+
+    bool _ViewThreshold( ViewThresholdForm threshold )
+    {
+        for ( uint32_t i = 0; i < Unit_Test::runCount(); ++i ) {
+            const std::vector<uint8_t> intensity = Unit_Test::intensityArray( 2 );
+            std::vector<penguinV::Image> image = Unit_Test::uniformImages( intensity );
+
+            std::vector<uint32_t> roiX, roiY;
+            uint32_t roiWidth, roiHeight;
+            Unit_Test::generateRoi( image, roiX, roiY, roiWidth, roiHeight );
+
+            const uint8_t thresholdValue = Unit_Test::randomValue<uint8_t>( 255 );
+
+            threshold( penguinV::ConstImageView( image[0], roiX[0], roiY[0], roiWidth, roiHeight ),
+                       penguinV::ImageView( image[1], roiX[1], roiY[1], roiWidth, roiHeight ), thresholdValue );
+
+            if ( !Unit_Test::verifyImage( image[1], roiX[1], roiY[1], roiWidth, roiHeight, intensity[0] < thresholdValue ? 0 : 255 ) )
+                return false;
+        }
+
+        return true;
+    }
+
+    bool ViewThresholdImageFunction()
+    {
+        return _ViewThreshold( Image_Function::Threshold );
+    }
+
+    bool ViewThresholdFunctionPool()
+    {
+        ThreadPoolMonoid::instance().resize( Unit_Test::randomValue<uint8_t>( 1, 8 ) );
+
+        return _ViewThreshold( Function_Pool::Threshold );
+    }
+
+    bool ViewThresholdSimd()
+    {
+        return _ViewThreshold( Image_Function_Simd::Threshold );
+    }
+
+    bool ViewThresholdPenguinV()
+    {
+        return _ViewThreshold( penguinV::Threshold );
+    }
+
+    // image type without any functions to verify conversion of images between image types
+    class ImageResidencyTest : public penguinV::Image
+    {
+    public:
+        ImageResidencyTest()
+        {
+            _setType( 250 );
+        }
+    };
+
+    size_t residencyConversionCount = 0u;
+
+    void ResidencyConvert( const penguinV::Image & in, penguinV::Image & out )
+    {
+        for ( uint32_t y = 0; y < in.height(); ++y )
+            memcpy( out.data() + y * out.rowSize(), in.data() + y * in.rowSize(), in.width() * in.colorCount() );
+
+        ++residencyConversionCount;
+    }
+
+    bool ResidencyConversion()
+    {
+        ImageTypeManager & manager = ImageTypeManager::instance();
+        static bool registered = false;
+        if ( !registered ) {
+            registered = true;
+            manager.setFunctionTable( ImageResidencyTest().type(), Image_Function_Helper::FunctionTableHolder() );
+            manager.setConvertFunction( ResidencyConvert, penguinV::Image(), ImageResidencyTest() );
+            manager.setConvertFunction( ResidencyConvert, ImageResidencyTest(), penguinV::Image() );
+        }
+
+        const bool intertypeConversion = manager.isIntertypeConversionEnabled();
+        manager.enableIntertypeConversion( true );
+
+        bool result = true;
+
+        for ( uint32_t i = 0; i < Unit_Test::runCount() && result; ++i ) {
+            const std::vector<uint8_t> intensity = Unit_Test::intensityArray( 3 );
+            std::vector<penguinV::Image> image = Unit_Test::uniformImages( intensity, ImageResidencyTest() );
+            const uint8_t thresholdValue = Unit_Test::randomValue<uint8_t>( 255 );
+            const uint8_t thresholdOut = intensity[0] < thresholdValue ? 0u : 255u;
+
+            // every function call converts all images
+            residencyConversionCount = 0u;
+            penguinV::Threshold( image[0], image[1], thresholdValue );
+            penguinV::Invert( image[1], image[2] );
+
+            result = residencyConversionCount == 6u && Unit_Test::verifyImage( image[2], static_cast<uint8_t>( ~thresholdOut ) );
+
+            residencyConversionCount = 0u;
+            {
+                penguinV::ResidencyScope scope( { &image[0], &image[1], &image[2] } );
+
+                penguinV::Threshold( image[0], image[1], thresholdValue );
+                penguinV::Invert( image[1], image[2] );
+                penguinV::BitwiseOr( image[1], image[2], image[1] );
+
+                // every image is converted once
+                result = result && residencyConversionCount == 3u && scope.conversionCount() == 3u;
+
+                scope.synchronize();
+                result = result && residencyConversionCount == 5u && Unit_Test::verifyImage( image[1], 255u )
+                         && Unit_Test::verifyImage( image[2], static_cast<uint8_t>( ~thresholdOut ) );
+
+                // synchronized images are not converted again
+                penguinV::Invert( image[1], image[0] );
+                scope.release( image[1] );
+            }
+
+            result = result && residencyConversionCount == 6u && Unit_Test::verifyImage( image[0], 0u );
+        }
+
+        manager.enableIntertypeConversion( intertypeConversion );
+
+        return result;
+    }
+
+    size_t backendThresholdCount = 0u;
+
+    void BackendThreshold( const penguinV::Image & in, uint32_t startXIn, uint32_t startYIn, penguinV::Image & out, uint32_t startXOut, uint32_t startYOut,
+                           uint32_t width, uint32_t height, uint8_t threshold )
+    {
+        Image_Function::Threshold( in, startXIn, startYIn, out, startXOut, startYOut, width, height, threshold );
+        ++backendThresholdCount;
+    }
+
+    bool BackendSelection()
+    {
+        BackendSelector & selector = BackendSelector::instance();
+
+        Image_Function_Helper::FunctionTableHolder table;
+        table.Threshold = BackendThreshold;
+        selector.registerBackend( "unit_test", penguinV::Image().type(), table );
+
+        // the test backend is slower for small images and faster for large images
+        selector.resetCost();
+        selector.setCost( BackendSelector::Threshold, "simd", 16u * 16u, 1e-6 );
+        selector.setCost( BackendSelector::Threshold, "simd", 1024u * 1024u, 1e-3 );
+        selector.setCost( BackendSelector::Threshold, "unit_test", 16u * 16u, 1e-5 );
+        selector.setCost( BackendSelector::Threshold, "unit_test", 1024u * 1024u, 1e-4 );
+
+        std::vector<std::string> decision;
+        selector.setDecisionHook( [&decision]( const BackendSelector::Decision & info ) { decision.push_back( info.backend ); } );
+
+        bool result = true;
+
+        for ( uint32_t i = 0; i < 2u && result; ++i ) {
+            selector.enable( true );
+
+            const std::vector<uint8_t> intensity = Unit_Test::intensityArray( 2 );
+            const uint8_t thresholdValue = Unit_Test::randomValue<uint8_t>( 255 );
+            const uint8_t thresholdOut = intensity[0] < thresholdValue ? 0u : 255u;
+
+            const penguinV::Image smallIn = Unit_Test::uniformImage( intensity[0], 16u, 16u );
+            penguinV::Image smallOut = Unit_Test::uniformImage( intensity[1], 16u, 16u );
+            const penguinV::Image largeIn = Unit_Test::uniformImage( intensity[0], 2048u, 1024u );
+            penguinV::Image largeOut = Unit_Test::uniformImage( intensity[1], 2048u, 1024u );
+
+            decision.clear();
+            backendThresholdCount = 0u;
+
+            penguinV::Threshold( smallIn, smallOut, thresholdValue );
+            penguinV::Threshold( largeIn, largeOut, thresholdValue );
+
+            selector.enable( false );
+            penguinV::Threshold( largeIn, largeOut, thresholdValue );
+
+            result = backendThresholdCount == 1u && decision.size() == 2u && decision[0] == "simd" && decision[1] == "unit_test"
+                     && Unit_Test::verifyImage( smallOut, thresholdOut ) && Unit_Test::verifyImage( largeOut, thresholdOut );
+
+            // the same decisions must be made with costs loaded from a file
+            const std::string path( "backend_cost.txt" );
+            selector.save( path );
+            selector.resetCost();
+            selector.load( path );
+            remove( path.data() );
+
+            result = result && ( selector.cost( BackendSelector::Threshold, "unit_test", 1024u * 1024u ) == 1e-4 );
+        }
+
+        // calibration measures all functions of all backends
+        ThreadPoolMonoid::instance().resize( Unit_Test::randomValue<uint8_t>( 1, 8 ) );
+        selector.calibrate( { 16u, 64u } );
+        result = result && selector.cost( BackendSelector::Sum, "simd", 64u * 64u ) > 0 && selector.cost( BackendSelector::Sum, "function_pool", 64u * 64u ) > 0
+                 && selector.cost( BackendSelector::Invert, "unit_test", 64u * 64u ) < 0;
+
+        selector.setDecisionHook( nullptr );
+        selector.resetCost();
+
+        return result;
+    }
 }
 
 #define ADD_TEMPLATE_FUNCTION( function, type )                                                                                                                          \
@@ -120,6 +526,15 @@ void addTests_Image_Buffer( UnitTestFramework & framework )
     ADD_TEST( framework, template_image::EmptyConstructor );
     ADD_TEST( framework, template_image::Constructor );
     ADD_TEST( framework, template_image::NullAssignment );
+    ADD_TEST( framework, template_image::SimdAlignedThreshold );
+    ADD_TEST( framework, template_image::ImagePoolRecycling );
+    ADD_TEST( framework, template_image::ImagePoolPipelineAllocation );
+    ADD_TEST( framework, template_image::OversizedImageRejected );
+#if !defined( _WIN32 )
+    ADD_TEST( framework, template_image::LargeImageAccumulation );
+#endif
+    ADD_TEST( framework, template_image::ViewConstructor );
+    ADD_TEST( framework, template_image::ViewInvalidParameters );
 
     ADD_TEMPLATE_FUNCTION( CopyConstructor, uint8_t );
     ADD_TEMPLATE_FUNCTION( CopyConstructor, uint16_t );
@@ -142,4 +557,16 @@ void addTests_Image_Buffer( UnitTestFramework & framework )
     ADD_TEMPLATE_FUNCTION( AssignmentOperator, int64_t );
     ADD_TEMPLATE_FUNCTION( AssignmentOperator, float );
     ADD_TEMPLATE_FUNCTION( AssignmentOperator, double );
+
+    ADD_TEMPLATE_FUNCTION( SimdAlignedConstructor, uint8_t );
+    ADD_TEMPLATE_FUNCTION( SimdAlignedConstructor, uint16_t );
+    ADD_TEMPLATE_FUNCTION( SimdAlignedConstructor, float );
+    ADD_TEMPLATE_FUNCTION( SimdAlignedConstructor, double );
+
+    ADD_TEST( framework, template_image::ViewThresholdImageFunction );
+    ADD_TEST( framework, template_image::ViewThresholdFunctionPool );
+    ADD_TEST( framework, template_image::ViewThresholdSimd );
+    ADD_TEST( framework, template_image::ViewThresholdPenguinV );
+    ADD_TEST( framework, template_image::ResidencyConversion );
+    ADD_TEST( framework, template_image::BackendSelection );
 }
@@ -21,6 +21,10 @@
 #include "unit_test_image_function.h"
 #include "../../src/filtering.h"
 #include "../../src/function_pool.h"
+#include "../../src/function_pool_async.h"
+#include "../../src/function_pool_batch.h"
+#include "../../src/function_pool_graph.h"
+#include "../../src/image_expression.h"
 #include "../../src/image_function.h"
 #include "../../src/image_function_helper.h"
 #include "../../src/image_function_simd.h"
@@ -28,8 +32,12 @@
 #include "../../src/thread_pool.h"
 #include "unit_test_framework.h"
 #include "unit_test_helper.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <math.h>
 #include <numeric>
+#include <thread>
 
 namespace
 {
@@ -190,6 +198,44 @@ namespace Function_Template
         return std::all_of( result.begin(), result.end(), [&sum]( uint32_t v ) { return v == sum; } );
     }
 
+    bool form1_Accumulate64( Accumulate64Form1 Accumulate64 )
+    {
+        const std::vector<uint8_t> intensity = intensityArray( randomValue<uint8_t>( 1, 16 ) );
+        std::vector<penguinV::Image> input = uniformImages( intensity );
+
+        std::vector<uint64_t> result( input[0].width() * input[0].height(), 0 );
+
+        for ( std::vector<penguinV::Image>::const_iterator image = input.begin(); image != input.end(); ++image ) {
+            Accumulate64( *image, result );
+        }
+
+        const uint64_t sum = std::accumulate( intensity.begin(), intensity.end(), 0u );
+
+        return std::all_of( result.begin(), result.end(), [&sum]( uint64_t v ) { return v == sum; } );
+    }
+
+    bool form2_Accumulate64( Accumulate64Form2 Accumulate64 )
+    {
+        const penguinV::Image input = randomImage( randomValue<uint32_t>( 1, 256 ), randomValue<uint32_t>( 1, 256 ) );
+
+        uint32_t roiX, roiY, roiWidth, roiHeight;
+        generateRoi( input, roiX, roiY, roiWidth, roiHeight );
+
+        std::vector<uint64_t> result( roiWidth * roiHeight, 0 );
+        Accumulate64( input, roiX, roiY, roiWidth, roiHeight, result );
+
+        // values must follow pixel order of non-uniform image
+        std::vector<uint64_t>::const_iterator value = result.begin();
+        for ( uint32_t y = roiY; y < roiY + roiHeight; ++y ) {
+            for ( uint32_t x = roiX; x < roiX + roiWidth; ++x, ++value ) {
+                if ( *value != input.data()[y * input.rowSize() + x] )
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
     bool form1_BinaryDilate( BinaryDilateForm1 BinaryDilate )
     {
         std::vector<uint8_t> fillData( randomValue<uint32_t>( 20, 200 ), 255u );
@@ -1063,6 +1109,58 @@ namespace Function_Template
                && std::accumulate( histogram.begin(), histogram.end(), 0u ) == roiWidth * roiHeight;
     }
 
+    bool form1_Histogram64( Histogram64Form1 Histogram64 )
+    {
+        const uint8_t intensity = intensityValue();
+        const penguinV::Image image = uniformImage( intensity );
+
+        const std::vector<uint64_t> histogram = Histogram64( image );
+
+        return histogram.size() == 256u && histogram[intensity] == image.width() * image.height()
+               && std::accumulate( histogram.begin(), histogram.end(), uint64_t( 0u ) ) == image.width() * image.height();
+    }
+
+    bool form2_Histogram64( Histogram64Form2 Histogram64 )
+    {
+        const uint8_t intensity = intensityValue();
+        const penguinV::Image image = uniformImage( intensity );
+
+        std::vector<uint64_t> histogram;
+        Histogram64( image, histogram );
+
+        return histogram.size() == 256u && histogram[intensity] == image.width() * image.height()
+               && std::accumulate( histogram.begin(), histogram.end(), uint64_t( 0u ) ) == image.width() * image.height();
+    }
+
+    bool form3_Histogram64( Histogram64Form3 Histogram64 )
+    {
+        const uint8_t intensity = intensityValue();
+        const penguinV::Image input = uniformImage( intensity );
+
+        uint32_t roiX, roiY, roiWidth, roiHeight;
+        generateRoi( input, roiX, roiY, roiWidth, roiHeight );
+
+        const std::vector<uint64_t> histogram = Histogram64( input, roiX, roiY, roiWidth, roiHeight );
+
+        return histogram.size() == 256u && histogram[intensity] == roiWidth * roiHeight
+               && std::accumulate( histogram.begin(), histogram.end(), uint64_t( 0u ) ) == roiWidth * roiHeight;
+    }
+
+    bool form4_Histogram64( Histogram64Form4 Histogram64 )
+    {
+        const uint8_t intensity = intensityValue();
+        const penguinV::Image input = uniformImage( intensity );
+
+        uint32_t roiX, roiY, roiWidth, roiHeight;
+        generateRoi( input, roiX, roiY, roiWidth, roiHeight );
+
+        std::vector<uint64_t> histogram;
+        Histogram64( input, roiX, roiY, roiWidth, roiHeight, histogram );
+
+        return histogram.size() == 256u && histogram[intensity] == roiWidth * roiHeight
+               && std::accumulate( histogram.begin(), histogram.end(), uint64_t( 0u ) ) == roiWidth * roiHeight;
+    }
+
     bool form5_Histogram( HistogramForm5 Histogram )
     {
         const uint8_t intensity = intensityValue();
@@ -1673,6 +1771,80 @@ namespace Function_Template
                && std::all_of( projection.begin(), projection.end(), [&value]( uint32_t v ) { return value == v; } );
     }
 
+    bool form1_ProjectionProfile64( ProjectionProfile64Form1 ProjectionProfile64 )
+    {
+        const uint8_t intensity = intensityValue();
+        const penguinV::Image image = uniformImage( intensity );
+
+        const bool horizontal = ( randomValue<int>( 2 ) == 0 );
+
+        std::vector<uint64_t> projection = ProjectionProfile64( image, horizontal );
+
+        const uint64_t value = ( horizontal ? image.height() : image.width() ) * intensity;
+
+        return projection.size() == ( horizontal ? image.width() : image.height() )
+               && std::all_of( projection.begin(), projection.end(), [&value]( uint64_t v ) { return value == v; } );
+    }
+
+    bool form2_ProjectionProfile64( ProjectionProfile64Form2 ProjectionProfile64 )
+    {
+        const uint8_t intensity = intensityValue();
+        const penguinV::Image image = uniformImage( intensity );
+
+        const bool horizontal = ( randomValue<int>( 2 ) == 0 );
+
+        std::vector<uint64_t> projection;
+        ProjectionProfile64( image, horizontal, projection );
+
+        const uint64_t value = ( horizontal ? image.height() : image.width() ) * intensity;
+
+        return projection.size() == ( horizontal ? image.width() : image.height() )
+               && std::all_of( projection.begin(), projection.end(), [&value]( uint64_t v ) { return value == v; } );
+    }
+
+    bool form3_ProjectionProfile64( ProjectionProfile64Form3 ProjectionProfile64 )
+    {
+        const uint8_t intensity = intensityValue();
+        const penguinV::Image image = uniformImage( intensity );
+
+        uint32_t roiX, roiY, roiWidth, roiHeight;
+        generateRoi( image, roiX, roiY, roiWidth, roiHeight );
+
+        const bool horizontal = ( randomValue<int>( 2 ) == 0 );
+
+        std::vector<uint64_t> projection = ProjectionProfile64( image, roiX, roiY, roiWidth, roiHeight, horizontal );
+
+        const uint64_t value = ( horizontal ? roiHeight : roiWidth ) * intensity;
+
+        return projection.size() == ( horizontal ? roiWidth : roiHeight )
+               && std::all_of( projection.begin(), projection.end(), [&value]( uint64_t v ) { return value == v; } );
+    }
+
+    bool form4_ProjectionProfile64( ProjectionProfile64Form4 ProjectionProfile64 )
+    {
+        const penguinV::Image image = randomImage( randomValue<uint32_t>( 1, 256 ), randomValue<uint32_t>( 1, 256 ) );
+
+        uint32_t roiX, roiY, roiWidth, roiHeight;
+        generateRoi( image, roiX, roiY, roiWidth, roiHeight );
+
+        const bool horizontal = ( randomValue<int>( 2 ) == 0 );
+
+        std::vector<uint64_t> projection;
+        ProjectionProfile64( image, roiX, roiY, roiWidth, roiHeight, horizontal, projection );
+
+        if ( projection.size() != ( horizontal ? roiWidth : roiHeight ) )
+            return false;
+
+        // values must follow pixel order of non-uniform image
+        std::vector<uint64_t> expected( projection.size(), 0u );
+        for ( uint32_t y = 0; y < roiHeight; ++y ) {
+            for ( uint32_t x = 0; x < roiWidth; ++x )
+                expected[horizontal ? x : y] += image.data()[( roiY + y ) * image.rowSize() + roiX + x];
+        }
+
+        return projection == expected;
+    }
+
     bool form1_ReplaceChannel( ReplaceChannelForm1 ReplaceChannel )
     {
         const std::vector<uint8_t> intensity = intensityArray( 2 );
@@ -2182,6 +2354,25 @@ namespace Function_Template
         return Sum( input, roiX, roiY, roiWidth, roiHeight ) == intensity * roiWidth * roiHeight;
     }
 
+    bool form1_Sum64( Sum64Form1 Sum64 )
+    {
+        const uint8_t intensity = intensityValue();
+        const penguinV::Image input = uniformImage( intensity );
+
+        return Sum64( input ) == static_cast<uint64_t>( intensity ) * input.width() * input.height();
+    }
+
+    bool form2_Sum64( Sum64Form2 Sum64 )
+    {
+        const uint8_t intensity = intensityValue();
+        const penguinV::Image input = uniformImage( intensity );
+
+        uint32_t roiX, roiY, roiWidth, roiHeight;
+        generateRoi( input, roiX, roiY, roiWidth, roiHeight );
+
+        return Sum64( input, roiX, roiY, roiWidth, roiHeight ) == static_cast<uint64_t>( intensity ) * roiWidth * roiHeight;
+    }
+
     bool form1_Threshold( ThresholdForm1 Threshold )
     {
         const uint8_t intensity = intensityValue();
@@ -2530,6 +2721,7 @@ namespace image_function
 
     SET_FUNCTION_4_FORMS( AbsoluteDifference )
     SET_FUNCTION_2_FORMS( Accumulate )
+    SET_FUNCTION_2_FORMS( Accumulate64 )
     SET_FUNCTION_2_FORMS( BinaryDilate )
     SET_FUNCTION_2_FORMS( BinaryErode )
     SET_FUNCTION_4_FORMS( BitwiseAnd )
@@ -2546,6 +2738,7 @@ namespace image_function
     SET_FUNCTION_4_FORMS( GammaCorrection )
     SET_FUNCTION_1_FORMS( GetThreshold )
     SET_FUNCTION_8_FORMS( Histogram )
+    SET_FUNCTION_4_FORMS( Histogram64 )
     SET_FUNCTION_4_FORMS( Invert )
     SET_FUNCTION_2_FORMS( IsBinary )
     SET_FUNCTION_2_FORMS( IsEqual )
@@ -2555,6 +2748,7 @@ namespace image_function
     SET_FUNCTION_4_FORMS( Minimum )
     SET_FUNCTION_4_FORMS( Normalize )
     SET_FUNCTION_4_FORMS( ProjectionProfile )
+    SET_FUNCTION_4_FORMS( ProjectionProfile64 )
     SET_FUNCTION_2_FORMS( ReplaceChannel )
     SET_FUNCTION_4_FORMS( Resize )
     SET_FUNCTION_4_FORMS( RgbToBgr )
@@ -2564,11 +2758,51 @@ namespace image_function
     SET_FUNCTION_2_FORMS( Split )
     SET_FUNCTION_4_FORMS( Subtract )
     SET_FUNCTION_2_FORMS( Sum )
+    SET_FUNCTION_2_FORMS( Sum64 )
     SET_FUNCTION_8_FORMS( Threshold )
     SET_FUNCTION_4_FORMS( Transpose )
 
     SET_FUNCTION_4_FORMS( Prewitt )
     SET_FUNCTION_4_FORMS( Sobel )
+
+    // Histogram of a colour area must count every channel of every pixel inside the area
+    bool ColorHistogram()
+    {
+        for ( uint32_t i = 0; i < 8; ++i ) {
+            const penguinV::Image gray = Unit_Test::randomImage();
+            const penguinV::Image image = Merge( gray, Unit_Test::randomImage( gray.width(), gray.height() ), Unit_Test::randomImage( gray.width(), gray.height() ) );
+            const penguinV::Image mask = Unit_Test::randomImage( gray.width(), gray.height() );
+
+            uint32_t roiX, roiY, roiWidth, roiHeight;
+            Unit_Test::generateRoi( image, roiX, roiY, roiWidth, roiHeight );
+
+            const uint32_t colorCount = image.colorCount();
+            std::vector<uint32_t> reference( 256u * colorCount, 0u );
+            std::vector<uint32_t> referenceMasked( 256u * colorCount, 0u );
+
+            for ( uint32_t y = roiY; y < roiY + roiHeight; ++y ) {
+                const uint8_t * imageX = image.data() + y * image.rowSize() + roiX * colorCount;
+                const uint8_t * maskX = mask.data() + y * mask.rowSize() + roiX;
+
+                for ( uint32_t x = 0; x < roiWidth; ++x, ++maskX ) {
+                    for ( uint32_t colorChannel = 0; colorChannel < colorCount; ++colorChannel, ++imageX ) {
+                        ++reference[*imageX * colorCount + colorChannel];
+                        if ( *maskX > 0 )
+                            ++referenceMasked[*imageX * colorCount + colorChannel];
+                    }
+                }
+            }
+
+            const std::vector<uint64_t> histogram64 = Histogram64( image, roiX, roiY, roiWidth, roiHeight );
+
+            if ( Histogram( image, roiX, roiY, roiWidth, roiHeight ) != reference
+                 || Histogram( image, roiX, roiY, mask, roiX, roiY, roiWidth, roiHeight ) != referenceMasked
+                 || !std::equal( reference.begin(), reference.end(), histogram64.begin() ) || histogram64.size() != reference.size() )
+                return false;
+        }
+
+        return true;
+    }
 }
 
 namespace function_pool
@@ -2579,6 +2813,8 @@ namespace function_pool
     const std::string namespaceName = "function_pool";
 
     SET_FUNCTION_4_FORMS( AbsoluteDifference )
+    SET_FUNCTION_2_FORMS( BinaryDilate )
+    SET_FUNCTION_2_FORMS( BinaryErode )
     SET_FUNCTION_4_FORMS( BitwiseAnd )
     SET_FUNCTION_4_FORMS( BitwiseOr )
     SET_FUNCTION_4_FORMS( BitwiseXor )
@@ -2601,9 +2837,614 @@ namespace function_pool
     SET_FUNCTION_2_FORMS( Sum )
     SET_FUNCTION_8_FORMS( Threshold )
     SET_FUNCTION_4_FORMS( Transpose )
+    SET_FUNCTION_4_FORMS( Prewitt )
+    SET_FUNCTION_4_FORMS( Sobel )
+
+    // Wide images with few rows are split into 2D tiles
+    bool TiledArea()
+    {
+        ThreadPoolMonoid::instance().resize( 4 );
+
+        for ( uint32_t i = 0; i < 4; ++i ) {
+            const penguinV::Image image = Unit_Test::randomImage( Unit_Test::randomValue<uint32_t>( 32768u, 65536u ), Unit_Test::randomValue<uint32_t>( 2u, 7u ) );
+
+            if ( Sum( image ) != Image_Function::Sum( image ) || Histogram( image ) != Image_Function::Histogram( image )
+                 || ProjectionProfile( image, true ) != Image_Function::ProjectionProfile( image, true )
+                 || ProjectionProfile( image, false ) != Image_Function::ProjectionProfile( image, false ) )
+                return false;
+
+            if ( !Image_Function::IsEqual( Flip( image, true, true ), Image_Function::Flip( image, true, true ) )
+                 || !Image_Function::IsEqual( Transpose( image ), Image_Function::Transpose( image ) )
+                 || !Image_Function::IsEqual( Threshold( image, 128u ), Image_Function::Threshold( image, 128u ) ) )
+                return false;
+        }
+
+        return true;
+    }
+
+    // Functions reading neighbour pixels must give the same result regardless of how an image is split into tasks
+    bool NeighbourArea()
+    {
+        for ( uint32_t i = 0; i < 4; ++i ) {
+            ThreadPoolMonoid::instance().resize( Unit_Test::randomValue<uint32_t>( 2u, 17u ) );
+
+            const penguinV::Image image = Unit_Test::randomImage( Unit_Test::randomValue<uint32_t>( 256u, 1024u ), Unit_Test::randomValue<uint32_t>( 256u, 1024u ) );
+
+            uint32_t roiX, roiY, roiWidth, roiHeight;
+            Unit_Test::generateRoi( image, roiX, roiY, roiWidth, roiHeight );
+            // ROI must be bigger than the biggest kernel
+            roiWidth = std::max( roiWidth, 8u );
+            roiHeight = std::max( roiHeight, 8u );
+            roiX = std::min( roiX, image.width() - roiWidth );
+            roiY = std::min( roiY, image.height() - roiHeight );
+
+            const uint32_t kernelSize = Unit_Test::randomValue<uint32_t>( 1u, 4u ) * 2u + 1u;
+
+            if ( !Image_Function::IsEqual( Median( image, kernelSize ), Image_Function::Median( image, kernelSize ) )
+                 || !Image_Function::IsEqual( Median( image, roiX, roiY, roiWidth, roiHeight, kernelSize ),
+                                              Image_Function::Median( image, roiX, roiY, roiWidth, roiHeight, kernelSize ) )
+                 || !Image_Function::IsEqual( Sobel( image ), Image_Function::Sobel( image ) )
+                 || !Image_Function::IsEqual( Sobel( image, roiX, roiY, roiWidth, roiHeight ), Image_Function::Sobel( image, roiX, roiY, roiWidth, roiHeight ) )
+                 || !Image_Function::IsEqual( Prewitt( image ), Image_Function::Prewitt( image ) )
+                 || !Image_Function::IsEqual( Prewitt( image, roiX, roiY, roiWidth, roiHeight ),
+                                              Image_Function::Prewitt( image, roiX, roiY, roiWidth, roiHeight ) ) )
+                return false;
+
+            const double shiftX = Unit_Test::randomFloatValue<double>( -32, 32, 0.25 );
+            const double shiftY = Unit_Test::randomFloatValue<double>( -32, 32, 0.25 );
+
+            if ( !Image_Function::IsEqual( Shift( image, shiftX, shiftY ), Image_Function::Shift( image, shiftX, shiftY ) ) )
+                return false;
+
+            penguinV::Image binary = Image_Function::Threshold( image, 128u );
+            penguinV::Image binaryReference = binary.generate( binary.width(), binary.height() );
+            Image_Function::Copy( binary, binaryReference );
+
+            const uint32_t dilationX = Unit_Test::randomValue<uint32_t>( 1u, 8u );
+            const uint32_t dilationY = Unit_Test::randomValue<uint32_t>( 1u, 8u );
+
+            BinaryDilate( binary, dilationX, dilationY );
+            Image_Function::BinaryDilate( binaryReference, dilationX, dilationY );
+
+            BinaryErode( binary, roiX, roiY, roiWidth, roiHeight, dilationY, dilationX );
+            Image_Function::BinaryErode( binaryReference, roiX, roiY, roiWidth, roiHeight, dilationY, dilationX );
+
+            if ( !Image_Function::IsEqual( binary, binaryReference ) )
+                return false;
+        }
+
+        return true;
+    }
+
+    // Chained asynchronous functions must not block thread pool even with one thread
+    bool AsyncChain()
+    {
+        for ( uint32_t i = 0; i < 4; ++i ) {
+            ThreadPoolMonoid::instance().resize( Unit_Test::randomValue<uint32_t>( 1u, 9u ) );
+
+            const penguinV::Image image = Unit_Test::randomImage();
+            const uint8_t threshold = Unit_Test::randomValue<uint8_t>( 255 );
+
+            const Async::Future<penguinV::Image> frame = Async::MakeReady( image );
+            const Async::Future<penguinV::Image> binary = Async::Threshold( frame, threshold );
+            const Async::Future<std::vector<uint32_t>> histogram = Async::Histogram( frame );
+            const Async::Future<penguinV::Image> difference = Async::AbsoluteDifference( frame, binary );
+            const Async::Future<uint32_t> sum = Async::Sum( difference );
+            const Async::Future<uint32_t> invertedSum
+                = binary.then( []( const penguinV::Image & in ) { return Function_Pool::Sum( Function_Pool::Invert( in ) ); } );
+
+            Async::WaitAll( binary, histogram, sum, invertedSum );
+
+            const penguinV::Image binaryReference = Image_Function::Threshold( image, threshold );
+
+            if ( !Image_Function::IsEqual( binary.get(), binaryReference ) || histogram.get() != Image_Function::Histogram( image )
+                 || sum.get() != Image_Function::Sum( Image_Function::AbsoluteDifference( image, binaryReference ) )
+                 || invertedSum.get() != Image_Function::Sum( Image_Function::Invert( binaryReference ) ) )
+                return false;
+
+            // an error is passed to all dependent futures
+            const Async::Future<uint32_t> failed = Async::Sum( Async::Median( frame, 2u ) );
+
+            try {
+                failed.get();
+                return false;
+            }
+            catch ( const penguinVException & ) {
+            }
+
+            try {
+                Async::WhenAll( { binary, failed } ).wait();
+                return false;
+            }
+            catch ( const penguinVException & ) {
+            }
+        }
+
+        return true;
+    }
+
+    class CountingTaskProvider : public TaskProvider
+    {
+    public:
+        explicit CountingTaskProvider( ThreadPool * pool )
+            : TaskProvider( pool )
+            , taskCount( 0u )
+        {}
+
+        bool process( size_t count )
+        {
+            _run( count );
+            return _wait();
+        }
+
+        std::atomic<size_t> taskCount;
+
+    protected:
+        virtual void _task( size_t )
+        {
+            ++taskCount;
+        }
+    };
+
+    // A thread waiting for tasks removed from thread pool must be told that results are not computed
+    bool RemovedTasks()
+    {
+        for ( uint32_t i = 0; i < 4; ++i ) {
+            ThreadPool pool( 1u );
+            std::atomic<bool> started( false );
+            std::atomic<bool> released( false );
+
+            std::shared_ptr<Async::FutureValue<void>> busy( new Async::FutureValue<void> );
+
+            {
+                ThreadPoolSelection selection( pool );
+
+                // the only worker thread is busy so next tasks stay in the queue
+                Async::Run( {}, busy, [&]() {
+                    started = true;
+                    while ( !released )
+                        std::this_thread::yield();
+                } );
+            }
+
+            while ( !started )
+                std::this_thread::yield();
+
+            CountingTaskProvider provider( &pool );
+            bool isSucceeded = true;
+            std::thread waiter( [&]() { isSucceeded = provider.process( Unit_Test::randomValue<uint32_t>( 2u, 100u ) ); } );
+
+            while ( pool.empty() )
+                std::this_thread::yield();
+
+            pool.clear();
+            waiter.join();
+
+            released = true;
+            busy->wait();
+
+            if ( isSucceeded || provider.taskCount != 0u )
+                return false;
+        }
+
+        return true;
+    }
+
+    // Asynchronous tasks waiting in queues must fail without blocking when thread pool is cleared or destroyed
+    bool AsyncClear()
+    {
+        for ( uint32_t i = 0; i < 4; ++i ) {
+            std::unique_ptr<ThreadPool> pool( new ThreadPool( 1u ) );
+            std::atomic<bool> started( false );
+            std::atomic<bool> released( false );
+
+            std::shared_ptr<Async::FutureValue<void>> busy( new Async::FutureValue<void> );
+            std::shared_ptr<Async::FutureValue<void>> cleared( new Async::FutureValue<void> );
+            std::shared_ptr<Async::FutureValue<void>> destroyed( new Async::FutureValue<void> );
+
+            {
+                ThreadPoolSelection selection( *pool );
+
+                // the only worker thread is busy so next tasks stay in the queue
+                Async::Run( {}, busy, [&]() {
+                    started = true;
+                    while ( !released )
+                        std::this_thread::yield();
+                } );
+
+                while ( !started )
+                    std::this_thread::yield();
+
+                Async::Run( {}, cleared, []() {} );
+                pool->clear();
+
+                Async::Run( {}, destroyed, []() {} );
+            }
+
+            std::thread releaser( [&]() {
+                std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+                released = true;
+            } );
+
+            pool.reset();
+            releaser.join();
+
+            if ( !busy->ready() || busy->failed() || !cleared->ready() || !cleared->failed() || !destroyed->ready() || !destroyed->failed() )
+                return false;
+        }
+
+        return true;
+    }
+
+    // Fused functions of graph must give the same results as separate functions
+    bool GraphPipeline()
+    {
+        for ( uint32_t i = 0; i < 4; ++i ) {
+            ThreadPoolMonoid::instance().resize( Unit_Test::randomValue<uint32_t>( 1u, 9u ) );
+
+            const uint32_t width = Unit_Test::randomValue<uint32_t>( 16u, 1024u );
+            const uint32_t height = Unit_Test::randomValue<uint32_t>( 16u, 1024u );
+
+            const penguinV::Image frame
+                = Image_Function::Merge( Unit_Test::randomImage( width, height ), Unit_Test::randomImage( width, height ), Unit_Test::randomImage( width, height ) );
+            const penguinV::Image mask = Unit_Test::randomImage( width, height );
+            const uint8_t channelId = Unit_Test::randomValue<uint8_t>( 3 );
+            const uint8_t threshold = Unit_Test::randomValue<uint8_t>( 255 );
+
+            Graph graph;
+            const Graph::Node frameNode = graph.input();
+            const Graph::Node maskNode = graph.input();
+            const Graph::Node masked = graph.bitwiseAnd( graph.threshold( graph.extractChannel( frameNode, channelId ), threshold ), maskNode );
+            const Graph::Node histogram = graph.histogram( masked );
+            const Graph::Node sum = graph.sum( graph.invert( masked ) );
+
+            uint32_t processedSum = 0u;
+            graph.process( masked, [&processedSum]( const penguinV::Image & image ) { processedSum = Image_Function::Sum( image ); } );
+
+            // whole image functions split the graph into groups which reuse intermediate images
+            const Graph::Node median = graph.transform( masked, []( const penguinV::Image & in, penguinV::Image & out ) { Function_Pool::Median( in, out, 3 ); } );
+            const Graph::Node flip
+                = graph.transform( graph.invert( median ), []( const penguinV::Image & in, penguinV::Image & out ) { Function_Pool::Flip( in, out, true, false ); } );
+            const Graph::Node result = graph.invert( flip );
+
+            graph.output( masked );
+            graph.output( result );
+
+            const penguinV::Image maskedReference
+                = Image_Function::BitwiseAnd( Image_Function::Threshold( Image_Function::ExtractChannel( frame, channelId ), threshold ), mask );
+            const penguinV::Image resultReference
+                = Image_Function::Invert( Image_Function::Flip( Image_Function::Invert( Image_Function::Median( maskedReference, 3 ) ), true, false ) );
+
+            for ( uint32_t run = 0; run < 2; ++run ) {
+                // band-sized images of tasks are kept between runs and must follow changes of thread count
+                ThreadPoolMonoid::instance().resize( Unit_Test::randomValue<uint32_t>( 1u, 9u ) );
+
+                graph.run( { &frame, &mask } );
+
+                if ( !Image_Function::IsEqual( graph.getImage( masked ), maskedReference ) || !Image_Function::IsEqual( graph.getImage( result ), resultReference )
+                     || graph.getHistogram( histogram ) != Image_Function::Histogram( maskedReference )
+                     || graph.getSum( sum ) != Image_Function::Sum( Image_Function::Invert( maskedReference ) )
+                     || processedSum != Image_Function::Sum( maskedReference ) || graph.bufferCount() != 2u )
+                    return false;
+            }
+        }
+
+        // a graph without inputs has nothing to run
+        try {
+            Graph().run( std::vector<const penguinV::Image *>() );
+            return false;
+        }
+        catch ( const penguinVException & ) {
+        }
+
+        return true;
+    }
+
+    // Every image of a batch must give the same result as a separate call of single threaded function
+    bool Batch()
+    {
+        for ( uint32_t i = 0; i < 4; ++i ) {
+            ThreadPoolMonoid::instance().resize( Unit_Test::randomValue<uint32_t>( 1u, 9u ) );
+
+            std::vector<penguinV::Image> image( Unit_Test::randomValue<size_t>( 1u, 200u ) );
+            for ( std::vector<penguinV::Image>::iterator patch = image.begin(); patch != image.end(); ++patch )
+                *patch = Unit_Test::randomImage( Unit_Test::randomValue<uint32_t>( 1u, 64u ), Unit_Test::randomValue<uint32_t>( 1u, 64u ) );
+
+            const uint8_t threshold = Unit_Test::randomValue<uint8_t>( 256 );
+            const uint8_t minThreshold = Unit_Test::randomValue<uint8_t>( 128 );
+            const uint8_t maxThreshold = Unit_Test::randomValue<uint8_t>( minThreshold, 256 );
+            const uint32_t widthOut = Unit_Test::randomValue<uint32_t>( 1u, 64u );
+            const uint32_t heightOut = Unit_Test::randomValue<uint32_t>( 1u, 64u );
+
+            const std::vector<penguinV::Image> threshold1 = Batch::Threshold( image, threshold );
+            const std::vector<penguinV::Image> threshold2 = Batch::Threshold( image, minThreshold, maxThreshold );
+            const std::vector<penguinV::Image> resized = Batch::Resize( image, widthOut, heightOut );
+            const std::vector<std::vector<uint32_t>> histogram = Batch::Histogram( image );
+            const std::vector<uint32_t> sum = Batch::Sum( image );
+            const std::vector<Blob_Detection::BlobDetection> detection = Batch::BlobDetection( threshold1 );
+
+            std::vector<penguinV::Image> out( image.size() );
+            for ( size_t id = 0; id < image.size(); ++id )
+                out[id].resize( image[id].width(), image[id].height() );
+            Batch::Threshold( image, out, threshold );
+
+            if ( threshold1.size() != image.size() || threshold2.size() != image.size() || resized.size() != image.size() || histogram.size() != image.size()
+                 || sum.size() != image.size() || detection.size() != image.size() )
+                return false;
+
+            for ( size_t id = 0; id < image.size(); ++id ) {
+                Blob_Detection::BlobDetection reference;
+                reference.find( threshold1[id] );
+
+                if ( !Image_Function::IsEqual( threshold1[id], Image_Function::Threshold( image[id], threshold ) )
+                     || !Image_Function::IsEqual( out[id], threshold1[id] )
+                     || !Image_Function::IsEqual( threshold2[id], Image_Function::Threshold( image[id], minThreshold, maxThreshold ) )
+                     || !Image_Function::IsEqual( resized[id], Image_Function::Resize( image[id], widthOut, heightOut ) )
+                     || histogram[id] != Image_Function::Histogram( image[id] ) || sum[id] != Image_Function::Sum( image[id] )
+                     || detection[id]().size() != reference().size() )
+                    return false;
+
+                for ( size_t blobId = 0; blobId < reference().size(); ++blobId ) {
+                    if ( detection[id]()[blobId].size() != reference()[blobId].size() )
+                        return false;
+                }
+            }
+
+            std::vector<penguinV::Image> wrongSize( image.size() + 1u );
+            try {
+                Batch::Threshold( image, wrongSize, threshold );
+                return false;
+            }
+            catch ( const penguinVException & ) {
+            }
+        }
+
+        return true;
+    }
+
+    // Results for a list of ROIs must be the same as results of separate calls for every ROI
+    bool RoiList()
+    {
+        for ( uint32_t i = 0; i < 4; ++i ) {
+            ThreadPoolMonoid::instance().resize( Unit_Test::randomValue<uint32_t>( 1u, 9u ) );
+
+            const penguinV::Image gray = Unit_Test::randomImage( Unit_Test::randomValue<uint32_t>( 64u, 1024u ), Unit_Test::randomValue<uint32_t>( 256u, 1024u ) );
+            const penguinV::Image rgb = Image_Function::Merge( gray, Unit_Test::randomImage( gray.width(), gray.height() ),
+                                                              Unit_Test::randomImage( gray.width(), gray.height() ) );
+
+            std::vector<penguinV::Roi> roi( Unit_Test::randomValue<size_t>( 1u, 300u ) ); // ROIs could overlap
+            for ( std::vector<penguinV::Roi>::iterator area = roi.begin(); area != roi.end(); ++area )
+                Unit_Test::generateRoi( gray, area->x, area->y, area->width, area->height );
+
+            const bool horizontal = ( Unit_Test::randomValue<uint32_t>( 2u ) == 0u );
+
+            const std::vector<std::vector<uint32_t>> histogram = Image_Function::Histogram( rgb, roi );
+            const std::vector<std::vector<uint32_t>> histogramPool = Histogram( gray, roi );
+            const std::vector<std::vector<uint32_t>> projection = Image_Function::ProjectionProfile( rgb, roi, horizontal );
+            const std::vector<std::vector<uint32_t>> projectionPool = ProjectionProfile( gray, roi, horizontal );
+            const std::vector<std::vector<uint32_t>> projectionSimd = Image_Function_Simd::ProjectionProfile( rgb, roi, horizontal );
+            const std::vector<uint32_t> sum = Image_Function::Sum( gray, roi );
+            const std::vector<uint32_t> sumPool = Sum( gray, roi );
+            const std::vector<uint32_t> sumSimd = Image_Function_Simd::Sum( gray, roi );
+
+            for ( size_t id = 0; id < roi.size(); ++id ) {
+                const penguinV::Roi & area = roi[id];
+
+                if ( histogram[id] != Image_Function::Histogram( rgb, area.x, area.y, area.width, area.height )
+                     || histogramPool[id] != Image_Function::Histogram( gray, area.x, area.y, area.width, area.height )
+                     || projection[id] != Image_Function::ProjectionProfile( rgb, area.x, area.y, area.width, area.height, horizontal )
+                     || projectionPool[id] != Image_Function::ProjectionProfile( gray, area.x, area.y, area.width, area.height, horizontal )
+                     || projectionSimd[id] != Image_Function::ProjectionProfile( rgb, area.x, area.y, area.width, area.height, horizontal )
+                     || sum[id] != Image_Function::Sum( gray, area.x, area.y, area.width, area.height )
+                     || sumPool[id] != Image_Function::Sum( gray, area.x, area.y, area.width, area.height )
+                     || sumSimd[id] != Image_Function::Sum( gray, area.x, area.y, area.width, area.height ) )
+                    return false;
+            }
+
+            try {
+                Sum( rgb, roi );
+                return false;
+            }
+            catch ( const penguinVException & error ) {
+                // Colour image must be rejected before ROIs are split between threads
+                if ( std::string( error.what() ).find( "gray-scaled" ) == std::string::npos )
+                    return false;
+            }
+
+            roi.push_back( penguinV::Roi( 0u, 0u, gray.width() + 1u, 1u ) );
+            try {
+                Sum( gray, roi );
+                return false;
+            }
+            catch ( const penguinVException & ) {
+            }
+        }
+
+        return true;
+    }
 }
 
+namespace image_expression
+{
+    // Fused expression must give the same results as separate functions for every SIMD technology and for image views
+    bool FusedExpression()
+    {
+        const std::vector<std::string> namespaceName
+            = { "image_function_avx512", "image_function_avx", "image_function_sse", "image_function_neon", "image_function_cpu" };
+
+        for ( std::vector<std::string>::const_iterator name = namespaceName.cbegin(); name != namespaceName.cend(); ++name ) {
+            // SIMD technologies which are not supported fall back to CPU code
+            simd::EnableSimd( false );
+            PrepareFunction( *name );
+
+            for ( uint32_t i = 0; i < 8; ++i ) {
+                const uint32_t width = Unit_Test::randomValue<uint32_t>( 1u, 300u );
+                const uint32_t height = Unit_Test::randomValue<uint32_t>( 1u, 32u );
+
+                const penguinV::Image in1 = Unit_Test::randomImage( width, height );
+                const penguinV::Image in2 = Unit_Test::randomImage( width, height );
+                const penguinV::Image in3 = Unit_Test::randomImage( width, height );
+                const uint8_t threshold = Unit_Test::randomValue<uint8_t>( 256 );
+                const uint8_t minThreshold = Unit_Test::randomValue<uint8_t>( 128 );
+                const uint8_t maxThreshold = Unit_Test::randomValue<uint8_t>( minThreshold, 256 );
+
+                const penguinV::Image threshold1 = Image_Expression::Threshold( Image_Expression::AbsoluteDifference( in1, in2 ), threshold );
+                const penguinV::Image arithmetic
+                    = Image_Expression::Maximum( Image_Expression::Invert( in1 ), Image_Expression::Minimum( Image_Expression::Subtract( in2, in3 ), in1 ) );
+                const penguinV::Image threshold2 = Image_Expression::Threshold(
+                    Image_Expression::BitwiseXor( in1, Image_Expression::BitwiseOr( in2, Image_Expression::BitwiseAnd( in3, in1 ) ) ), minThreshold, maxThreshold );
+
+                if ( !Image_Function::IsEqual( threshold1, Image_Function::Threshold( Image_Function::AbsoluteDifference( in1, in2 ), threshold ) )
+                     || !Image_Function::IsEqual( arithmetic, Image_Function::Maximum( Image_Function::Invert( in1 ),
+                                                                                       Image_Function::Minimum( Image_Function::Subtract( in2, in3 ), in1 ) ) )
+                     || !Image_Function::IsEqual( threshold2,
+                                                  Image_Function::Threshold( Image_Function::BitwiseXor(
+                                                                                 in1, Image_Function::BitwiseOr( in2, Image_Function::BitwiseAnd( in3, in1 ) ) ),
+                                                                             minThreshold, maxThreshold ) ) ) {
+                    simd::EnableSimd( true );
+                    return false;
+                }
+
+                // views of images and evaluation in place
+                uint32_t roiX1, roiY1, roiX2, roiY2, roiWidth, roiHeight;
+                Unit_Test::generateRoi( in1, roiX1, roiY1, roiWidth, roiHeight );
+                roiX2 = Unit_Test::randomValue<uint32_t>( width - roiWidth + 1 );
+                roiY2 = Unit_Test::randomValue<uint32_t>( height - roiHeight + 1 );
+
+                penguinV::Image out = in2;
+                const penguinV::ConstImageView view1( in1, roiX1, roiY1, roiWidth, roiHeight );
+                const penguinV::ImageView viewOut( out, roiX2, roiY2, roiWidth, roiHeight );
+
+                Image_Expression::Evaluate( Image_Expression::Invert( Image_Expression::Maximum( view1, viewOut ) ), viewOut );
+
+                penguinV::Image reference = in2;
+                Image_Function::Invert( Image_Function::Maximum( in1, roiX1, roiY1, in2, roiX2, roiY2, roiWidth, roiHeight ), 0, 0, reference, roiX2, roiY2,
+                                        roiWidth, roiHeight );
+
+                if ( !Image_Function::IsEqual( out, reference ) ) {
+                    simd::EnableSimd( true );
+                    return false;
+                }
+
+                // 16-bit images
+                penguinV::Image16Bit in16Bit1( width, height );
+                penguinV::Image16Bit in16Bit2( width, height );
+                for ( uint32_t y = 0; y < height; ++y ) {
+                    for ( uint32_t x = 0; x < width; ++x ) {
+                        in16Bit1.data()[y * in16Bit1.rowSize() + x] = Unit_Test::randomValue<uint16_t>( 65536 );
+                        in16Bit2.data()[y * in16Bit2.rowSize() + x] = Unit_Test::randomValue<uint16_t>( 65536 );
+                    }
+                }
+
+                const uint16_t threshold16Bit = Unit_Test::randomValue<uint16_t>( 65536 );
+                const penguinV::Image16Bit out16Bit
+                    = Image_Expression::Maximum( Image_Expression::AbsoluteDifference( in16Bit1, in16Bit2 ),
+                                                 Image_Expression::Minimum( in16Bit1, Image_Expression::Threshold( in16Bit2, threshold16Bit ) ) );
+
+                for ( uint32_t y = 0; y < height; ++y ) {
+                    for ( uint32_t x = 0; x < width; ++x ) {
+                        const uint16_t value1 = in16Bit1.data()[y * in16Bit1.rowSize() + x];
+                        const uint16_t value2 = in16Bit2.data()[y * in16Bit2.rowSize() + x];
+
+                        const uint16_t difference = static_cast<uint16_t>( value1 > value2 ? value1 - value2 : value2 - value1 );
+                        const uint16_t binary = value2 < threshold16Bit ? 0u : 65535u;
+                        const uint16_t minimum = std::min( value1, binary );
+
+                        if ( out16Bit.data()[y * out16Bit.rowSize() + x] != std::max( difference, minimum ) ) {
+                            simd::EnableSimd( true );
+                            return false;
+                        }
+                    }
+                }
+            }
+
+            simd::EnableSimd( true );
+        }
+
+        return true;
+    }
+
+    // Fused expressions use the widest register compiled into the header which is not wider than SIMD type selected during runtime.
+    // A build without -march=native must not fall back to scalar code on CPUs supporting AVX
+    bool EvaluationRegister()
+    {
+        simd::EnableSimd( true );
+
+        const simd::SIMDType actual = simd::actualSimdType();
+        simd::SIMDType expected = simd::cpu_function;
+
+#ifdef PENGUINV_NEON_SET
+        if ( actual == simd::neon_function )
+            expected = simd::neon_function;
+#endif
+#ifdef PENGUINV_SSE_SET
+        if ( actual == simd::sse_function || actual == simd::avx_function || actual == simd::avx512_function )
+            expected = simd::sse_function;
+#endif
+#ifdef PENGUINV_AVX_SET
+        if ( actual == simd::avx_function || actual == simd::avx512_function )
+            expected = simd::avx_function;
+#endif
 #ifdef PENGUINV_AVX512_SKL_SET
+        if ( actual == simd::avx512_function )
+            expected = simd::avx512_function;
+#endif
+
+        return Image_Expression::EvaluationSimdType() == expected;
+    }
+}
+
+namespace image_function_simd
+{
+    // Instruction set is selected during runtime among sets supported by processor and not disabled by simd::Enable*() functions
+    bool RuntimeSelection()
+    {
+        const bool isAvx512 = SimdInfo::isAVX512SKLAvailable();
+        const bool isAvx = SimdInfo::isAvxAvailable();
+        const bool isSse = SimdInfo::isSseAvailable();
+        const bool isNeon = SimdInfo::isNeonAvailable();
+
+        const uint32_t width = Unit_Test::randomValue<uint32_t>( 1u, 300u );
+        const uint32_t height = Unit_Test::randomValue<uint32_t>( 1u, 32u );
+        const penguinV::Image in1 = Unit_Test::randomImage( width, height );
+        const penguinV::Image in2 = Unit_Test::randomImage( width, height );
+        const uint8_t threshold = Unit_Test::randomValue<uint8_t>( 256 );
+
+        const penguinV::Image reference = Image_Function::Threshold( Image_Function::AbsoluteDifference( in1, in2 ), threshold );
+        const uint32_t referenceSum = Image_Function::Sum( in1 );
+
+        for ( uint32_t disabled = 0; disabled < 5u; ++disabled ) {
+            // disable sets one by one starting from the newest one
+            simd::EnableAvx512( disabled < 1u );
+            simd::EnableAvx( disabled < 2u );
+            simd::EnableSse( disabled < 3u );
+            simd::EnableNeon( disabled < 4u );
+
+            simd::SIMDType expected = simd::cpu_function;
+            if ( isAvx512 && disabled < 1u )
+                expected = simd::avx512_function;
+            else if ( isAvx && disabled < 2u )
+                expected = simd::avx_function;
+            else if ( isSse && disabled < 3u )
+                expected = simd::sse_function;
+            else if ( isNeon && disabled < 4u )
+                expected = simd::neon_function;
+
+            if ( simd::actualSimdType() != expected
+                 || !Image_Function::IsEqual( reference, Image_Function_Simd::Threshold( Image_Function_Simd::AbsoluteDifference( in1, in2 ), threshold ) )
+                 || Image_Function_Simd::Sum( in1 ) != referenceSum ) {
+                simd::EnableSimd( true );
+                return false;
+            }
+        }
+
+        simd::EnableSimd( true );
+
+        return true;
+    }
+}
+
+#ifdef PENGUINV_AVX512_SKL_DISPATCH
 namespace avx512
 {
     using namespace Image_Function_Simd;
@@ -2613,6 +3454,7 @@ namespace avx512
 
     SET_FUNCTION_4_FORMS( AbsoluteDifference )
     SET_FUNCTION_2_FORMS( Accumulate )
+    SET_FUNCTION_2_FORMS( Accumulate64 )
     SET_FUNCTION_4_FORMS( BitwiseAnd )
     SET_FUNCTION_4_FORMS( BitwiseOr )
     SET_FUNCTION_4_FORMS( BitwiseXor )
@@ -2622,12 +3464,15 @@ namespace avx512
     SET_FUNCTION_4_FORMS( Maximum )
     SET_FUNCTION_4_FORMS( Minimum )
     SET_FUNCTION_4_FORMS( ProjectionProfile )
+    SET_FUNCTION_4_FORMS( ProjectionProfile64 )
     SET_FUNCTION_4_FORMS( Subtract )
     SET_FUNCTION_2_FORMS( Sum )
+    SET_FUNCTION_2_FORMS( Sum64 )
+    SET_FUNCTION_8_FORMS( Threshold )
 }
 #endif
 
-#ifdef PENGUINV_AVX_SET
+#ifdef PENGUINV_AVX_DISPATCH
 namespace avx
 {
     using namespace Image_Function_Simd;
@@ -2637,6 +3482,7 @@ namespace avx
 
     SET_FUNCTION_4_FORMS( AbsoluteDifference )
     SET_FUNCTION_2_FORMS( Accumulate )
+    SET_FUNCTION_2_FORMS( Accumulate64 )
     SET_FUNCTION_4_FORMS( BitwiseAnd )
     SET_FUNCTION_4_FORMS( BitwiseOr )
     SET_FUNCTION_4_FORMS( BitwiseXor )
@@ -2646,14 +3492,16 @@ namespace avx
     SET_FUNCTION_4_FORMS( Maximum )
     SET_FUNCTION_4_FORMS( Minimum )
     SET_FUNCTION_4_FORMS( ProjectionProfile )
+    SET_FUNCTION_4_FORMS( ProjectionProfile64 )
     SET_FUNCTION_4_FORMS( RgbToBgr )
     SET_FUNCTION_4_FORMS( Subtract )
     SET_FUNCTION_2_FORMS( Sum )
+    SET_FUNCTION_2_FORMS( Sum64 )
     SET_FUNCTION_8_FORMS( Threshold )
 }
 #endif
 
-#ifdef PENGUINV_NEON_SET
+#ifdef PENGUINV_NEON_DISPATCH
 namespace neon
 {
     using namespace Image_Function_Simd;
@@ -2663,6 +3511,7 @@ namespace neon
 
     SET_FUNCTION_4_FORMS( AbsoluteDifference )
     SET_FUNCTION_2_FORMS( Accumulate )
+    SET_FUNCTION_2_FORMS( Accumulate64 )
     SET_FUNCTION_4_FORMS( BitwiseAnd )
     SET_FUNCTION_4_FORMS( BitwiseOr )
     SET_FUNCTION_4_FORMS( BitwiseXor )
@@ -2674,14 +3523,16 @@ namespace neon
     SET_FUNCTION_4_FORMS( Maximum )
     SET_FUNCTION_4_FORMS( Minimum )
     SET_FUNCTION_4_FORMS( ProjectionProfile )
+    SET_FUNCTION_4_FORMS( ProjectionProfile64 )
     SET_FUNCTION_4_FORMS( RgbToBgr )
     SET_FUNCTION_4_FORMS( Subtract )
     SET_FUNCTION_2_FORMS( Sum )
+    SET_FUNCTION_2_FORMS( Sum64 )
     SET_FUNCTION_8_FORMS( Threshold )
 }
 #endif
 
-#ifdef PENGUINV_SSE_SET
+#ifdef PENGUINV_SSE_DISPATCH
 namespace sse
 {
     using namespace Image_Function_Simd;
@@ -2691,6 +3542,7 @@ namespace sse
 
     SET_FUNCTION_4_FORMS( AbsoluteDifference )
     SET_FUNCTION_2_FORMS( Accumulate )
+    SET_FUNCTION_2_FORMS( Accumulate64 )
     SET_FUNCTION_4_FORMS( BitwiseAnd )
     SET_FUNCTION_4_FORMS( BitwiseOr )
     SET_FUNCTION_4_FORMS( BitwiseXor )
@@ -2702,9 +3554,11 @@ namespace sse
     SET_FUNCTION_4_FORMS( Maximum )
     SET_FUNCTION_4_FORMS( Minimum )
     SET_FUNCTION_4_FORMS( ProjectionProfile )
+    SET_FUNCTION_4_FORMS( ProjectionProfile64 )
     SET_FUNCTION_4_FORMS( RgbToBgr )
     SET_FUNCTION_4_FORMS( Subtract )
     SET_FUNCTION_2_FORMS( Sum )
+    SET_FUNCTION_2_FORMS( Sum64 )
     SET_FUNCTION_8_FORMS( Threshold )
 }
 #endif
@@ -2712,4 +3566,17 @@ namespace sse
 void addTests_Image_Function( UnitTestFramework & framework )
 {
     FunctionRegistrator::instance().set( framework );
+
+    ADD_TEST( framework, image_function::ColorHistogram );
+    ADD_TEST( framework, function_pool::TiledArea );
+    ADD_TEST( framework, function_pool::NeighbourArea );
+    ADD_TEST( framework, function_pool::AsyncChain );
+    ADD_TEST( framework, function_pool::AsyncClear );
+    ADD_TEST( framework, function_pool::RemovedTasks );
+    ADD_TEST( framework, function_pool::GraphPipeline );
+    ADD_TEST( framework, function_pool::Batch );
+    ADD_TEST( framework, function_pool::RoiList );
+    ADD_TEST( framework, image_expression::FusedExpression );
+    ADD_TEST( framework, image_expression::EvaluationRegister );
+    ADD_TEST( framework, image_function_simd::RuntimeSelection );
 }
@@ -0,0 +1,255 @@
+/***************************************************************************
+ *   penguinV: https://github.com/ihhub/penguinV                           *
+ *   Copyright (C) 2017 - 2022                                             *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "unit_test_memory.h"
+#include "../../src/memory/cpu_memory.h"
+#include "unit_test_framework.h"
+#include "unit_test_helper.h"
+#include <algorithm>
+
+namespace
+{
+    size_t roundedSize( size_t size )
+    {
+        size_t chunkSize = 32u; // minimum chunk size of CPU allocator
+        while ( chunkSize < size )
+            chunkSize <<= 1;
+
+        return chunkSize;
+    }
+
+    std::vector<size_t> randomSizes()
+    {
+        std::vector<size_t> size( Unit_Test::randomValue<uint32_t>( 1u, 64u ) );
+        for ( std::vector<size_t>::iterator value = size.begin(); value != size.end(); ++value )
+            *value = Unit_Test::randomValue<uint32_t>( 1u, 4096u );
+
+        return size;
+    }
+
+    // allocates all objects and frees marked ones immediately, the rest are freed in reverse order at the end
+    void allocationPattern( cpu_Memory::MemoryAllocator & allocator, const std::vector<size_t> & size, const std::vector<uint8_t> & freeImmediately )
+    {
+        std::vector<uint8_t *> data;
+
+        for ( size_t i = 0; i < size.size(); ++i ) {
+            data.push_back( allocator.allocate<uint8_t>( size[i] ) );
+
+            if ( freeImmediately[i] != 0 ) {
+                allocator.free( data.back() );
+                data.pop_back();
+            }
+        }
+
+        for ( std::vector<uint8_t *>::reverse_iterator address = data.rbegin(); address != data.rend(); ++address )
+            allocator.free( *address );
+    }
+}
+
+namespace memory
+{
+    bool StatisticsUsedSize()
+    {
+        for ( uint32_t i = 0; i < Unit_Test::runCount(); ++i ) {
+            cpu_Memory::MemoryAllocator allocator;
+            allocator.reserve( 1024 * 1024 );
+
+            const std::vector<size_t> size = randomSizes();
+            std::vector<uint8_t *> data;
+
+            size_t requestedSize = 0;
+            size_t usedSize = 0;
+
+            for ( std::vector<size_t>::const_iterator value = size.begin(); value != size.end(); ++value ) {
+                data.push_back( allocator.allocate<uint8_t>( *value ) );
+                requestedSize += *value;
+                usedSize += roundedSize( *value );
+            }
+
+            const cpu_Memory::MemoryAllocator::Statistics info = allocator.statistics();
+
+            size_t freeSize = 0;
+            for ( std::vector<size_t>::const_iterator value = info.freeSize.begin(); value != info.freeSize.end(); ++value )
+                freeSize += *value;
+
+            for ( std::vector<uint8_t *>::iterator address = data.begin(); address != data.end(); ++address )
+                allocator.free( *address );
+
+            if ( info.reservedSize != 1024 * 1024 || info.usedSize != usedSize || info.peakUsedSize != usedSize || info.requestedSize != requestedSize
+                 || info.roundedSize != usedSize || info.heapAllocationCount != 0 || info.failedSplitCount != 0 || freeSize + usedSize != info.reservedSize )
+                return false;
+        }
+
+        return true;
+    }
+
+    bool StatisticsHeapAllocation()
+    {
+        for ( uint32_t i = 0; i < Unit_Test::runCount(); ++i ) {
+            cpu_Memory::MemoryAllocator allocator;
+            allocator.reserve( 1024 );
+
+            const uint32_t count = Unit_Test::randomValue<uint32_t>( 1u, 16u );
+            std::vector<uint8_t *> data;
+
+            for ( uint32_t j = 0; j < count; ++j )
+                data.push_back( allocator.allocate<uint8_t>( Unit_Test::randomValue<uint32_t>( 1024u, 4096u ) ) );
+
+            // both chunks of 512 bytes are taken so the third allocation cannot split any chunk
+            data.push_back( allocator.allocate<uint8_t>( 512 ) );
+            data.push_back( allocator.allocate<uint8_t>( 512 ) );
+            data.push_back( allocator.allocate<uint8_t>( 512 ) );
+
+            const cpu_Memory::MemoryAllocator::Statistics info = allocator.statistics();
+
+            for ( std::vector<uint8_t *>::iterator address = data.begin(); address != data.end(); ++address )
+                allocator.free( *address );
+
+            if ( info.heapAllocationCount != count + 1u || info.failedSplitCount != 1u || info.usedSize != 1024u )
+                return false;
+        }
+
+        return true;
+    }
+
+    bool HeapAllocationAlignment()
+    {
+        for ( uint32_t i = 0; i < Unit_Test::runCount(); ++i ) {
+            cpu_Memory::MemoryAllocator allocator;
+            allocator.reserve( 1024 );
+
+            uint8_t * data = allocator.allocate<uint8_t>( Unit_Test::randomValue<uint32_t>( 1024u, 65536u ) );
+            const bool isAligned = ( reinterpret_cast<std::uintptr_t>( data ) % 64u ) == 0;
+            allocator.free( data );
+
+            if ( !isAligned || allocator.statistics().heapAllocationCount != 1u )
+                return false;
+        }
+
+        return true;
+    }
+
+    bool ArenaAllocation()
+    {
+        const cpu_Memory::ArenaType arena[2] = { cpu_Memory::page_arena, cpu_Memory::huge_page_arena };
+
+        for ( uint32_t i = 0; i < Unit_Test::runCount(); ++i ) {
+            cpu_Memory::MemoryAllocator allocator;
+            allocator.reserve( 1024 * 1024, arena[Unit_Test::randomValue<uint8_t>( 2 )], Unit_Test::randomValue<uint8_t>( 2 ) == 0 ? -1 : 0 );
+
+            const std::vector<size_t> size = randomSizes();
+            std::vector<uint8_t *> data;
+
+            bool isValid = true;
+
+            for ( std::vector<size_t>::const_iterator value = size.begin(); value != size.end(); ++value ) {
+                data.push_back( allocator.allocate<uint8_t>( *value ) );
+                std::fill( data.back(), data.back() + *value, static_cast<uint8_t>( *value ) );
+
+                if ( !allocator.contains( data.back() ) || ( reinterpret_cast<std::uintptr_t>( data.back() ) % 32u ) != 0 )
+                    isValid = false;
+            }
+
+            for ( size_t j = 0; j < data.size(); ++j ) {
+                if ( std::count( data[j], data[j] + size[j], static_cast<uint8_t>( size[j] ) ) != static_cast<std::ptrdiff_t>( size[j] ) )
+                    isValid = false;
+
+                allocator.free( data[j] );
+            }
+
+            // the same size of memory from another arena
+            allocator.reserve( 1024 * 1024, cpu_Memory::heap_arena );
+
+            if ( !isValid || allocator.arenaType() != cpu_Memory::heap_arena || allocator.statistics().reservedSize != 1024 * 1024 )
+                return false;
+        }
+
+        return true;
+    }
+
+    bool NodeArenaAllocation()
+    {
+        cpu_Memory::NodeMemoryAllocator allocator;
+        allocator.reserve( 1024 * 1024, cpu_Memory::page_arena );
+
+        const uint32_t threadNode = cpu_Memory::NodeMemoryAllocator::threadNode();
+
+        for ( uint32_t i = 0; i < Unit_Test::runCount(); ++i ) {
+            const uint32_t node = Unit_Test::randomValue<uint32_t>( static_cast<uint32_t>( allocator.arenaCount() ) );
+            cpu_Memory::NodeMemoryAllocator::setThreadNode( node );
+
+            const size_t size = Unit_Test::randomValue<uint32_t>( 1u, 65536u );
+            uint8_t * data = allocator.allocate<uint8_t>( size );
+            const bool isNodeMemory = allocator.allocator( node ).contains( data );
+            allocator.free( data );
+
+            if ( !isNodeMemory ) {
+                cpu_Memory::NodeMemoryAllocator::setThreadNode( threadNode );
+                return false;
+            }
+        }
+
+        cpu_Memory::NodeMemoryAllocator::setThreadNode( threadNode );
+
+        return allocator.arenaCount() == cpu_Memory::nodeCount();
+    }
+
+    bool SuggestedReserveSize()
+    {
+        for ( uint32_t i = 0; i < Unit_Test::runCount(); ++i ) {
+            const std::vector<size_t> size = randomSizes();
+
+            std::vector<uint8_t> freeImmediately( size.size() );
+            for ( std::vector<uint8_t>::iterator value = freeImmediately.begin(); value != freeImmediately.end(); ++value )
+                *value = Unit_Test::randomValue<uint8_t>( 2 );
+
+            cpu_Memory::MemoryAllocator recorder;
+            recorder.reserve( 1024 );
+
+            recorder.startRecording();
+            allocationPattern( recorder, size, freeImmediately );
+            recorder.stopRecording();
+
+            const size_t suggestedSize = recorder.suggestedReserveSize();
+            if ( suggestedSize == 0 )
+                return false;
+
+            cpu_Memory::MemoryAllocator allocator;
+            allocator.reserve( suggestedSize );
+
+            allocationPattern( allocator, size, freeImmediately );
+
+            if ( allocator.statistics().heapAllocationCount != 0 )
+                return false;
+        }
+
+        return true;
+    }
+}
+
+void addTests_Memory( UnitTestFramework & framework )
+{
+    ADD_TEST( framework, memory::StatisticsUsedSize );
+    ADD_TEST( framework, memory::StatisticsHeapAllocation );
+    ADD_TEST( framework, memory::HeapAllocationAlignment );
+    ADD_TEST( framework, memory::ArenaAllocation );
+    ADD_TEST( framework, memory::NodeArenaAllocation );
+    ADD_TEST( framework, memory::SuggestedReserveSize );
+}
@@ -27,6 +27,7 @@
 #include "unit_test_image_buffer.h"
 #include "unit_test_image_function.h"
 #include "unit_test_math.h"
+#include "unit_test_memory.h"
 
 int main( int argc, char * argv[] )
 {
@@ -42,6 +43,7 @@ int main( int argc, char * argv[] )
     addTests_Image_Buffer( framework );
     addTests_Image_Function( framework );
     addTests_Math( framework );
+    addTests_Memory( framework );
 
     return framework.run();
 }